@@ -199,6 +199,16 @@ namespace NTimeFormat
     }
 }
 
+// Code of the complete event of ObjectDataMgr.loadGroupAsync
+namespace NGroupLoad
+{
+    shared enum EGroupLoad
+    {
+        EGL_LOADED = 0,
+        EGL_FAILED
+    }
+}
+
 namespace NActionPress
 {
     enum EActionPress
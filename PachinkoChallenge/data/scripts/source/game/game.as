@@ -162,14 +162,14 @@ class CGame
     /************************************************************************
     *    DESC:  Physics callbacks
     ************************************************************************/
-    void beginContact( CSprite & spriteA, CSprite & spriteB )
+    void beginContact( array<CSprite@> @ contactAry )
     {
-        mGameState.beginContact( spriteA, spriteB );
+        mGameState.beginContact( contactAry );
     }
 
-    void endContact( CSprite & spriteA, CSprite & spriteB )
+    void endContact( array<CSprite@> @ contactAry )
     {
-        mGameState.endContact( spriteA, spriteB );
+        mGameState.endContact( contactAry );
     }
 
     void destroyFixture( CSprite & sprite )
@@ -26,16 +26,18 @@ void main()
 /************************************************************************
 *    DESC:  Physics callbacks
 ************************************************************************/
-void Physics_BeginContact( CSprite & spriteA, CSprite & spriteB )
+// The contacts of the step come in one array with the sprites
+// of each contact next to each other (a0, b0, a1, b1...)
+void Physics_BeginContact( array<CSprite@> @ contactAry )
 {
     if( hGame !is null )
-        hGame.beginContact( spriteA, spriteB );
+        hGame.beginContact( contactAry );
 }
 
-void Physics_EndContact( CSprite & spriteA, CSprite & spriteB )
+void Physics_EndContact( array<CSprite@> @ contactAry )
 {
     if( hGame !is null )
-        hGame.endContact( spriteA, spriteB );
+        hGame.endContact( contactAry );
 }
 
 void Physics_DestroyFixture( CSprite & sprite )
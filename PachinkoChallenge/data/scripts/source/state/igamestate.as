@@ -93,6 +93,20 @@ class iGameState
     { return mStateMessage; }
 
     // Physics callbacks
+    // The contacts of the step come in one array (a0, b0, a1, b1...)
+    // By default each contact is passed on to the pair version
+    void beginContact( array<CSprite@> @ contactAry )
+    {
+        for( uint i = 0; i < contactAry.length(); i += 2 )
+            beginContact( contactAry[i], contactAry[i+1] );
+    }
+
+    void endContact( array<CSprite@> @ contactAry )
+    {
+        for( uint i = 0; i < contactAry.length(); i += 2 )
+            endContact( contactAry[i], contactAry[i+1] );
+    }
+
     void beginContact( CSprite & spriteA, CSprite & spriteB )
     {
         // Empty member to be overwritten
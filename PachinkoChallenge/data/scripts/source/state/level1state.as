@@ -357,41 +357,55 @@ final class CRunState : CCommonState
 
     //
     //  Begin contact physics callback
+    //  All the contacts of the step come in one array (a0, b0, a1, b1...)
     //
-    void beginContact( CSprite & spriteA, CSprite & spriteB )
+    void beginContact( array<CSprite@> @ contactAry ) override
     {
-        if( spriteA.getId() == NLevelDefs::SPRITE_PEG )
+        for( uint i = 0; i < contactAry.length(); i += 2 )
         {
-            spriteA.resetAndRecycle();
-            spriteA.setFrame(1);
-        }
-        else if( spriteB.getId() == NLevelDefs::SPRITE_PEG )
-        {
-            spriteB.resetAndRecycle();
-            spriteB.setFrame(1);
-        }
-        else if( spriteA.getId() == NLevelDefs::SPRITE_MULTI )
-        {
-            playerMultiInc( spriteB );
-        }
-        else if( spriteB.getId() == NLevelDefs::SPRITE_MULTI )
-        {
-            playerMultiInc( spriteA );
+            CSprite @ spriteA = contactAry[i];
+            CSprite @ spriteB = contactAry[i+1];
+
+            if( spriteA.getId() == NLevelDefs::SPRITE_PEG )
+            {
+                spriteA.resetAndRecycle();
+                spriteA.setFrame(1);
+            }
+            else if( spriteB.getId() == NLevelDefs::SPRITE_PEG )
+            {
+                spriteB.resetAndRecycle();
+                spriteB.setFrame(1);
+            }
+            else if( spriteA.getId() == NLevelDefs::SPRITE_MULTI )
+            {
+                playerMultiInc( spriteB );
+            }
+            else if( spriteB.getId() == NLevelDefs::SPRITE_MULTI )
+            {
+                playerMultiInc( spriteA );
+            }
         }
     }
 
     //
     //  End contact physics callback
+    //  All the contacts of the step come in one array (a0, b0, a1, b1...)
     //
-    void endContact( CSprite & spriteA, CSprite & spriteB )
+    void endContact( array<CSprite@> @ contactAry ) override
     {
-        if( spriteA.getId() == NLevelDefs::SPRITE_PEG )
-        {
-            spriteA.stopAndRestart( "peg_off" );
-        }
-        else if( spriteB.getId() == NLevelDefs::SPRITE_PEG )
+        for( uint i = 0; i < contactAry.length(); i += 2 )
         {
-            spriteB.stopAndRestart( "peg_off" );
+            CSprite @ spriteA = contactAry[i];
+            CSprite @ spriteB = contactAry[i+1];
+
+            if( spriteA.getId() == NLevelDefs::SPRITE_PEG )
+            {
+                spriteA.stopAndRestart( "peg_off" );
+            }
+            else if( spriteB.getId() == NLevelDefs::SPRITE_PEG )
+            {
+                spriteB.stopAndRestart( "peg_off" );
+            }
         }
     }
 
@@ -428,7 +442,9 @@ void RestartGameMsg( uiControl & control )
 //
 void LoadRunAssets()
 {
-    ObjectDataMgr.loadGroup( "(level_1)" );
+    // Normally loaded in the background by the load state
+    if( !ObjectDataMgr.isGroupLoaded( "(level_1)" ) )
+        ObjectDataMgr.loadGroup( "(level_1)" );
     
     // Create the physics world
     PhysicsWorldManager2D.createWorld( "(game)" );
@@ -50,6 +50,9 @@ final class CLoadState : CCommonState
             if( event.type == NStateDefs::ESE_FADE_IN_COMPLETE )
                 assetLoad();
             
+            else if( event.type == NStateDefs::ESE_GROUP_LOAD_COMPLETE )
+                groupLoadComplete( event.user.code );
+            
             else if( event.type == NStateDefs::ESE_THREAD_LOAD_COMPLETE )
                 Spawn("State_FadeOut");
             
@@ -66,8 +69,25 @@ final class CLoadState : CCommonState
         if( mStateMessage.getLoadState() == NStateDefs::EGS_TITLE_SCREEN )
             SpawnByThread( "LoadTitleScreenAssets" );
 
+        // The level's objects are loaded on the worker threads while the load screen animates
         else if( mStateMessage.getLoadState() == NStateDefs::EGS_RUN )
-            SpawnByThread( "LoadRunAssets" );
+            ObjectDataMgr.loadGroupAsync( "(level_1)", NStateDefs::ESE_GROUP_LOAD_COMPLETE );
+    }
+    
+    //
+    //  Finish loading the assets once the objects are in
+    //
+    void groupLoadComplete( int code )
+    {
+        // Free what the failed load created. LoadRunAssets then loads the group the
+        // blocking way so an error that isn't a one off is reported as usual.
+        if( code == NGroupLoad::EGL_FAILED )
+        {
+            Print( "Background load of (level_1) failed. Loading it again." );
+            ObjectDataMgr.freeGroup( "(level_1)" );
+        }
+        
+        SpawnByThread( "LoadRunAssets" );
     }
     
     //
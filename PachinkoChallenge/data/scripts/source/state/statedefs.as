@@ -20,7 +20,8 @@ namespace NStateDefs
         ESE_STATE_USER_EVENTS = 0x8100,
         ESE_FADE_IN_COMPLETE,
         ESE_FADE_OUT_COMPLETE,
-        ESE_THREAD_LOAD_COMPLETE
+        ESE_THREAD_LOAD_COMPLETE,
+        ESE_GROUP_LOAD_COMPLETE
     }
 }
 
@@ -0,0 +1,94 @@
+
+//
+//  FILE NAME:  animstress.as
+//
+//  DESC:       Stress test of thousands of sprites changing frames every frame
+//              NOTE: Run it by setting group="(anim_stress)" on the scripting node
+//                    of data/settings/settings.cfg. The timings are sent to Print.
+//
+
+// Sprites in each pass and the frames that are timed after the warm up
+const uint ANIM_STRESS_SPRITES = 4000;
+const uint ANIM_STRESS_WARM_UP = 60;
+const uint ANIM_STRESS_FRAMES = 600;
+
+void main()
+{
+    // Create the rendering device
+    Device.create( "data/shaders/pipeline.cfg" );
+    Device.showWindow();
+
+    ObjectDataMgr.loadListTable( "data/objects/2d/objectDataList/dataTable.lst" );
+    ObjectDataMgr.loadGroup( "(anim_stress)" );
+
+    // One texture and descriptor set per frame vs all the frames in one texture array
+    AnimStress_Run( "peg_frames" );
+    AnimStress_Run( "peg_array" );
+
+    ObjectDataMgr.freeGroup( "(anim_stress)" );
+    Device.destroy();
+}
+
+//
+//  Create a grid of sprites and time the frames while every sprite changes frame
+//
+void AnimStress_Run( const string &in objectName )
+{
+    const string strategyName = "_anim_stress_";
+
+    Strategy @strategy = StrategyMgr.createActorStrategy( strategyName );
+    strategy.setCommandBuffer( strategyName );
+    StrategyMgr.activateStrategy( strategyName );
+
+    // Lay out the sprites on a grid covering the screen
+    const CSize sizeHalf = Settings.getDefaultSizeHalf();
+    const uint columns = 80;
+    const uint rows = (ANIM_STRESS_SPRITES + columns - 1) / columns;
+    const float stepX = (sizeHalf.w * 2) / columns;
+    const float stepY = (sizeHalf.h * 2) / rows;
+
+    array<CSprite@> spriteAry;
+    for( uint i = 0; i < ANIM_STRESS_SPRITES; ++i )
+    {
+        CSprite @sprite = strategy.create( objectName, "", true, "(anim_stress)" ).getSprite();
+        sprite.setPos( -sizeHalf.w + (stepX * ((i % columns) + 0.5f)), sizeHalf.h - (stepY * ((i / columns) + 0.5f)) );
+        sprite.setScale( 0.4f, 0.4f );
+        spriteAry.insertLast( sprite );
+    }
+
+    const uint frameCount = spriteAry[0].getFrameCount();
+    double setFrameTime = 0;
+    double frameTime = 0;
+
+    for( uint frame = 0; frame < ANIM_STRESS_WARM_UP + ANIM_STRESS_FRAMES; ++frame )
+    {
+        PollEvents();
+
+        const double frameStart = HighResTimer.getTime();
+
+        // Offset the frame by the sprite index so neighbouring sprites differ
+        HighResTimer.timerStart();
+        for( uint i = 0; i < spriteAry.length(); ++i )
+            spriteAry[i].setFrame( (frame + i) % frameCount );
+        const float setFrameMs = HighResTimer.timerStop();
+
+        StrategyMgr.update();
+        StrategyMgr.transform();
+        Device.render();
+
+        if( frame >= ANIM_STRESS_WARM_UP )
+        {
+            setFrameTime += setFrameMs;
+            frameTime += HighResTimer.getTime() - frameStart;
+        }
+    }
+
+    Print( objectName + ": " + spriteAry.length() + " sprites, " + frameCount + " frames, " +
+           "setFrame avg " + (setFrameTime / ANIM_STRESS_FRAMES) + " ms, " +
+           "frame avg " + (frameTime / ANIM_STRESS_FRAMES) + " ms" );
+
+    // Wait for the frames in flight before freeing what they use
+    Device.waitForIdle();
+    StrategyMgr.deleteStrategy( strategyName );
+    Device.deleteCommandPoolGroup( strategyName );
+}
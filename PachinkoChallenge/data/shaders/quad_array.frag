@@ -0,0 +1,16 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+// The frames of the animation are the layers of the array
+layout(binding = 1) uniform sampler2DArray texSampler;
+
+layout(location = 0) in vec2 fragTexCoord;
+layout(location = 1) in vec4 fragColor;
+layout(location = 2) flat in float fragLayer;
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+    outColor = texture(texSampler, vec3(fragTexCoord, fragLayer)) * fragColor;
+}
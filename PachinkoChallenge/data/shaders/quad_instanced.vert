@@ -0,0 +1,29 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+// Per vertex
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec2 inTexCoord;
+
+// Per instance. The matrix is model * viewProj and takes up locations 2 - 5
+layout(location = 2) in mat4 inMatrix;
+layout(location = 6) in vec4 inColor;
+layout(location = 7) in vec4 inAdditive;
+
+// Texture region as a UV offset and size. Unit rect unless the quad is in a texture atlas
+layout(location = 8) in vec4 inUVRect;
+
+layout(location = 0) out vec2 fragTexCoord;
+layout(location = 1) out vec4 fragColor;
+
+out gl_PerVertex
+{
+    vec4 gl_Position;
+};
+
+void main()
+{
+    gl_Position = inMatrix * vec4(inPosition, 1.0);
+    fragTexCoord = inUVRect.xy + (inTexCoord * inUVRect.zw);
+    fragColor = inColor * inAdditive;
+}
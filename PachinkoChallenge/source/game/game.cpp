@@ -190,16 +190,16 @@ void CGame::pollEvents()
 ****************************************************************************/
 void CGame::recordCommandBuffer( const uint32_t cmdBufIndex )
 {
-    std::vector< std::future<void> > jobs;
+    CJobCounter counter;
     auto & strategyVec = CStrategyMgr::Instance().getStrategyVec();
 
     for( auto iter : strategyVec )
-        jobs.emplace_back( CThreadPool::Instance().post( &CStrategy::recordCommandBuffer, iter, cmdBufIndex ) );
+        CThreadPool::Instance().post( counter, [iter, cmdBufIndex]() { iter->recordCommandBuffer( cmdBufIndex ); } );
 
-    jobs.emplace_back( CThreadPool::Instance().post( &CMenuMgr::recordCommandBuffer, &CMenuMgr::Instance(), cmdBufIndex ) );
+    CThreadPool::Instance().post( counter, [cmdBufIndex]() { CMenuMgr::Instance().recordCommandBuffer( cmdBufIndex ); } );
 
     // Wait for all the jobs to finish
-    for( auto && iter : jobs ) iter.get();
+    CThreadPool::Instance().wait( counter );
 
     CStrategyMgr::Instance().updateSecondaryCmdBuf( cmdBufIndex );
     CMenuMgr::Instance().updateSecondaryCmdBuf( cmdBufIndex );
@@ -0,0 +1,163 @@
+/************************************************************************
+*    FILE NAME:       quadbatch.cpp
+*
+*    DESCRIPTION:     Batches consecutive quads that share the same
+*                     pipeline, texture and vertex buffers into one
+*                     instanced draw
+************************************************************************/
+
+// Physical component dependency
+#include <2d/quadbatch.h>
+
+// Game lib dependencies
+#include <common/vertex.h>
+#include <system/device.h>
+#include <system/pipeline.h>
+#include <system/memorybuffer.h>
+#include <system/descriptorset.h>
+#include <utilities/statcounter.h>
+
+thread_local CQuadBatch * CQuadBatch::m_pActive = nullptr;
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CQuadBatch::CQuadBatch( uint32_t index, VkCommandBuffer cmdBuffer ) :
+    m_index( index ),
+    m_cmdBuffer( cmdBuffer ),
+    m_pInstanceData( CDevice::Instance().getInstanceData( index ) ),
+    m_instanceBuffer( CDevice::Instance().getInstanceBuffer( index ) ),
+    m_pPrevActive( m_pActive )
+{
+    m_pActive = this;
+}
+
+/************************************************************************
+*    DESC:  destructor
+************************************************************************/
+CQuadBatch::~CQuadBatch()
+{
+    flush();
+
+    m_pActive = m_pPrevActive;
+}
+
+/************************************************************************
+*    DESC:  Add a quad to the batch
+*
+*    NOTE:  Returns false if the quad can't be batched
+************************************************************************/
+bool CQuadBatch::add(
+    int pipelineIndex,
+    const CMemoryBuffer & vbo,
+    const CMemoryBuffer & ibo,
+    int iboCount,
+    const CDescriptorSet * pDescriptorSet,
+    const CMatrix & matrix,
+    const CColor & color,
+    const CColor & additive,
+    const CRect<float> & uvRect )
+{
+    if( m_pInstanceData == nullptr )
+        return false;
+
+    const VkDescriptorSet descriptorSet = pDescriptorSet->m_descriptorVec[m_index];
+
+    // Draw what we have if this quad can't be part of the batch
+    if( (m_instanceCount > 0) &&
+        ((pipelineIndex != m_pipelineIndex) ||
+         (vbo.m_buffer != m_vbo) ||
+         (ibo.m_buffer != m_ibo) ||
+         (iboCount != m_iboCount) ||
+         (descriptorSet != m_descriptorSet)) )
+        flush();
+
+    // The instances of a draw need to be together so draw what we have and get a new block
+    if( m_nextInstance == m_blockEnd )
+    {
+        flush();
+
+        if( !CDevice::Instance().allocInstanceBlock( BLOCK_SIZE, m_nextInstance ) )
+        {
+            m_nextInstance = m_blockEnd = 0;
+            return false;
+        }
+
+        m_blockEnd = m_nextInstance + BLOCK_SIZE;
+    }
+
+    // Start a new batch
+    if( m_instanceCount == 0 )
+    {
+        m_pipelineIndex = pipelineIndex;
+        m_vbo = vbo.m_buffer;
+        m_ibo = ibo.m_buffer;
+        m_iboCount = iboCount;
+        m_descriptorSet = descriptorSet;
+        m_firstInstance = m_nextInstance;
+    }
+
+    NVertex::quad_instance & rInstance = m_pInstanceData[m_nextInstance++];
+    rInstance.matrix = matrix;
+    rInstance.color = color;
+    rInstance.additive = additive;
+    rInstance.uvRect = uvRect;
+
+    ++m_instanceCount;
+
+    return true;
+}
+
+/************************************************************************
+*    DESC:  Record the draw of the quads in the batch
+************************************************************************/
+void CQuadBatch::flush()
+{
+    if( m_instanceCount > 0 )
+    {
+        auto & device( CDevice::Instance() );
+        const SPipelineData & rPipelineData = device.getPipelineData( m_pipelineIndex );
+
+        CDrawCommand drawCmd;
+        drawCmd.m_pipeline = rPipelineData.pipeline;
+        drawCmd.m_pipelineLayout = rPipelineData.pipelineLayout;
+
+        // The quad's vertex buffer and the per instance buffer
+        drawCmd.m_vertexBuffer[0] = m_vbo;
+        drawCmd.m_vertexBuffer[1] = m_instanceBuffer;
+        drawCmd.m_vertexBufferCount = 2;
+
+        drawCmd.m_indexBuffer = m_ibo;
+        drawCmd.m_indexCount = m_iboCount;
+        drawCmd.m_instanceCount = m_instanceCount;
+        drawCmd.m_firstInstance = m_firstInstance;
+
+        // The descriptor set only holds the texture so it's shared by the whole batch
+        drawCmd.m_descriptorSet = m_descriptorSet;
+        drawCmd.m_useDynamicOffset = false;
+
+        // Do the draw
+        device.recordDraw( m_cmdBuffer, drawCmd );
+
+        CStatCounter::Instance().incBatchCounter( m_instanceCount );
+
+        m_instanceCount = 0;
+    }
+}
+
+/************************************************************************
+*    DESC:  Get the active batch of this thread
+************************************************************************/
+CQuadBatch * CQuadBatch::getActive()
+{
+    return m_pActive;
+}
+
+/************************************************************************
+*    DESC:  Flush the active batch of this thread
+************************************************************************/
+void CQuadBatch::flushActive()
+{
+    if( m_pActive != nullptr )
+        m_pActive->flush();
+}
@@ -0,0 +1,96 @@
+/************************************************************************
+*    FILE NAME:       quadbatch.h
+*
+*    DESCRIPTION:     Batches consecutive quads that share the same
+*                     pipeline, texture and vertex buffers into one
+*                     instanced draw
+************************************************************************/
+
+#pragma once
+
+// Vulkan lib dependencies
+#include <system/vulkan.h>
+
+// Game lib dependencies
+#include <common/rect.h>
+
+// Boost lib dependencies
+#include <boost/noncopyable.hpp>
+
+// Standard lib dependencies
+#include <cstdint>
+
+// Forward declaration(s)
+class CMatrix;
+class CColor;
+class CMemoryBuffer;
+class CDescriptorSet;
+namespace NVertex { class quad_instance; }
+
+class CQuadBatch : public boost::noncopyable
+{
+public:
+
+    // Constructor
+    // NOTE: Becomes the active batch of this thread until destroyed
+    CQuadBatch( uint32_t index, VkCommandBuffer cmdBuffer );
+
+    // Destructor
+    ~CQuadBatch();
+
+    // Add a quad to the batch. Returns false if the quad can't be batched.
+    bool add(
+        int pipelineIndex,
+        const CMemoryBuffer & vbo,
+        const CMemoryBuffer & ibo,
+        int iboCount,
+        const CDescriptorSet * pDescriptorSet,
+        const CMatrix & matrix,
+        const CColor & color,
+        const CColor & additive,
+        const CRect<float> & uvRect );
+
+    // Record the draw of the quads in the batch
+    void flush();
+
+    // Get the active batch of this thread. nullptr if none
+    static CQuadBatch * getActive();
+
+    // Flush the active batch of this thread
+    // NOTE: Needs to be called before any non-batched draw to keep the draw order
+    static void flushActive();
+
+private:
+
+    // Number of instances allocated at a time from the frame's instance buffer
+    static constexpr uint32_t BLOCK_SIZE = 64;
+
+    // Swap chain image index and command buffer being recorded
+    uint32_t m_index;
+    VkCommandBuffer m_cmdBuffer;
+
+    // What the quads in the batch have in common
+    int m_pipelineIndex = -1;
+    VkBuffer m_vbo = VK_NULL_HANDLE;
+    VkBuffer m_ibo = VK_NULL_HANDLE;
+    int m_iboCount = 0;
+    VkDescriptorSet m_descriptorSet = VK_NULL_HANDLE;
+
+    // Instance range of the batch
+    uint32_t m_firstInstance = 0;
+    uint32_t m_instanceCount = 0;
+
+    // Next free instance and end of the currently allocated block
+    uint32_t m_nextInstance = 0;
+    uint32_t m_blockEnd = 0;
+
+    // Instance data and buffer for this frame
+    NVertex::quad_instance * m_pInstanceData;
+    VkBuffer m_instanceBuffer;
+
+    // The batch that was active before this one
+    CQuadBatch * m_pPrevActive;
+
+    // Active batch of this thread
+    static thread_local CQuadBatch * m_pActive;
+};
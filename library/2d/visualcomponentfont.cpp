@@ -19,12 +19,14 @@
 #include <managers/fontmanager.h>
 #include <utilities/genfunc.h>
 #include <utilities/statcounter.h>
+#include <2d/quadbatch.h>
 
 /************************************************************************
 *    desc:  Constructor
 ************************************************************************/
 CVisualComponentFont::CVisualComponentFont( const iObjectData & objectData ) :
-    CVisualComponentQuad( objectData )
+    CVisualComponentQuad( objectData ),
+    m_iboCount(0)
 {
 }
 
@@ -33,13 +35,14 @@ CVisualComponentFont::CVisualComponentFont( const iObjectData & objectData ) :
 ************************************************************************/
 CVisualComponentFont::~CVisualComponentFont()
 {
-    CDevice::Instance().AddToDeleteQueue( m_vboBuffer );
+    if( !m_vboBuffer.isEmpty() )
+        CDevice::Instance().AddToDeleteQueue( m_vboBuffer );
 }
 
 /************************************************************************
 *    DESC:  Update the UBO buffer
 ************************************************************************/
-void CVisualComponentFont::updateUBO(
+uint32_t CVisualComponentFont::updateUBO(
     uint32_t index,
     CDevice & device,
     const iObjectVisualData & rVisualData,
@@ -54,7 +57,7 @@ void CVisualComponentFont::updateUBO(
     ubo.additive = m_additive;
 
     // Update the uniform buffer
-    device.updateUniformBuffer( ubo, m_uniformBufVec[index].m_deviceMemory );
+    return device.updateUniformBuffer( index, ubo );
 }
 
 /***************************************************************************
@@ -70,6 +73,9 @@ void CVisualComponentFont::recordCommandBuffer(
     {
         // Increment our stat counter to keep track of what is going on.
         CStatCounter::Instance().incDisplayCounter();
+
+        // Draw anything batched before this to keep the draw order
+        CQuadBatch::flushActive();
         
         const auto & rVisualData( m_rObjectData.getVisualData() );
         auto & device( CDevice::Instance() );
@@ -78,29 +84,33 @@ void CVisualComponentFont::recordCommandBuffer(
         const SPipelineData & rPipelineData = device.getPipelineData( rVisualData.getPipelineIndex() );
 
         // Update the UBO buffer
-        updateUBO( index, device, rVisualData, pObject, camera );
+        const uint32_t uboOffset = updateUBO( index, device, rVisualData, pObject, camera );
+
+        CDrawCommand drawCmd;
+        drawCmd.m_pipeline = rPipelineData.pipeline;
+        drawCmd.m_pipelineLayout = rPipelineData.pipelineLayout;
 
-        // Bind the pipeline
-        vkCmdBindPipeline( cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, rPipelineData.pipeline );
+        // Dynamic strings write their glyph quads to this frame's dynamic vertex ring
+        drawCmd.m_vertexBuffer[0] = m_vboBuffer.m_buffer;
 
-        // Bind vertex buffer
-        VkBuffer vertexBuffers[] = {m_vboBuffer.m_buffer};
-        VkDeviceSize offsets[] = {0};
-        vkCmdBindVertexBuffers( cmdBuffer, 0, 1, vertexBuffers, offsets );
+        if( m_fontData.m_fontProp.m_dynamic )
+        {
+            drawCmd.m_vertexBuffer[0] = device.getDynamicVertexBuffer( index );
+            drawCmd.m_vertexOffset[0] = device.updateDynamicVertexBuffer( index, m_spLayout->m_quadVec );
+        }
 
-        // Bind the index buffer
-        vkCmdBindIndexBuffer( cmdBuffer, device.getSharedFontIBO().m_buffer, 0, VK_INDEX_TYPE_UINT16 );
+        drawCmd.m_indexBuffer = device.getSharedFontIBO().m_buffer;
+        drawCmd.m_indexCount = m_iboCount;
 
-        // With the regular descriptor set implementation, objects that use the same texture and UBO can't share the same
-        // descriptor set because the translation matrix is part of the UBO the objects sharing this will render ontop of each other
-        vkCmdBindDescriptorSets( 
-            cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, rPipelineData.pipelineLayout, 0, 1, &m_pDescriptorSet->m_descriptorVec[index], 0, nullptr );
+        // The UBO is bound with the dynamic offset of this object's data in the frame's uniform ring
+        drawCmd.m_descriptorSet = m_pDescriptorSet->m_descriptorVec[index];
+        drawCmd.m_dynamicOffset = uboOffset;
 
         // Use the push descriptors
         //m_pushDescSet.cmdPushDescriptorSet( index, cmdBuffer, rPipelineData.pipelineLayout );
 
         // Do the draw
-        vkCmdDrawIndexed( cmdBuffer, m_iboCount, 1, 0, 0, 0 );
+        device.recordDraw( cmdBuffer, drawCmd );
     }
 }
 
@@ -144,256 +154,302 @@ void CVisualComponentFont::createFontString()
 void CVisualComponentFont::createFontString( const std::string & fontString )
 {
     // Qualify if we want to build the font string
-    if( !fontString.empty() &&
-        !m_fontData.m_fontProp.m_fontName.empty() &&
-        ((fontString != m_fontData.m_fontString) || m_vboBuffer.isEmpty()) )
+    if( !fontString.empty() && !m_fontData.m_fontProp.m_fontName.empty() )
     {
-        m_fontData.m_fontStrSize.clear();
-        float lastCharDif(0.f);
-        auto & device( CDevice::Instance() );
-
-        const CFont & font = CFontMgr::Instance().getFont( m_fontData.m_fontProp.m_fontName );
+        CFontLayoutKey key;
+        key.m_fontString = fontString;
+        key.m_fontProp = m_fontData.m_fontProp;
 
         m_fontData.m_fontString = fontString;
 
-        // count up the number of space characters
-        const int spaceCharCount = NGenFunc::CountStrOccurrence( m_fontData.m_fontString, " " );
+        // Dynamic strings don't have a VBO
+        const bool vboReady = (m_fontData.m_fontProp.m_dynamic == m_vboBuffer.isEmpty());
 
-        // count up the number of bar | characters
-        const int barCharCount = NGenFunc::CountStrOccurrence( m_fontData.m_fontString, "|" );
+        if( (m_spLayout == nullptr) || (key != m_layoutKey) || !vboReady )
+        {
+            auto & device( CDevice::Instance() );
+            auto & fontMgr( CFontMgr::Instance() );
 
-        // Size of the allocation
-        size_t charCount = m_fontData.m_fontString.size() - spaceCharCount - barCharCount;
-        m_iboCount = charCount * 6;
+            const CFont & font = fontMgr.getFont( m_fontData.m_fontProp.m_fontName );
+            const bool fontChange = (m_pDescriptorSet == nullptr) || (m_layoutKey.m_fontProp.m_fontName != m_fontData.m_fontProp.m_fontName);
 
-        // Set a flag to indicate if the IBO should be built
-        const bool BUILD_FONT_IBO = (m_iboCount > device.getSharedFontIBOMaxIndiceCount());
+            // Strings that have been laid out before are shared from the font manager's cache
+            // Dynamic strings change too often to be worth caching and would push out the shared layouts
+            if( (m_spLayout == nullptr) || (key != m_layoutKey) )
+            {
+                if( m_fontData.m_fontProp.m_dynamic )
+                {
+                    m_spLayout = generateLayout( font, fontString );
+                }
+                else
+                {
+                    m_spLayout = fontMgr.findLayout( key );
+                    if( m_spLayout == nullptr )
+                    {
+                        m_spLayout = generateLayout( font, fontString );
+                        fontMgr.addLayout( key, m_spLayout );
+                    }
+                }
 
-        // Allocate the quad array
-        std::vector<CQuad2D> quadVec( charCount );
+                m_layoutKey = key;
+            }
 
-        // Create a buffer to hold the indices
-        std::vector<uint16_t> iboVec( m_iboCount );
+            m_fontData.m_fontStrSize = m_spLayout->m_fontStrSize;
+            m_iboCount = m_spLayout->m_quadVec.size() * 6;
 
-        float xOffset = 0.f;
-        float width = 0.f;
-        float lineHeightOffset = 0.f;
-        float lineHeightWrap = font.getLineHeight() + font.getVertPadding() + m_fontData.m_fontProp.m_lineWrapHeight;
-        float initialHeightOffset = font.getBaselineOffset() + font.getVertPadding();
-        float lineSpace = font.getLineHeight() - font.getBaselineOffset();
+            // Create the font IBO vector
+            // All fonts share the same IBO because it's always the same and the only difference is it's length
+            // This updates the current IBO if it exceeds the current max
+            if( m_iboCount > device.getSharedFontIBOMaxIndiceCount() )
+            {
+                // Create a buffer to hold the indices
+                std::vector<uint16_t> iboVec( m_iboCount );
 
-        uint counter = 0;
-        int lineCount = 0;
+                for( size_t i = 0; i < m_spLayout->m_quadVec.size(); ++i )
+                {
+                    // Create the indices into the VBO
+                    int arrayIndex = i * 6;
+                    int vertIndex = i * 4;
 
-        // Get the size of the texture
-        CSize<float> textureSize = font.getTextureSize();
+                    iboVec[arrayIndex]   = vertIndex;
+                    iboVec[arrayIndex+1] = vertIndex+1;
+                    iboVec[arrayIndex+2] = vertIndex+2;
 
-        // Handle the horizontal alignment
-        std::vector<float> lineWidthOffsetVec = calcLineWidthOffset( font, m_fontData.m_fontString );
+                    iboVec[arrayIndex+3] = vertIndex+2;
+                    iboVec[arrayIndex+4] = vertIndex+3;
+                    iboVec[arrayIndex+5] = vertIndex;
+                }
 
-        // Set the initial line offset
-        xOffset = lineWidthOffsetVec[lineCount++];
+                device.createSharedFontIBO( iboVec );
+            }
 
-        // Handle the vertical alignment
-        if( m_fontData.m_fontProp.m_vAlign == EVertAlignment::VERT_TOP )
-            lineHeightOffset = initialHeightOffset - font.getBaselineOffset();
+            // Free the previous memory buffer
+            if( !m_vboBuffer.isEmpty() )
+            {
+                device.AddToDeleteQueue( m_vboBuffer );
+                m_vboBuffer = CMemoryBuffer();
+            }
 
-        if( m_fontData.m_fontProp.m_vAlign == EVertAlignment::VERT_CENTER )
-        {
-            lineHeightOffset = -(initialHeightOffset - ((font.getBaselineOffset()-lineSpace) / 2.f) - font.getVertPadding());
+            // Create the font vertex buffer
+            // Dynamic strings are written to the frame's dynamic vertex ring when the command buffer is recorded
+            if( !m_fontData.m_fontProp.m_dynamic )
+                device.creatMemoryBuffer( m_spLayout->m_quadVec, m_vboBuffer, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT );
 
-            if( lineWidthOffsetVec.size() > 1 )
-                lineHeightOffset = -((lineHeightWrap * lineWidthOffsetVec.size()) / 2.f);
-        }
+            // The descriptor set only depends on the font texture so only get a new one if the font changed
+            // Can't update the descriptor set because it could be actuve in the command buffer.
+            // The strategy is to recycle the current one and grab a fresh one
+            if( fontChange )
+            {
+                if( m_pDescriptorSet != nullptr )
+                    device.recycleDescriptorSet( m_pDescriptorSet );
 
-        else if( m_fontData.m_fontProp.m_vAlign == EVertAlignment::VERT_BOTTOM )
-        {
-            lineHeightOffset = -(initialHeightOffset - font.getBaselineOffset() - font.getVertPadding());
+                m_pDescriptorSet = device.getDescriptorSet(
+                    m_rObjectData.getVisualData().getPipelineIndex(),
+                    font.getTexture() );
+            }
 
-            if( lineWidthOffsetVec.size() > 1 )
-                lineHeightOffset += -((lineHeightWrap * (lineWidthOffsetVec.size()-1)) + font.getBaselineOffset());
+            /*device.createPushDescriptorSet(
+                pipelineIndex,
+                font.getTexture(),
+                m_uniformBufVec,
+                m_pushDescSet );*/
         }
+    }
+    else if( fontString.empty() &&
+             (fontString != m_fontData.m_fontString) &&
+             (m_spLayout != nullptr) )
+    {
+        m_fontData.m_fontString.clear();
+    }
+}
 
-        // Remove any fractional component of the line height offset
-        lineHeightOffset = (int)lineHeightOffset;
+/************************************************************************
+*    DESC:  Generate the glyph quads of the font string
+************************************************************************/
+std::shared_ptr<CFontLayout> CVisualComponentFont::generateLayout(
+    const CFont & font,
+    const std::string & fontString )
+{
+    std::shared_ptr<CFontLayout> spLayout( new CFontLayout );
+    float lastCharDif(0.f);
 
-        // Setup each character in the vertex buffer
-        for( size_t i = 0; i < m_fontData.m_fontString.size(); ++i )
-        {
-            char id = m_fontData.m_fontString[i];
+    // count up the number of space characters
+    const int spaceCharCount = NGenFunc::CountStrOccurrence( fontString, " " );
 
-            // Line wrap if '|' character was used
-            if( id == '|' )
-            {
-                xOffset = lineWidthOffsetVec[lineCount];
-                width = 0.f;
+    // count up the number of bar | characters
+    const int barCharCount = NGenFunc::CountStrOccurrence( fontString, "|" );
 
-                lineHeightOffset += lineHeightWrap;
-                ++lineCount;
-            }
-            else
-            {
-                // See if we can find the character
-                const CCharData & charData = font.getCharData(id);
+    // Allocate the quad array
+    spLayout->m_quadVec.resize( fontString.size() - spaceCharCount - barCharCount );
 
-                // Ignore space characters
-                if( id != ' ' )
-                {
-                    CRect<float> rect = charData.rect;
-
-                    float yOffset = lineHeightOffset + charData.offset.h;
-
-                    // Check if the width or height is odd. If so, we offset
-                    // by 0.5 for proper orthographic rendering
-                    float additionalOffsetX = 0;
-                    if( (int)rect.x2 % 2 != 0 )
-                        additionalOffsetX = 0.5f;
-
-                    float additionalOffsetY = 0;
-                    if( (int)rect.y2 % 2 != 0 )
-                        additionalOffsetY = 0.5f;
-
-                    auto & quadBuf = quadVec[counter];
-
-                    // Calculate the second vertex of the first face
-                    quadBuf.vert[1].vert.x = xOffset + charData.offset.w + additionalOffsetX;
-                    quadBuf.vert[1].vert.y = yOffset + additionalOffsetY;
-                    quadBuf.vert[1].uv.u = rect.x1 / textureSize.w;
-                    quadBuf.vert[1].uv.v = rect.y1 / textureSize.h;
-                    
-                    // Calculate the forth vertex of the first face
-                    quadBuf.vert[3].vert.x = xOffset + rect.x2 + charData.offset.w + additionalOffsetX;
-                    quadBuf.vert[3].vert.y = yOffset + rect.y2 + additionalOffsetY;
-                    quadBuf.vert[3].uv.u = (rect.x1 + rect.x2) / textureSize.w;
-                    quadBuf.vert[3].uv.v = (rect.y1 + rect.y2) / textureSize.h;
-                    
-                    // Calculate the first vertex of the first face
-                    quadBuf.vert[0].vert.x = quadBuf.vert[3].vert.x;
-                    quadBuf.vert[0].vert.y = quadBuf.vert[1].vert.y;
-                    quadBuf.vert[0].uv.u = quadBuf.vert[3].uv.u;
-                    quadBuf.vert[0].uv.v = quadBuf.vert[1].uv.v;
-
-                    // Calculate the third vertex of the second face
-                    quadBuf.vert[2].vert.x = quadBuf.vert[1].vert.x;
-                    quadBuf.vert[2].vert.y = quadBuf.vert[3].vert.y;
-                    quadBuf.vert[2].uv.u = quadBuf.vert[1].uv.u;
-                    quadBuf.vert[2].uv.v = quadBuf.vert[3].uv.v;
-
-                    // Should we build or rebuild the font IBO
-                    if( BUILD_FONT_IBO )
-                    {
-                        // Create the indices into the VBO
-                        int arrayIndex = counter * 6;
-                        int vertIndex = counter * 4;
+    float xOffset = 0.f;
+    float width = 0.f;
+    float lineHeightOffset = 0.f;
+    float lineHeightWrap = font.getLineHeight() + font.getVertPadding() + m_fontData.m_fontProp.m_lineWrapHeight;
+    float initialHeightOffset = font.getBaselineOffset() + font.getVertPadding();
+    float lineSpace = font.getLineHeight() - font.getBaselineOffset();
 
-                        iboVec[arrayIndex]   = vertIndex;
-                        iboVec[arrayIndex+1] = vertIndex+1;
-                        iboVec[arrayIndex+2] = vertIndex+2;
+    uint counter = 0;
+    int lineCount = 0;
 
-                        iboVec[arrayIndex+3] = vertIndex+2;
-                        iboVec[arrayIndex+4] = vertIndex+3;
-                        iboVec[arrayIndex+5] = vertIndex;
-                    }
+    // Get the size of the texture
+    CSize<float> textureSize = font.getTextureSize();
 
-                    ++counter;
-                }
+    // Handle the horizontal alignment
+    std::vector<float> lineWidthOffsetVec = calcLineWidthOffset( font, fontString );
 
-                // Inc the font position
-                float inc = charData.xAdvance + m_fontData.m_fontProp.m_kerning + font.getHorzPadding();
+    // Set the initial line offset
+    xOffset = lineWidthOffsetVec[lineCount++];
 
-                // Add in any additional spacing for the space character
-                if( id == ' ' )
-                    inc += m_fontData.m_fontProp.m_spaceCharKerning;
+    // Handle the vertical alignment
+    if( m_fontData.m_fontProp.m_vAlign == EVertAlignment::VERT_TOP )
+        lineHeightOffset = initialHeightOffset - font.getBaselineOffset();
 
-                width += inc;
-                xOffset += inc;
+    if( m_fontData.m_fontProp.m_vAlign == EVertAlignment::VERT_CENTER )
+    {
+        lineHeightOffset = -(initialHeightOffset - ((font.getBaselineOffset()-lineSpace) / 2.f) - font.getVertPadding());
 
-                // Get the longest width of this font string
-                if( m_fontData.m_fontStrSize.w < width )
-                {
-                    m_fontData.m_fontStrSize.w = width;
+        if( lineWidthOffsetVec.size() > 1 )
+            lineHeightOffset = -((lineHeightWrap * lineWidthOffsetVec.size()) / 2.f);
+    }
 
-                    // This is the space between this character and the next.
-                    // Save this difference so that it can be subtracted at the end
-                    lastCharDif = inc - charData.rect.x2;
-                }
+    else if( m_fontData.m_fontProp.m_vAlign == EVertAlignment::VERT_BOTTOM )
+    {
+        lineHeightOffset = -(initialHeightOffset - font.getBaselineOffset() - font.getVertPadding());
 
-                // Wrap to another line
-                if( (id == ' ') && (m_fontData.m_fontProp.m_lineWrapWidth > 0.f) )
-                {
-                    float nextWord = 0.f;
+        if( lineWidthOffsetVec.size() > 1 )
+            lineHeightOffset += -((lineHeightWrap * (lineWidthOffsetVec.size()-1)) + font.getBaselineOffset());
+    }
 
-                    // Get the length of the next word to see if if should wrap
-                    for( size_t j = i+1; j < m_fontData.m_fontString.size(); ++j )
-                    {
-                        id = m_fontData.m_fontString[j];
+    // Remove any fractional component of the line height offset
+    lineHeightOffset = (int)lineHeightOffset;
 
-                        if( id != '|' )
-                        {
-                            // See if we can find the character
-                            const CCharData & anotherCharData = font.getCharData(id);
+    // Setup each character in the vertex buffer
+    for( size_t i = 0; i < fontString.size(); ++i )
+    {
+        char id = fontString[i];
 
-                            // Break here when space is found
-                            // Don't add the space to the size of the next word
-                            if( id == ' ' )
-                                break;
+        // Line wrap if '|' character was used
+        if( id == '|' )
+        {
+            xOffset = lineWidthOffsetVec[lineCount];
+            width = 0.f;
 
-                            // Don't count the
-                            nextWord += anotherCharData.xAdvance + m_fontData.m_fontProp.m_kerning + font.getHorzPadding();
-                        }
-                    }
+            lineHeightOffset += lineHeightWrap;
+            ++lineCount;
+        }
+        else
+        {
+            // See if we can find the character
+            const CCharData & charData = font.getCharData(id);
+
+            // Ignore space characters
+            if( id != ' ' )
+            {
+                CRect<float> rect = charData.rect;
+
+                float yOffset = lineHeightOffset + charData.offset.h;
+
+                // Check if the width or height is odd. If so, we offset
+                // by 0.5 for proper orthographic rendering
+                float additionalOffsetX = 0;
+                if( (int)rect.x2 % 2 != 0 )
+                    additionalOffsetX = 0.5f;
+
+                float additionalOffsetY = 0;
+                if( (int)rect.y2 % 2 != 0 )
+                    additionalOffsetY = 0.5f;
+
+                auto & quadBuf = spLayout->m_quadVec[counter];
+
+                // Calculate the second vertex of the first face
+                quadBuf.vert[1].vert.x = xOffset + charData.offset.w + additionalOffsetX;
+                quadBuf.vert[1].vert.y = yOffset + additionalOffsetY;
+                quadBuf.vert[1].uv.u = rect.x1 / textureSize.w;
+                quadBuf.vert[1].uv.v = rect.y1 / textureSize.h;
+                
+                // Calculate the forth vertex of the first face
+                quadBuf.vert[3].vert.x = xOffset + rect.x2 + charData.offset.w + additionalOffsetX;
+                quadBuf.vert[3].vert.y = yOffset + rect.y2 + additionalOffsetY;
+                quadBuf.vert[3].uv.u = (rect.x1 + rect.x2) / textureSize.w;
+                quadBuf.vert[3].uv.v = (rect.y1 + rect.y2) / textureSize.h;
+                
+                // Calculate the first vertex of the first face
+                quadBuf.vert[0].vert.x = quadBuf.vert[3].vert.x;
+                quadBuf.vert[0].vert.y = quadBuf.vert[1].vert.y;
+                quadBuf.vert[0].uv.u = quadBuf.vert[3].uv.u;
+                quadBuf.vert[0].uv.v = quadBuf.vert[1].uv.v;
+
+                // Calculate the third vertex of the second face
+                quadBuf.vert[2].vert.x = quadBuf.vert[1].vert.x;
+                quadBuf.vert[2].vert.y = quadBuf.vert[3].vert.y;
+                quadBuf.vert[2].uv.u = quadBuf.vert[1].uv.u;
+                quadBuf.vert[2].uv.v = quadBuf.vert[3].uv.v;
+
+                ++counter;
+            }
+
+            // Inc the font position
+            float inc = charData.xAdvance + m_fontData.m_fontProp.m_kerning + font.getHorzPadding();
+
+            // Add in any additional spacing for the space character
+            if( id == ' ' )
+                inc += m_fontData.m_fontProp.m_spaceCharKerning;
+
+            width += inc;
+            xOffset += inc;
+
+            // Get the longest width of this font string
+            if( spLayout->m_fontStrSize.w < width )
+            {
+                spLayout->m_fontStrSize.w = width;
+
+                // This is the space between this character and the next.
+                // Save this difference so that it can be subtracted at the end
+                lastCharDif = inc - charData.rect.x2;
+            }
+
+            // Wrap to another line
+            if( (id == ' ') && (m_fontData.m_fontProp.m_lineWrapWidth > 0.f) )
+            {
+                float nextWord = 0.f;
+
+                // Get the length of the next word to see if if should wrap
+                for( size_t j = i+1; j < fontString.size(); ++j )
+                {
+                    id = fontString[j];
 
-                    if( width + nextWord >= m_fontData.m_fontProp.m_lineWrapWidth )
+                    if( id != '|' )
                     {
-                        xOffset = lineWidthOffsetVec[lineCount++];
-                        width = 0.f;
+                        // See if we can find the character
+                        const CCharData & anotherCharData = font.getCharData(id);
+
+                        // Break here when space is found
+                        // Don't add the space to the size of the next word
+                        if( id == ' ' )
+                            break;
 
-                        lineHeightOffset += -lineHeightWrap;
+                        // Don't count the
+                        nextWord += anotherCharData.xAdvance + m_fontData.m_fontProp.m_kerning + font.getHorzPadding();
                     }
                 }
+
+                if( width + nextWord >= m_fontData.m_fontProp.m_lineWrapWidth )
+                {
+                    xOffset = lineWidthOffsetVec[lineCount++];
+                    width = 0.f;
+
+                    lineHeightOffset += -lineHeightWrap;
+                }
             }
         }
-
-        // Subtract the extra space after the last character
-        m_fontData.m_fontStrSize.w -= lastCharDif;
-        m_fontData.m_fontStrSize.h = font.getLineHeight();
-        
-        // Free the previous memory buffer
-        if( !m_vboBuffer.isEmpty() )
-            device.AddToDeleteQueue( m_vboBuffer );
-        
-        // Create the font vertex buffer
-        device.creatMemoryBuffer( quadVec, m_vboBuffer, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT );
-        
-        // Create the font IBO vector
-        // All fonts share the same IBO because it's always the same and the only difference is it's length
-        // This updates the current IBO if it exceeds the current max
-        if( BUILD_FONT_IBO )
-            device.createSharedFontIBO( iboVec );
-
-        // Recycle if the descriptor set is not null
-        // Can't update the descriptor set because it could be actuve in the command buffer.
-        // The strategy is to recycle the current one and grab a fresh one
-        if( m_pDescriptorSet != nullptr )
-            CDevice::Instance().recycleDescriptorSet( m_pDescriptorSet );
-            
-        m_pDescriptorSet = device.getDescriptorSet(
-            m_rObjectData.getVisualData().getPipelineIndex(),
-            font.getTexture(),
-            m_uniformBufVec );
-
-        /*device.createPushDescriptorSet(
-            pipelineIndex,
-            font.getTexture(),
-            m_uniformBufVec,
-            m_pushDescSet );*/
-    }
-    else if( fontString.empty() &&
-             (fontString != m_fontData.m_fontString) &&
-             (!m_vboBuffer.isEmpty()) )
-    {
-        m_fontData.m_fontString.clear();
     }
+
+    // Subtract the extra space after the last character
+    spLayout->m_fontStrSize.w -= lastCharDif;
+    spLayout->m_fontStrSize.h = font.getLineHeight();
+
+    return spLayout;
 }
 
 /************************************************************************
@@ -538,5 +594,6 @@ const CSize<float> & CVisualComponentFont::getSize() const
 bool CVisualComponentFont::allowCommandRecording()
 {
     return CVisualComponentQuad::allowCommandRecording() ||
-        ((GENERATION_TYPE == EGenType::FONT) && !m_fontData.m_fontString.empty() && !m_vboBuffer.isEmpty());
+        ((GENERATION_TYPE == EGenType::FONT) && !m_fontData.m_fontString.empty() && (m_iboCount > 0) &&
+         (m_fontData.m_fontProp.m_dynamic ? (m_spLayout != nullptr) : !m_vboBuffer.isEmpty()));
 }
\ No newline at end of file
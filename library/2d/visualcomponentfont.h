@@ -13,6 +13,10 @@
 // Game lib dependencies
 #include <common/fontdata.h>
 #include <system/memorybuffer.h>
+#include <managers/fontmanager.h>
+
+// Standard lib dependencies
+#include <memory>
 
 // Forward declaration(s)
 class CFont;
@@ -57,7 +61,7 @@ public:
 private:
     
     // Update the UBO buffer
-    void updateUBO(
+    uint32_t updateUBO(
         uint32_t index,
         CDevice & device,
         const iObjectVisualData & rVisualData,
@@ -77,6 +81,11 @@ private:
     std::vector<float> calcLineWidthOffset(
         const CFont & font,
         const std::string & str);
+
+    // Generate the glyph quads of the font string
+    std::shared_ptr<CFontLayout> generateLayout(
+        const CFont & font,
+        const std::string & fontString );
     
     // Is recording the command buffer allowed?
     bool allowCommandRecording() override;
@@ -87,8 +96,15 @@ private:
     CFontData m_fontData;
     
     // VBO buffer
+    // NOTE: Empty for dynamic font strings
     CMemoryBuffer m_vboBuffer;
     
     // ibo count
     size_t m_iboCount;
+
+    // Layout of the displayed string. Shared with the font manager's layout cache
+    std::shared_ptr<const CFontLayout> m_spLayout;
+
+    // What the current layout was generated from
+    CFontLayoutKey m_layoutKey;
 };
@@ -17,6 +17,7 @@
 #include <system/device.h>
 #include <system/pipeline.h>
 #include <system/uniformbufferobject.h>
+#include <2d/quadbatch.h>
 
 /************************************************************************
 *    desc:  Constructor
@@ -25,20 +26,55 @@ CVisualComponentQuad::CVisualComponentQuad( const iObjectData & objectData ) :
     iVisualComponent( objectData ),
     m_rObjectData( objectData ),
     m_quadVertScale( objectData.getSize() * objectData.getVisualData().getDefaultUniformScale() ),
-    m_pDescriptorSet(nullptr)
+    m_pDescriptorSet(nullptr),
+    m_instancedPipelineIndex(-1),
+    m_pInstanceDescriptorSet(nullptr)
 {
     auto & device( CDevice::Instance() );
-    const uint32_t pipelineIndex( objectData.getVisualData().getPipelineIndex() );
-
-    // Create the uniform buffer
-    m_uniformBufVec = device.createUniformBufferVec( pipelineIndex );
+    const auto & rVisualData( objectData.getVisualData() );
+    const uint32_t pipelineIndex( rVisualData.getPipelineIndex() );
 
     // Create the descriptor set
     if( GENERATION_TYPE != EGenType::FONT )
         m_pDescriptorSet = device.getDescriptorSet(
             pipelineIndex,
-            objectData.getVisualData().getTexture(),
-            m_uniformBufVec );
+            rVisualData.getTexture() );
+
+    // Plain quads can be batched into instanced draws if the pipeline has an instanced version
+    if( (GENERATION_TYPE == EGenType::QUAD) && rVisualData.allowBatching() )
+    {
+        m_instancedPipelineIndex = device.getPipelineData( pipelineIndex ).instancedPipelineIndex;
+
+        if( m_instancedPipelineIndex > -1 )
+            m_pInstanceDescriptorSet = device.getInstanceDescriptorSet(
+                m_instancedPipelineIndex,
+                rVisualData.getTexture() );
+    }
+
+    // Grab the sets of all the frames now so setFrame doesn't recycle and search for sets every animation tick
+    // NOTE: Sets are shared per texture so this only adds to the ref counts of sets the other sprites already hold.
+    //       A texture array has one set for all the frames so there's nothing to switch.
+    //       Sprite sheet frames are glyphs of the one texture.
+    if( (m_pDescriptorSet != nullptr) &&
+        (GENERATION_TYPE != EGenType::SPRITE_SHEET) &&
+        (rVisualData.getFrameCount() > 1) &&
+        !rVisualData.isTextureArray() )
+    {
+        m_pFrameDescriptorSetVec.reserve( rVisualData.getFrameCount() );
+        m_pFrameDescriptorSetVec.push_back( m_pDescriptorSet );
+
+        for( uint i = 1; i < rVisualData.getFrameCount(); ++i )
+            m_pFrameDescriptorSetVec.push_back( device.getDescriptorSet( pipelineIndex, rVisualData.getTexture( i ) ) );
+
+        if( m_pInstanceDescriptorSet != nullptr )
+        {
+            m_pFrameInstanceDescriptorSetVec.reserve( rVisualData.getFrameCount() );
+
+            for( uint i = 0; i < rVisualData.getFrameCount(); ++i )
+                m_pFrameInstanceDescriptorSetVec.push_back(
+                    device.getInstanceDescriptorSet( m_instancedPipelineIndex, rVisualData.getTexture( i ) ) );
+        }
+    }
     
     // Create the push descriptor set
     // This is just data and doesn't need to be freed
@@ -55,8 +91,12 @@ CVisualComponentQuad::CVisualComponentQuad( const iObjectData & objectData ) :
 ************************************************************************/
 CVisualComponentQuad::~CVisualComponentQuad()
 {
-    CDevice::Instance().AddToDeleteQueue( m_uniformBufVec );
-    CDevice::Instance().recycleDescriptorSet( m_pDescriptorSet );
+    // The active set is one of the frame sets if the quad is animated
+    if( m_pFrameDescriptorSetVec.empty() )
+        CDevice::Instance().recycleDescriptorSet( m_pDescriptorSet );
+
+    for( auto iter : m_pFrameDescriptorSetVec )
+        CDevice::Instance().recycleDescriptorSet( iter );
 }
 
 /***************************************************************************
@@ -74,48 +114,89 @@ void CVisualComponentQuad::recordCommandBuffer(
         CStatCounter::Instance().incDisplayCounter();
         
         const auto & rVisualData( m_rObjectData.getVisualData() );
+
+        // Add to the active batch if this quad allows it
+        if( m_pInstanceDescriptorSet != nullptr )
+        {
+            CQuadBatch * pQuadBatch = CQuadBatch::getActive();
+            if( pQuadBatch != nullptr )
+            {
+                // The view projection is part of the instance matrix so batches aren't tied to a camera
+                CMatrix matrix;
+                matrix.setScale( m_quadVertScale );
+                matrix *= pObject->getMatrix();
+                matrix *= camera.getFinalMatrix();
+
+                if( pQuadBatch->add(
+                    m_instancedPipelineIndex,
+                    rVisualData.getVBO(),
+                    rVisualData.getIBO(),
+                    rVisualData.getIBOCount(),
+                    m_pInstanceDescriptorSet,
+                    matrix,
+                    m_color,
+                    m_additive,
+                    rVisualData.getUVRect( m_frameIndex ) ) )
+                    return;
+            }
+        }
+
+        // Draw anything batched before this to keep the draw order
+        CQuadBatch::flushActive();
+
         auto & device( CDevice::Instance() );
 
         // Get the pipeline data
         const SPipelineData & rPipelineData = device.getPipelineData( rVisualData.getPipelineIndex() );
 
         // Update the UBO buffer
-        updateUBO( index, device, rVisualData, pObject, camera );
-
-        // Bind the pipeline
-        vkCmdBindPipeline( cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, rPipelineData.pipeline );
+        const uint32_t uboOffset = updateUBO( index, device, rVisualData, pObject, camera );
 
-        // Bind vertex buffer
-        VkBuffer vertexBuffers[] = {rVisualData.getVBO().m_buffer};
-        VkDeviceSize offsets[] = {0};
-        vkCmdBindVertexBuffers( cmdBuffer, 0, 1, vertexBuffers, offsets );
+        CDrawCommand drawCmd;
+        drawCmd.m_pipeline = rPipelineData.pipeline;
+        drawCmd.m_pipelineLayout = rPipelineData.pipelineLayout;
 
-        // Bind the index buffer
-        vkCmdBindIndexBuffer( cmdBuffer, rVisualData.getIBO().m_buffer, 0, VK_INDEX_TYPE_UINT16 );
+        // Frames packed into a texture atlas have their own UVs
+        drawCmd.m_vertexBuffer[0] = rVisualData.getFrameVBO( m_frameIndex ).m_buffer;
+        drawCmd.m_indexBuffer = rVisualData.getIBO().m_buffer;
+        drawCmd.m_indexCount = rVisualData.getIBOCount();
 
-        // With the regular descriptor set implementation, objects that use the same texture and UBO can't share the same
-        // descriptor set because the translation matrix is part of the UBO the objects sharing this will render ontop of each other
-        vkCmdBindDescriptorSets( 
-            cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, rPipelineData.pipelineLayout, 0, 1, &m_pDescriptorSet->m_descriptorVec[index], 0, nullptr );
+        // The UBO is bound with the dynamic offset of this object's data in the frame's uniform ring
+        drawCmd.m_descriptorSet = m_pDescriptorSet->m_descriptorVec[index];
+        drawCmd.m_dynamicOffset = uboOffset;
 
         // Use the push descriptors
         //m_pushDescSet.cmdPushDescriptorSet( index, cmdBuffer, rPipelineData.pipelineLayout );
 
         // Do the draw
-        vkCmdDrawIndexed( cmdBuffer, rVisualData.getIBOCount(), 1, 0, 0, 0 );
+        device.recordDraw( cmdBuffer, drawCmd );
     }
 }
 
 /************************************************************************
 *    DESC:  Update the UBO buffer
 ************************************************************************/
-void CVisualComponentQuad::updateUBO(
+uint32_t CVisualComponentQuad::updateUBO(
     uint32_t index,
     CDevice & device,
     const iObjectVisualData & rVisualData,
     const CObject * const pObject,
     const CCamera & camera )
 {
+    // The frame of a texture array is picked by the layer in the UBO
+    if( rVisualData.isTextureArray() )
+    {
+        NUBO::model_viewProj_color_additive_layer ubo;
+        ubo.model.setScale( m_quadVertScale );
+        ubo.model *= pObject->getMatrix();
+        ubo.viewProj = camera.getFinalMatrix();
+        ubo.color = m_color;
+        ubo.additive = m_additive;
+        ubo.layer = m_frameIndex;
+
+        return device.updateUniformBuffer( index, ubo );
+    }
+
     // Setup the uniform buffer object
     NUBO::model_viewProj_color_additive ubo;
     ubo.model.setScale( m_quadVertScale );
@@ -125,7 +206,7 @@ void CVisualComponentQuad::updateUBO(
     ubo.additive = m_additive;
 
     // Update the uniform buffer
-    device.updateUniformBuffer( ubo, m_uniformBufVec[index].m_deviceMemory );
+    return device.updateUniformBuffer( index, ubo );
 }
 
 /************************************************************************
@@ -145,16 +226,14 @@ void CVisualComponentQuad::setFrame( uint index )
         m_quadVertScale.w = rTexture.size.w * defScale;
         m_quadVertScale.h = rTexture.size.h * defScale;
 
-        // Recycle if the descriptor set is not null
-        // Can't update the descriptor set because it could be actuve in the command buffer.
-        // The strategy is to recycle the current one and grab a fresh one
-        if( m_pDescriptorSet != nullptr )
-            CDevice::Instance().recycleDescriptorSet( m_pDescriptorSet );
-            
-        m_pDescriptorSet = CDevice::Instance().getDescriptorSet(
-            m_rObjectData.getVisualData().getPipelineIndex(),
-            rTexture,
-            m_uniformBufVec );
+        // The sets of all the frames were grabbed in the constructor so just switch to this frame's
+        // NOTE: Frames packed into a texture atlas share a set and pick their UVs through the frame VBO or uvRect.
+        //       Frames in a texture array share a set and pick their layer through the UBO.
+        if( index < m_pFrameDescriptorSetVec.size() )
+            m_pDescriptorSet = m_pFrameDescriptorSetVec[index];
+
+        if( index < m_pFrameInstanceDescriptorSetVec.size() )
+            m_pInstanceDescriptorSet = m_pFrameInstanceDescriptorSetVec[index];
         
         // Update the texture
         //m_pushDescSet.updateTexture( rTexture );
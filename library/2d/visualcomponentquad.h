@@ -17,6 +17,9 @@
 // Boost lib dependencies
 #include <boost/noncopyable.hpp>
 
+// Standard lib dependencies
+#include <vector>
+
 // Forward declaration(s)
 class iObjectVisualData;
 class CMemoryBuffer;
@@ -53,7 +56,7 @@ protected:
 private:
     
     // Update the UBO buffer
-    virtual void updateUBO(
+    virtual uint32_t updateUBO(
         uint32_t index,
         CDevice & device,
         const iObjectVisualData & rVisualData,
@@ -62,9 +65,6 @@ private:
 
 protected:
     
-    // Uniform buffers
-    std::vector<CMemoryBuffer> m_uniformBufVec;
-    
     // Reference to object visual data
     const iObjectData & m_rObjectData;
     
@@ -74,6 +74,19 @@ protected:
     // Descriptor Set for this image
     CDescriptorSet * m_pDescriptorSet;
 
+    // Descriptor sets of every frame of an animated quad, grabbed up front so
+    // changing frames only switches pointers. Frames in the same texture atlas share one.
+    std::vector<CDescriptorSet *> m_pFrameDescriptorSetVec;
+
+    // Instanced pipeline used for batching. -1 if this quad is not batched
+    int m_instancedPipelineIndex;
+
+    // Descriptor set shared by all batched quads using the same texture. Owned by the device.
+    CDescriptorSet * m_pInstanceDescriptorSet;
+
+    // Instance descriptor sets of every frame. Owned by the device.
+    std::vector<CDescriptorSet *> m_pFrameInstanceDescriptorSetVec;
+
     // Push Descriptor set
     //CPushDescriptorSet m_pushDescSet;
 };
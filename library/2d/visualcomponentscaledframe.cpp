@@ -33,7 +33,7 @@ CVisualComponentScaledFrame::~CVisualComponentScaledFrame()
 /************************************************************************
 *    DESC:  Update the UBO buffer
 ************************************************************************/
-void CVisualComponentScaledFrame::updateUBO(
+uint32_t CVisualComponentScaledFrame::updateUBO(
     uint32_t index,
     CDevice & device,
     const iObjectVisualData & rVisualData,
@@ -48,7 +48,7 @@ void CVisualComponentScaledFrame::updateUBO(
     ubo.additive = m_additive;
 
     // Update the uniform buffer
-    device.updateUniformBuffer( ubo, m_uniformBufVec[index].m_deviceMemory );
+    return device.updateUniformBuffer( index, ubo );
 }
 
 /************************************************************************
@@ -35,7 +35,7 @@ CVisualComponentSpriteSheet::~CVisualComponentSpriteSheet()
 /************************************************************************
 *    DESC:  Update the UBO buffer
 ************************************************************************/
-void CVisualComponentSpriteSheet::updateUBO(
+uint32_t CVisualComponentSpriteSheet::updateUBO(
     uint32_t index,
     CDevice & device,
     const iObjectVisualData & rVisualData,
@@ -52,7 +52,7 @@ void CVisualComponentSpriteSheet::updateUBO(
     ubo.glyph = m_glyphUV;
 
     // Update the uniform buffer
-    device.updateUniformBuffer( ubo, m_uniformBufVec[index].m_deviceMemory );
+    return device.updateUniformBuffer( index, ubo );
 }
 
 /************************************************************************
@@ -26,7 +26,7 @@ public:
 private:
     
     // Update the UBO buffer
-    void updateUBO(
+    uint32_t updateUBO(
         uint32_t index,
         CDevice & device,
         const iObjectVisualData & rVisualData,
@@ -17,6 +17,7 @@
 #include <system/uniformbufferobject.h>
 #include <utilities/statcounter.h>
 #include <common/camera.h>
+#include <2d/quadbatch.h>
 
 /************************************************************************
 *    DESC:  Constructor
@@ -31,16 +32,12 @@ CVisualComponent3D::CVisualComponent3D( const iObjectData & objectData ) :
     auto & device( CDevice::Instance() );
     const uint32_t pipelineIndex( objectData.getVisualData().getPipelineIndex() );
 
-    // Create the uniform buffer
-    m_uniformBufVec = device.createUniformBufferVec( pipelineIndex );
-    
     // Create the push descriptor set
     for( auto & iter : m_rModel.m_meshVec )
         m_pDescriptorSetVec.push_back( 
             device.getDescriptorSet(
                 pipelineIndex,
-                iter.m_textureVec.back(),
-                m_uniformBufVec ));
+                iter.m_textureVec.back() ));
 
     /*device.createPushDescriptorSet(
         pipelineIndex,
@@ -54,8 +51,6 @@ CVisualComponent3D::CVisualComponent3D( const iObjectData & objectData ) :
 ************************************************************************/
 CVisualComponent3D::~CVisualComponent3D()
 {
-    CDevice::Instance().AddToDeleteQueue( m_uniformBufVec );
-
     for( auto iter : m_pDescriptorSetVec )
         CDevice::Instance().recycleDescriptorSet( iter );
 }
@@ -73,6 +68,9 @@ void CVisualComponent3D::recordCommandBuffer(
     {
         // Increment our stat counter to keep track of what is going on.
         CStatCounter::Instance().incDisplayCounter();
+
+        // Draw anything batched before this to keep the draw order
+        CQuadBatch::flushActive();
         
         const auto & rVisualData( m_rObjectData.getVisualData() );
         auto & device( CDevice::Instance() );
@@ -81,31 +79,27 @@ void CVisualComponent3D::recordCommandBuffer(
         const SPipelineData & rPipelineData = device.getPipelineData( rVisualData.getPipelineIndex() );
 
         // Update the UBO buffer
-        updateUBO( index, device, rVisualData, pObject, camera );
+        const uint32_t uboOffset = updateUBO( index, device, rVisualData, pObject, camera );
+
+        CDrawCommand drawCmd;
+        drawCmd.m_pipeline = rPipelineData.pipeline;
+        drawCmd.m_pipelineLayout = rPipelineData.pipelineLayout;
 
-        // Bind the pipeline
-        vkCmdBindPipeline( cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, rPipelineData.pipeline );
+        // The UBO is bound with the dynamic offset of this object's data in the frame's uniform ring
+        drawCmd.m_dynamicOffset = uboOffset;
         
         for( size_t i = 0; i < m_rModel.m_meshVec.size(); ++i )
         {
-            // Bind vertex buffer
-            VkBuffer vertexBuffers[] = {m_rModel.m_meshVec[i].m_vboBuffer.m_buffer};
-            VkDeviceSize offsets[] = {0};
-            vkCmdBindVertexBuffers( cmdBuffer, 0, 1, vertexBuffers, offsets );
-
-            // Bind the index buffer
-            vkCmdBindIndexBuffer( cmdBuffer, m_rModel.m_meshVec[i].m_iboBuffer.m_buffer, 0, VK_INDEX_TYPE_UINT16 );
-
-            // With the regular descriptor set implementation, objects that use the same texture and UBO can't share the same
-            // descriptor set because the translation matrix is part of the UBO the objects sharing this will render ontop of each other
-            vkCmdBindDescriptorSets( 
-                cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, rPipelineData.pipelineLayout, 0, 1, &m_pDescriptorSetVec[i]->m_descriptorVec[index], 0, nullptr );
+            drawCmd.m_vertexBuffer[0] = m_rModel.m_meshVec[i].m_vboBuffer.m_buffer;
+            drawCmd.m_indexBuffer = m_rModel.m_meshVec[i].m_iboBuffer.m_buffer;
+            drawCmd.m_indexCount = m_rModel.m_meshVec[i].m_iboCount;
+            drawCmd.m_descriptorSet = m_pDescriptorSetVec[i]->m_descriptorVec[index];
 
             // Use the push descriptors
             //m_pushDescSetVec[i].cmdPushDescriptorSet( index, cmdBuffer, rPipelineData.pipelineLayout );
 
             // Do the draw
-            vkCmdDrawIndexed( cmdBuffer, m_rModel.m_meshVec[i].m_iboCount, 1, 0, 0, 0 );
+            device.recordDraw( cmdBuffer, drawCmd );
         }
     }
 }
@@ -113,7 +107,7 @@ void CVisualComponent3D::recordCommandBuffer(
 /************************************************************************
 *    DESC:  Update the UBO buffer
 ************************************************************************/
-void CVisualComponent3D::updateUBO(
+uint32_t CVisualComponent3D::updateUBO(
     uint32_t index,
     CDevice & device,
     const iObjectVisualData & rVisualData,
@@ -129,7 +123,7 @@ void CVisualComponent3D::updateUBO(
     ubo.additive = m_additive;
 
     // Update the uniform buffer
-    device.updateUniformBuffer( ubo, m_uniformBufVec[index].m_deviceMemory );
+    return device.updateUniformBuffer( index, ubo );
 }
 
 /************************************************************************
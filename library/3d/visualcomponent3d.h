@@ -55,7 +55,7 @@ public:
 private:
     
     // Update the UBO buffer
-    void updateUBO(
+    uint32_t updateUBO(
         uint32_t index,
         CDevice & device,
         const iObjectVisualData & rVisualData,
@@ -70,9 +70,6 @@ private:
     // Copy of model data
     const CModel & m_rModel;
     
-    // Uniform buffers
-    std::vector<CMemoryBuffer> m_uniformBufVec;
-
     // Descriptor Set for this image
     std::vector<CDescriptorSet *> m_pDescriptorSetVec;
 
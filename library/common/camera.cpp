@@ -11,10 +11,16 @@
 #include <utilities/settings.h>
 #include <utilities/xmlParser.h>
 #include <node/inode.h>
+#include <system/device.h>
+#include <utilities/threadpool.h>
+#include <2d/quadbatch.h>
+#include <utilities/statcounter.h>
 
 // Standard lib dependencies
 #include <cstring>
 #include <cstdlib>
+#include <algorithm>
+#include <limits>
 
 /************************************************************************
 *    DESC:  Constructor
@@ -388,38 +394,136 @@ bool CCamera::inViewX( const CPoint<float> & transPos, const float radius )
     return true;
 }
 
+/************************************************************************
+*    DESC:  Get the area of the world the cull tests let through
+*
+*    NOTE:  Perspective uses the farthest z so the area holds for every
+*           node. Axes that aren't culled are left unbounded.
+************************************************************************/
+void CCamera::getCullBounds( float maxAbsZ, CPoint<float> & minPos, CPoint<float> & maxPos ) const
+{
+    CSize<float> halfSize;
+
+    if( m_projType == EProjectionType::ORTHOGRAPHIC )
+        halfSize = CSettings::Instance().getDefaultSizeHalf();
+    else
+        halfSize = CSettings::Instance().getScreenAspectRatio() * maxAbsZ;
+
+    const CPoint<float> center( -getTransPos().x / m_scale.x, -getTransPos().y / m_scale.y );
+    halfSize.w = std::abs( halfSize.w / m_scale.x );
+    halfSize.h = std::abs( halfSize.h / m_scale.y );
+
+    minPos.x = -std::numeric_limits<float>::max();
+    minPos.y = -std::numeric_limits<float>::max();
+    maxPos.x = std::numeric_limits<float>::max();
+    maxPos.y = std::numeric_limits<float>::max();
+
+    if( m_cullType != ECullType::CULL_Y_ONLY )
+    {
+        minPos.x = center.x - halfSize.w;
+        maxPos.x = center.x + halfSize.w;
+    }
+
+    if( m_cullType != ECullType::CULL_X_ONLY )
+    {
+        minPos.y = center.y - halfSize.h;
+        maxPos.y = center.y + halfSize.h;
+    }
+}
+
 /************************************************************************
 *    DESC:  Handle the recording of the command buffers based on culling
 ************************************************************************/
 void CCamera::recordCommandBuffer( uint32_t index, VkCommandBuffer cmdBuffer, std::vector<iNode *> & pNodeVec )
 {
+    recordCommandBuffer( index, cmdBuffer, pNodeVec, 0, pNodeVec.size() );
+}
+
+/************************************************************************
+*    DESC:  Split the node vector into chunks that are recorded in parallel
+*
+*    NOTE:  Each command buffer must come from a different command pool.
+*           Chunks are in node order so executing the command buffers
+*           in array order keeps the same draw order as the serial path.
+*           Wait on the counter before using the command buffers.
+************************************************************************/
+void CCamera::recordCommandBuffer(
+    uint32_t index,
+    const VkCommandBuffer * pCmdBufArray,
+    size_t chunkCount,
+    std::vector<iNode *> & pNodeVec,
+    CJobCounter & counter )
+{
+    const size_t nodeCount = pNodeVec.size();
+    const size_t chunkSize = (nodeCount + chunkCount - 1) / chunkCount;
+
+    for( size_t chunk = 0; chunk < chunkCount; ++chunk )
+    {
+        const size_t begin = std::min( chunk * chunkSize, nodeCount );
+        const size_t end = std::min( begin + chunkSize, nodeCount );
+        VkCommandBuffer cmdBuffer = pCmdBufArray[chunk];
+
+        // Empty chunks still need to be recorded because they are executed with the others
+        CThreadPool::Instance().post( counter,
+            [this, index, cmdBuffer, &pNodeVec, begin, end]()
+            {
+                CDevice::Instance().beginCommandBuffer( index, cmdBuffer );
+                recordCommandBuffer( index, cmdBuffer, pNodeVec, begin, end );
+                CDevice::Instance().endCommandBuffer( cmdBuffer );
+            } );
+    }
+}
+
+/************************************************************************
+*    DESC:  Record the command buffers for a range of nodes based on culling
+************************************************************************/
+void CCamera::recordCommandBuffer( uint32_t index, VkCommandBuffer cmdBuffer, std::vector<iNode *> & pNodeVec, size_t begin, size_t end )
+{
+    // Consecutive quads that share a texture are batched into instanced draws
+    CQuadBatch quadBatch( index, cmdBuffer );
+
+    int visibleCount = 0;
+
     if( m_cullType == ECullType::_NULL_)
     {
-        for( auto iter : pNodeVec )
-            iter->recordCommandBuffer( index, cmdBuffer, *this );
+        for( size_t i = begin; i < end; ++i )
+            pNodeVec[i]->recordCommandBuffer( index, cmdBuffer, *this );
+
+        visibleCount = end - begin;
     }
     else if( m_cullType == ECullType::CULL_FULL)
     {
-        for( auto iter : pNodeVec )
+        for( size_t i = begin; i < end; ++i )
         {
-            if( inView( iter->getObject()->getTransPos(), iter->getRadius() ) )
-                iter->recordCommandBuffer( index, cmdBuffer, *this );
+            if( inView( pNodeVec[i]->getObject()->getTransPos(), pNodeVec[i]->getRadius() ) )
+            {
+                pNodeVec[i]->recordCommandBuffer( index, cmdBuffer, *this );
+                ++visibleCount;
+            }
         }
     }
     else if( m_cullType == ECullType::CULL_X_ONLY)
     {
-        for( auto iter : pNodeVec )
+        for( size_t i = begin; i < end; ++i )
         {
-            if( inViewX( iter->getObject()->getTransPos(), iter->getRadius() ) )
-                iter->recordCommandBuffer( index, cmdBuffer, *this );
+            if( inViewX( pNodeVec[i]->getObject()->getTransPos(), pNodeVec[i]->getRadius() ) )
+            {
+                pNodeVec[i]->recordCommandBuffer( index, cmdBuffer, *this );
+                ++visibleCount;
+            }
         }
     }
     else if( m_cullType == ECullType::CULL_Y_ONLY)
     {
-        for( auto iter : pNodeVec )
+        for( size_t i = begin; i < end; ++i )
         {
-            if( inViewY( iter->getObject()->getTransPos(), iter->getRadius() ) )
-                iter->recordCommandBuffer( index, cmdBuffer, *this );
+            if( inViewY( pNodeVec[i]->getObject()->getTransPos(), pNodeVec[i]->getRadius() ) )
+            {
+                pNodeVec[i]->recordCommandBuffer( index, cmdBuffer, *this );
+                ++visibleCount;
+            }
         }
     }
+
+    CStatCounter::Instance().incCullCounters( visibleCount, (end - begin) - visibleCount );
 }
\ No newline at end of file
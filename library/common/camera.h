@@ -19,6 +19,7 @@
 // Forward Declarations
 struct XMLNode;
 class iNode;
+class CJobCounter;
 
 class CCamera : public CObject
 {
@@ -87,9 +88,20 @@ public:
     // Check if the raduis is in the view frustrum of the X
     bool inViewX( const CPoint<float> & transPos, const float radius );
 
+    // Get the area of the world the cull tests let through
+    void getCullBounds( float maxAbsZ, CPoint<float> & minPos, CPoint<float> & maxPos ) const;
+
     // Handle the recording of the command buffers based on culling
     void recordCommandBuffer( uint32_t index, VkCommandBuffer cmdBuffer, std::vector<iNode *> & m_pNodeVec );
 
+    // Split the node vector into chunks that are recorded in parallel. One command buffer per chunk.
+    void recordCommandBuffer(
+        uint32_t index,
+        const VkCommandBuffer * pCmdBufArray,
+        size_t chunkCount,
+        std::vector<iNode *> & pNodeVec,
+        CJobCounter & counter );
+
 protected:
     
     // Apply the rotation
@@ -100,6 +112,9 @@ private:
     // Calculate the final matrix
     void calcFinalMatrix();
 
+    // Record the command buffers for a range of nodes based on culling
+    void recordCommandBuffer( uint32_t index, VkCommandBuffer cmdBuffer, std::vector<iNode *> & pNodeVec, size_t begin, size_t end );
+
 private:
 
     // World position value
@@ -14,6 +14,9 @@
 #include <managers/fontmanager.h>
 #include <common/defs.h>
 
+// Standard lib dependencies
+#include <cstring>
+
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
@@ -59,6 +62,7 @@ void CFontProperties::copy( const CFontProperties & obj )
     m_spaceCharKerning = obj.m_spaceCharKerning;
     m_lineWrapWidth = obj.m_lineWrapWidth;
     m_lineWrapHeight = obj.m_lineWrapHeight;
+    m_dynamic = obj.m_dynamic;
     
     // Throws an exception if font is not loaded
     CFontMgr::Instance().isFont( m_fontName );
@@ -90,6 +94,9 @@ void CFontProperties::loadFromNode( const XMLNode & node )
 
         if( attrNode.isAttributeSet( "lineWrapHeight" ) )
             m_lineWrapHeight = std::atof( attrNode.getAttribute( "lineWrapHeight" ) );
+
+        if( attrNode.isAttributeSet( "dynamic" ) )
+            m_dynamic = ( std::strcmp( attrNode.getAttribute( "dynamic" ), "true" ) == 0 );
     }
 
     // Get the alignment node
@@ -52,4 +52,8 @@ public:
     
     // add spacing to the lines
     float m_lineWrapHeight = 0.f;
+
+    // Stream the glyph quads into the frame's dynamic vertex ring instead of a VBO
+    // Meant for strings that change often like scores and timers
+    bool m_dynamic = false;
 };
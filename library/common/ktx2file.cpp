@@ -0,0 +1,388 @@
+
+/************************************************************************
+*    FILE NAME:       ktx2file.cpp
+*
+*    DESCRIPTION:     Reads and writes KTX2 texture containers holding
+*                     pre-compressed, pre-mipped images
+*
+*    NOTE:            Only single layer, single face 2D textures without
+*                     supercompression are supported
+************************************************************************/
+
+// Physical component dependency
+#include <common/ktx2file.h>
+
+// Game lib dependencies
+#include <utilities/exceptionhandling.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
+
+// Standard lib dependencies
+#include <cstring>
+#include <numeric>
+#include <algorithm>
+#include <tuple>
+
+/************************************************************************
+*    File header and level index as laid out in the file
+************************************************************************/
+struct SKtx2Header
+{
+    uint8_t identifier[12];
+    uint32_t vkFormat;
+    uint32_t typeSize;
+    uint32_t pixelWidth;
+    uint32_t pixelHeight;
+    uint32_t pixelDepth;
+    uint32_t layerCount;
+    uint32_t faceCount;
+    uint32_t levelCount;
+    uint32_t supercompressionScheme;
+    uint32_t dfdByteOffset;
+    uint32_t dfdByteLength;
+    uint32_t kvdByteOffset;
+    uint32_t kvdByteLength;
+    uint64_t sgdByteOffset;
+    uint64_t sgdByteLength;
+};
+
+struct SKtx2Level
+{
+    uint64_t byteOffset;
+    uint64_t byteLength;
+    uint64_t uncompressedByteLength;
+};
+
+static_assert( sizeof(SKtx2Header) == 80, "KTX2 header is not packed" );
+static_assert( sizeof(SKtx2Level) == 24, "KTX2 level index is not packed" );
+
+static const uint8_t KTX2_IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CKtx2File::CKtx2File() :
+    m_format(VK_FORMAT_UNDEFINED),
+    m_width(0),
+    m_height(0)
+{
+}
+
+/************************************************************************
+*    DESC:  destructor
+************************************************************************/
+CKtx2File::~CKtx2File()
+{
+}
+
+/************************************************************************
+*    DESC:  Parse the file data. The level data stays in the vector
+************************************************************************/
+void CKtx2File::parse( std::vector<char> && dataVec, const std::string & filePath )
+{
+    m_dataVec = std::move( dataVec );
+    m_levelVec.clear();
+
+    SKtx2Header header;
+    if( m_dataVec.size() < sizeof(header) )
+        throw NExcept::CCriticalException("KTX2 Load Error!",
+            boost::str( boost::format("File is too small to be a KTX2 file (%s).\n\n%s\nLine: %s") % filePath % __FUNCTION__ % __LINE__ ));
+
+    std::memcpy( &header, m_dataVec.data(), sizeof(header) );
+
+    if( (std::memcmp( header.identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER) ) != 0) ||
+        (header.pixelWidth == 0) || (header.pixelHeight == 0) || (header.pixelDepth != 0) ||
+        (header.layerCount > 1) || (header.faceCount != 1) || (header.supercompressionScheme != 0) )
+        throw NExcept::CCriticalException("KTX2 Load Error!",
+            boost::str( boost::format("KTX2 file is not a plain 2D texture (%s).\n\n%s\nLine: %s") % filePath % __FUNCTION__ % __LINE__ ));
+
+    CTexelBlock texelBlock;
+    if( !getTexelBlock( static_cast<VkFormat>(header.vkFormat), texelBlock ) )
+        throw NExcept::CCriticalException("KTX2 Load Error!",
+            boost::str( boost::format("KTX2 format %d is not supported (%s).\n\n%s\nLine: %s") % header.vkFormat % filePath % __FUNCTION__ % __LINE__ ));
+
+    m_format = static_cast<VkFormat>(header.vkFormat);
+    m_width = header.pixelWidth;
+    m_height = header.pixelHeight;
+
+    // A level count of zero asks the loader to generate the mips
+    const uint32_t levelCount = std::max( header.levelCount, 1u );
+
+    if( m_dataVec.size() < (sizeof(header) + (sizeof(SKtx2Level) * levelCount)) )
+        throw NExcept::CCriticalException("KTX2 Load Error!",
+            boost::str( boost::format("KTX2 level index is cut short (%s).\n\n%s\nLine: %s") % filePath % __FUNCTION__ % __LINE__ ));
+
+    for( uint32_t i = 0; i < levelCount; ++i )
+    {
+        SKtx2Level level;
+        std::memcpy( &level, m_dataVec.data() + sizeof(header) + (sizeof(SKtx2Level) * i), sizeof(level) );
+
+        if( (level.byteOffset + level.byteLength > m_dataVec.size()) ||
+            (level.byteLength < calcLevelSize( m_format, getLevelWidth( i ), getLevelHeight( i ) )) )
+            throw NExcept::CCriticalException("KTX2 Load Error!",
+                boost::str( boost::format("KTX2 level %d is out of range (%s).\n\n%s\nLine: %s") % i % filePath % __FUNCTION__ % __LINE__ ));
+
+        m_levelVec.emplace_back( level.byteOffset, level.byteLength );
+    }
+}
+
+/************************************************************************
+*    DESC:  Start a new file with the base level size
+************************************************************************/
+void CKtx2File::create( VkFormat format, uint32_t width, uint32_t height )
+{
+    m_format = format;
+    m_width = width;
+    m_height = height;
+
+    m_levelVec.clear();
+    m_dataVec.clear();
+}
+
+/************************************************************************
+*    DESC:  Add the next smaller level
+************************************************************************/
+void CKtx2File::addLevel( const void * pData, size_t size )
+{
+    m_levelVec.emplace_back( m_dataVec.size(), size );
+
+    const char * pByte = static_cast<const char *>(pData);
+    m_dataVec.insert( m_dataVec.end(), pByte, pByte + size );
+}
+
+/************************************************************************
+*    DESC:  Write out the file data
+*           NOTE: The levels are stored smallest first as the spec asks
+************************************************************************/
+std::vector<char> CKtx2File::write() const
+{
+    std::vector<uint32_t> dfdVec;
+    writeDataFormatDesc( dfdVec );
+
+    CTexelBlock texelBlock;
+    getTexelBlock( m_format, texelBlock );
+
+    // Levels are aligned to the texel block size and to 4 bytes
+    const size_t levelAlignment = std::lcm( texelBlock.bytes, 4u );
+    const uint32_t levelCount = m_levelVec.size();
+
+    SKtx2Header header = {};
+    std::memcpy( header.identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER) );
+    header.vkFormat = m_format;
+    header.typeSize = 1;
+    header.pixelWidth = m_width;
+    header.pixelHeight = m_height;
+    header.faceCount = 1;
+    header.levelCount = levelCount;
+    header.dfdByteOffset = sizeof(header) + (sizeof(SKtx2Level) * levelCount);
+    header.dfdByteLength = dfdVec.size() * sizeof(uint32_t);
+
+    std::vector<char> fileVec( header.dfdByteOffset + header.dfdByteLength );
+    std::memcpy( fileVec.data(), &header, sizeof(header) );
+    std::memcpy( fileVec.data() + header.dfdByteOffset, dfdVec.data(), header.dfdByteLength );
+
+    std::vector<SKtx2Level> levelIndexVec( levelCount );
+
+    for( size_t i = levelCount; i-- > 0; )
+    {
+        fileVec.resize( ((fileVec.size() + levelAlignment - 1) / levelAlignment) * levelAlignment );
+
+        levelIndexVec[i].byteOffset = fileVec.size();
+        levelIndexVec[i].byteLength = m_levelVec[i].second;
+        levelIndexVec[i].uncompressedByteLength = m_levelVec[i].second;
+
+        auto dataIter = m_dataVec.begin() + m_levelVec[i].first;
+        fileVec.insert( fileVec.end(), dataIter, dataIter + m_levelVec[i].second );
+    }
+
+    std::memcpy( fileVec.data() + sizeof(header), levelIndexVec.data(), sizeof(SKtx2Level) * levelCount );
+
+    return fileVec;
+}
+
+/************************************************************************
+*    DESC:  Write the data format descriptor of the format
+*           NOTE: Only the formats the texture baker writes are described
+************************************************************************/
+void CKtx2File::writeDataFormatDesc( std::vector<uint32_t> & dfdVec ) const
+{
+    // Data format descriptor model, channel and transfer values
+    const uint32_t MODEL_RGBSDA = 1;
+    const uint32_t MODEL_BC1A = 128;
+    const uint32_t MODEL_BC3 = 130;
+    const uint32_t PRIMARIES_BT709 = 1;
+    const uint32_t TRANSFER_LINEAR = 1;
+    const uint32_t CHANNEL_ALPHA = 15;
+
+    uint32_t model(0);
+
+    // Sample bit offset, bit length and channel
+    std::vector<std::tuple<uint32_t, uint32_t, uint32_t>> sampleVec;
+
+    if( m_format == VK_FORMAT_R8G8B8A8_UNORM )
+    {
+        model = MODEL_RGBSDA;
+        sampleVec = { {0, 8, 0}, {8, 8, 1}, {16, 8, 2}, {24, 8, CHANNEL_ALPHA} };
+    }
+    else if( (m_format == VK_FORMAT_BC1_RGB_UNORM_BLOCK) || (m_format == VK_FORMAT_BC1_RGBA_UNORM_BLOCK) )
+    {
+        model = MODEL_BC1A;
+        sampleVec = { {0, 64, 0} };
+    }
+    else if( m_format == VK_FORMAT_BC3_UNORM_BLOCK )
+    {
+        model = MODEL_BC3;
+        sampleVec = { {0, 64, CHANNEL_ALPHA}, {64, 64, 0} };
+    }
+    else
+    {
+        throw NExcept::CCriticalException("KTX2 Save Error!",
+            boost::str( boost::format("KTX2 format %d can't be written.\n\n%s\nLine: %s") % m_format % __FUNCTION__ % __LINE__ ));
+    }
+
+    CTexelBlock texelBlock;
+    getTexelBlock( m_format, texelBlock );
+
+    const uint32_t blockSize = 24 + (16 * sampleVec.size());
+
+    dfdVec.clear();
+    dfdVec.push_back( 4 + blockSize );
+    dfdVec.push_back( 0 );                          // Khronos vendor, basic descriptor type
+    dfdVec.push_back( 2 | (blockSize << 16) );      // Version 2 and the block size
+    dfdVec.push_back( model | (PRIMARIES_BT709 << 8) | (TRANSFER_LINEAR << 16) );
+    dfdVec.push_back( (texelBlock.width - 1) | ((texelBlock.height - 1) << 8) );
+    dfdVec.push_back( texelBlock.bytes );           // Bytes in plane 0
+    dfdVec.push_back( 0 );
+
+    for( auto & iter : sampleVec )
+    {
+        const uint32_t bitLength = std::get<1>(iter);
+
+        dfdVec.push_back( std::get<0>(iter) | ((bitLength - 1) << 16) | (std::get<2>(iter) << 24) );
+        dfdVec.push_back( 0 );
+        dfdVec.push_back( 0 );
+        dfdVec.push_back( (bitLength >= 32) ? 0xFFFFFFFF : ((1u << bitLength) - 1) );
+    }
+}
+
+/************************************************************************
+*    DESC:  Get the format and the size of the base level
+************************************************************************/
+VkFormat CKtx2File::getFormat() const
+{
+    return m_format;
+}
+
+uint32_t CKtx2File::getWidth() const
+{
+    return m_width;
+}
+
+uint32_t CKtx2File::getHeight() const
+{
+    return m_height;
+}
+
+/************************************************************************
+*    DESC:  Get the level info
+************************************************************************/
+uint32_t CKtx2File::getLevelCount() const
+{
+    return m_levelVec.size();
+}
+
+uint32_t CKtx2File::getLevelWidth( uint32_t level ) const
+{
+    return std::max( m_width >> level, 1u );
+}
+
+uint32_t CKtx2File::getLevelHeight( uint32_t level ) const
+{
+    return std::max( m_height >> level, 1u );
+}
+
+const char * CKtx2File::getLevelData( uint32_t level ) const
+{
+    return m_dataVec.data() + m_levelVec[level].first;
+}
+
+size_t CKtx2File::getLevelSize( uint32_t level ) const
+{
+    return m_levelVec[level].second;
+}
+
+/************************************************************************
+*    DESC:  Get the total size of the level data
+************************************************************************/
+size_t CKtx2File::getDataSize() const
+{
+    size_t size(0);
+    for( auto & iter : m_levelVec )
+        size += iter.second;
+
+    return size;
+}
+
+/************************************************************************
+*    DESC:  Get the texel block of a format
+*           NOTE: The engine samples all textures as UNORM so only
+*                 those formats are allowed
+************************************************************************/
+bool CKtx2File::getTexelBlock( VkFormat format, CTexelBlock & texelBlock )
+{
+    switch( format )
+    {
+        case VK_FORMAT_R8G8B8A8_UNORM:
+            texelBlock = {1, 1, 4};
+            return true;
+
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK:
+            texelBlock = {4, 4, 8};
+            return true;
+
+        case VK_FORMAT_BC3_UNORM_BLOCK:
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+        case VK_FORMAT_ASTC_4x4_UNORM_BLOCK:
+            texelBlock = {4, 4, 16};
+            return true;
+
+        case VK_FORMAT_ASTC_6x6_UNORM_BLOCK:
+            texelBlock = {6, 6, 16};
+            return true;
+
+        case VK_FORMAT_ASTC_8x8_UNORM_BLOCK:
+            texelBlock = {8, 8, 16};
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+/************************************************************************
+*    DESC:  Is the format block compressed
+************************************************************************/
+bool CKtx2File::isCompressed( VkFormat format )
+{
+    CTexelBlock texelBlock;
+    return getTexelBlock( format, texelBlock ) && (texelBlock.width > 1);
+}
+
+/************************************************************************
+*    DESC:  Get the size of a level of a format
+************************************************************************/
+size_t CKtx2File::calcLevelSize( VkFormat format, uint32_t width, uint32_t height )
+{
+    CTexelBlock texelBlock;
+    if( !getTexelBlock( format, texelBlock ) )
+        return 0;
+
+    return (size_t)((width + texelBlock.width - 1) / texelBlock.width) *
+           (size_t)((height + texelBlock.height - 1) / texelBlock.height) *
+           texelBlock.bytes;
+}
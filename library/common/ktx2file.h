@@ -0,0 +1,97 @@
+
+/************************************************************************
+*    FILE NAME:       ktx2file.h
+*
+*    DESCRIPTION:     Reads and writes KTX2 texture containers holding
+*                     pre-compressed, pre-mipped images
+*
+*    NOTE:            Only single layer, single face 2D textures without
+*                     supercompression are supported
+************************************************************************/
+
+#pragma once
+
+// Vulkan lib dependencies
+#include <system/vulkan.h>
+
+// Standard lib dependencies
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/************************************************************************
+*    Size of the texel blocks of a format
+************************************************************************/
+class CTexelBlock
+{
+public:
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t bytes = 0;
+};
+
+class CKtx2File
+{
+public:
+
+    // Constructor
+    CKtx2File();
+
+    // Destructor
+    ~CKtx2File();
+
+    // Parse the file data. The level data stays in the vector
+    void parse( std::vector<char> && dataVec, const std::string & filePath );
+
+    // Start a new file with the base level size
+    void create( VkFormat format, uint32_t width, uint32_t height );
+
+    // Add the next smaller level
+    void addLevel( const void * pData, size_t size );
+
+    // Write out the file data
+    std::vector<char> write() const;
+
+    // Get the format and the size of the base level
+    VkFormat getFormat() const;
+    uint32_t getWidth() const;
+    uint32_t getHeight() const;
+
+    // Get the level info
+    uint32_t getLevelCount() const;
+    uint32_t getLevelWidth( uint32_t level ) const;
+    uint32_t getLevelHeight( uint32_t level ) const;
+    const char * getLevelData( uint32_t level ) const;
+    size_t getLevelSize( uint32_t level ) const;
+
+    // Get the total size of the level data
+    size_t getDataSize() const;
+
+    // Get the texel block of a format. Returns false for formats that can't be in the container
+    static bool getTexelBlock( VkFormat format, CTexelBlock & texelBlock );
+
+    // Is the format block compressed
+    static bool isCompressed( VkFormat format );
+
+    // Get the size of a level of a format
+    static size_t calcLevelSize( VkFormat format, uint32_t width, uint32_t height );
+
+private:
+
+    // Write the data format descriptor of the format
+    void writeDataFormatDesc( std::vector<uint32_t> & dfdVec ) const;
+
+private:
+
+    // Format and size of the base level
+    VkFormat m_format;
+    uint32_t m_width;
+    uint32_t m_height;
+
+    // Offset and size of each level in the data vector. Level 0 is the base level
+    std::vector<std::pair<size_t, size_t>> m_levelVec;
+
+    // File data when parsed or the level data when created
+    std::vector<char> m_dataVec;
+};
@@ -10,6 +10,7 @@
 // Game lib dependencies
 #include <utilities/xmlparsehelper.h>
 #include <utilities/genfunc.h>
+#include <utilities/statcounter.h>
 
 // Standard lib dependencies
 #include <cstring>
@@ -40,6 +41,7 @@ const CPoint<float> & CObject::getPos() const
 void CObject::setPos( const CPoint<float> & position )
 {
     m_parameters.add( TRANSLATE | TRANSFORM );
+    markSubtreeDirty();
 
     m_pos = position;
 }
@@ -47,6 +49,7 @@ void CObject::setPos( const CPoint<float> & position )
 void CObject::setPos( float x, float y, float z )
 {
     m_parameters.add( TRANSLATE | TRANSFORM );
+    markSubtreeDirty();
 
     m_pos.set( x, y, z );
 }
@@ -57,6 +60,7 @@ void CObject::setPos( float x, float y, float z )
 void CObject::incPos( const CPoint<float> & position )
 {
     m_parameters.add( TRANSLATE | TRANSFORM );
+    markSubtreeDirty();
 
     m_pos += position;
 }
@@ -64,6 +68,7 @@ void CObject::incPos( const CPoint<float> & position )
 void CObject::incPos( float x, float y, float z )
 {
     m_parameters.add( TRANSLATE | TRANSFORM );
+    markSubtreeDirty();
 
     m_pos.inc( x, y, z );
 }
@@ -83,6 +88,7 @@ void CObject::invertPos()
 void CObject::setRot( const CPoint<float> & rotation, bool convertToRadians )
 {
     m_parameters.add( ROTATE | TRANSFORM );
+    markSubtreeDirty();
 
     m_rot = rotation;
     
@@ -95,6 +101,7 @@ void CObject::setRot( const CPoint<float> & rotation, bool convertToRadians )
 void CObject::setRot( float x, float y, float z, bool convertToRadians )
 {
     m_parameters.add( ROTATE | TRANSFORM );
+    markSubtreeDirty();
     
     if( convertToRadians )
         m_rot.set( x * defs_DEG_TO_RAD, y * defs_DEG_TO_RAD, z * defs_DEG_TO_RAD );
@@ -109,6 +116,7 @@ void CObject::setRot( float x, float y, float z, bool convertToRadians )
 void CObject::incRot( const CPoint<float> & rotation, bool convertToRadians )
 {
     m_parameters.add( ROTATE | TRANSFORM );
+    markSubtreeDirty();
 
     if( convertToRadians )
         m_rot += rotation * defs_DEG_TO_RAD;
@@ -121,6 +129,7 @@ void CObject::incRot( const CPoint<float> & rotation, bool convertToRadians )
 void CObject::incRot( float x, float y, float z, bool convertToRadians )
 {
     m_parameters.add( ROTATE | TRANSFORM );
+    markSubtreeDirty();
     
     if( convertToRadians )
         m_rot.inc( x * defs_DEG_TO_RAD, y * defs_DEG_TO_RAD, z * defs_DEG_TO_RAD );
@@ -143,6 +152,7 @@ const CPoint<float> & CObject::getRot() const
 void CObject::setScale( const CPoint<float> & scale )
 {
     m_parameters.add( SCALE | TRANSFORM );
+    markSubtreeDirty();
 
     m_scale = scale;
 }
@@ -150,6 +160,7 @@ void CObject::setScale( const CPoint<float> & scale )
 void CObject::setScale( float x, float y, float z )
 {
     m_parameters.add( SCALE | TRANSFORM );
+    markSubtreeDirty();
 
     m_scale.set( x, y, z );
 }
@@ -160,6 +171,7 @@ void CObject::setScale( float x, float y, float z )
 void CObject::incScale( const CPoint<float> & scale )
 {
     m_parameters.add( SCALE | TRANSFORM );
+    markSubtreeDirty();
 
     m_scale += scale;
 }
@@ -167,6 +179,7 @@ void CObject::incScale( const CPoint<float> & scale )
 void CObject::incScale( float x, float y, float z )
 {
     m_parameters.add( SCALE | TRANSFORM );
+    markSubtreeDirty();
 
     m_scale.inc( x, y, z );
 }
@@ -193,6 +206,7 @@ const CPoint<float> & CObject::getCenterPos() const
 void CObject::setCenterPos( const CPoint<float> & position )
 {
     m_parameters.add( CENTER_POINT | TRANSFORM );
+    markSubtreeDirty();
 
     m_centerPos = position;
 }
@@ -200,6 +214,7 @@ void CObject::setCenterPos( const CPoint<float> & position )
 void CObject::setCenterPos( float x, float y, float z )
 {
     m_parameters.add( CENTER_POINT | TRANSFORM );
+    markSubtreeDirty();
 
     m_centerPos.set( x, y, z );
 }
@@ -212,6 +227,7 @@ void CObject::setCropOffset( const CSize<int16_t> & offset )
     if( !m_centerPos.isEmpty() || !offset.isEmpty() )
     {
         m_parameters.add( CROP_OFFSET | TRANSFORM );
+        markSubtreeDirty();
 
         m_cropOffset = offset;
     }
@@ -342,6 +358,7 @@ void CObject::transformLocal( CMatrix & matrix )
 void CObject::transform()
 {
     m_parameters.remove( WAS_TRANSFORMED );
+    m_pTransformParent = nullptr;
     
     if( m_parameters.isSet( TRANSFORM ) )
     {
@@ -349,11 +366,14 @@ void CObject::transform()
     
         m_transPos = m_pos;
     }
+
+    CStatCounter::Instance().countTransform( wasTranformed() );
 }
 
 void CObject::transform( const CObject & object )
 {
     m_parameters.remove( WAS_TRANSFORMED );
+    m_pTransformParent = &object;
     
     if( m_parameters.isSet( TRANSFORM ) || object.wasTranformed() )
     {
@@ -365,6 +385,8 @@ void CObject::transform( const CObject & object )
 
         m_matrix.transform( m_transPos, CPoint<float>() );
     }
+
+    CStatCounter::Instance().countTransform( wasTranformed() );
 }
 
 /************************************************************************
@@ -427,6 +449,48 @@ bool CObject::wasTranformed() const
 void CObject::forceTransform()
 {
     m_parameters.add( TRANSFORM );
+    markSubtreeDirty();
+}
+
+/************************************************************************
+*    DESC:  Does the object or any of its children need to be visited by the transform
+************************************************************************/
+bool CObject::isSubtreeDirty() const
+{
+    return (m_subtreeDirty.load( std::memory_order_relaxed ) > 0);
+}
+
+/************************************************************************
+*    DESC:  Flag the object and the objects above it so the transform visits them
+*
+*    NOTE:  The objects above are the ones that last transformed this one.
+*           An object is only linked after its first transform, which
+*           is why new objects start out dirty.
+************************************************************************/
+void CObject::markSubtreeDirty() const
+{
+    for( const CObject * pObject = this; pObject != nullptr; pObject = pObject->m_pTransformParent )
+        pObject->m_subtreeDirty.store( SUBTREE_DIRTY_VISITS, std::memory_order_relaxed );
+}
+
+/************************************************************************
+*    DESC:  Count down the visits after the transform visited the object and its children
+*
+*    NOTE:  A transformed object leaves its children with WAS_TRANSFORMED
+*           set so it needs one more visit to clear them.
+************************************************************************/
+void CObject::subtreeVisited()
+{
+    // Only the transform calls this so the relaxed load and store don't need to be one step
+    uint8_t dirty = m_subtreeDirty.load( std::memory_order_relaxed );
+
+    if( dirty > 0 )
+        --dirty;
+
+    if( wasTranformed() && (dirty == 0) )
+        dirty = 1;
+
+    m_subtreeDirty.store( dirty, std::memory_order_relaxed );
 }
 
 /************************************************************************
@@ -16,6 +16,7 @@
 
 // Standard lib dependencies
 #include <cstdint>
+#include <atomic>
 #include <string>
 #include <map>
 #include <tuple>
@@ -152,6 +153,16 @@ public: // transform related members
 
     // Force the transform
     void forceTransform();
+
+    // Does the object or any of its children need to be visited by the transform
+    bool isSubtreeDirty() const;
+
+    // Flag the object and the objects above it so the transform visits them
+    void markSubtreeDirty() const;
+
+    // Call after the transform visited the object and its children
+    // NOTE: Only the code that skips clean objects needs to call this
+    void subtreeVisited();
     
     // Get the object's translated position
     const CPoint<float> & getTransPos() const;
@@ -216,6 +227,15 @@ protected:
     // Translated position
     CPoint<float> m_transPos;
 
+    // Object that last transformed this one. Used to pass the dirty flag up the hierarchy
+    const CObject * m_pTransformParent = nullptr;
+
+    // Number of transforms that still need to visit this object and its children
+    // NOTE: One to transform and one to clear the WAS_TRANSFORMED flags it leaves behind.
+    //       Atomic because sprites updated in parallel script lanes can share a parent.
+    static constexpr uint8_t SUBTREE_DIRTY_VISITS = 2;
+    mutable std::atomic<uint8_t> m_subtreeDirty{SUBTREE_DIRTY_VISITS};
+
 protected: // transform related members
 
     // local matrix
@@ -9,6 +9,8 @@
 
 // Game lib dependencies
 #include <common/size.h>
+#include <system/memoryallocator.h>
+#include <system/samplercache.h>
 
 // Standard lib dependencies
 #include <vector>
@@ -34,18 +36,27 @@ public:
     // Mip levels
     uint32_t mipLevels = 1;
 
+    // Array layers. More than one if the frames of an animation are in a texture array
+    uint32_t layerCount = 1;
+
+    // Image format. Block compressed if loaded from a pre-compressed KTX2 file
+    VkFormat format = VK_FORMAT_R8G8B8A8_UNORM;
+
     // Texture image handle
     VkImage textureImage = VK_NULL_HANDLE;
 
-    // Texture memory handle
-    VkDeviceMemory textureImageMemory = VK_NULL_HANDLE;
+    // Texture memory sub-allocated from the device memory blocks
+    CMemoryAllocation textureImageAllocation;
 
     // Texture Image View
     VkImageView textureImageView = VK_NULL_HANDLE;
 
-    // Texture shader sampler
+    // Texture shader sampler. Shared with the textures using the same sampler settings.
     VkSampler textureSampler = VK_NULL_HANDLE;
 
+    // Cache the sampler came from
+    CSamplerCache * pSamplerCache = nullptr;
+
     // Texture size - mostly needed for 2D
     CSize<int32_t> size;
     
@@ -95,6 +106,8 @@ public:
     {
         textFilePath.clear();
         mipLevels = 1;
+        layerCount = 1;
+        format = VK_FORMAT_R8G8B8A8_UNORM;
         size.clear();
 
         if( textureImage != VK_NULL_HANDLE )
@@ -103,11 +116,8 @@ public:
             textureImage = VK_NULL_HANDLE;
         }
 
-        if( textureImageMemory != VK_NULL_HANDLE )
-        {
-            vkFreeMemory( logicalDevice, textureImageMemory, nullptr );
-            textureImageMemory = VK_NULL_HANDLE;
-        }
+        // Return the memory to the allocator
+        textureImageAllocation.free();
 
         if( textureImageView != VK_NULL_HANDLE )
         {
@@ -115,10 +125,16 @@ public:
             textureImageView = VK_NULL_HANDLE;
         }
 
+        // Return the sampler to the cache
         if( textureSampler != VK_NULL_HANDLE )
         {
-            vkDestroySampler( logicalDevice, textureSampler, nullptr );
+            if( pSamplerCache != nullptr )
+                pSamplerCache->release( textureSampler );
+            else
+                vkDestroySampler( logicalDevice, textureSampler, nullptr );
+
             textureSampler = VK_NULL_HANDLE;
+            pSamplerCache = nullptr;
         }
     }
 };
@@ -29,7 +29,7 @@ namespace NVertex
             bindingDescription.stride = sizeof(vert_uv_normal);
             bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
         }
-        else if( bindingDes == "vert_uv" )
+        else if( (bindingDes == "vert_uv") || (bindingDes == "vert_uv_instance") )
         {
             bindingDescription.stride = sizeof(vert_uv);
             bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
@@ -49,6 +49,23 @@ namespace NVertex
         return bindingDescription;
     }
 
+    /************************************************************************
+    *    DESC:  Get the per instance input binding description
+    ************************************************************************/ 
+    VkVertexInputBindingDescription getInstanceBindingDesc( const std::string & bindingDes )
+    {
+        VkVertexInputBindingDescription bindingDescription = {};
+        bindingDescription.binding = 1;
+
+        if( bindingDes == "vert_uv_instance" )
+        {
+            bindingDescription.stride = sizeof(quad_instance);
+            bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+        }
+
+        return bindingDescription;
+    }
+
     /************************************************************************
     *    DESC:  Get the vertex input attribute description
     ************************************************************************/ 
@@ -85,7 +102,7 @@ namespace NVertex
                 attrDescVec.push_back( attrDesc );
             }
         }
-        else if( vertAttrDes == "vert_uv" )
+        else if( (vertAttrDes == "vert_uv") || (vertAttrDes == "vert_uv_instance") )
         {
             {
                 VkVertexInputAttributeDescription attrDesc = {};
@@ -104,6 +121,47 @@ namespace NVertex
                 attrDesc.offset = offsetof(vert_uv, uv);
                 attrDescVec.push_back( attrDesc );
             }
+
+            if( vertAttrDes == "vert_uv_instance" )
+            {
+                // The matrix takes up 4 locations, one for each column
+                for( uint32_t i = 0; i < 4; ++i )
+                {
+                    VkVertexInputAttributeDescription attrDesc = {};
+                    attrDesc.binding = 1;
+                    attrDesc.location = 2 + i;
+                    attrDesc.format = VK_FORMAT_R32G32B32A32_SFLOAT;
+                    attrDesc.offset = offsetof(quad_instance, matrix) + (sizeof(float) * 4 * i);
+                    attrDescVec.push_back( attrDesc );
+                }
+
+                {
+                    VkVertexInputAttributeDescription attrDesc = {};
+                    attrDesc.binding = 1;
+                    attrDesc.location = 6;
+                    attrDesc.format = VK_FORMAT_R32G32B32A32_SFLOAT;
+                    attrDesc.offset = offsetof(quad_instance, color);
+                    attrDescVec.push_back( attrDesc );
+                }
+
+                {
+                    VkVertexInputAttributeDescription attrDesc = {};
+                    attrDesc.binding = 1;
+                    attrDesc.location = 7;
+                    attrDesc.format = VK_FORMAT_R32G32B32A32_SFLOAT;
+                    attrDesc.offset = offsetof(quad_instance, additive);
+                    attrDescVec.push_back( attrDesc );
+                }
+
+                {
+                    VkVertexInputAttributeDescription attrDesc = {};
+                    attrDesc.binding = 1;
+                    attrDesc.location = 8;
+                    attrDesc.format = VK_FORMAT_R32G32B32A32_SFLOAT;
+                    attrDesc.offset = offsetof(quad_instance, uvRect);
+                    attrDescVec.push_back( attrDesc );
+                }
+            }
         }
         else if( vertAttrDes == "vert" )
         {
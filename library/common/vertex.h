@@ -10,6 +10,9 @@
 #include <common/point.h>
 #include <common/uv.h>
 #include <common/normal.h>
+#include <common/color.h>
+#include <common/rect.h>
+#include <utilities/matrix.h>
 
 // Standard lib dependencies
 #include <string>
@@ -53,9 +56,30 @@ namespace NVertex
         CNormal<float> norm;
     };
 
+    // Per instance data of an instanced quad
+    class quad_instance
+    {
+    public:
+
+        // Model, view and projection matrix
+        CMatrix matrix;
+
+        // Color
+        CColor color;
+
+        // Additive color
+        CColor additive;
+
+        // UV offset and size of the texture region. Set for quads packed into a texture atlas
+        CRect<float> uvRect;
+    };
+
     // Get the vertex input binding binding description
     VkVertexInputBindingDescription getBindingDesc( const std::string & bindingDes );
 
+    // Get the per instance input binding description. Stride is zero if not instanced
+    VkVertexInputBindingDescription getInstanceBindingDesc( const std::string & bindingDes );
+
     // Get the vertex input attribute description
     std::vector<VkVertexInputAttributeDescription> getAttributeDesc( const std::string & vertAttrDes );
 }
@@ -13,6 +13,7 @@
 #include <utilities/exceptionhandling.h>
 #include <utilities/genfunc.h>
 #include <utilities/settings.h>
+#include <utilities/statcounter.h>
 #include <gui/menutree.h>
 #include <gui/menu.h>
 #include <gui/scrollparam.h>
@@ -864,6 +865,8 @@ void CMenuMgr::transform( const std::vector<CMenuTree *> & activeTreeVec )
         if( iter->isActive() )
             iter->transform();
     }
+
+    CStatCounter::Instance().publishTransformCounters();
 }
 
 /***************************************************************************
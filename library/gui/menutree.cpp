@@ -80,14 +80,29 @@ void CMenuTree::update()
 ************************************************************************/
 void CMenuTree::transform()
 {
+    // Menus with nothing changed in them are skipped
     for( auto iter : m_pMenuPathVec )
-        iter->transform();
+    {
+        if( iter->isSubtreeDirty() )
+        {
+            iter->transform();
+            iter->subtreeVisited();
+        }
+    }
 }
 
 void CMenuTree::transform( const CObject & object )
 {
+    const bool parentTransformed = object.wasTranformed();
+
     for( auto iter : m_pMenuPathVec )
-        iter->transform( object );
+    {
+        if( parentTransformed || iter->isSubtreeDirty() )
+        {
+            iter->transform( object );
+            iter->subtreeVisited();
+        }
+    }
 }
 
 /***************************************************************************
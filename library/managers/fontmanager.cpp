@@ -111,6 +111,9 @@ void CFontMgr::deleteTheFont( const std::string & key )
     // If it's found, delete from the map
     if( iter != m_fontMap.end() )
         m_fontMap.erase( iter );
+
+    // Layouts hold the character data of the deleted font
+    clearLayoutCache();
 }
 
 
@@ -121,3 +124,46 @@ const std::string & CFontMgr::getGroup() const
 {
     return m_group;
 }
+
+
+/************************************************************************
+*    DESC:  Find a cached font layout. Returns nullptr if not found
+************************************************************************/
+std::shared_ptr<const CFontLayout> CFontMgr::findLayout( const CFontLayoutKey & key )
+{
+    std::unique_lock<std::mutex> lock( m_layoutMutex );
+
+    auto iter = m_layoutCacheMap.find( key );
+    if( iter != m_layoutCacheMap.end() )
+        return iter->second;
+
+    return nullptr;
+}
+
+
+/************************************************************************
+*    DESC:  Add a font layout to the cache
+*
+*    NOTE:  The cache is just cleared when full. Font strings hold their
+*           own reference so this doesn't effect anything being displayed
+************************************************************************/
+void CFontMgr::addLayout( const CFontLayoutKey & key, std::shared_ptr<const CFontLayout> spLayout )
+{
+    std::unique_lock<std::mutex> lock( m_layoutMutex );
+
+    if( m_layoutCacheMap.size() >= MAX_LAYOUT_CACHE_SIZE )
+        m_layoutCacheMap.clear();
+
+    m_layoutCacheMap.emplace( key, spLayout );
+}
+
+
+/************************************************************************
+*    DESC:  Clear the font layout cache
+************************************************************************/
+void CFontMgr::clearLayoutCache()
+{
+    std::unique_lock<std::mutex> lock( m_layoutMutex );
+
+    m_layoutCacheMap.clear();
+}
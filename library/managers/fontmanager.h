@@ -9,10 +9,63 @@
 
 // Game lib dependencies
 #include <2d/font.h>
+#include <common/fontproperties.h>
+#include <common/quad2d.h>
+#include <common/size.h>
 
 // Standard lib dependencies
 #include <string>
 #include <map>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+/************************************************************************
+*    Glyph quads and size of a laid out font string
+************************************************************************/
+class CFontLayout
+{
+public:
+
+    // Glyph quads. Spaces and line breaks don't have one
+    std::vector<CQuad2D> m_quadVec;
+
+    // Size of the font string
+    CSize<float> m_fontStrSize;
+};
+
+/************************************************************************
+*    What a font layout depends on
+************************************************************************/
+class CFontLayoutKey
+{
+public:
+
+    bool operator < ( const CFontLayoutKey & obj ) const
+    {
+        return std::tie( m_fontString, m_fontProp.m_fontName, m_fontProp.m_hAlign, m_fontProp.m_vAlign,
+                         m_fontProp.m_kerning, m_fontProp.m_spaceCharKerning, m_fontProp.m_lineWrapWidth, m_fontProp.m_lineWrapHeight ) <
+               std::tie( obj.m_fontString, obj.m_fontProp.m_fontName, obj.m_fontProp.m_hAlign, obj.m_fontProp.m_vAlign,
+                         obj.m_fontProp.m_kerning, obj.m_fontProp.m_spaceCharKerning, obj.m_fontProp.m_lineWrapWidth, obj.m_fontProp.m_lineWrapHeight );
+    }
+
+    bool operator == ( const CFontLayoutKey & obj ) const
+    {
+        return !(*this < obj) && !(obj < *this);
+    }
+
+    bool operator != ( const CFontLayoutKey & obj ) const
+    {
+        return !(*this == obj);
+    }
+
+    // Displayed font string
+    std::string m_fontString;
+
+    // Font and the properties that effect the layout
+    CFontProperties m_fontProp;
+};
 
 class CFontMgr
 {
@@ -40,6 +93,15 @@ public:
     // Get the group name
     const std::string & getGroup() const;
 
+    // Find a cached font layout. Returns nullptr if not found
+    std::shared_ptr<const CFontLayout> findLayout( const CFontLayoutKey & key );
+
+    // Add a font layout to the cache
+    void addLayout( const CFontLayoutKey & key, std::shared_ptr<const CFontLayout> spLayout );
+
+    // Clear the font layout cache
+    void clearLayoutCache();
+
 private:
 
     CFontMgr();
@@ -52,4 +114,13 @@ private:
 
     // Group name
     std::string m_group;
+
+    // Font layouts shared by all the font strings displaying the same text
+    std::map<const CFontLayoutKey, std::shared_ptr<const CFontLayout>> m_layoutCacheMap;
+
+    // Font strings can be created from the load threads
+    std::mutex m_layoutMutex;
+
+    // Max number of cached font layouts
+    static constexpr size_t MAX_LAYOUT_CACHE_SIZE = 512;
 };
@@ -0,0 +1,123 @@
+
+/************************************************************************
+*    FILE NAME:       textureatlasmanager.cpp
+*
+*    DESCRIPTION:     Temporary container for the texture atlas of the
+*                     group being loaded. Maps the textures packed by the
+*                     atlas packer tool to their region of the atlas.
+************************************************************************/
+
+// Physical component dependency
+#include <managers/textureatlasmanager.h>
+
+// Game lib dependencies
+#include <utilities/xmlParser.h>
+#include <utilities/exceptionhandling.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
+
+// Standard lib dependencies
+#include <cstdlib>
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CTextureAtlasMgr::CTextureAtlasMgr() :
+    m_atlasCount(0),
+    m_atlasArea(0),
+    m_regionArea(0)
+{
+}
+
+
+/************************************************************************
+*    DESC:  destructor
+************************************************************************/
+CTextureAtlasMgr::~CTextureAtlasMgr()
+{
+}
+
+
+/************************************************************************
+*    DESC:  Load the atlas regions from XML file
+************************************************************************/
+void CTextureAtlasMgr::load( const std::string & filePath )
+{
+    // Open and parse the XML file:
+    const XMLNode node = XMLNode::openFileHelper( filePath.c_str(), "textureAtlas" );
+
+    for( int i = 0; i < node.nChildNode("atlas"); ++i )
+    {
+        const XMLNode atlasNode = node.getChildNode( "atlas", i );
+
+        const std::string atlasFilePath = atlasNode.getAttribute( "file" );
+        const CSize<int> atlasSize( std::atoi( atlasNode.getAttribute( "width" ) ), std::atoi( atlasNode.getAttribute( "height" ) ) );
+
+        if( atlasSize.isEmpty() )
+            throw NExcept::CCriticalException("Texture Atlas Load Error!",
+                boost::str( boost::format("Atlas size not set (%s - %s).\n\n%s\nLine: %s")
+                    % filePath % atlasFilePath % __FUNCTION__ % __LINE__ ));
+
+        ++m_atlasCount;
+        m_atlasArea += (int64_t)atlasSize.w * atlasSize.h;
+
+        for( int j = 0; j < atlasNode.nChildNode("region"); ++j )
+        {
+            const XMLNode regionNode = atlasNode.getChildNode( "region", j );
+
+            CAtlasRegion region;
+            region.m_atlasFilePath = atlasFilePath;
+            region.m_x = std::atoi( regionNode.getAttribute( "x" ) );
+            region.m_y = std::atoi( regionNode.getAttribute( "y" ) );
+            region.m_size.w = std::atoi( regionNode.getAttribute( "width" ) );
+            region.m_size.h = std::atoi( regionNode.getAttribute( "height" ) );
+
+            region.m_uvRect.x1 = (float)region.m_x / (float)atlasSize.w;
+            region.m_uvRect.y1 = (float)region.m_y / (float)atlasSize.h;
+            region.m_uvRect.x2 = (float)region.m_size.w / (float)atlasSize.w;
+            region.m_uvRect.y2 = (float)region.m_size.h / (float)atlasSize.h;
+
+            m_regionArea += (int64_t)region.m_size.w * region.m_size.h;
+
+            m_regionMap.emplace( regionNode.getAttribute( "file" ), region );
+        }
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Find the region of a texture
+************************************************************************/
+const CAtlasRegion * CTextureAtlasMgr::findRegion( const std::string & textureFilePath ) const
+{
+    auto iter = m_regionMap.find( textureFilePath );
+    if( iter != m_regionMap.end() )
+        return &iter->second;
+
+    return nullptr;
+}
+
+
+/************************************************************************
+*    DESC:  Get the atlas statistics as a string for debug output
+************************************************************************/
+std::string CTextureAtlasMgr::getStatsStr() const
+{
+    return boost::str( boost::format("textures: %d - atlases: %d - fill: %.1f%%")
+        % m_regionMap.size()
+        % m_atlasCount
+        % ((m_atlasArea > 0) ? (100.0 * m_regionArea / m_atlasArea) : 0.0) );
+}
+
+
+/************************************************************************
+*    DESC:  Clear all the atlas data
+************************************************************************/
+void CTextureAtlasMgr::clear()
+{
+    m_regionMap.clear();
+    m_atlasCount = 0;
+    m_atlasArea = 0;
+    m_regionArea = 0;
+}
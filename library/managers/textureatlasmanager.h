@@ -0,0 +1,80 @@
+
+/************************************************************************
+*    FILE NAME:       textureatlasmanager.h
+*
+*    DESCRIPTION:     Temporary container for the texture atlas of the
+*                     group being loaded. Maps the textures packed by the
+*                     atlas packer tool to their region of the atlas.
+************************************************************************/
+
+#pragma once
+
+// Game lib dependencies
+#include <common/size.h>
+#include <common/rect.h>
+
+// Standard lib dependencies
+#include <string>
+#include <map>
+#include <cstdint>
+
+/************************************************************************
+*    Region of an atlas a texture was packed into
+************************************************************************/
+class CAtlasRegion
+{
+public:
+
+    // Atlas image file
+    std::string m_atlasFilePath;
+
+    // Pixel position and size of the region in the atlas
+    int m_x = 0;
+    int m_y = 0;
+    CSize<int> m_size;
+
+    // Region as an offset and size in UV space. Same layout as the sprite sheet glyph UV.
+    CRect<float> m_uvRect;
+};
+
+class CTextureAtlasMgr
+{
+public:
+
+    // Get the instance of the singleton class
+    static CTextureAtlasMgr & Instance()
+    {
+        static CTextureAtlasMgr textureAtlasMgr;
+        return textureAtlasMgr;
+    }
+
+    // Load the atlas regions from XML file
+    void load( const std::string & filePath );
+
+    // Find the region of a texture. nullptr if it wasn't packed
+    const CAtlasRegion * findRegion( const std::string & textureFilePath ) const;
+
+    // Get the atlas statistics as a string for debug output
+    std::string getStatsStr() const;
+
+    // Clear all the atlas data
+    void clear();
+
+private:
+
+    // Constructor
+    CTextureAtlasMgr();
+
+    // Destructor
+    ~CTextureAtlasMgr();
+
+private:
+
+    // Map of regions keyed by the file path of the packed texture
+    std::map< const std::string, CAtlasRegion > m_regionMap;
+
+    // Number of atlases and the area of the atlases and of the regions in them
+    int m_atlasCount;
+    int64_t m_atlasArea;
+    int64_t m_regionArea;
+};
@@ -85,6 +85,8 @@ void CRenderNode::transform( iNode * pNode )
     {
         iNode * pNextNode;
         auto nodeIter = pNode->getNodeIter();
+        const CObject & rParent = *pNode->getObject();
+        const bool parentTransformed = rParent.wasTranformed();
 
         do
         {
@@ -93,15 +95,24 @@ void CRenderNode::transform( iNode * pNode )
 
             if( pNextNode != nullptr )
             {
-                // Transform the object
-                if( pNextNode->getType() == ENodeType::UI_CONTROL )
-                    pNextNode->getControl()->transform( *pNode->getObject() );
-                    
-                else
-                    pNextNode->getObject()->transform( *pNode->getObject() );
+                CObject * pObject = pNextNode->getObject();
 
-                // Call a recursive function again
-                transform( pNextNode );
+                // Skip the node and its children if nothing changed
+                if( parentTransformed || pObject->isSubtreeDirty() )
+                {
+                    // Transform the object
+                    // NOTE: Qualified call so a node's override doesn't transform its children a second time
+                    if( pNextNode->getType() == ENodeType::UI_CONTROL )
+                        pNextNode->getControl()->transform( rParent );
+
+                    else
+                        pObject->CObject::transform( rParent );
+
+                    // Call a recursive function again
+                    transform( pNextNode );
+
+                    pObject->subtreeVisited();
+                }
             }
         }
         while( pNextNode != nullptr );
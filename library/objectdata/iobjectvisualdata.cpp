@@ -13,6 +13,7 @@ CColor iObjectVisualData::m_null_color;
 CMemoryBuffer iObjectVisualData::m_null_memoryBuffer;
 CSpriteSheet iObjectVisualData::m_null_spriteSheet;
 CModel iObjectVisualData::m_null_model;
+CRect<float> iObjectVisualData::m_unit_uvRect( 0.f, 0.f, 1.f, 1.f );
 
 // Constructor / Destructor
 iObjectVisualData::iObjectVisualData()
@@ -10,6 +10,7 @@
 // Game lib dependencies
 #include <common/defs.h>
 #include <common/color.h>
+#include <common/rect.h>
 #include <common/texture.h>
 #include <common/model.h>
 #include <sprite/spritesheet.h>
@@ -58,6 +59,14 @@ public:
     virtual const CMemoryBuffer & getVBO() const
     { return m_null_memoryBuffer; }
 
+    // Get the VBO of a frame. Only differs from the VBO if the frames have their own UVs
+    virtual const CMemoryBuffer & getFrameVBO( uint index = 0 ) const
+    { return getVBO(); }
+
+    // Get the UV rect of a frame as an offset and size
+    virtual const CRect<float> & getUVRect( uint index = 0 ) const
+    { return m_unit_uvRect; }
+
     // Get the IBO
     virtual const CMemoryBuffer & getIBO() const
     { return m_null_memoryBuffer; }
@@ -81,6 +90,14 @@ public:
     // Access functions for the default uniform scale
     virtual float getDefaultUniformScale() const
     { return 0.f; }
+
+    // Can this object be batched into instanced draws
+    virtual bool allowBatching() const
+    { return false; }
+
+    // Are the frames the layers of a texture array
+    virtual bool isTextureArray() const
+    { return false; }
     
     // Get the mesh3d vector
     virtual const CModel & getModel() const
@@ -93,4 +110,5 @@ private:
     static CMemoryBuffer m_null_memoryBuffer;
     static CSpriteSheet m_null_spriteSheet;
     static CModel m_null_model;
+    static CRect<float> m_unit_uvRect;
 };
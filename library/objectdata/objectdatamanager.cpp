@@ -15,10 +15,14 @@
 #include <objectdata/objectdata2d.h>
 #include <objectdata/objectdata3d.h>
 #include <managers/spritesheetmanager.h>
+#include <managers/textureatlasmanager.h>
 #include <system/device.h>
+#include <utilities/threadpool.h>
+#include <utilities/genfunc.h>
 
 // Standard lib dependencies
 #include <string>
+#include <algorithm>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
@@ -47,6 +51,8 @@ CObjectDataMgr::~CObjectDataMgr()
  ************************************************************************/
 const iObjectData & CObjectDataMgr::getData( const std::string & group, const std::string & name ) const
 {
+    std::unique_lock<std::mutex> lock( m_mutex );
+
     auto mapIter = m_objectDataMapMap.find( group );
     if( mapIter == m_objectDataMapMap.end() )
         throw NExcept::CCriticalException("Obj Data List Get Data Error!",
@@ -79,6 +85,208 @@ void CObjectDataMgr::loadGroupAry( const CScriptArray & strategyIdAry )
 }
 
 void CObjectDataMgr::loadGroup( const std::string & group )
+{
+    const auto & fileVec = getGroupFileList( group );
+
+    // Make sure the group isn't loaded or being loaded in the background
+    {
+        std::unique_lock<std::mutex> lock( m_mutex );
+
+        if( (m_objectDataMapMap.find( group ) != m_objectDataMapMap.end()) ||
+            (m_loadProgressMap.find( group ) != m_loadProgressMap.end()) )
+            throw NExcept::CCriticalException("Obj Data List group load Error!",
+                boost::str( boost::format("Object data list group has already been loaded (%s).\n\n%s\nLine: %s")
+                    % group % __FUNCTION__ % __LINE__ ));
+    }
+
+    // Build the group map on the side and add it once everything is created
+    std::map<const std::string, std::unique_ptr<iObjectData>> groupMap;
+
+    {
+        std::unique_lock<std::mutex> lock( m_parseMutex );
+
+        loadTextureAtlas( group );
+
+        for( auto & iter : fileVec )
+            load( group, iter, groupMap );
+
+        CTextureAtlasMgr::Instance().clear();
+    }
+
+    {
+        // Submit the group's uploads together
+        CUploadBatchScope uploadBatch( CDevice::Instance() );
+
+        createFromData( group, groupMap );
+
+        uploadBatch.end();
+    }
+
+    NGenFunc::PostDebugMsg( boost::str( boost::format("Group loaded: %s, %s") % group % CDevice::Instance().getSamplerStatsStr() ) );
+
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_objectDataMapMap.emplace( group, std::move(groupMap) );
+}
+
+
+/************************************************************************
+ *    DESC:  Load a group on the worker threads
+ *           The xml is parsed on a worker and the objects' textures and
+ *           buffers are decoded and uploaded in parallel. The group is
+ *           only added to the object data map once all of it is created.
+ ************************************************************************/
+void CObjectDataMgr::loadGroupAsync( const std::string & group, int completeEvent )
+{
+    // Make sure the group is in the list table before handing it off
+    getGroupFileList( group );
+
+    std::shared_ptr<CGroupLoadProgress> spProgress( new CGroupLoadProgress );
+
+    {
+        std::unique_lock<std::mutex> lock( m_mutex );
+
+        if( (m_objectDataMapMap.find( group ) != m_objectDataMapMap.end()) ||
+            (m_loadProgressMap.find( group ) != m_loadProgressMap.end()) )
+            throw NExcept::CCriticalException("Obj Data List group load Error!",
+                boost::str( boost::format("Object data list group has already been loaded (%s).\n\n%s\nLine: %s")
+                    % group % __FUNCTION__ % __LINE__ ));
+
+        m_loadProgressMap.emplace( group, spProgress );
+    }
+
+    // Loads run in the background queue so the frame's job waits never stall on them
+    CThreadPool::Instance().postBackground( [this, group, completeEvent, spProgress]()
+        { loadGroupJob( group, completeEvent, spProgress ); } );
+}
+
+
+/************************************************************************
+ *    DESC:  Load the group on a worker thread
+ ************************************************************************/
+void CObjectDataMgr::loadGroupJob( const std::string & group, int completeEvent, std::shared_ptr<CGroupLoadProgress> spProgress )
+{
+    try
+    {
+        std::map<const std::string, std::unique_ptr<iObjectData>> groupMap;
+
+        {
+            std::unique_lock<std::mutex> lock( m_parseMutex );
+
+            loadTextureAtlas( group );
+
+            for( auto & iter : getGroupFileList( group ) )
+                load( group, iter, groupMap );
+
+            CTextureAtlasMgr::Instance().clear();
+        }
+
+        // Decoding the images is the slow part so the objects are split up over the workers
+        std::vector<iObjectData *> objectVec;
+        objectVec.reserve( groupMap.size() );
+
+        for( auto & iter : groupMap )
+            objectVec.push_back( iter.second.get() );
+
+        spProgress->m_objectCount = static_cast<int>(objectVec.size());
+
+        // A few chunks per worker keeps them all busy while still batching the uploads of each chunk
+        const size_t grainSize = std::max<size_t>( 1, objectVec.size() / ((CThreadPool::Instance().threadCount() + 1) * 4) );
+
+        CThreadPool::Instance().parallelFor( objectVec.size(), grainSize,
+            [&objectVec, &group, &spProgress]( size_t begin, size_t end )
+            {
+                // Submit the uploads of the chunk together
+                CUploadBatchScope uploadBatch( CDevice::Instance() );
+
+                for( size_t i = begin; i < end; ++i )
+                {
+                    objectVec[i]->createFromData( group );
+                    ++spProgress->m_createdCount;
+                }
+
+                // A failed submit is thrown to parallelFor which hands it to the load's error
+                uploadBatch.end();
+            });
+
+        NGenFunc::PostDebugMsg( boost::str( boost::format("Group loaded: %s, %s") % group % CDevice::Instance().getSamplerStatsStr() ) );
+
+        std::unique_lock<std::mutex> lock( m_mutex );
+        m_objectDataMapMap.emplace( group, std::move(groupMap) );
+        m_loadProgressMap.erase( group );
+    }
+    catch( NExcept::CCriticalException & ex )
+    {
+        spProgress->m_errorTitle = ex.getErrorTitle();
+        spProgress->m_errorMsg = ex.getErrorMsg();
+    }
+    catch( std::exception const & ex )
+    {
+        spProgress->m_errorTitle = "Obj Data List Async Load Error!";
+        spProgress->m_errorMsg = ex.what();
+    }
+
+    // NOTE: What was created before an error is freed by freeGroup or getLoadProgress on the
+    //       main thread. The device's delete queue and descriptor sets can't be touched from here.
+    const bool failed = !spProgress->m_errorMsg.empty();
+    spProgress->m_done = true;
+
+    if( failed )
+        NGenFunc::PostDebugMsg( boost::str( boost::format("Group load failed: %s, %s") % group % spProgress->m_errorMsg ) );
+
+    if( completeEvent != 0 )
+        NGenFunc::DispatchEvent( completeEvent, (failed ? EGL_FAILED : EGL_LOADED) );
+}
+
+
+/************************************************************************
+ *    DESC:  Get the load progress of a group from 0 to 1
+ ************************************************************************/
+float CObjectDataMgr::getLoadProgress( const std::string & group )
+{
+    std::shared_ptr<CGroupLoadProgress> spProgress;
+
+    {
+        std::unique_lock<std::mutex> lock( m_mutex );
+
+        if( m_objectDataMapMap.find( group ) != m_objectDataMapMap.end() )
+            return 1.f;
+
+        auto iter = m_loadProgressMap.find( group );
+        if( iter == m_loadProgressMap.end() )
+            return 0.f;
+
+        spProgress = iter->second;
+
+        // Add one to the count so 1 is only returned once the group is in the map
+        if( !spProgress->m_done || spProgress->m_errorMsg.empty() )
+            return (float)spProgress->m_createdCount / (float)(spProgress->m_objectCount + 1);
+
+        // Allow the group to be loaded again
+        m_loadProgressMap.erase( iter );
+    }
+
+    // Free what the failed load created before the error and report it
+    CDevice::Instance().deleteGroupAssets( group );
+
+    throw NExcept::CCriticalException( spProgress->m_errorTitle, spProgress->m_errorMsg );
+}
+
+
+/************************************************************************
+ *    DESC:  Is the group loaded
+ ************************************************************************/
+bool CObjectDataMgr::isGroupLoaded( const std::string & group )
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+
+    return (m_objectDataMapMap.find( group ) != m_objectDataMapMap.end());
+}
+
+
+/************************************************************************
+ *    DESC:  Get the list table entry of the group
+ ************************************************************************/
+const std::vector<std::string> & CObjectDataMgr::getGroupFileList( const std::string & group )
 {
     // Check for a hardware extension
     std::string ext;
@@ -93,20 +301,44 @@ void CObjectDataMgr::loadGroup( const std::string & group )
             boost::str( boost::format("Object data list group name can't be found (%s).\n\n%s\nLine: %s")
                 % group % __FUNCTION__ % __LINE__ ));
 
-    // Load the group data if it doesn't already exist
-    if( m_objectDataMapMap.find( group ) == m_objectDataMapMap.end() )
-    {
-        // Create a new group map inside of our map
-        m_objectDataMapMap.emplace( group, std::map<const std::string, std::unique_ptr<iObjectData>>() );
+    return listTableIter->second;
+}
+
 
-        for( auto & iter : listTableIter->second )
-            load( group, iter );
+/************************************************************************
+ *    DESC:  Derived class loading of class specific data
+ *           NOTE: Saves the texture atlas file made by the atlas packer
+ ************************************************************************/
+void CObjectDataMgr::loadUniqueData( const XMLNode & node, const std::string & group )
+{
+    if( node.isAttributeSet("textureAtlas") )
+    {
+        std::string atlasFilePath = node.getAttribute("textureAtlas");
+        if( !atlasFilePath.empty() )
+            m_atlasFileMap.emplace( group, atlasFilePath );
     }
-    else
+}
+
+
+/************************************************************************
+ *    DESC:  Load the texture atlas of the group if it has one
+ *           NOTE: The atlas manager is shared so this is called under the parse lock
+ ************************************************************************/
+void CObjectDataMgr::loadTextureAtlas( const std::string & group )
+{
+    // Check for a hardware extension
+    std::string ext;
+    if( !m_mobileExt.empty() && CSettings::Instance().isMobileDevice() )
+        if( m_listTableMap.find( group + m_mobileExt ) != m_listTableMap.end() )
+            ext = m_mobileExt;
+
+    auto iter = m_atlasFileMap.find( group + ext );
+    if( iter != m_atlasFileMap.end() )
     {
-        throw NExcept::CCriticalException("Obj Data List group load Error!",
-            boost::str( boost::format("Object data list group has already been loaded (%s).\n\n%s\nLine: %s")
-                % group % __FUNCTION__ % __LINE__ ));
+        CTextureAtlasMgr::Instance().load( iter->second );
+
+        NGenFunc::PostDebugMsg( boost::str( boost::format("Texture atlas (%s): %s")
+            % group % CTextureAtlasMgr::Instance().getStatsStr() ) );
     }
 }
 
@@ -114,7 +346,10 @@ void CObjectDataMgr::loadGroup( const std::string & group )
 /************************************************************************
  *    DESC:  Load all object information
  ************************************************************************/
-void CObjectDataMgr::load( const std::string & group, const std::string & filePath )
+void CObjectDataMgr::load(
+    const std::string & group,
+    const std::string & filePath,
+    std::map<const std::string, std::unique_ptr<iObjectData>> & rGroupMap )
 {
     // Open and parse the XML file:
     XMLNode mainNode = XMLNode::openFileHelper( filePath.c_str() );
@@ -129,10 +364,7 @@ void CObjectDataMgr::load( const std::string & group, const std::string & filePa
 
         if( std::strcmp( childNode.getName(), "objectDataList2D" ) == 0 )
         {
-            load2D( group, childNode );
-
-            // Create the assets from data
-            createFromData( group );
+            load2D( group, childNode, rGroupMap );
 
             // Free the sprite sheet data because it's no longer needed
             CSpriteSheetMgr::Instance().clear();
@@ -142,10 +374,7 @@ void CObjectDataMgr::load( const std::string & group, const std::string & filePa
 
         else if( std::strcmp( childNode.getName(), "objectDataList3D" ) == 0 )
         {
-            load3D( group, childNode );
-
-            // Create the assets from data
-            createFromData( group );
+            load3D( group, childNode, rGroupMap );
 
             return;
         }
@@ -164,12 +393,11 @@ void CObjectDataMgr::load( const std::string & group, const std::string & filePa
 /************************************************************************
  *    DESC:  Load all object information
  ************************************************************************/
-void CObjectDataMgr::load2D( const std::string & group, const XMLNode & mainNode )
+void CObjectDataMgr::load2D(
+    const std::string & group,
+    const XMLNode & mainNode,
+    std::map<const std::string, std::unique_ptr<iObjectData>> & rGroupMap )
 {
-    // Get an iterator to the group
-    auto groupMapIter = m_objectDataMapMap.find( group );
-
-
     //////////////////////////////////////////////
     // Load the default data
     //////////////////////////////////////////////
@@ -200,7 +428,7 @@ void CObjectDataMgr::load2D( const std::string & group, const XMLNode & mainNode
         const std::string name = objectNode.getAttribute( "name" );
 
         // Allocate the object data to the map
-        auto iter = groupMapIter->second.emplace( name, new CObjectData2D( defaultData ) );
+        auto iter = rGroupMap.emplace( name, new CObjectData2D( defaultData ) );
 
         // // Check for duplicate names
         if( !iter.second )
@@ -219,11 +447,11 @@ void CObjectDataMgr::load2D( const std::string & group, const XMLNode & mainNode
 /************************************************************************
  *    DESC:  Load all object information
  ************************************************************************/
-void CObjectDataMgr::load3D( const std::string & group, const XMLNode & mainNode )
+void CObjectDataMgr::load3D(
+    const std::string & group,
+    const XMLNode & mainNode,
+    std::map<const std::string, std::unique_ptr<iObjectData>> & rGroupMap )
 {
-    // Get an iterator to the group
-    auto groupMapIter = m_objectDataMapMap.find( group );
-
     //////////////////////////////////////////////
     // Load the default data
     //////////////////////////////////////////////
@@ -254,7 +482,7 @@ void CObjectDataMgr::load3D( const std::string & group, const XMLNode & mainNode
         const std::string name = objectNode.getAttribute( "name" );
 
         // Allocate the object data to the map
-        auto iter = groupMapIter->second.emplace( name, new CObjectData3D( defaultData ) );
+        auto iter = rGroupMap.emplace( name, new CObjectData3D( defaultData ) );
 
         // Check for duplicate names
         if( !iter.second )
@@ -273,21 +501,13 @@ void CObjectDataMgr::load3D( const std::string & group, const XMLNode & mainNode
 /************************************************************************
  *    DESC:  Create the group's VBO, IBO, textures, etc
  ************************************************************************/
-void CObjectDataMgr::createFromData( const std::string & group )
+void CObjectDataMgr::createFromData(
+    const std::string & group,
+    std::map<const std::string, std::unique_ptr<iObjectData>> & rGroupMap )
 {
     // Create it from the data
-    auto groupMapIter = m_objectDataMapMap.find( group );
-    if( groupMapIter != m_objectDataMapMap.end() )
-    {
-        for( auto & iter : groupMapIter->second )
-            iter.second->createFromData( group );
-    }
-    else
-    {
-        throw NExcept::CCriticalException("Object Create From Data Group Error!",
-            boost::str( boost::format("Object data list group name can't be found (%s).\n\n%s\nLine: %s")
-                % group % __FUNCTION__ % __LINE__ ));
-    }
+    for( auto & iter : rGroupMap )
+        iter.second->createFromData( group );
 }
 
 
@@ -327,6 +547,21 @@ void CObjectDataMgr::freeDataGroup( const std::string & group )
             boost::str( boost::format("Object data list group name can't be found (%s).\n\n%s\nLine: %s")
                 % group % __FUNCTION__ % __LINE__ ));
 
+    std::unique_lock<std::mutex> lock( m_mutex );
+
+    auto progressIter = m_loadProgressMap.find( group );
+    if( progressIter != m_loadProgressMap.end() )
+    {
+        // The assets of a group still loading can't be freed from under the workers
+        if( !progressIter->second->m_done )
+            throw NExcept::CCriticalException("Obj Data List Free Group Data Error!",
+                boost::str( boost::format("Object data list group is still loading (%s).\n\n%s\nLine: %s")
+                    % group % __FUNCTION__ % __LINE__ ));
+
+        // A failed load's assets are freed with the group. Allow it to be loaded again
+        m_loadProgressMap.erase( progressIter );
+    }
+
     // Unload the group data
     auto mapIter = m_objectDataMapMap.find( group );
     if( mapIter != m_objectDataMapMap.end() )
@@ -338,6 +573,8 @@ void CObjectDataMgr::freeDataGroup( const std::string & group )
  ************************************************************************/
 std::string CObjectDataMgr::findGroup( const std::string & objectName )
 {
+    std::unique_lock<std::mutex> lock( m_mutex );
+
     std::string result;
 
     // Work your way backwards through the map because chances are we are looking
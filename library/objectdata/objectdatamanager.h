@@ -13,16 +13,44 @@
 // Standard lib dependencies
 #include <memory>
 #include <vector>
+#include <mutex>
+#include <atomic>
 
 // Forward declaration(s)
 class iObjectData;
 class CScriptArray;
 struct XMLNode;
 
+/************************************************************************
+*    Progress of a group being loaded in the background
+************************************************************************/
+class CGroupLoadProgress
+{
+public:
+
+    // Number of objects in the group and how many have been created
+    std::atomic_int m_objectCount{0};
+    std::atomic_int m_createdCount{0};
+
+    // Set once the group has been added to the object data map
+    std::atomic_bool m_done{false};
+
+    // Error message if the load failed
+    std::string m_errorMsg;
+    std::string m_errorTitle;
+};
+
 class CObjectDataMgr : public CManagerBase
 {
 public:
 
+    // Code of the complete event of a background group load
+    enum EGroupLoad
+    {
+        EGL_LOADED,
+        EGL_FAILED
+    };
+
     // Get the instance of the singleton class
     static CObjectDataMgr & Instance()
     {
@@ -38,6 +66,19 @@ public:
     void loadGroupLst( const std::vector<std::string> & groupVec );
     void loadGroupAry( const CScriptArray & strategyIdAry );
 
+    // Load a group on the worker threads. Dispatches the complete event when done if not zero.
+    // NOTE: The event's code is EGL_LOADED or EGL_FAILED. A failed group isn't loaded and
+    //       freeGroup frees what it created before the error.
+    void loadGroupAsync( const std::string & group, int completeEvent = 0 );
+
+    // Get the load progress of a group from 0 to 1
+    // NOTE: Throws the error of a failed background load after freeing its device assets
+    //       so it needs to be called from the main thread
+    float getLoadProgress( const std::string & group );
+
+    // Is the group loaded
+    bool isGroupLoaded( const std::string & group );
+
     // Free all of the meshes and materials of a specific data group
     void freeGroup( const std::string & group );
     void freeGroupLst( const std::vector<std::string> & groupVec );
@@ -51,13 +92,25 @@ private:
     CObjectDataMgr();
     virtual ~CObjectDataMgr();
 
+    // Get the list table entry of the group
+    const std::vector<std::string> & getGroupFileList( const std::string & group );
+
+    // Derived class loading of class specific data
+    void loadUniqueData( const XMLNode & node, const std::string & group ) override;
+
+    // Load the texture atlas of the group if it has one
+    void loadTextureAtlas( const std::string & group );
+
     // Load all object information from an xml
-    void load( const std::string & group, const std::string & filePath );
-    void load2D( const std::string & group, const XMLNode & mainNode );
-    void load3D( const std::string & group, const XMLNode & mainNode );
+    void load( const std::string & group, const std::string & filePath, std::map<const std::string, std::unique_ptr<iObjectData>> & rGroupMap );
+    void load2D( const std::string & group, const XMLNode & mainNode, std::map<const std::string, std::unique_ptr<iObjectData>> & rGroupMap );
+    void load3D( const std::string & group, const XMLNode & mainNode, std::map<const std::string, std::unique_ptr<iObjectData>> & rGroupMap );
 
     // Create the group's VBO, IBO, textures, etc
-    void createFromData( const std::string & group );
+    void createFromData( const std::string & group, std::map<const std::string, std::unique_ptr<iObjectData>> & rGroupMap );
+
+    // Load the group on a worker thread
+    void loadGroupJob( const std::string & group, int completeEvent, std::shared_ptr<CGroupLoadProgress> spProgress );
 
     // Free only the data of a specific group
     void freeDataGroup( const std::string & group );
@@ -66,4 +119,16 @@ private:
     
     // Map in a map of all the objects' data
     std::map<const std::string, std::map<const std::string, std::unique_ptr<iObjectData>> > m_objectDataMapMap;
+
+    // Groups being loaded in the background
+    std::map<const std::string, std::shared_ptr<CGroupLoadProgress>> m_loadProgressMap;
+
+    // Guards the object data map and the load progress map
+    mutable std::mutex m_mutex;
+
+    // The sprite sheet manager used while parsing is shared so only one group is parsed at a time
+    std::mutex m_parseMutex;
+
+    // Texture atlas file of the groups that were packed by the atlas packer
+    std::map<const std::string, std::string> m_atlasFileMap;
 };
@@ -11,6 +11,7 @@
 // Game lib dependencies
 #include <system/device.h>
 #include <managers/spritesheetmanager.h>
+#include <managers/textureatlasmanager.h>
 #include <utilities/xmlParser.h>
 #include <utilities/xmlparsehelper.h>
 #include <utilities/exceptionhandling.h>
@@ -35,6 +36,7 @@ CObjectVisualData2D::CObjectVisualData2D() :
     m_genType(EGenType::_NULL_),
     m_pipelineIndex(-1),
     m_textureSequenceCount(0),
+    m_textureArray(false),
     // The below defaults need to match the defaults in texture.h
     m_genMipLevels(false),
     m_magFilter(VK_FILTER_LINEAR),
@@ -51,7 +53,8 @@ CObjectVisualData2D::CObjectVisualData2D() :
     m_minLod(0.0f),
     m_iboCount(0),
     m_defaultUniformScale(1),
-    m_mirror(EMirror::_NULL_)
+    m_mirror(EMirror::_NULL_),
+    m_allowBatching(true)
 {
 }
 
@@ -77,6 +80,10 @@ void CObjectVisualData2D::loadFromNode( const XMLNode & objectNode, const std::s
         if( visualNode.isAttributeSet("defaultUniformScale") )
             m_defaultUniformScale = std::atof( visualNode.getAttribute( "defaultUniformScale" ) );
 
+        // Opt out of being batched into instanced draws
+        if( visualNode.isAttributeSet("batch") )
+            m_allowBatching = (std::strcmp(visualNode.getAttribute( "batch" ), "true") == 0);
+
         // See if we have a texture to load
         const XMLNode textureNode = visualNode.getChildNode("texture");
         if( !textureNode.isEmpty() )
@@ -87,6 +94,10 @@ void CObjectVisualData2D::loadFromNode( const XMLNode & objectNode, const std::s
             if( textureNode.isAttributeSet("file") )
                 m_textureFilePath = textureNode.getAttribute( "file" );
 
+            // Load the sequence into a texture array so changing frames doesn't change the descriptor set
+            if( textureNode.isAttributeSet("array") )
+                m_textureArray = (std::strcmp(textureNode.getAttribute( "array" ), "true") == 0);
+
             // Enable mip map generation
             if( textureNode.isAttributeSet("mip_levels") )
                 m_genMipLevels = (std::strcmp(textureNode.getAttribute( "mip_levels" ), "true") == 0);
@@ -388,10 +399,62 @@ void CObjectVisualData2D::loadFromNode( const XMLNode & objectNode, const std::s
                 boost::str( boost::format("Shader object data missing.\n\n%s\nLine: %s")
                     % __FUNCTION__ % __LINE__ ));
         }
+
+        // The regions may have been copied from the default data
+        m_atlasRegionVec.clear();
+
+        // Only quads using the default sampler are packed into the atlas
+        if( (m_genType == EGenType::QUAD) && !m_textureFilePath.empty() && !isTextureArray() && usesDefaultSampler() )
+            findAtlasRegions();
     }
 }
 
 
+/************************************************************************
+*    DESC:  Find the texture atlas regions of the frames
+*           NOTE: The atlas is only used if all the frames were packed into it
+************************************************************************/
+void CObjectVisualData2D::findAtlasRegions()
+{
+    const int frameCount = (m_textureSequenceCount > 0) ? m_textureSequenceCount : 1;
+
+    std::vector<CAtlasRegion> regionVec;
+    regionVec.reserve( frameCount );
+
+    for( int i = 0; i < frameCount; ++i )
+    {
+        std::string filePath = m_textureFilePath;
+        if( m_textureSequenceCount > 0 )
+            filePath = boost::str( boost::format(m_textureFilePath) % i );
+
+        const CAtlasRegion * pRegion = CTextureAtlasMgr::Instance().findRegion( filePath );
+        if( pRegion == nullptr )
+            return;
+
+        regionVec.push_back( *pRegion );
+    }
+
+    m_atlasRegionVec.swap( regionVec );
+}
+
+
+/************************************************************************
+*    DESC:  Does the texture use the default sampler
+*           NOTE: Textures sharing an atlas share its sampler
+************************************************************************/
+bool CObjectVisualData2D::usesDefaultSampler() const
+{
+    const CTexture defTexture;
+
+    return (m_genMipLevels == defTexture.genMipLevels) &&
+           (m_magFilter == defTexture.magFilter) &&
+           (m_minFilter == defTexture.minFilter) &&
+           (m_samplerAddressModeU == defTexture.samplerAddressModeU) &&
+           (m_samplerAddressModeV == defTexture.samplerAddressModeV) &&
+           (m_samplerAddressModeW == defTexture.samplerAddressModeW);
+}
+
+
 /************************************************************************
 *    DESC:  Create the object from data
 ************************************************************************/
@@ -500,6 +563,27 @@ void CObjectVisualData2D::generateQuad( const std::string & group )
         m_vboBuffer = CDevice::Instance().creatMemoryBuffer( group, "quad_solid_vbo" + horzStr + vertStr, vert_vec, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT );
     else
         m_vboBuffer = CDevice::Instance().creatMemoryBuffer( group, "quad_uv_vbo" + horzStr + vertStr, vert_uv_vec, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT );
+
+    // Frames packed into an atlas get a VBO with the UVs of their region
+    // NOTE: The instanced draws still use the unit quad and offset the UVs in the shader
+    m_atlasVboBufferVec.reserve( m_atlasRegionVec.size() );
+
+    for( auto & iter : m_atlasRegionVec )
+    {
+        std::vector<NVertex::vert_uv> atlas_vert_uv_vec( vert_uv_vec );
+
+        for( auto & vertIter : atlas_vert_uv_vec )
+        {
+            vertIter.uv.u = iter.m_uvRect.x1 + (vertIter.uv.u * iter.m_uvRect.x2);
+            vertIter.uv.v = iter.m_uvRect.y1 + (vertIter.uv.v * iter.m_uvRect.y2);
+        }
+
+        const std::string vboName = boost::str( boost::format("quad_uv_vbo%s%s_%s_%d_%d")
+            % horzStr % vertStr % iter.m_atlasFilePath % iter.m_x % iter.m_y );
+
+        m_atlasVboBufferVec.push_back(
+            CDevice::Instance().creatMemoryBuffer( group, vboName, atlas_vert_uv_vec, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT ) );
+    }
     
     m_iboBuffer = CDevice::Instance().creatMemoryBuffer( group, "quad_ibo", iboVec, VK_BUFFER_USAGE_INDEX_BUFFER_BIT );
 
@@ -524,7 +608,33 @@ void CObjectVisualData2D::createTexture( const std::string & group, CTexture & r
         rTexture.samplerAddressModeV = m_samplerAddressModeV;
         rTexture.samplerAddressModeW = m_samplerAddressModeW;
 
-        if( m_textureSequenceCount > 0 )
+        // The frames use the atlas texture sized to their region
+        if( !m_atlasRegionVec.empty() )
+        {
+            m_textureVec.reserve( m_atlasRegionVec.size() );
+
+            for( auto & iter : m_atlasRegionVec )
+            {
+                rTexture.textFilePath = iter.m_atlasFilePath;
+
+                rTexture = CDevice::Instance().createTexture( group, rTexture );
+                rTexture.size = iter.m_size;
+                m_textureVec.emplace_back( rTexture );
+            }
+        }
+        // Every frame refers to the same texture array and picks its layer through the UBO
+        else if( isTextureArray() )
+        {
+            std::vector<std::string> filePathVec;
+            filePathVec.reserve( m_textureSequenceCount );
+
+            for( int i = 0; i < m_textureSequenceCount; ++i )
+                filePathVec.push_back( boost::str( boost::format(m_textureFilePath) % i ) );
+
+            rTexture = CDevice::Instance().createTextureArray( group, rTexture, filePathVec );
+            m_textureVec.assign( m_textureSequenceCount, rTexture );
+        }
+        else if( m_textureSequenceCount > 0 )
         {
             m_textureVec.reserve( m_textureSequenceCount );
 
@@ -1015,6 +1125,30 @@ const CMemoryBuffer & CObjectVisualData2D::getVBO() const
 }
 
 
+/************************************************************************
+*    DESC:  Get the VBO of a frame
+************************************************************************/
+const CMemoryBuffer & CObjectVisualData2D::getFrameVBO( uint index ) const
+{
+    if( index < m_atlasVboBufferVec.size() )
+        return m_atlasVboBufferVec[index];
+
+    return m_vboBuffer;
+}
+
+
+/************************************************************************
+*    DESC:  Get the UV rect of a frame
+************************************************************************/
+const CRect<float> & CObjectVisualData2D::getUVRect( uint index ) const
+{
+    if( index < m_atlasRegionVec.size() )
+        return m_atlasRegionVec[index].m_uvRect;
+
+    return iObjectVisualData::getUVRect( index );
+}
+
+
 /************************************************************************
 *    DESC:  Get the IBO
 ************************************************************************/
@@ -1070,3 +1204,23 @@ float CObjectVisualData2D::getDefaultUniformScale() const
 {
     return m_defaultUniformScale;
 }
+
+
+/************************************************************************
+*    DESC:  Can this object be batched into instanced draws
+************************************************************************/
+bool CObjectVisualData2D::allowBatching() const
+{
+    // The instanced pipelines sample a 2D texture
+    return m_allowBatching && !isTextureArray();
+}
+
+
+/************************************************************************
+*    DESC:  Are the frames the layers of a texture array
+*           NOTE: Only a quad with a texture sequence is loaded as an array
+************************************************************************/
+bool CObjectVisualData2D::isTextureArray() const
+{
+    return m_textureArray && (m_genType == EGenType::QUAD) && (m_textureSequenceCount > 0);
+}
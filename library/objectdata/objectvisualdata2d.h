@@ -21,6 +21,7 @@
 #include <common/vertex.h>
 #include <sprite/spritesheet.h>
 #include <system/memorybuffer.h>
+#include <managers/textureatlasmanager.h>
 
 // Standard lib dependencies
 #include <string>
@@ -59,6 +60,12 @@ public:
     // Get the VBO
     const CMemoryBuffer & getVBO() const override;
 
+    // Get the VBO of a frame
+    const CMemoryBuffer & getFrameVBO( uint index = 0 ) const override;
+
+    // Get the UV rect of a frame
+    const CRect<float> & getUVRect( uint index = 0 ) const override;
+
     // Get the IBO
     const CMemoryBuffer & getIBO() const override;
 
@@ -77,7 +84,19 @@ public:
     // Access functions for the default uniform scale
     float getDefaultUniformScale() const override;
 
+    // Can this object be batched into instanced draws
+    bool allowBatching() const override;
+
+    // Are the frames the layers of a texture array
+    bool isTextureArray() const override;
+
 private:
+
+    // Find the texture atlas regions of the frames
+    void findAtlasRegions();
+
+    // Does the texture use the default sampler
+    bool usesDefaultSampler() const;
     
     // Create the texture from loaded image data
     void createTexture( const std::string & group, CTexture & rTexture, CSize<float> & rSize );
@@ -148,6 +167,12 @@ private:
     // VBO buffer
     CMemoryBuffer m_vboBuffer;
 
+    // Atlas regions of the frames. Empty if the texture wasn't packed into an atlas
+    std::vector<CAtlasRegion> m_atlasRegionVec;
+
+    // VBO of each atlas frame with the UVs of its region
+    std::vector<CMemoryBuffer> m_atlasVboBufferVec;
+
     // IBO
     CMemoryBuffer m_iboBuffer;
 
@@ -166,6 +191,9 @@ private:
     // Texture Sequence count
     int m_textureSequenceCount;
 
+    // Load the texture sequence into a texture array
+    bool m_textureArray;
+
     // Enable generation of mip map levels
     bool m_genMipLevels;
 
@@ -225,4 +253,7 @@ private:
     
     // Mirror enum
     EMirror m_mirror;
+
+    // Allow batching into instanced draws
+    bool m_allowBatching;
 };
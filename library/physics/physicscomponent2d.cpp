@@ -79,6 +79,7 @@ void CPhysicsComponent2D::destroy()
     {
         m_pWorld->destroyBody( m_pBody );
         m_pBody = nullptr;
+        m_pPrevState = nullptr;
     }
 }
 
@@ -106,6 +107,7 @@ void CPhysicsComponent2D::createBody( const CSprite & sprite )
 
         // Create the body
         m_pBody = m_pWorld->createBody( bodyDef );
+        m_pPrevState = m_pWorld->getPrevBodyState( m_pBody );
     }
 }
 
@@ -361,12 +363,27 @@ void CPhysicsComponent2D::update( CSprite * pSprite )
     {
         CStatCounter::Instance().incPhysicsObjectsCounter();
 
-        if( (BODY_TYPE > b2_staticBody) && m_pBody->IsAwake() )
+        if( BODY_TYPE > b2_staticBody )
         {
             const b2Vec2 & pos = m_pBody->GetPosition();
             const float angle = m_pBody->GetAngle();
-            pSprite->setPos( pos.x * METERS_TO_PIXELS, pos.y * METERS_TO_PIXELS );
-            pSprite->setRot( 0, 0, angle, false );
+            const float ratio = m_pWorld->getTimeRatio();
+
+            // Blend between the last two steps so the sprite moves smoothly at any frame rate
+            // NOTE: A body that just fell asleep still needs to finish blending to its resting place
+            if( (ratio < 1.f) && (m_pPrevState != nullptr) &&
+                ((m_pPrevState->pos != pos) || (m_pPrevState->angle != angle)) )
+            {
+                const b2Vec2 lerpPos = m_pPrevState->pos + ratio * (pos - m_pPrevState->pos);
+                const float lerpAngle = m_pPrevState->angle + ratio * (angle - m_pPrevState->angle);
+                pSprite->setPos( lerpPos.x * METERS_TO_PIXELS, lerpPos.y * METERS_TO_PIXELS );
+                pSprite->setRot( 0, 0, lerpAngle, false );
+            }
+            else if( m_pBody->IsAwake() )
+            {
+                pSprite->setPos( pos.x * METERS_TO_PIXELS, pos.y * METERS_TO_PIXELS );
+                pSprite->setRot( 0, 0, angle, false );
+            }
         }
     }
 }
@@ -381,6 +398,9 @@ void CPhysicsComponent2D::setTransform( float x, float y, float angle, bool rese
     {
         m_pBody->SetTransform( b2Vec2( x * PIXELS_TO_METERS, y * PIXELS_TO_METERS ), angle );
 
+        // Don't blend from where the body was before being moved
+        m_pWorld->resetPrevBodyState( m_pBody );
+
         if( resetVelocity )
         {
             m_pBody->SetLinearVelocity( b2Vec2(0,0) );
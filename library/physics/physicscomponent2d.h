@@ -29,6 +29,7 @@ class CPhysicsWorld2D;
 class b2Body;
 class CFixture;
 class b2Fixture;
+struct SBodyState;
 
 class CPhysicsComponent2D : public iPhysicsComponent, boost::noncopyable
 {
@@ -137,4 +138,8 @@ private:
     // Pointer to the world
     // NOTE: Do not free. We don't own this pointer.
     CPhysicsWorld2D * m_pWorld;
+
+    // State of the body before the last step
+    // NOTE: Do not free. The world owns this.
+    const SBodyState * m_pPrevState = nullptr;
 };
@@ -14,12 +14,19 @@
 #include <utilities/mathfunc.h>
 #include <utilities/exceptionhandling.h>
 #include <script/scriptmanager.h>
+#include <utilities/genfunc.h>
+
+// AngelScript lib dependencies
+#include <angelscript.h>
+#include <scriptarray/scriptarray.h>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
 
 // Standard lib dependencies
 #include <cstring>
+#include <cstdlib>
+#include <algorithm>
 
 // SDL lib dependencies
 #include <SDL2/SDL.h>
@@ -34,8 +41,13 @@ CPhysicsWorld2D::CPhysicsWorld2D() :
     m_stepTime(0),
     m_stepTimeSec(0),
     m_timeRatio(0),
+    m_maxSubSteps(5),
     m_velStepCount(6),
-    m_posStepCount(2)
+    m_posStepCount(2),
+    m_contactEventVec(256),
+    m_contactEventCount(0),
+    m_contactQueueGrew(false),
+    m_deferContacts(false)
 {
     setFPS(30);
 }
@@ -85,6 +97,9 @@ void CPhysicsWorld2D::loadFromNode( const XMLNode & node )
         m_velStepCount = std::atoi( steppingNode.getAttribute( "velocity" ) );
         m_posStepCount = std::atoi( steppingNode.getAttribute( "position" ) );
 
+        if( steppingNode.isAttributeSet( "maxSubSteps" ) )
+            setMaxSubSteps( std::atoi( steppingNode.getAttribute( "maxSubSteps" ) ) );
+
         float fps = std::atof( steppingNode.getAttribute( "fps" ) );
 
         // If the number is negative, get the current refresh rate
@@ -109,27 +124,14 @@ void CPhysicsWorld2D::loadFromNode( const XMLNode & node )
         m_pixelsPerMeter = std::atof( conversionNode.getAttribute( "pixelsPerMeter" ) );
     }
 
-    // Load the group and script for the begin contact listener
-    XMLNode beginContactNode = node.getChildNode( "beginContactListener" );
-    if( !beginContactNode.isEmpty() )
-    {
-        std::string group = beginContactNode.getAttribute( "group" );
-        std::string script = beginContactNode.getAttribute( "script" );
-
-        if( !group.empty() && !script.empty() )
-            m_beginContactTuple = {group, script};
-    }
-
-    // Load the group and script for the end contact listener
-    XMLNode endContactNode = node.getChildNode( "endContactListener" );
-    if( !endContactNode.isEmpty() )
-    {
-        std::string group = endContactNode.getAttribute( "group" );
-        std::string script = endContactNode.getAttribute( "script" );
+    // Get the max number of contacts recorded in a step
+    XMLNode contactQueueNode = node.getChildNode( "contactQueue" );
+    if( !contactQueueNode.isEmpty() && contactQueueNode.isAttributeSet( "size" ) )
+        m_contactEventVec.resize( std::max( 1, std::atoi( contactQueueNode.getAttribute( "size" ) ) ) );
 
-        if( !group.empty() && !script.empty() )
-            m_endContactTuple = {group, script};
-    }
+    // Load the begin and end contact listeners
+    loadContactListener( node.getChildNode( "beginContactListener" ), m_beginContactListener );
+    loadContactListener( node.getChildNode( "endContactListener" ), m_endContactListener );
 
     // Load the group and script for the delete fixture listener
     XMLNode deleteFixtureNode = node.getChildNode( "deleteFixtureListener" );
@@ -155,6 +157,32 @@ void CPhysicsWorld2D::loadFromNode( const XMLNode & node )
 }
 
 
+/************************************************************************
+*    DESC:  Load the contact listener
+************************************************************************/
+void CPhysicsWorld2D::loadContactListener( const XMLNode & node, SContactListener & listener )
+{
+    if( !node.isEmpty() )
+    {
+        std::string group = node.getAttribute( "group" );
+        std::string script = node.getAttribute( "script" );
+
+        if( !group.empty() && !script.empty() )
+        {
+            listener.group = group;
+            listener.script = script;
+        }
+
+        if( node.isAttributeSet( "batch" ) )
+            listener.batch = ( std::strcmp( node.getAttribute( "batch" ), "true" ) == 0 );
+
+        // Accepts hex values
+        if( node.isAttributeSet( "categoryBits" ) )
+            listener.categoryBits = std::strtoul( node.getAttribute( "categoryBits" ), nullptr, 0 );
+    }
+}
+
+
 /************************************************************************
 *    DESC:  Get the world
 ************************************************************************/
@@ -183,7 +211,7 @@ b2Body * CPhysicsWorld2D::createBody( const b2BodyDef & pDef )
             boost::str( boost::format("Error creating physics body.\n\n%s\nLine: %s")
                 % __FUNCTION__ % __LINE__ ));
 
-    m_pBodySet.insert( pBody );
+    m_pBodyMap.emplace( pBody, SBodyState{ pBody->GetPosition(), pBody->GetAngle() } );
 
     return pBody;
 }
@@ -195,15 +223,15 @@ b2Body * CPhysicsWorld2D::createBody( const b2BodyDef & pDef )
 ************************************************************************/
 void CPhysicsWorld2D::destroyBody( b2Body * pBody )
 {
-    auto iter = m_pBodySet.find( pBody );
+    auto iter = m_pBodyMap.find( pBody );
 
-    if( iter != m_pBodySet.end() )
+    if( iter != m_pBodyMap.end() )
     {
         // Destroy the body
         m_world.DestroyBody( pBody );
 
-        // Remove the body from the set
-        m_pBodySet.erase( iter );
+        // Remove the body from the map
+        m_pBodyMap.erase( iter );
     }
 }
 
@@ -212,18 +240,41 @@ void CPhysicsWorld2D::destroyBody( b2Body * pBody )
 *    DESC:  Perform fixed time step physics simulation
 ************************************************************************/
 void CPhysicsWorld2D::fixedTimeStep()
+{
+    fixedTimeStep( CHighResTimer::Instance().getElapsedTime() );
+}
+
+void CPhysicsWorld2D::fixedTimeStep( float elapsedTime )
 {
     if( m_active )
     {
         // Increment the timer
-        m_timer += CHighResTimer::Instance().getElapsedTime();
+        m_timer += elapsedTime;
 
-        if( m_timer > m_stepTime )
+        // Drop the time that would take more than the max steps to catch up on
+        const float maxTime = m_stepTime * m_maxSubSteps;
+        if( m_timer > maxTime )
+            m_timer = maxTime;
+
+        while( m_timer >= m_stepTime )
         {
-            m_timer = NMathFunc::Modulus( m_timer, m_stepTime );
+            m_timer -= m_stepTime;
+
+            // Save the state of the bodies before the last step for interpolating
+            if( m_timer < m_stepTime )
+            {
+                for( auto & iter : m_pBodyMap )
+                {
+                    if( iter.first->GetType() != b2_staticBody )
+                    {
+                        iter.second.pos = iter.first->GetPosition();
+                        iter.second.angle = iter.first->GetAngle();
+                    }
+                }
+            }
 
             // Begin the physics world step
-            m_world.Step( m_stepTimeSec, m_velStepCount, m_posStepCount );
+            step( m_stepTimeSec );
         }
 
         m_timeRatio = m_timer / m_stepTime;
@@ -234,15 +285,35 @@ void CPhysicsWorld2D::fixedTimeStep()
 *    DESC:  Perform variable time step physics simulation
 ************************************************************************/
 void CPhysicsWorld2D::variableTimeStep()
+{
+    variableTimeStep( CHighResTimer::Instance().getElapsedTime() );
+}
+
+void CPhysicsWorld2D::variableTimeStep( float elapsedTime )
 {
     if( m_active )
     {
         // Begin the physics world step
-        m_world.Step( CHighResTimer::Instance().getElapsedTime() / 1000.f, m_velStepCount, m_posStepCount );
+        step( elapsedTime / 1000.f );
+
+        // Nothing to interpolate. The sprites use the current state
+        m_timeRatio = 1.f;
     }
 }
 
 
+/************************************************************************
+*    DESC:  Step the world and hand the contacts of the step to the scripts
+************************************************************************/
+void CPhysicsWorld2D::step( float timeStep )
+{
+    m_world.Step( timeStep, m_velStepCount, m_posStepCount );
+
+    if( !m_deferContacts )
+        dispatchContacts();
+}
+
+
 /************************************************************************
 *    DESC:  Get the focus
 *
@@ -281,6 +352,45 @@ float CPhysicsWorld2D::getTimeRatio() const
 }
 
 
+/************************************************************************
+*    DESC:  Set the max number of steps done in one frame
+************************************************************************/
+void CPhysicsWorld2D::setMaxSubSteps( int maxSubSteps )
+{
+    if( maxSubSteps > 0 )
+        m_maxSubSteps = maxSubSteps;
+}
+
+
+/************************************************************************
+*    DESC:  Get the state of the body before the last step
+*           NOTE: The pointer stays valid until the body is destroyed
+************************************************************************/
+const SBodyState * CPhysicsWorld2D::getPrevBodyState( b2Body * pBody ) const
+{
+    auto iter = m_pBodyMap.find( pBody );
+    if( iter != m_pBodyMap.end() )
+        return &iter->second;
+
+    return nullptr;
+}
+
+
+/************************************************************************
+*    DESC:  Set the state before the last step to the current state
+*           so a moved body doesn't blend from its old location
+************************************************************************/
+void CPhysicsWorld2D::resetPrevBodyState( b2Body * pBody )
+{
+    auto iter = m_pBodyMap.find( pBody );
+    if( iter != m_pBodyMap.end() )
+    {
+        iter->second.pos = pBody->GetPosition();
+        iter->second.angle = pBody->GetAngle();
+    }
+}
+
+
 /************************************************************************
 *    DESC:  Set the activity of the physics world
 ************************************************************************/
@@ -333,33 +443,117 @@ void CPhysicsWorld2D::EnableDestructionListener( bool enable )
 ************************************************************************/
 void CPhysicsWorld2D::BeginContact(b2Contact* contact)
 {
-    void * pVoidA = contact->GetFixtureA()->GetUserData();
-    void * pVoidB = contact->GetFixtureB()->GetUserData();
+    recordContact( contact, m_beginContactListener, true );
+}
 
-    if( (pVoidA != nullptr) && (pVoidB != nullptr) && !std::get<0>(m_beginContactTuple).empty() )
+
+/************************************************************************
+*    DESC:  Called when two fixtures cease to touch
+************************************************************************/
+void CPhysicsWorld2D::EndContact(b2Contact* contact)
+{
+    recordContact( contact, m_endContactListener, false );
+}
+
+
+/************************************************************************
+*    DESC:  Record the contact to be dispatched after the step
+*           NOTE: Called from inside the step. The queue keeps its size so
+*                 it only allocates until it fits the busiest step
+************************************************************************/
+void CPhysicsWorld2D::recordContact( b2Contact * contact, const SContactListener & listener, bool begin )
+{
+    const b2Fixture * pFixtureA = contact->GetFixtureA();
+    const b2Fixture * pFixtureB = contact->GetFixtureB();
+
+    void * pVoidA = pFixtureA->GetUserData();
+    void * pVoidB = pFixtureB->GetUserData();
+
+    if( (pVoidA != nullptr) && (pVoidB != nullptr) && !listener.group.empty() &&
+        ((pFixtureA->GetFilterData().categoryBits | pFixtureB->GetFilterData().categoryBits) & listener.categoryBits) )
     {
-        // Can't pass as void * so just doing a typecast to avoid an error.
-        // The type doesn't really matter and avoinding adding a CSprite dependancy.
-        CScriptMgr::Instance().prepare(
-            std::get<0>(m_beginContactTuple), std::get<1>(m_beginContactTuple), {(char *)pVoidA, (char *)pVoidB});
+        if( m_contactEventCount == m_contactEventVec.size() )
+        {
+            m_contactEventVec.resize( m_contactEventVec.size() * 2 );
+            m_contactQueueGrew = true;
+        }
+
+        m_contactEventVec[m_contactEventCount++] = {pVoidA, pVoidB, begin};
     }
 }
 
 
 /************************************************************************
-*    DESC:  Called when two fixtures cease to touch
+*    DESC:  Hand the recorded contacts to the scripts
 ************************************************************************/
-void CPhysicsWorld2D::EndContact(b2Contact* contact)
+void CPhysicsWorld2D::dispatchContacts()
 {
-    void * pVoidA = contact->GetFixtureA()->GetUserData();
-    void * pVoidB = contact->GetFixtureB()->GetUserData();
+    if( m_contactEventCount > 0 )
+    {
+        dispatchContacts( m_beginContactListener, true );
+        dispatchContacts( m_endContactListener, false );
 
-    if( (pVoidA != nullptr) && (pVoidB != nullptr) && !std::get<0>(m_endContactTuple).empty() )
+        m_contactEventCount = 0;
+    }
+
+    if( m_contactQueueGrew )
     {
-        // Can't pass as void * so just doing a typecast to avoid an error.
-        // The type doesn't really matter and avoinding adding a CSprite dependancy.
-        CScriptMgr::Instance().prepare(
-            std::get<0>(m_endContactTuple), std::get<1>(m_endContactTuple), {(char *)pVoidA, (char *)pVoidB});
+        NGenFunc::PostDebugMsg( boost::str( boost::format("Physics contact queue grew to %d. Set <contactQueue size> to avoid allocating during the step.")
+            % m_contactEventVec.size() ) );
+
+        m_contactQueueGrew = false;
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Hand the recorded contacts to the listener
+*
+*    NOTE:  A batch listener gets an array of sprite handles with the
+*           contacting sprites next to each other (a0, b0, a1, b1...)
+************************************************************************/
+void CPhysicsWorld2D::dispatchContacts( const SContactListener & listener, bool begin )
+{
+    if( listener.group.empty() )
+        return;
+
+    if( listener.batch )
+    {
+        uint pairCount(0);
+        for( size_t i = 0; i < m_contactEventCount; ++i )
+            if( m_contactEventVec[i].begin == begin )
+                ++pairCount;
+
+        if( pairCount > 0 )
+        {
+            asITypeInfo * arrayType = CScriptMgr::Instance().getPtrToTypeInfo( "array<CSprite@>" );
+            CScriptArray * pAry = CScriptArray::Create( arrayType, pairCount * 2 );
+
+            uint index(0);
+            for( size_t i = 0; i < m_contactEventCount; ++i )
+            {
+                if( m_contactEventVec[i].begin == begin )
+                {
+                    pAry->SetValue( index++, &m_contactEventVec[i].pUserDataA );
+                    pAry->SetValue( index++, &m_contactEventVec[i].pUserDataB );
+                }
+            }
+
+            // The script function takes a handle so the context holds its own reference
+            CScriptMgr::Instance().prepare( listener.group, listener.script, {(void *)pAry} );
+            pAry->Release();
+        }
+    }
+    else
+    {
+        for( size_t i = 0; i < m_contactEventCount; ++i )
+        {
+            // Can't pass as void * so just doing a typecast to avoid an error.
+            // The type doesn't really matter and avoinding adding a CSprite dependancy.
+            if( m_contactEventVec[i].begin == begin )
+                CScriptMgr::Instance().prepare(
+                    listener.group, listener.script, {(char *)m_contactEventVec[i].pUserDataA, (char *)m_contactEventVec[i].pUserDataB});
+        }
     }
 }
 
@@ -14,13 +14,45 @@
 // Standard lib dependencies
 #include <string>
 #include <tuple>
-#include <unordered_set>
+#include <vector>
+#include <unordered_map>
 
 // Forward declaration(s)
 struct XMLNode;
 
+// Body position and angle before the last step. Used to interpolate the sprite between steps
+struct SBodyState
+{
+    b2Vec2 pos;
+    float angle;
+};
+
+// Contact recorded during the step and handed to the scripts after it
+struct SContactEvent
+{
+    void * pUserDataA;
+    void * pUserDataB;
+    bool begin;
+};
+
+// Script function for a contact listener
+struct SContactListener
+{
+    std::string group;
+    std::string script;
+
+    // Get all the contacts of the step in one array instead of one call per contact
+    bool batch = false;
+
+    // Only contacts where one of the fixtures is in these categories are recorded
+    uint16_t categoryBits = 0xFFFF;
+};
+
 class CPhysicsWorld2D : public b2ContactListener, b2DestructionListener
 {
+    // The manager steps the worlds on the thread pool and dispatches the contacts after
+    friend class CPhysicsWorldManager2D;
+
 public:
 
     // Constructor
@@ -42,10 +74,17 @@ public:
 
     // Perform fixed time step physics simulation
     void fixedTimeStep();
+
+    // Perform fixed time step physics simulation for the passed in elapsed time in milliseconds
+    // NOTE: The same sequence of elapsed times always gives the same simulation
+    void fixedTimeStep( float elapsedTime );
     
     // Perform variable time step physics simulation
     void variableTimeStep();
 
+    // Perform variable time step physics simulation for the passed in elapsed time in milliseconds
+    void variableTimeStep( float elapsedTime );
+
     // Get the focus
     const CPoint<int> & getFocus() const;
 
@@ -55,6 +94,15 @@ public:
     // The the time ratio
     float getTimeRatio() const;
 
+    // Set the max number of steps done in one frame
+    void setMaxSubSteps( int maxSubSteps );
+
+    // Get the state of the body before the last step
+    const SBodyState * getPrevBodyState( b2Body * pBody ) const;
+
+    // Set the state before the last step to the current state so a moved body doesn't blend
+    void resetPrevBodyState( b2Body * pBody );
+
     // Set-Get the activity of the physics world
     void setActive( bool value );
     bool isActive() const;
@@ -80,6 +128,21 @@ private:
     // Called when any joint is about to be destroyed
     void SayGoodbye(b2Joint* joint) override;
 
+    // Step the world and hand the contacts of the step to the scripts
+    void step( float timeStep );
+
+    // Record the contact to be dispatched after the step
+    void recordContact( b2Contact * contact, const SContactListener & listener, bool begin );
+
+    // Hand the recorded contacts to the scripts
+    void dispatchContacts();
+
+    // Hand the recorded contacts to the listener
+    void dispatchContacts( const SContactListener & listener, bool begin );
+
+    // Load the contact listener
+    void loadContactListener( const XMLNode & node, SContactListener & listener );
+
 private:
 
     // Box2D world
@@ -88,9 +151,9 @@ private:
     // World focus point
     CPoint<int> m_focus;
 
-    // All bodies that are handled by this physics world
+    // All bodies that are handled by this physics world and their state before the last step
     // NOTE: Class doesn't not own the data. Do Not Delete!
-    std::unordered_set<b2Body *> m_pBodySet;
+    std::unordered_map<b2Body *, SBodyState> m_pBodyMap;
 
     // If we're actively running simulations
     bool m_active;
@@ -110,6 +173,9 @@ private:
     // The ratio of time between steps
     float m_timeRatio;
 
+    // Max number of steps done in one frame. Time past that is dropped so a slow frame can't snowball
+    int m_maxSubSteps;
+
     // The number of velocity and position steps to calculate
     int m_velStepCount;
     int m_posStepCount;
@@ -118,8 +184,18 @@ private:
     float m_pixelsPerMeter;
 
     // Listener members
-    std::tuple<std::string, std::string> m_beginContactTuple;
-    std::tuple<std::string, std::string> m_endContactTuple;
+    SContactListener m_beginContactListener;
+    SContactListener m_endContactListener;
     std::tuple<std::string, std::string> m_deleteFixtureTuple;
     std::tuple<std::string, std::string> m_deleteJointTuple;
+
+    // Contacts recorded during the step. Only allocates when a step has more contacts than ever before
+    std::vector<SContactEvent> m_contactEventVec;
+    size_t m_contactEventCount;
+
+    // Did the queue have to grow this step
+    bool m_contactQueueGrew;
+
+    // Hold the contacts until the manager dispatches them. Set while the world is stepped off the main thread
+    bool m_deferContacts;
 };
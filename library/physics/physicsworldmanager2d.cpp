@@ -12,6 +12,8 @@
 #include <utilities/exceptionhandling.h>
 #include <utilities/xmlParser.h>
 #include <utilities/deletefuncs.h>
+#include <utilities/highresolutiontimer.h>
+#include <utilities/threadpool.h>
 #include <physics/physicsworld2d.h>
 
 // Boost lib dependencies
@@ -97,6 +99,74 @@ CPhysicsWorld2D & CPhysicsWorldManager2D::getWorld( const std::string & group )
 }
 
 
+/************************************************************************
+*    DESC:  Perform fixed time step physics simulation on all the active worlds
+************************************************************************/
+void CPhysicsWorldManager2D::fixedTimeStep()
+{
+    step( CHighResTimer::Instance().getElapsedTime(), true );
+}
+
+
+/************************************************************************
+*    DESC:  Perform variable time step physics simulation on all the active worlds
+************************************************************************/
+void CPhysicsWorldManager2D::variableTimeStep()
+{
+    step( CHighResTimer::Instance().getElapsedTime(), false );
+}
+
+
+/************************************************************************
+*    DESC:  Step all the active worlds and dispatch their contacts
+*
+*    NOTE:  Worlds share nothing so each one is stepped by one thread and
+*           the result doesn't depend on the number of threads. The
+*           contacts go to the scripts on this thread after all the steps
+*           in the world's order so the script calls are in a fixed order.
+************************************************************************/
+void CPhysicsWorldManager2D::step( float elapsedTime, bool fixedStep )
+{
+    m_pActiveWorldVec.clear();
+
+    for( auto & iter : m_pWorld2dMap )
+        if( iter.second->isActive() )
+            m_pActiveWorldVec.push_back( iter.second );
+
+    if( m_pActiveWorldVec.size() == 1 )
+    {
+        if( fixedStep )
+            m_pActiveWorldVec.front()->fixedTimeStep( elapsedTime );
+        else
+            m_pActiveWorldVec.front()->variableTimeStep( elapsedTime );
+    }
+    else if( m_pActiveWorldVec.size() > 1 )
+    {
+        // Scripts can't be prepared from the worker threads
+        for( auto iter : m_pActiveWorldVec )
+            iter->m_deferContacts = true;
+
+        CThreadPool::Instance().parallelFor( m_pActiveWorldVec.size(), 1,
+            [this, elapsedTime, fixedStep]( size_t begin, size_t end )
+            {
+                for( size_t i = begin; i < end; ++i )
+                {
+                    if( fixedStep )
+                        m_pActiveWorldVec[i]->fixedTimeStep( elapsedTime );
+                    else
+                        m_pActiveWorldVec[i]->variableTimeStep( elapsedTime );
+                }
+            } );
+
+        for( auto iter : m_pActiveWorldVec )
+        {
+            iter->m_deferContacts = false;
+            iter->dispatchContacts();
+        }
+    }
+}
+
+
 /************************************************************************
 *    DESC:  Destroy the physics world
 ************************************************************************/
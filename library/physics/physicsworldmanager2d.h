@@ -13,6 +13,7 @@
 // Standard lib dependencies
 #include <string>
 #include <map>
+#include <vector>
 
 // Forward declaration(s)
 class CPhysicsWorld2D;
@@ -36,6 +37,11 @@ public:
 
     // Get the physics world
     CPhysicsWorld2D & getWorld( const std::string & group );
+
+    // Perform fixed/variable time step physics simulation on all the active worlds
+    // NOTE: The worlds are stepped in parallel on the thread pool
+    void fixedTimeStep();
+    void variableTimeStep();
     
     // Delete all worlds
     void clear();
@@ -51,8 +57,14 @@ private:
     // Load the physics worlds from an XML
     void load( const std::string & group, const std::string & filePath );
 
+    // Step all the active worlds and dispatch their contacts
+    void step( float elapsedTime, bool fixedStep );
+
 private:
 
     // Map of physics worlds
     std::map<const std::string, CPhysicsWorld2D *> m_pWorld2dMap;
+
+    // Worlds being stepped this frame. Kept around to avoid allocating every frame
+    std::vector<CPhysicsWorld2D *> m_pActiveWorldVec;
 };
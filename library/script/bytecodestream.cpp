@@ -10,6 +10,7 @@
 
 // Game lib dependencies
 #include <utilities/exceptionhandling.h>
+#include <utilities/smartpointers.h>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
@@ -17,16 +18,18 @@
 // SDL lib dependencies
 #include <SDL2/SDL.h>
 
+// Standard lib dependencies
+#include <cstring>
+
+// Identifies the header of a cached byte code file
+static const uint32_t BYTE_CODE_MAGIC = 0x31434253; // "SBC1"
+
 /************************************************************************
 *    desc:  Constructor
 ************************************************************************/
-CByteCodeStream::CByteCodeStream( const std::string & file, const std::string & mode )
+CByteCodeStream::CByteCodeStream() :
+    m_readPos(0)
 {
-    // Open file for reading
-    m_scpFile.reset( SDL_RWFromFile( file.c_str(), mode.c_str() ) );
-    if( m_scpFile.isNull() )
-        throw NExcept::CCriticalException("AngelScript File Open Error!",
-            boost::str( boost::format("Error Opening file (%s).\n\n%s\nLine: %s") % file % __FUNCTION__ % __LINE__ ));
 }
 
 
@@ -38,29 +41,96 @@ CByteCodeStream::~CByteCodeStream()
 }
 
 /************************************************************************
-*    DESC:  Write the byte code to the file
+*    DESC:  Load the whole file into the buffer in one read
+*           NOTE: SDL is used instead of mapping the file so this also
+*                 works for files packed in the Android assets
+************************************************************************/
+bool CByteCodeStream::load( const std::string & file )
+{
+    NSmart::scoped_SDL_filehandle_ptr<SDL_RWops> scpFile( SDL_RWFromFile( file.c_str(), "rb" ) );
+    if( scpFile.isNull() )
+        return false;
+
+    const Sint64 sizeInBytes = SDL_RWsize( scpFile.get() );
+    if( sizeInBytes < 0 )
+        return false;
+
+    m_bufferVec.resize( (size_t)sizeInBytes );
+    m_readPos = 0;
+
+    if( (sizeInBytes > 0) && (SDL_RWread( scpFile.get(), m_bufferVec.data(), 1, m_bufferVec.size() ) != m_bufferVec.size()) )
+        throw NExcept::CCriticalException("AngelScript File Read Error!",
+            boost::str( boost::format("Error reading file (%s).\n\n%s\nLine: %s") % file % __FUNCTION__ % __LINE__ ));
+
+    return true;
+}
+
+/************************************************************************
+*    DESC:  Save the buffer to the file in one write
+************************************************************************/
+void CByteCodeStream::save( const std::string & file )
+{
+    NSmart::scoped_SDL_filehandle_ptr<SDL_RWops> scpFile( SDL_RWFromFile( file.c_str(), "wb" ) );
+    if( scpFile.isNull() )
+        throw NExcept::CCriticalException("AngelScript File Open Error!",
+            boost::str( boost::format("Error Opening file (%s).\n\n%s\nLine: %s") % file % __FUNCTION__ % __LINE__ ));
+
+    if( !m_bufferVec.empty() && (SDL_RWwrite( scpFile.get(), m_bufferVec.data(), 1, m_bufferVec.size() ) != m_bufferVec.size()) )
+        throw NExcept::CCriticalException("AngelScript File Write Error!",
+            boost::str( boost::format("Error writing file (%s).\n\n%s\nLine: %s") % file % __FUNCTION__ % __LINE__ ));
+}
+
+/************************************************************************
+*    DESC:  Write the cache header that goes before the byte code
+************************************************************************/
+void CByteCodeStream::writeHeader( uint64_t interfaceHash, uint64_t sourceHash )
+{
+    Write( &BYTE_CODE_MAGIC, sizeof(BYTE_CODE_MAGIC) );
+    Write( &interfaceHash, sizeof(interfaceHash) );
+    Write( &sourceHash, sizeof(sourceHash) );
+}
+
+/************************************************************************
+*    DESC:  Read the cache header that goes before the byte code
+*           NOTE: Returns false for files saved without a header
+************************************************************************/
+bool CByteCodeStream::readHeader( uint64_t & interfaceHash, uint64_t & sourceHash )
+{
+    uint32_t magic(0);
+    if( (Read( &magic, sizeof(magic) ) < 0) || (magic != BYTE_CODE_MAGIC) )
+        return false;
+
+    return (Read( &interfaceHash, sizeof(interfaceHash) ) == 0) &&
+           (Read( &sourceHash, sizeof(sourceHash) ) == 0);
+}
+
+/************************************************************************
+*    DESC:  Write the byte code to the buffer
 ************************************************************************/
 int CByteCodeStream::Write( const void *ptr, asUINT sizeInBytes ) 
 {
     if( sizeInBytes > 0 )
     {
-        if( SDL_RWwrite( m_scpFile.get(), ptr, 1, sizeInBytes ) == 0 )
-            return -1;
+        const char * pData = static_cast<const char *>(ptr);
+        m_bufferVec.insert( m_bufferVec.end(), pData, pData + sizeInBytes );
     }
 
     return 0;
 }
 
 /************************************************************************
-*    DESC:  Read the byte code from the file
+*    DESC:  Read the byte code from the buffer
 ************************************************************************/
 int CByteCodeStream::Read( void *ptr, asUINT sizeInBytes ) 
 { 
     if( sizeInBytes > 0 )
     {
-        if( SDL_RWread( m_scpFile.get(), ptr, 1, sizeInBytes ) == 0 )
+        if( (m_bufferVec.size() - m_readPos) < sizeInBytes )
             return -1;
+
+        std::memcpy( ptr, m_bufferVec.data() + m_readPos, sizeInBytes );
+        m_readPos += sizeInBytes;
     }
 
     return 0;
-}
\ No newline at end of file
+}
@@ -10,33 +10,43 @@
 // Physical component dependency
 #include <angelscript.h>
 
-// Game lib dependencies
-#include <utilities/smartpointers.h>
-
 // Standard lib dependencies
 #include <string>
-
-// Forward declaration(s)
-struct SDL_RWops;
+#include <vector>
+#include <cstdint>
 
 class CByteCodeStream : public asIBinaryStream
 {
 public:
 
     // Constructor
-    CByteCodeStream( const std::string & file, const std::string & mode );
+    CByteCodeStream();
 
     // Destructor
     virtual ~CByteCodeStream();
+
+    // Load the whole file into the buffer in one read
+    // NOTE: Returns false if the file can't be opened
+    bool load( const std::string & file );
+
+    // Save the buffer to the file in one write
+    void save( const std::string & file );
+
+    // Write/Read the cache header that goes before the byte code
+    void writeHeader( uint64_t interfaceHash, uint64_t sourceHash );
+    bool readHeader( uint64_t & interfaceHash, uint64_t & sourceHash );
  
-    // Write the byte code to the file
+    // Write the byte code to the buffer
     int Write( const void *ptr, asUINT sizeInBytes ) override;
 
-    // Read the byte code from the file
+    // Read the byte code from the buffer
     int Read( void *ptr, asUINT sizeInBytes ) override;
 
 private:
 
-    // Scoped file handle pointer
-    NSmart::scoped_SDL_filehandle_ptr<SDL_RWops> m_scpFile;
+    // Byte code buffer
+    std::vector<char> m_bufferVec;
+
+    // Read position in the buffer
+    size_t m_readPos;
 };
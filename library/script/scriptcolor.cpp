@@ -12,6 +12,7 @@
 #include <common/color.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptwrap.h>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
@@ -61,35 +62,35 @@ namespace NScriptColor
         Throw( pEngine->RegisterObjectType("CColor", sizeof(CColor), asOBJ_VALUE | asOBJ_POD | asGetTypeTraits<CColor>() | asOBJ_APP_CLASS_ALLFLOATS ) );
 
         // Register the object constructor
-        Throw( pEngine->RegisterObjectBehaviour("CColor", asBEHAVE_CONSTRUCT, "void f()",                           WRAP_OBJ_LAST(Constructor),           asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectBehaviour("CColor", asBEHAVE_CONSTRUCT, "void f(const CColor & in)",          WRAP_OBJ_LAST(CopyConstructor),       asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectBehaviour("CColor", asBEHAVE_CONSTRUCT, "void f(float, float, float, float)", WRAP_OBJ_LAST(ConstructorFromFloats), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectBehaviour("CColor", asBEHAVE_DESTRUCT,  "void f()",                           WRAP_OBJ_LAST(Destructor),            asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectBehaviour("CColor", asBEHAVE_CONSTRUCT, "void f()",                           SCRIPT_OBJ_LAST(Constructor)) );
+        Throw( pEngine->RegisterObjectBehaviour("CColor", asBEHAVE_CONSTRUCT, "void f(const CColor & in)",          SCRIPT_OBJ_LAST(CopyConstructor)) );
+        Throw( pEngine->RegisterObjectBehaviour("CColor", asBEHAVE_CONSTRUCT, "void f(float, float, float, float)", SCRIPT_OBJ_LAST(ConstructorFromFloats)) );
+        Throw( pEngine->RegisterObjectBehaviour("CColor", asBEHAVE_DESTRUCT,  "void f()",                           SCRIPT_OBJ_LAST(Destructor)) );
 
         // assignment operator
-        Throw( pEngine->RegisterObjectMethod("CColor", "CColor & opAssign(const CColor & in)", WRAP_MFN_PR(CColor, operator =, (const CColor &), CColor &), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CColor", "CColor & opAssign(const CColor & in)", SCRIPT_MFN_PR(CColor, operator =, (const CColor &), CColor &)) );
 
         // binary operators
-        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opAdd ( const CColor & in )", WRAP_MFN_PR(CColor, operator +, (const CColor &) const, CColor), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opSub ( const CColor & in )", WRAP_MFN_PR(CColor, operator -, (const CColor &) const, CColor), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opMul ( const CColor & in )", WRAP_MFN_PR(CColor, operator *, (const CColor &) const, CColor), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opDiv ( const CColor & in )", WRAP_MFN_PR(CColor, operator /, (const CColor &) const, CColor), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opAdd ( const CColor & in )", SCRIPT_MFN_PR(CColor, operator +, (const CColor &) const, CColor)) );
+        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opSub ( const CColor & in )", SCRIPT_MFN_PR(CColor, operator -, (const CColor &) const, CColor)) );
+        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opMul ( const CColor & in )", SCRIPT_MFN_PR(CColor, operator *, (const CColor &) const, CColor)) );
+        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opDiv ( const CColor & in )", SCRIPT_MFN_PR(CColor, operator /, (const CColor &) const, CColor)) );
 
-        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opAdd ( float )", WRAP_MFN_PR(CColor, operator +, (float) const, CColor), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opSub ( float )", WRAP_MFN_PR(CColor, operator -, (float) const, CColor), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opMul ( float )", WRAP_MFN_PR(CColor, operator *, (float) const, CColor), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opDiv ( float )", WRAP_MFN_PR(CColor, operator /, (float) const, CColor), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opAdd ( float )", SCRIPT_MFN_PR(CColor, operator +, (float) const, CColor)) );
+        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opSub ( float )", SCRIPT_MFN_PR(CColor, operator -, (float) const, CColor)) );
+        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opMul ( float )", SCRIPT_MFN_PR(CColor, operator *, (float) const, CColor)) );
+        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opDiv ( float )", SCRIPT_MFN_PR(CColor, operator /, (float) const, CColor)) );
 
         // compound assignment operators
-        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opAddAssign ( const CColor & in )", WRAP_MFN_PR(CColor, operator +=, (const CColor &), CColor), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opSubAssign ( const CColor & in )", WRAP_MFN_PR(CColor, operator -=, (const CColor &), CColor), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opMulAssign ( const CColor & in )", WRAP_MFN_PR(CColor, operator *=, (const CColor &), CColor), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opDivAssign ( const CColor & in )", WRAP_MFN_PR(CColor, operator /=, (const CColor &), CColor), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opAddAssign ( const CColor & in )", SCRIPT_MFN_PR(CColor, operator +=, (const CColor &), CColor)) );
+        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opSubAssign ( const CColor & in )", SCRIPT_MFN_PR(CColor, operator -=, (const CColor &), CColor)) );
+        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opMulAssign ( const CColor & in )", SCRIPT_MFN_PR(CColor, operator *=, (const CColor &), CColor)) );
+        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opDivAssign ( const CColor & in )", SCRIPT_MFN_PR(CColor, operator /=, (const CColor &), CColor)) );
 
-        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opAddAssign ( float )", WRAP_MFN_PR(CColor, operator +=, (float), CColor), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opSubAssign ( float )", WRAP_MFN_PR(CColor, operator -=, (float), CColor), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opMulAssign ( float )", WRAP_MFN_PR(CColor, operator *=, (float), CColor), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opDivAssign ( float )", WRAP_MFN_PR(CColor, operator /=, (float), CColor), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opAddAssign ( float )", SCRIPT_MFN_PR(CColor, operator +=, (float), CColor)) );
+        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opSubAssign ( float )", SCRIPT_MFN_PR(CColor, operator -=, (float), CColor)) );
+        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opMulAssign ( float )", SCRIPT_MFN_PR(CColor, operator *=, (float), CColor)) );
+        Throw( pEngine->RegisterObjectMethod("CColor", "CColor opDivAssign ( float )", SCRIPT_MFN_PR(CColor, operator /=, (float), CColor)) );
 
 	    // Register property
         Throw( pEngine->RegisterObjectProperty("CColor", "float r", asOFFSET(CColor, r)) );
@@ -98,8 +99,8 @@ namespace NScriptColor
         Throw( pEngine->RegisterObjectProperty("CColor", "float a", asOFFSET(CColor, a)) );
 
         // Class members
-        Throw( pEngine->RegisterObjectMethod("CColor", "void set( float r, float g, float b, float a )",       WRAP_MFN(CColor, set),          asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CColor", "void transformHSV( float hue, float sat, float val )", WRAP_MFN(CColor, transformHSV), asCALL_GENERIC) );
-	    Throw( pEngine->RegisterObjectMethod("CColor", "void convert()",                                       WRAP_MFN(CColor, convert),      asCALL_GENERIC ) );
+        Throw( pEngine->RegisterObjectMethod("CColor", "void set( float r, float g, float b, float a )",       SCRIPT_MFN(CColor, set)) );
+        Throw( pEngine->RegisterObjectMethod("CColor", "void transformHSV( float hue, float sat, float val )", SCRIPT_MFN(CColor, transformHSV)) );
+	    Throw( pEngine->RegisterObjectMethod("CColor", "void convert()",                                       SCRIPT_MFN(CColor, convert) ) );
     }
 }
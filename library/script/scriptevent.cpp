@@ -11,6 +11,7 @@
 // Game lib dependencies
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptwrap.h>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
@@ -157,12 +158,12 @@ namespace NScriptEvent
         Throw( pEngine->RegisterObjectProperty("CTextEditingEvent", "uint windowID",       asOFFSET(SDL_TextEditingEvent, windowID)) );
         Throw( pEngine->RegisterObjectProperty("CTextEditingEvent", "int start",           asOFFSET(SDL_TextEditingEvent, start)) );
         Throw( pEngine->RegisterObjectProperty("CTextEditingEvent", "int length",          asOFFSET(SDL_TextEditingEvent, length)) );
-        Throw( pEngine->RegisterObjectMethod("CTextEditingEvent", "const string & getStr()", WRAP_OBJ_LAST(GetTextEditingString), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CTextEditingEvent", "const string & getStr()", SCRIPT_OBJ_LAST(GetTextEditingString)) );
 
         Throw( pEngine->RegisterObjectProperty("CTextInputEvent", "uint type",             asOFFSET(SDL_TextInputEvent, type)) );
         Throw( pEngine->RegisterObjectProperty("CTextInputEvent", "uint timestamp",        asOFFSET(SDL_TextInputEvent, timestamp)) );
         Throw( pEngine->RegisterObjectProperty("CTextInputEvent", "uint windowID",         asOFFSET(SDL_TextInputEvent, windowID)) );
-        Throw( pEngine->RegisterObjectMethod("CTextInputEvent", "const string & getStr()", WRAP_OBJ_LAST(GetTextInputString), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CTextInputEvent", "const string & getStr()", SCRIPT_OBJ_LAST(GetTextInputString)) );
 
         Throw( pEngine->RegisterObjectProperty("CMouseMotionEvent", "uint type",           asOFFSET(SDL_MouseMotionEvent, type)) );
         Throw( pEngine->RegisterObjectProperty("CMouseMotionEvent", "uint timestamp",      asOFFSET(SDL_MouseMotionEvent, timestamp)) );
@@ -285,6 +286,6 @@ namespace NScriptEvent
         Throw( pEngine->RegisterObjectProperty("CDropEvent", "uint type",                  asOFFSET(SDL_DropEvent, type)) );
         Throw( pEngine->RegisterObjectProperty("CDropEvent", "uint timestamp",             asOFFSET(SDL_DropEvent, timestamp)) );
         Throw( pEngine->RegisterObjectProperty("CDropEvent", "uint windowID",              asOFFSET(SDL_DropEvent, windowID)) );
-        Throw( pEngine->RegisterObjectMethod("CDropEvent", "const string & getFileStr()",  WRAP_OBJ_LAST(GetFileString), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CDropEvent", "const string & getFileStr()",  SCRIPT_OBJ_LAST(GetFileString)) );
      }
 }
\ No newline at end of file
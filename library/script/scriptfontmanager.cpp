@@ -12,6 +12,7 @@
 #include <managers/fontmanager.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptwrap.h>
 #include <utilities/exceptionhandling.h>
 
 // AngelScript lib dependencies
@@ -51,7 +52,7 @@ namespace NScriptFontManager
         // Register type
         Throw( pEngine->RegisterObjectType( "CFontMgr", 0, asOBJ_REF|asOBJ_NOCOUNT) );
 
-        Throw( pEngine->RegisterObjectMethod("CFontMgr", "void load(string &in)", WRAP_OBJ_LAST(Load), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CFontMgr", "void load(string &in)", SCRIPT_OBJ_LAST(Load)) );
         
         // Set this object registration as a global property to simulate a singleton
         Throw( pEngine->RegisterGlobalProperty("CFontMgr FontMgr", &CFontMgr::Instance()) );
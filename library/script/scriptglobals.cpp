@@ -7,6 +7,7 @@
 
 // Physical component dependency
 #include <script/scriptglobals.h>
+#include <script/scriptwrap.h>
 
 // Game lib dependencies
 #include <utilities/highresolutiontimer.h>
@@ -164,10 +165,10 @@ namespace NScriptGlobals
 
         Throw( pEngine->RegisterGlobalFunction("int RandInt(int, int)", asFUNCTION(RandInt), asCALL_GENERIC) );
         Throw( pEngine->RegisterGlobalFunction("float RandFloat(float, float)", asFUNCTION(RandFloat), asCALL_GENERIC) );
-        Throw( pEngine->RegisterGlobalFunction("void Print(string &in)", WRAP_FN(NGenFunc::PostDebugMsg), asCALL_GENERIC) );
+        Throw( pEngine->RegisterGlobalFunction("void Print(string &in)", SCRIPT_FN(NGenFunc::PostDebugMsg)) );
         Throw( pEngine->RegisterGlobalFunction("void Suspend()", asFUNCTION(Suspend), asCALL_GENERIC) );
-        Throw( pEngine->RegisterGlobalFunction("int UniformRandomInt(int startRange, int endRange, int seed = 0)", WRAP_FN(NGenFunc::UniformRandomInt), asCALL_GENERIC ) );
-        Throw( pEngine->RegisterGlobalFunction("float UniformRandomFloat(float startRange, float endRange, int seed = 0)", WRAP_FN(NGenFunc::UniformRandomFloat), asCALL_GENERIC ) );
+        Throw( pEngine->RegisterGlobalFunction("int UniformRandomInt(int startRange, int endRange, int seed = 0)", SCRIPT_FN(NGenFunc::UniformRandomInt) ) );
+        Throw( pEngine->RegisterGlobalFunction("float UniformRandomFloat(float startRange, float endRange, int seed = 0)", SCRIPT_FN(NGenFunc::UniformRandomFloat) ) );
         // The DispatchEvent function has 4 parameters and because they are not defined here, they only return garbage
         // AngelScript is not allowing the other two voided pointers
         Throw( pEngine->RegisterGlobalFunction("int DispatchEvent(int type, int code = 0)", asFUNCTION(DispatchEvent), asCALL_GENERIC) );
@@ -12,6 +12,7 @@
 #include <utilities/highresolutiontimer.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptwrap.h>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
@@ -31,11 +32,11 @@ namespace NScriptHighResolutionTimer
         // Register type
         Throw( pEngine->RegisterObjectType( "CHighResTimer", 0, asOBJ_REF|asOBJ_NOCOUNT) );
         
-        Throw( pEngine->RegisterObjectMethod("CHighResTimer", "void calcElapsedTime()",  WRAP_MFN(CHighResTimer, calcElapsedTime), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CHighResTimer", "double getElapsedTime()", WRAP_MFN(CHighResTimer, getElapsedTime),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CHighResTimer", "void timerStart()",       WRAP_MFN(CHighResTimer, timerStart),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CHighResTimer", "float timerStop()",       WRAP_MFN(CHighResTimer, timerStop),       asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CHighResTimer", "double getTime()",        WRAP_MFN(CHighResTimer, getTime),         asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CHighResTimer", "void calcElapsedTime()",  SCRIPT_MFN(CHighResTimer, calcElapsedTime)) );
+        Throw( pEngine->RegisterObjectMethod("CHighResTimer", "double getElapsedTime()", SCRIPT_MFN(CHighResTimer, getElapsedTime)) );
+        Throw( pEngine->RegisterObjectMethod("CHighResTimer", "void timerStart()",       SCRIPT_MFN(CHighResTimer, timerStart)) );
+        Throw( pEngine->RegisterObjectMethod("CHighResTimer", "float timerStop()",       SCRIPT_MFN(CHighResTimer, timerStop)) );
+        Throw( pEngine->RegisterObjectMethod("CHighResTimer", "double getTime()",        SCRIPT_MFN(CHighResTimer, getTime)) );
 
         // Set this object registration as a global property to simulate a singleton
         Throw( pEngine->RegisterGlobalProperty("CHighResTimer HighResTimer", &CHighResTimer::Instance()) );
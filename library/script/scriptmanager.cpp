@@ -16,17 +16,32 @@
 #include <utilities/threadpool.h>
 #include <script/bytecodestream.h>
 
+// SDL lib dependencies
+#include <SDL2/SDL.h>
+
 // Boost lib dependencies
 #include <boost/format.hpp>
+#include <boost/crc.hpp>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
 
+// Standard lib dependencies
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+// 64 bit CRC used to key the byte code cache
+typedef boost::crc_optimal<64, 0x42F0E1EBA9EA3693, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, true, true> crc64_t;
+
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
 CScriptMgr::CScriptMgr()
 {
+    // Scripts are executed from the thread pool
+    asPrepareMultithread();
+
     // Create the script engine
     scpEngine.reset( asCreateScriptEngine(ANGELSCRIPT_VERSION) );
     if( scpEngine.isNull() )
@@ -85,14 +100,9 @@ void CScriptMgr::loadUniqueData( const XMLNode & node, const std::string & group
                             % group % __FUNCTION__ % __LINE__ ));
                 }
 
-                // Save the byte code
-                CByteCodeStream byteCode( byteCodePath, "wb" );
-                if( pScriptModule->SaveByteCode( &byteCode, CSettings::Instance().getStripDebugInfo() ) < 0 )
-                {
-                    throw NExcept::CCriticalException("Script Byte Code Save Error!",
-                        boost::str( boost::format("Error writing script byte code (%s).\n\n%s\nLine: %s")
-                            % group % __FUNCTION__ % __LINE__ ));
-                }
+                // Save the byte code with the hash of the scripts it was built from
+                std::vector<std::vector<char>> sourceVecVec;
+                saveByteCode( pScriptModule, group, byteCodePath, loadSources( m_listTableMap[group], sourceVecVec ) );
 
                 // Discard this module and all it's contents.
                 // It will be reloaded through the normal process and will error if it's not discarded
@@ -108,6 +118,8 @@ void CScriptMgr::loadUniqueData( const XMLNode & node, const std::string & group
 ************************************************************************/
 void CScriptMgr::clear()
 {
+    std::lock_guard<std::mutex> lock( m_contextMutex );
+
     // Release the context pool
     for( auto iter : m_pContextPoolVec )
         iter->Release();
@@ -128,6 +140,8 @@ void CScriptMgr::clear()
 ************************************************************************/
 void CScriptMgr::loadGroup( const std::string & group, const bool forceLoadFromScript )
 {
+    const auto startTime = std::chrono::steady_clock::now();
+
     // Make sure the group we are looking has been defined in the list table file
     auto listTableIter = m_listTableMap.find( group );
     if( listTableIter == m_listTableMap.end() )
@@ -146,38 +160,312 @@ void CScriptMgr::loadGroup( const std::string & group, const bool forceLoadFromS
 
     // See if we have the file path to the byte code
     auto byteCodeFileIter = m_byteCodeFileMap.find( group );
+    const bool useByteCodeFile = (byteCodeFileIter != m_byteCodeFileMap.end()) && !forceLoadFromScript;
+    const char * pLoadedFrom = "scripts";
+    bool byteCodeLoaded = false;
+    bool byteCodeRejected = false;
 
     // Load the byte code
-    if( CSettings::Instance().getLoadByteCode() && byteCodeFileIter != m_byteCodeFileMap.end() && !forceLoadFromScript )
+    // The scripts may not be shipped with the byte code so only the engine interface can be checked
+    if( useByteCodeFile && CSettings::Instance().getLoadByteCode() )
     {
-        CByteCodeStream byteCode( byteCodeFileIter->second, "rb" );
-        if( pScriptModule->LoadByteCode( &byteCode ) < 0 )
+        byteCodeLoaded = loadByteCodeFile( pScriptModule, byteCodeFileIter->second );
+        byteCodeRejected = !byteCodeLoaded;
+
+        if( byteCodeLoaded )
+            pLoadedFrom = "byte code";
+    }
+
+    // Build from the scripts if there's no byte code or it can't be used
+    if( !byteCodeLoaded )
+    {
+        // The cache is written to the pref path because the shipped byte code files can be read only
+        const std::string cachePath =
+            (useByteCodeFile && CSettings::Instance().getByteCodeCache()) ? getByteCodeCachePath( byteCodeFileIter->second ) : std::string();
+        const bool useCache = !cachePath.empty();
+
+        std::vector<std::vector<char>> sourceVecVec;
+        uint64_t sourceHash(0);
+
+        try
+        {
+            sourceHash = loadSources( listTableIter->second, sourceVecVec );
+        }
+        catch( NExcept::CCriticalException & ex )
         {
+            if( !byteCodeRejected )
+                throw;
+
             throw NExcept::CCriticalException("Script Byte Code Load Error!",
-                boost::str( boost::format("Error loading script byte code (%s).\n\n%s\nLine: %s")
-                    % group % __FUNCTION__ % __LINE__ ));
+                boost::str( boost::format("Script byte code is out of date and the scripts to build it can't be loaded (%s). "
+                    "Rebuild the byte code by running once with saveByteCode=\"true\".\n\n%s\n\n%s\nLine: %s")
+                    % byteCodeFileIter->second % ex.getErrorMsg() % __FUNCTION__ % __LINE__ ));
+        }
+
+        // Use the cached byte code if it was built from the same scripts and engine interface
+        if( useCache && loadByteCodeCache( pScriptModule, cachePath, sourceHash ) )
+        {
+            pLoadedFrom = "cache";
+        }
+        else
+        {
+            // Add the scripts to the module
+            for( size_t i = 0; i < sourceVecVec.size(); ++i )
+                addScript( pScriptModule, listTableIter->second[i], sourceVecVec[i] );
+
+            // Build all the scripts added to the module
+            buildScript( pScriptModule, group );
+
+            // Failing to update the cache only costs a rebuild on the next run
+            if( useCache )
+            {
+                try
+                {
+                    saveByteCode( pScriptModule, group, cachePath, sourceHash );
+                }
+                catch( NExcept::CCriticalException & ex )
+                {
+                    NGenFunc::PostDebugMsg( ex.getErrorMsg() );
+                }
+            }
         }
     }
-    else
+
+    const float loadTime = std::chrono::duration<float, std::milli>( std::chrono::steady_clock::now() - startTime ).count();
+    CStatCounter::Instance().addScriptLoadTime( loadTime );
+
+    NGenFunc::PostDebugMsg( boost::str( boost::format("Script group %s loaded from %s in %.1fms") % group % pLoadedFrom % loadTime ) );
+}
+
+
+/************************************************************************
+*    DESC:  Load the scripts of a group
+*
+*    ret: uint64_t - hash of the file paths and their contents
+************************************************************************/
+uint64_t CScriptMgr::loadSources( const std::vector<std::string> & filePathVec, std::vector<std::vector<char>> & sourceVecVec )
+{
+    crc64_t crc;
+    sourceVecVec.reserve( filePathVec.size() );
+
+    for( auto & iter : filePathVec )
     {
-        // Add the scripts to the module
-        for( auto & iter : listTableIter->second )
-            addScript( pScriptModule, iter );
+        sourceVecVec.push_back( NGenFunc::FileToVec( iter, NGenFunc::TERMINATE ) );
 
-        // Build all the scripts added to the module
-        buildScript( pScriptModule, group );
+        // The file path is the section name so it's part of the hash
+        crc.process_bytes( iter.c_str(), iter.size() + 1 );
+        crc.process_bytes( sourceVecVec.back().data(), sourceVecVec.back().size() );
     }
+
+    return crc.checksum();
 }
 
 
 /************************************************************************
-*    DESC:  Add the script to the module
+*    DESC:  Get the hash of everything registered with the engine
+*           NOTE: Byte code refers to the registered interface by
+*                 declaration so any change to it makes the byte code stale
 ************************************************************************/
-void CScriptMgr::addScript( asIScriptModule * pScriptModule, const std::string & filePath )
+uint64_t CScriptMgr::getInterfaceHash()
 {
-    // Load the script file into a charater array
-    std::vector<char> bufVec = NGenFunc::FileToVec( filePath, NGenFunc::TERMINATE );
+    crc64_t crc;
+
+    auto processStr = [&crc]( const char * pStr )
+    {
+        if( pStr != nullptr )
+            crc.process_bytes( pStr, std::strlen( pStr ) + 1 );
+        else
+            crc.process_byte( 0 );
+    };
+
+    processStr( ANGELSCRIPT_VERSION_STRING );
+    processStr( asGetLibraryOptions() );
+
+    for( asUINT i = 0; i < scpEngine->GetObjectTypeCount(); ++i )
+    {
+        asITypeInfo * pType = scpEngine->GetObjectTypeByIndex( i );
+        processStr( pType->GetNamespace() );
+        processStr( pType->GetName() );
+
+        const asDWORD flags = pType->GetFlags();
+        crc.process_bytes( &flags, sizeof(flags) );
+
+        for( asUINT j = 0; j < pType->GetFactoryCount(); ++j )
+            processStr( pType->GetFactoryByIndex( j )->GetDeclaration( true, true ) );
+
+        for( asUINT j = 0; j < pType->GetBehaviourCount(); ++j )
+        {
+            asEBehaviours behaviour;
+            processStr( pType->GetBehaviourByIndex( j, &behaviour )->GetDeclaration( true, true ) );
+            crc.process_bytes( &behaviour, sizeof(behaviour) );
+        }
+
+        for( asUINT j = 0; j < pType->GetMethodCount(); ++j )
+            processStr( pType->GetMethodByIndex( j )->GetDeclaration( true, true ) );
+
+        for( asUINT j = 0; j < pType->GetPropertyCount(); ++j )
+            processStr( pType->GetPropertyDeclaration( j, true ) );
+    }
+
+    for( asUINT i = 0; i < scpEngine->GetGlobalFunctionCount(); ++i )
+        processStr( scpEngine->GetGlobalFunctionByIndex( i )->GetDeclaration( true, true ) );
+
+    for( asUINT i = 0; i < scpEngine->GetGlobalPropertyCount(); ++i )
+    {
+        const char * pName(nullptr);
+        const char * pNameSpace(nullptr);
+        int typeId(0);
+        bool isConst(false);
+
+        scpEngine->GetGlobalPropertyByIndex( i, &pName, &pNameSpace, &typeId, &isConst );
+        processStr( pNameSpace );
+        processStr( pName );
+        processStr( scpEngine->GetTypeDeclaration( typeId, true ) );
+        crc.process_byte( isConst );
+    }
+
+    for( asUINT i = 0; i < scpEngine->GetEnumCount(); ++i )
+    {
+        asITypeInfo * pEnum = scpEngine->GetEnumByIndex( i );
+        processStr( pEnum->GetNamespace() );
+        processStr( pEnum->GetName() );
+
+        for( asUINT j = 0; j < pEnum->GetEnumValueCount(); ++j )
+        {
+            int value(0);
+            processStr( pEnum->GetEnumValueByIndex( j, &value ) );
+            crc.process_bytes( &value, sizeof(value) );
+        }
+    }
+
+    for( asUINT i = 0; i < scpEngine->GetFuncdefCount(); ++i )
+        processStr( scpEngine->GetFuncdefByIndex( i )->GetFuncdefSignature()->GetDeclaration( true, true ) );
+
+    for( asUINT i = 0; i < scpEngine->GetTypedefCount(); ++i )
+    {
+        asITypeInfo * pTypedef = scpEngine->GetTypedefByIndex( i );
+        processStr( pTypedef->GetNamespace() );
+        processStr( pTypedef->GetName() );
+        processStr( scpEngine->GetTypeDeclaration( pTypedef->GetTypedefTypeId(), true ) );
+    }
+
+    return crc.checksum();
+}
+
 
+/************************************************************************
+*    DESC:  Load the byte code file of a group
+*
+*    NOTE:  Files saved before the header was added or for a different
+*           engine interface are rejected so the scripts can be built
+*
+*    ret: bool - false if the scripts need to be built
+************************************************************************/
+bool CScriptMgr::loadByteCodeFile( asIScriptModule * pScriptModule, const std::string & filePath )
+{
+    CByteCodeStream byteCode;
+    if( !byteCode.load( filePath ) )
+    {
+        NGenFunc::PostDebugMsg( boost::str( boost::format("Script byte code can't be opened, building the scripts (%s)") % filePath ) );
+        return false;
+    }
+
+    uint64_t interfaceHash(0), sourceHash(0);
+    if( !byteCode.readHeader( interfaceHash, sourceHash ) || (interfaceHash != getInterfaceHash()) )
+    {
+        NGenFunc::PostDebugMsg( boost::str( boost::format("Script byte code is out of date, building the scripts (%s)") % filePath ) );
+        return false;
+    }
+
+    // A failed load leaves the module empty so it can still be built from the scripts
+    if( pScriptModule->LoadByteCode( &byteCode ) < 0 )
+    {
+        NGenFunc::PostDebugMsg( boost::str( boost::format("Script byte code could not be loaded, building the scripts (%s)") % filePath ) );
+        return false;
+    }
+
+    return true;
+}
+
+
+/************************************************************************
+*    DESC:  Get the path of the byte code cache in the pref path
+*
+*    ret: string - empty if there's no pref path to write to
+************************************************************************/
+std::string CScriptMgr::getByteCodeCachePath( const std::string & byteCodeFile )
+{
+    char * pPrefPath = SDL_GetPrefPath( CSettings::Instance().getEngineName().c_str(), CSettings::Instance().getGameName().c_str() );
+    if( pPrefPath == nullptr )
+        return std::string();
+
+    // Flatten the byte code file path so the groups don't need sub folders
+    std::string fileName = byteCodeFile;
+    std::replace( fileName.begin(), fileName.end(), '/', '_' );
+    std::replace( fileName.begin(), fileName.end(), '\\', '_' );
+
+    const std::string cachePath = std::string(pPrefPath) + fileName;
+    SDL_free(pPrefPath);
+
+    return cachePath;
+}
+
+
+/************************************************************************
+*    DESC:  Load the cached byte code if it's not stale
+*
+*    ret: bool - false if the scripts need to be built
+************************************************************************/
+bool CScriptMgr::loadByteCodeCache( asIScriptModule * pScriptModule, const std::string & filePath, uint64_t sourceHash )
+{
+    CByteCodeStream byteCode;
+    if( !byteCode.load( filePath ) )
+        return false;
+
+    uint64_t interfaceHash(0), cachedSourceHash(0);
+    if( !byteCode.readHeader( interfaceHash, cachedSourceHash ) ||
+        (cachedSourceHash != sourceHash) ||
+        (interfaceHash != getInterfaceHash()) )
+    {
+        NGenFunc::PostDebugMsg( boost::str( boost::format("Script byte code cache is stale (%s)") % filePath ) );
+        return false;
+    }
+
+    // A failed load leaves the module empty so it can still be built from the scripts
+    if( pScriptModule->LoadByteCode( &byteCode ) < 0 )
+    {
+        NGenFunc::PostDebugMsg( boost::str( boost::format("Script byte code cache could not be loaded (%s)") % filePath ) );
+        return false;
+    }
+
+    return true;
+}
+
+
+/************************************************************************
+*    DESC:  Save the byte code of a built module
+************************************************************************/
+void CScriptMgr::saveByteCode( asIScriptModule * pScriptModule, const std::string & group, const std::string & filePath, uint64_t sourceHash )
+{
+    CByteCodeStream byteCode;
+    byteCode.writeHeader( getInterfaceHash(), sourceHash );
+
+    if( pScriptModule->SaveByteCode( &byteCode, CSettings::Instance().getStripDebugInfo() ) < 0 )
+    {
+        throw NExcept::CCriticalException("Script Byte Code Save Error!",
+            boost::str( boost::format("Error writing script byte code (%s).\n\n%s\nLine: %s")
+                % group % __FUNCTION__ % __LINE__ ));
+    }
+
+    byteCode.save( filePath );
+}
+
+
+/************************************************************************
+*    DESC:  Add the script to the module
+************************************************************************/
+void CScriptMgr::addScript( asIScriptModule * pScriptModule, const std::string & filePath, const std::vector<char> & bufVec )
+{
     // Load script into module section - the file path is it's ID
     if( pScriptModule->AddScriptSection(filePath.c_str(), bufVec.data() ) < 0 )
     {
@@ -212,6 +500,8 @@ void CScriptMgr::buildScript( asIScriptModule * pScriptModule, const std::string
 ************************************************************************/
 asIScriptContext * CScriptMgr::getContext()
 {
+    std::unique_lock<std::mutex> lock( m_contextMutex );
+
     // Set the active contex counter
     CStatCounter::Instance().setActiveContexCounter( ++m_activeContextCounter );
 
@@ -226,6 +516,8 @@ asIScriptContext * CScriptMgr::getContext()
         return pContex;
     }
 
+    lock.unlock();
+
     return scpEngine->CreateContext();
 }
 
@@ -235,6 +527,8 @@ asIScriptContext * CScriptMgr::getContext()
 ************************************************************************/
 void CScriptMgr::recycleContext( asIScriptContext * pContext )
 {
+    std::lock_guard<std::mutex> lock( m_contextMutex );
+
     if( m_pContextPoolVec.size() < (float)m_activeContextCounter * m_maxPoolPercentage )
         m_pContextPoolVec.push_back( pContext );
     else
@@ -250,6 +544,8 @@ void CScriptMgr::recycleContext( asIScriptContext * pContext )
 ************************************************************************/
 asIScriptFunction * CScriptMgr::getPtrToFunc( const std::string & group, const std::string & name )
 {
+    std::lock_guard<std::mutex> lock( m_lookupMutex );
+
     // Create the map group if it doesn't already exist
     auto mapMapIter = m_scriptFunctMapMap.find( group );
     if( mapMapIter == m_scriptFunctMapMap.end() )
@@ -292,6 +588,8 @@ asIScriptFunction * CScriptMgr::getPtrToFunc( const std::string & group, const s
 ************************************************************************/
 asITypeInfo * CScriptMgr::getPtrToTypeInfo( const std::string & typeDecl )
 {
+    std::lock_guard<std::mutex> lock( m_lookupMutex );
+
     // See if this declaration pointer has already been saved
     auto mapIter = m_pTypeDeclMap.find( typeDecl );
     if( mapIter == m_pTypeDeclMap.end() )
@@ -362,7 +660,16 @@ void CScriptMgr::prepare(
     const std::string & funcName,
     const std::vector<CScriptParam> & paramVec )
 {
-    prepare( group, funcName, m_pActiveContextVec, paramVec );
+    // Get a context from the script manager pool
+    asIScriptContext * pContext = getContext();
+
+    // The active contexts can be added to from the script lanes
+    {
+        std::lock_guard<std::mutex> lock( m_contextMutex );
+        m_pActiveContextVec.push_back( pContext );
+    }
+
+    prepare( group, funcName, pContext, paramVec );
 }
 
 void CScriptMgr::prepare(
@@ -444,7 +751,7 @@ void CScriptMgr::prepareSpawn( const std::string & funcName, const std::string &
             grp = pContex->GetFunction()->GetModuleName();
 
         // Prepare the script function to run
-        prepare( grp, funcName, m_pActiveContextVec );
+        prepare( grp, funcName );
     }
 }
 
@@ -471,7 +778,7 @@ void CScriptMgr::spawnByThread( const std::string & funcName, const std::string
         // Use the thread pool if active.
         if( CThreadPool::Instance().isActive() )
         {
-            CThreadPool::Instance().post( &CScriptMgr::executeFromThread, this, pContex );
+            CThreadPool::Instance().postBackground( &CScriptMgr::executeFromThread, this, pContex );
         }
         else
         {
@@ -500,18 +807,15 @@ void CScriptMgr::executeFromThread( asIScriptContext * pContext )
     }
     catch( NExcept::CCriticalException & ex )
     {
-        m_errorTitle = ex.getErrorTitle();
-        m_errorMsg = ex.getErrorMsg();
+        setThreadError( ex.getErrorTitle(), ex.getErrorMsg() );
     }
     catch( std::exception const & ex )
     {
-        m_errorTitle = "Standard Exception";
-        m_errorMsg = ex.what();
+        setThreadError( "Standard Exception", ex.what() );
     }
     catch(...)
     {
-        m_errorTitle = "Unknown Error";
-        m_errorMsg = "Something bad happened and I'm not sure what it was.";
+        setThreadError( "Unknown Error", "Something bad happened and I'm not sure what it was." );
     }
     
     // release it here
@@ -519,14 +823,32 @@ void CScriptMgr::executeFromThread( asIScriptContext * pContext )
 }
 
 
+/************************************************************************
+*    DESC:  Keep the first error from a thread to be thrown on the main thread
+************************************************************************/
+void CScriptMgr::setThreadError( const std::string & title, const std::string & msg )
+{
+    std::lock_guard<std::mutex> lock( m_errorMutex );
+
+    if( m_errorMsg.empty() )
+    {
+        m_errorTitle = title;
+        m_errorMsg = msg;
+    }
+}
+
+
 /************************************************************************
 *    DESC:  Update the script
 ************************************************************************/
 bool CScriptMgr::update()
 {
     // Re-throw any threaded exceptions
-    if( !m_errorMsg.empty() )
-        throw NExcept::CCriticalException( m_errorTitle, m_errorMsg );
+    {
+        std::lock_guard<std::mutex> lock( m_errorMutex );
+        if( !m_errorMsg.empty() )
+            throw NExcept::CCriticalException( m_errorTitle, m_errorMsg );
+    }
     
     if( !m_pActiveContextVec.empty() )
         update( m_pActiveContextVec );
@@ -18,6 +18,8 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <mutex>
+#include <cstdint>
 
 // Forward declaration(s)
 class asIScriptEngine;
@@ -27,6 +29,18 @@ class asIScriptFunction;
 class asITypeInfo;
 struct asSMessageInfo;
 
+/************************************************************************
+*    Thread safety
+*
+*    Safe from any thread, including the strategy's script lanes:
+*      getContext, recycleContext, prepare, prepareSpawn, spawnByThread,
+*      getPtrToFunc, getPtrToTypeInfo and update( pContextVec ) on a
+*      context vector only that thread uses
+*
+*    Main thread only:
+*      loading and freeing groups, clear, update() of the active contexts
+*      and anything that creates or deletes nodes, sprites or strategies
+************************************************************************/
 class CScriptMgr : public CManagerBase
 {
 public:
@@ -107,7 +121,25 @@ private:
     virtual ~CScriptMgr();
 
     // Add the script to the module
-    void addScript( asIScriptModule * pScriptModule, const std::string & filePath );
+    void addScript( asIScriptModule * pScriptModule, const std::string & filePath, const std::vector<char> & bufVec );
+
+    // Load the scripts of a group and return the hash of their contents
+    uint64_t loadSources( const std::vector<std::string> & filePathVec, std::vector<std::vector<char>> & sourceVecVec );
+
+    // Get the hash of everything registered with the engine
+    uint64_t getInterfaceHash();
+
+    // Load the byte code file of a group
+    bool loadByteCodeFile( asIScriptModule * pScriptModule, const std::string & filePath );
+
+    // Get the path of the byte code cache in the pref path
+    std::string getByteCodeCachePath( const std::string & byteCodeFile );
+
+    // Load the cached byte code if it's not stale
+    bool loadByteCodeCache( asIScriptModule * pScriptModule, const std::string & filePath, uint64_t sourceHash );
+
+    // Save the byte code of a built module
+    void saveByteCode( asIScriptModule * pScriptModule, const std::string & group, const std::string & filePath, uint64_t sourceHash );
 
     // Build all the scripts added to the module
     void buildScript( asIScriptModule * pScriptModule, const std::string & group );
@@ -121,6 +153,9 @@ private:
     // Execute the script from thread
     void executeFromThread( asIScriptContext * pContext );
 
+    // Keep the first error from a thread to be thrown on the main thread
+    void setThreadError( const std::string & title, const std::string & msg );
+
 private:
 
     const bool FORCE_LOAD_FROM_SCRIPT = true;
@@ -139,11 +174,20 @@ private:
     
     // Holds active contexts that are executing scripts
     std::vector<asIScriptContext *> m_pActiveContextVec;
+
+    // Guards the context pool, the active context vector and the counter
+    std::mutex m_contextMutex;
+
+    // Guards the function and type declaration maps
+    std::mutex m_lookupMutex;
     
     // Error string messages
     std::string m_errorTitle;
     std::string m_errorMsg;
 
+    // Guards the error strings set from the threads
+    std::mutex m_errorMutex;
+
     // Active context counter
     int m_activeContextCounter = 0;
 
@@ -12,6 +12,7 @@
 #include <gui/menu.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptwrap.h>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
@@ -122,42 +123,42 @@ namespace NScriptMenu
         // Register type
         Throw( pEngine->RegisterObjectType(  "CMenu", 0, asOBJ_REF|asOBJ_NOCOUNT) );
 
-        Throw( pEngine->RegisterObjectMethod("CMenu", "void setAlpha(float alpha)",                            WRAP_MFN(CMenu, setAlpha),              asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CMenu", "float getAlpha()",                                      WRAP_MFN(CMenu, getAlpha),              asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CMenu", "void setAlpha(float alpha)",                            SCRIPT_MFN(CMenu, setAlpha)) );
+        Throw( pEngine->RegisterObjectMethod("CMenu", "float getAlpha()",                                      SCRIPT_MFN(CMenu, getAlpha)) );
 
-        Throw( pEngine->RegisterObjectMethod("CMenu", "uiControl & getControl(string &in)",                    WRAP_MFN(CMenu, getPtrToControl),       asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CMenu", "uiControl & getActiveControl()",                        WRAP_MFN(CMenu, getPtrToActiveControl), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CMenu", "uiControl & getControl(string &in)",                    SCRIPT_MFN(CMenu, getPtrToControl)) );
+        Throw( pEngine->RegisterObjectMethod("CMenu", "uiControl & getActiveControl()",                        SCRIPT_MFN(CMenu, getPtrToActiveControl)) );
 
-        Throw( pEngine->RegisterObjectMethod("CMenu", "bool isActive()",                                       WRAP_MFN(CMenu, isActive),              asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CMenu", "void activateFirstInactiveControl()",                   WRAP_MFN(CMenu, activateFirstInactiveControl), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CMenu", "void deactivateAllControls()",                          WRAP_MFN(CMenu, deactivateAllControls), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CMenu", "bool isActive()",                                       SCRIPT_MFN(CMenu, isActive)) );
+        Throw( pEngine->RegisterObjectMethod("CMenu", "void activateFirstInactiveControl()",                   SCRIPT_MFN(CMenu, activateFirstInactiveControl)) );
+        Throw( pEngine->RegisterObjectMethod("CMenu", "void deactivateAllControls()",                          SCRIPT_MFN(CMenu, deactivateAllControls)) );
 
         // Object pos, rot & scale
-        Throw( pEngine->RegisterObjectMethod("CMenu", "void setVisible(bool)",                                 WRAP_OBJ_LAST(SetVisible), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CMenu", "bool isVisible()",                                      WRAP_OBJ_LAST(IsVisible),  asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CMenu", "void setVisible(bool)",                                 SCRIPT_OBJ_LAST(SetVisible)) );
+        Throw( pEngine->RegisterObjectMethod("CMenu", "bool isVisible()",                                      SCRIPT_OBJ_LAST(IsVisible)) );
 
-        Throw( pEngine->RegisterObjectMethod("CMenu", "void setPos(CPoint &in)",                               WRAP_OBJ_LAST(SetPos1),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CMenu", "void setPos(float x = 0, float y = 0, float z = 0)",    WRAP_OBJ_LAST(SetPos2),    asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CMenu", "void setPos(CPoint &in)",                               SCRIPT_OBJ_LAST(SetPos1)) );
+        Throw( pEngine->RegisterObjectMethod("CMenu", "void setPos(float x = 0, float y = 0, float z = 0)",    SCRIPT_OBJ_LAST(SetPos2)) );
 
-        Throw( pEngine->RegisterObjectMethod("CMenu", "void incPos(CPoint & in)",                              WRAP_OBJ_LAST(IncPos1),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CMenu", "void incPos(float x = 0, float y = 0, float z = 0)",    WRAP_OBJ_LAST(IncPos2),    asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CMenu", "void incPos(CPoint & in)",                              SCRIPT_OBJ_LAST(IncPos1)) );
+        Throw( pEngine->RegisterObjectMethod("CMenu", "void incPos(float x = 0, float y = 0, float z = 0)",    SCRIPT_OBJ_LAST(IncPos2)) );
 
-        Throw( pEngine->RegisterObjectMethod("CMenu", "const CPoint & getPos()",                               WRAP_OBJ_LAST(GetPos),     asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CMenu", "const CPoint & getPos()",                               SCRIPT_OBJ_LAST(GetPos)) );
 
-        Throw( pEngine->RegisterObjectMethod("CMenu", "void setRot(CPoint &in, bool convertToRadians = true)", WRAP_OBJ_LAST(SetRot1),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CMenu", "void setRot(float x = 0, float y = 0, float z = 0, bool convertToRadians = true)", WRAP_OBJ_LAST(SetRot2), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CMenu", "void setRot(CPoint &in, bool convertToRadians = true)", SCRIPT_OBJ_LAST(SetRot1)) );
+        Throw( pEngine->RegisterObjectMethod("CMenu", "void setRot(float x = 0, float y = 0, float z = 0, bool convertToRadians = true)", SCRIPT_OBJ_LAST(SetRot2)) );
 
-        Throw( pEngine->RegisterObjectMethod("CMenu", "void incRot(CPoint &in, bool convertToRadians = true)", WRAP_OBJ_LAST(IncRot1),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CMenu", "void incRot(float x = 0, float y = 0, float z = 0, bool convertToRadians = true)", WRAP_OBJ_LAST(IncRot2), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CMenu", "void incRot(CPoint &in, bool convertToRadians = true)", SCRIPT_OBJ_LAST(IncRot1)) );
+        Throw( pEngine->RegisterObjectMethod("CMenu", "void incRot(float x = 0, float y = 0, float z = 0, bool convertToRadians = true)", SCRIPT_OBJ_LAST(IncRot2)) );
 
-        Throw( pEngine->RegisterObjectMethod("CMenu", "const CPoint & getRot()",                               WRAP_OBJ_LAST(GetRot),     asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CMenu", "const CPoint & getRot()",                               SCRIPT_OBJ_LAST(GetRot)) );
 
-        Throw( pEngine->RegisterObjectMethod("CMenu", "void setScale(CPoint & in)",                            WRAP_OBJ_LAST(SetScale1),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CMenu", "void setScale(float x = 1, float y = 1, float z = 1)",  WRAP_OBJ_LAST(SetScale2),  asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CMenu", "void setScale(CPoint & in)",                            SCRIPT_OBJ_LAST(SetScale1)) );
+        Throw( pEngine->RegisterObjectMethod("CMenu", "void setScale(float x = 1, float y = 1, float z = 1)",  SCRIPT_OBJ_LAST(SetScale2)) );
 
-        Throw( pEngine->RegisterObjectMethod("CMenu", "void incScale(CPoint & in)",                            WRAP_OBJ_LAST(IncScale1),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CMenu", "void incScale(float x = 1, float y = 1, float z = 1)",  WRAP_OBJ_LAST(IncScale2),  asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CMenu", "void incScale(CPoint & in)",                            SCRIPT_OBJ_LAST(IncScale1)) );
+        Throw( pEngine->RegisterObjectMethod("CMenu", "void incScale(float x = 1, float y = 1, float z = 1)",  SCRIPT_OBJ_LAST(IncScale2)) );
 
-        Throw( pEngine->RegisterObjectMethod("CMenu", "const CPoint & getScale()",                             WRAP_OBJ_LAST(GetScale),   asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CMenu", "const CPoint & getScale()",                             SCRIPT_OBJ_LAST(GetScale)) );
     }
 }
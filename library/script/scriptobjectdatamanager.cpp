@@ -12,6 +12,7 @@
 #include <objectdata/objectdatamanager.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptwrap.h>
 #include <utilities/exceptionhandling.h>
 
 // AngelScript lib dependencies
@@ -59,6 +60,46 @@ namespace NScriptObjectDataManager
         }
     }
 
+    /************************************************************************
+    *    DESC:  Load a group on the worker threads
+    ************************************************************************/
+    void LoadGroupAsync( const std::string & group, int completeEvent, CObjectDataMgr & rObjectDataMgr )
+    {
+        try
+        {
+            rObjectDataMgr.loadGroupAsync( group, completeEvent );
+        }
+        catch( NExcept::CCriticalException & ex )
+        {
+            asGetActiveContext()->SetException(ex.getErrorMsg().c_str());
+        }
+        catch( std::exception const & ex )
+        {
+            asGetActiveContext()->SetException(ex.what());
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  Get the load progress of a group
+    ************************************************************************/
+    float GetLoadProgress( const std::string & group, CObjectDataMgr & rObjectDataMgr )
+    {
+        try
+        {
+            return rObjectDataMgr.getLoadProgress( group );
+        }
+        catch( NExcept::CCriticalException & ex )
+        {
+            asGetActiveContext()->SetException(ex.getErrorMsg().c_str());
+        }
+        catch( std::exception const & ex )
+        {
+            asGetActiveContext()->SetException(ex.what());
+        }
+
+        return 0.f;
+    }
+
     void LoadGroupAry( const CScriptArray & groupAry, CObjectDataMgr & rObjectDataMgr )
     {
         try
@@ -123,11 +164,14 @@ namespace NScriptObjectDataManager
         // Register type
         Throw( pEngine->RegisterObjectType( "CObjectDataMgr", 0, asOBJ_REF|asOBJ_NOCOUNT) );
         
-        Throw( pEngine->RegisterObjectMethod("CObjectDataMgr", "void loadListTable(string &in)",       WRAP_OBJ_LAST(LoadListTable), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObjectDataMgr", "void loadGroup(string &in)",           WRAP_OBJ_LAST(LoadGroup),     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObjectDataMgr", "void loadGroupAry(array<string> &in)", WRAP_OBJ_LAST(LoadGroupAry),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObjectDataMgr", "void freeGroup(string &in)",           WRAP_OBJ_LAST(FreeGroup),     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObjectDataMgr", "void freeGroupAry(array<string> &in)", WRAP_OBJ_LAST(FreeGroupAry),  asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CObjectDataMgr", "void loadListTable(string &in)",       SCRIPT_OBJ_LAST(LoadListTable)) );
+        Throw( pEngine->RegisterObjectMethod("CObjectDataMgr", "void loadGroup(string &in)",           SCRIPT_OBJ_LAST(LoadGroup)) );
+        Throw( pEngine->RegisterObjectMethod("CObjectDataMgr", "void loadGroupAry(array<string> &in)", SCRIPT_OBJ_LAST(LoadGroupAry)) );
+        Throw( pEngine->RegisterObjectMethod("CObjectDataMgr", "void loadGroupAsync(string &in, int completeEvent = 0)", SCRIPT_OBJ_LAST(LoadGroupAsync)) );
+        Throw( pEngine->RegisterObjectMethod("CObjectDataMgr", "float getLoadProgress(string &in)",    SCRIPT_OBJ_LAST(GetLoadProgress)) );
+        Throw( pEngine->RegisterObjectMethod("CObjectDataMgr", "bool isGroupLoaded(string &in)",       SCRIPT_MFN(CObjectDataMgr, isGroupLoaded)) );
+        Throw( pEngine->RegisterObjectMethod("CObjectDataMgr", "void freeGroup(string &in)",           SCRIPT_OBJ_LAST(FreeGroup)) );
+        Throw( pEngine->RegisterObjectMethod("CObjectDataMgr", "void freeGroupAry(array<string> &in)", SCRIPT_OBJ_LAST(FreeGroupAry)) );
         
         // Set this object registration as a global property to simulate a singleton
         Throw( pEngine->RegisterGlobalProperty("CObjectDataMgr ObjectDataMgr", &CObjectDataMgr::Instance()) );
@@ -13,6 +13,7 @@
 #include <physics/physicsworld2d.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptwrap.h>
 #include <utilities/exceptionhandling.h>
 
 // AngelScript lib dependencies
@@ -53,19 +54,23 @@ namespace NScriptPhysics2d
         // Register type
         Throw( pEngine->RegisterObjectType("CPhysicsWorld2D", 0, asOBJ_REF|asOBJ_NOCOUNT) );
 
-        Throw( pEngine->RegisterObjectMethod("CPhysicsWorld2D", "void fixedTimeStep()",                                 WRAP_MFN(CPhysicsWorld2D, fixedTimeStep),             asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPhysicsWorld2D", "void variableTimeStep()",                              WRAP_MFN(CPhysicsWorld2D, variableTimeStep),          asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPhysicsWorld2D", "void EnableContactListener( bool enable = true )",     WRAP_MFN(CPhysicsWorld2D, EnableContactListener),     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPhysicsWorld2D", "void EnableDestructionListener( bool enable = true )", WRAP_MFN(CPhysicsWorld2D, EnableDestructionListener), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CPhysicsWorld2D", "void fixedTimeStep()",                                 SCRIPT_MFN_PR(CPhysicsWorld2D, fixedTimeStep, (), void)) );
+        Throw( pEngine->RegisterObjectMethod("CPhysicsWorld2D", "void fixedTimeStep(float)",                            SCRIPT_MFN_PR(CPhysicsWorld2D, fixedTimeStep, (float), void)) );
+        Throw( pEngine->RegisterObjectMethod("CPhysicsWorld2D", "void setMaxSubSteps(int)",                             SCRIPT_MFN(CPhysicsWorld2D, setMaxSubSteps)) );
+        Throw( pEngine->RegisterObjectMethod("CPhysicsWorld2D", "void variableTimeStep()",                              SCRIPT_MFN_PR(CPhysicsWorld2D, variableTimeStep, (), void)) );
+        Throw( pEngine->RegisterObjectMethod("CPhysicsWorld2D", "void EnableContactListener( bool enable = true )",     SCRIPT_MFN(CPhysicsWorld2D, EnableContactListener)) );
+        Throw( pEngine->RegisterObjectMethod("CPhysicsWorld2D", "void EnableDestructionListener( bool enable = true )", SCRIPT_MFN(CPhysicsWorld2D, EnableDestructionListener)) );
 
         // Register type
         Throw( pEngine->RegisterObjectType( "CPhysicsWorldManager2D", 0, asOBJ_REF|asOBJ_NOCOUNT) );
         
-        Throw( pEngine->RegisterObjectMethod("CPhysicsWorldManager2D", "void loadListTable(string &in)",         WRAP_OBJ_LAST(LoadListTable),                   asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPhysicsWorldManager2D", "void createWorld(string &in)",           WRAP_MFN(CPhysicsWorldManager2D, createWorld),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPhysicsWorldManager2D", "void destroyWorld(string &in)",          WRAP_MFN(CPhysicsWorldManager2D, destroyWorld), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPhysicsWorldManager2D", "CPhysicsWorld2D & getWorld(string &in)", WRAP_MFN(CPhysicsWorldManager2D, getWorld),     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPhysicsWorldManager2D", "void clear()",                           WRAP_MFN(CPhysicsWorldManager2D, clear),        asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CPhysicsWorldManager2D", "void loadListTable(string &in)",         SCRIPT_OBJ_LAST(LoadListTable)) );
+        Throw( pEngine->RegisterObjectMethod("CPhysicsWorldManager2D", "void createWorld(string &in)",           SCRIPT_MFN(CPhysicsWorldManager2D, createWorld)) );
+        Throw( pEngine->RegisterObjectMethod("CPhysicsWorldManager2D", "void destroyWorld(string &in)",          SCRIPT_MFN(CPhysicsWorldManager2D, destroyWorld)) );
+        Throw( pEngine->RegisterObjectMethod("CPhysicsWorldManager2D", "CPhysicsWorld2D & getWorld(string &in)", SCRIPT_MFN(CPhysicsWorldManager2D, getWorld)) );
+        Throw( pEngine->RegisterObjectMethod("CPhysicsWorldManager2D", "void clear()",                           SCRIPT_MFN(CPhysicsWorldManager2D, clear)) );
+        Throw( pEngine->RegisterObjectMethod("CPhysicsWorldManager2D", "void fixedTimeStep()",                   SCRIPT_MFN(CPhysicsWorldManager2D, fixedTimeStep)) );
+        Throw( pEngine->RegisterObjectMethod("CPhysicsWorldManager2D", "void variableTimeStep()",                SCRIPT_MFN(CPhysicsWorldManager2D, variableTimeStep)) );
         
         // Set this object registration as a global property to simulate a singleton
         Throw( pEngine->RegisterGlobalProperty("CPhysicsWorldManager2D PhysicsWorldManager2D", &CPhysicsWorldManager2D::Instance()) );
@@ -11,6 +11,7 @@
 // Game lib dependencies
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptwrap.h>
 #include <utilities/exceptionhandling.h>
 
 // AngelScript lib dependencies
@@ -88,10 +89,10 @@ namespace NScriptScriptManager
         // Register type
         Throw( pEngine->RegisterObjectType( "CScriptMgr", 0, asOBJ_REF|asOBJ_NOCOUNT) );
         
-        Throw( pEngine->RegisterObjectMethod("CScriptMgr", "void loadGroup(string &in)",       WRAP_OBJ_LAST(LoadGroup),       asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CScriptMgr", "void freeGroup(string &in)",       WRAP_OBJ_LAST(FreeGroup),       asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CScriptMgr", "void clear()",                     WRAP_OBJ_LAST(Clear),           asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CScriptMgr", "void setMaxPoolPercentage(float)", WRAP_MFN(CScriptMgr, setMaxPoolPercentage), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CScriptMgr", "void loadGroup(string &in)",       SCRIPT_OBJ_LAST(LoadGroup)) );
+        Throw( pEngine->RegisterObjectMethod("CScriptMgr", "void freeGroup(string &in)",       SCRIPT_OBJ_LAST(FreeGroup)) );
+        Throw( pEngine->RegisterObjectMethod("CScriptMgr", "void clear()",                     SCRIPT_OBJ_LAST(Clear)) );
+        Throw( pEngine->RegisterObjectMethod("CScriptMgr", "void setMaxPoolPercentage(float)", SCRIPT_MFN(CScriptMgr, setMaxPoolPercentage)) );
         
         // Set this object registration as a global property to simulate a singleton
         Throw( pEngine->RegisterGlobalProperty("CScriptMgr ScriptMgr", &CScriptMgr::Instance()) );
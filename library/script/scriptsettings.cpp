@@ -12,6 +12,7 @@
 #include <utilities/settings.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptwrap.h>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
@@ -31,36 +32,36 @@ namespace NScriptSettings
         // Register type
         Throw( pEngine->RegisterObjectType( "CSettings", 0, asOBJ_REF|asOBJ_NOCOUNT) );
         
-        Throw( pEngine->RegisterObjectMethod("CSettings", "const CSize & getSize()",              WRAP_MFN(CSettings, getSize),              asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSettings", "const CSize & getDefaultSize()",       WRAP_MFN(CSettings, getDefaultSize),       asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSettings", "const CSize & getSizeHalf()",          WRAP_MFN(CSettings, getSizeHalf),          asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSettings", "const CSize & getNativeSize()",        WRAP_MFN(CSettings, getNativeSize),        asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSettings", "const CSize & getDefaultSizeHalf()",   WRAP_MFN(CSettings, getDefaultSizeHalf),   asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSettings", "void setSize(const CSize & in)",       WRAP_MFN(CSettings, setSize),              asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSettings", "const CSize & getScreenAspectRatio()", WRAP_MFN(CSettings, getScreenAspectRatio), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSettings", "const CSize & getOrthoAspectRatio()",  WRAP_MFN(CSettings, getOrthoAspectRatio),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSettings", "void calcRatio()",                     WRAP_MFN(CSettings, calcRatio),            asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSettings", "const CSize & getSize()",              SCRIPT_MFN(CSettings, getSize)) );
+        Throw( pEngine->RegisterObjectMethod("CSettings", "const CSize & getDefaultSize()",       SCRIPT_MFN(CSettings, getDefaultSize)) );
+        Throw( pEngine->RegisterObjectMethod("CSettings", "const CSize & getSizeHalf()",          SCRIPT_MFN(CSettings, getSizeHalf)) );
+        Throw( pEngine->RegisterObjectMethod("CSettings", "const CSize & getNativeSize()",        SCRIPT_MFN(CSettings, getNativeSize)) );
+        Throw( pEngine->RegisterObjectMethod("CSettings", "const CSize & getDefaultSizeHalf()",   SCRIPT_MFN(CSettings, getDefaultSizeHalf)) );
+        Throw( pEngine->RegisterObjectMethod("CSettings", "void setSize(const CSize & in)",       SCRIPT_MFN(CSettings, setSize)) );
+        Throw( pEngine->RegisterObjectMethod("CSettings", "const CSize & getScreenAspectRatio()", SCRIPT_MFN(CSettings, getScreenAspectRatio)) );
+        Throw( pEngine->RegisterObjectMethod("CSettings", "const CSize & getOrthoAspectRatio()",  SCRIPT_MFN(CSettings, getOrthoAspectRatio)) );
+        Throw( pEngine->RegisterObjectMethod("CSettings", "void calcRatio()",                     SCRIPT_MFN(CSettings, calcRatio)) );
         
-        Throw( pEngine->RegisterObjectMethod("CSettings", "bool getVSync()",                      WRAP_MFN(CSettings, getVSync),             asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSettings", "void setVSync(bool)",                  WRAP_MFN(CSettings, setVSync),             asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSettings", "bool getFullScreen()",                 WRAP_MFN(CSettings, getFullScreen),        asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSettings", "void setFullScreen(bool)",             WRAP_MFN(CSettings, setFullScreen),        asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSettings", "bool getVSync()",                      SCRIPT_MFN(CSettings, getVSync)) );
+        Throw( pEngine->RegisterObjectMethod("CSettings", "void setVSync(bool)",                  SCRIPT_MFN(CSettings, setVSync)) );
+        Throw( pEngine->RegisterObjectMethod("CSettings", "bool getFullScreen()",                 SCRIPT_MFN(CSettings, getFullScreen)) );
+        Throw( pEngine->RegisterObjectMethod("CSettings", "void setFullScreen(bool)",             SCRIPT_MFN(CSettings, setFullScreen)) );
         
-        Throw( pEngine->RegisterObjectMethod("CSettings", "int getSectorSize()",                  WRAP_MFN(CSettings, getSectorSize),        asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSettings", "int getSectorSizeHalf()",              WRAP_MFN(CSettings, getSectorSizeHalf),    asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSettings", "int getSectorSize()",                  SCRIPT_MFN(CSettings, getSectorSize)) );
+        Throw( pEngine->RegisterObjectMethod("CSettings", "int getSectorSizeHalf()",              SCRIPT_MFN(CSettings, getSectorSizeHalf)) );
         
-        Throw( pEngine->RegisterObjectMethod("CSettings", "int getAnisotropicLevel()",            WRAP_MFN(CSettings, getAnisotropicLevel),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSettings", "void setAnisotropicLevel(int)",        WRAP_MFN(CSettings, setAnisotropicLevel),  asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSettings", "int getAnisotropicLevel()",            SCRIPT_MFN(CSettings, getAnisotropicLevel)) );
+        Throw( pEngine->RegisterObjectMethod("CSettings", "void setAnisotropicLevel(int)",        SCRIPT_MFN(CSettings, setAnisotropicLevel)) );
         
-        Throw( pEngine->RegisterObjectMethod("CSettings", "bool isDebugMode()",                   WRAP_MFN(CSettings, isDebugMode),          asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSettings", "bool isDebugAsMobile()",               WRAP_MFN(CSettings, isDebugAsMobile),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSettings", "bool isAutoplay()",                    WRAP_MFN(CSettings, isAutoplay),           asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSettings", "bool isMobileDevice()",                WRAP_MFN(CSettings, isMobileDevice),       asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSettings", "bool isDebugMode()",                   SCRIPT_MFN(CSettings, isDebugMode)) );
+        Throw( pEngine->RegisterObjectMethod("CSettings", "bool isDebugAsMobile()",               SCRIPT_MFN(CSettings, isDebugAsMobile)) );
+        Throw( pEngine->RegisterObjectMethod("CSettings", "bool isAutoplay()",                    SCRIPT_MFN(CSettings, isAutoplay)) );
+        Throw( pEngine->RegisterObjectMethod("CSettings", "bool isMobileDevice()",                SCRIPT_MFN(CSettings, isMobileDevice)) );
         
-        Throw( pEngine->RegisterObjectMethod("CSettings", "int getGamePadStickDeadZone()",        WRAP_MFN(CSettings, getGamePadStickDeadZone), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSettings", "void setGamePadStickDeadZone(int)",    WRAP_MFN(CSettings, setGamePadStickDeadZone), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSettings", "int getGamePadStickDeadZone()",        SCRIPT_MFN(CSettings, getGamePadStickDeadZone)) );
+        Throw( pEngine->RegisterObjectMethod("CSettings", "void setGamePadStickDeadZone(int)",    SCRIPT_MFN(CSettings, setGamePadStickDeadZone)) );
         
-        Throw( pEngine->RegisterObjectMethod("CSettings", "void saveSettings()",                  WRAP_MFN(CSettings, saveSettings), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSettings", "void saveSettings()",                  SCRIPT_MFN(CSettings, saveSettings)) );
         
         // Set this object registration as a global property to simulate a singleton
         Throw( pEngine->RegisterGlobalProperty("CSettings Settings", &CSettings::Instance()) );
@@ -12,6 +12,7 @@
 #include <common/size.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptwrap.h>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
@@ -69,45 +70,45 @@ namespace NScriptSize
         Throw( pEngine->RegisterObjectType("CSize", sizeof(CSize<float>), asOBJ_VALUE | asOBJ_POD | asGetTypeTraits<CSize<float>>() | asOBJ_APP_CLASS_ALLFLOATS ) );
 
         // Register the object operator overloads
-        Throw( pEngine->RegisterObjectBehaviour("CSize", asBEHAVE_CONSTRUCT, "void f()",                 WRAP_OBJ_LAST(Constructor),              asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectBehaviour("CSize", asBEHAVE_CONSTRUCT, "void f(const CSize & in)", WRAP_OBJ_LAST(CopyConstructor),          asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectBehaviour("CSize", asBEHAVE_CONSTRUCT, "void f(float, float)",     WRAP_OBJ_LAST(ConstructorFromTwoFloats), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectBehaviour("CSize", asBEHAVE_DESTRUCT,  "void f()",                 WRAP_OBJ_LAST(Destructor),               asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectBehaviour("CSize", asBEHAVE_CONSTRUCT, "void f()",                 SCRIPT_OBJ_LAST(Constructor)) );
+        Throw( pEngine->RegisterObjectBehaviour("CSize", asBEHAVE_CONSTRUCT, "void f(const CSize & in)", SCRIPT_OBJ_LAST(CopyConstructor)) );
+        Throw( pEngine->RegisterObjectBehaviour("CSize", asBEHAVE_CONSTRUCT, "void f(float, float)",     SCRIPT_OBJ_LAST(ConstructorFromTwoFloats)) );
+        Throw( pEngine->RegisterObjectBehaviour("CSize", asBEHAVE_DESTRUCT,  "void f()",                 SCRIPT_OBJ_LAST(Destructor)) );
 
         // assignment operator
         Throw( pEngine->RegisterObjectMethod("CSize", "CSize & opAssign(const CSize & in)", asFUNCTION(OpAssignCSize), asCALL_GENERIC) );
 
         // binary operators
-        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opAdd ( const CSize & in )", WRAP_MFN_PR(CSize<float>, operator +, (const CSize<float> &) const, CSize<float>), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opSub ( const CSize & in )", WRAP_MFN_PR(CSize<float>, operator -, (const CSize<float> &) const, CSize<float>), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opMul ( const CSize & in )", WRAP_MFN_PR(CSize<float>, operator *, (const CSize<float> &) const, CSize<float>), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opDiv ( const CSize & in )", WRAP_MFN_PR(CSize<float>, operator /, (const CSize<float> &) const, CSize<float>), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opAdd ( const CSize & in )", SCRIPT_MFN_PR(CSize<float>, operator +, (const CSize<float> &) const, CSize<float>)) );
+        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opSub ( const CSize & in )", SCRIPT_MFN_PR(CSize<float>, operator -, (const CSize<float> &) const, CSize<float>)) );
+        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opMul ( const CSize & in )", SCRIPT_MFN_PR(CSize<float>, operator *, (const CSize<float> &) const, CSize<float>)) );
+        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opDiv ( const CSize & in )", SCRIPT_MFN_PR(CSize<float>, operator /, (const CSize<float> &) const, CSize<float>)) );
 
-        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opAdd ( float )", WRAP_MFN_PR(CSize<float>, operator +, (float) const, CSize<float>), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opSub ( float )", WRAP_MFN_PR(CSize<float>, operator -, (float) const, CSize<float>), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opMul ( float )", WRAP_MFN_PR(CSize<float>, operator *, (float) const, CSize<float>), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opDiv ( float )", WRAP_MFN_PR(CSize<float>, operator /, (float) const, CSize<float>), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opAdd ( float )", SCRIPT_MFN_PR(CSize<float>, operator +, (float) const, CSize<float>)) );
+        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opSub ( float )", SCRIPT_MFN_PR(CSize<float>, operator -, (float) const, CSize<float>)) );
+        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opMul ( float )", SCRIPT_MFN_PR(CSize<float>, operator *, (float) const, CSize<float>)) );
+        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opDiv ( float )", SCRIPT_MFN_PR(CSize<float>, operator /, (float) const, CSize<float>)) );
 
         // compound assignment operators
-        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opAddAssign ( const CSize & in )", WRAP_MFN_PR(CSize<float>, operator +=, (const CSize<float> &), CSize<float>), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opSubAssign ( const CSize & in )", WRAP_MFN_PR(CSize<float>, operator -=, (const CSize<float> &), CSize<float>), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opMulAssign ( const CSize & in )", WRAP_MFN_PR(CSize<float>, operator *=, (const CSize<float> &), CSize<float>), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opDivAssign ( const CSize & in )", WRAP_MFN_PR(CSize<float>, operator /=, (const CSize<float> &), CSize<float>), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opAddAssign ( const CSize & in )", SCRIPT_MFN_PR(CSize<float>, operator +=, (const CSize<float> &), CSize<float>)) );
+        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opSubAssign ( const CSize & in )", SCRIPT_MFN_PR(CSize<float>, operator -=, (const CSize<float> &), CSize<float>)) );
+        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opMulAssign ( const CSize & in )", SCRIPT_MFN_PR(CSize<float>, operator *=, (const CSize<float> &), CSize<float>)) );
+        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opDivAssign ( const CSize & in )", SCRIPT_MFN_PR(CSize<float>, operator /=, (const CSize<float> &), CSize<float>)) );
 
-        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opAddAssign ( float )", WRAP_MFN_PR(CSize<float>, operator +=, (float) , CSize<float>), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opSubAssign ( float )", WRAP_MFN_PR(CSize<float>, operator -=, (float) , CSize<float>), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opMulAssign ( float )", WRAP_MFN_PR(CSize<float>, operator *=, (float) , CSize<float>), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opDivAssign ( float )", WRAP_MFN_PR(CSize<float>, operator /=, (float) , CSize<float>), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opAddAssign ( float )", SCRIPT_MFN_PR(CSize<float>, operator +=, (float) , CSize<float>)) );
+        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opSubAssign ( float )", SCRIPT_MFN_PR(CSize<float>, operator -=, (float) , CSize<float>)) );
+        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opMulAssign ( float )", SCRIPT_MFN_PR(CSize<float>, operator *=, (float) , CSize<float>)) );
+        Throw( pEngine->RegisterObjectMethod("CSize", "CSize opDivAssign ( float )", SCRIPT_MFN_PR(CSize<float>, operator /=, (float) , CSize<float>)) );
 
         // Register property
         Throw( pEngine->RegisterObjectProperty("CSize", "float w", asOFFSET(CSize<float>, w)) );
         Throw( pEngine->RegisterObjectProperty("CSize", "float h", asOFFSET(CSize<float>, h)) );
 
         // Class members
-        Throw( pEngine->RegisterObjectMethod("CSize", "void clear()",          WRAP_MFN(CSize<float>, clear),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSize", "void round()",          WRAP_MFN(CSize<float>, round),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSize", "bool isEmpty() const",  WRAP_MFN(CSize<float>, isEmpty),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSize", "bool isWEmpty() const", WRAP_MFN(CSize<float>, isWEmpty), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSize", "bool isHEmpty() const", WRAP_MFN(CSize<float>, isHEmpty), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSize", "void clear()",          SCRIPT_MFN(CSize<float>, clear)) );
+        Throw( pEngine->RegisterObjectMethod("CSize", "void round()",          SCRIPT_MFN(CSize<float>, round)) );
+        Throw( pEngine->RegisterObjectMethod("CSize", "bool isEmpty() const",  SCRIPT_MFN(CSize<float>, isEmpty)) );
+        Throw( pEngine->RegisterObjectMethod("CSize", "bool isWEmpty() const", SCRIPT_MFN(CSize<float>, isWEmpty)) );
+        Throw( pEngine->RegisterObjectMethod("CSize", "bool isHEmpty() const", SCRIPT_MFN(CSize<float>, isHEmpty)) );
     }
 }
@@ -14,6 +14,7 @@
 #include <sound/sound.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptwrap.h>
 #include <utilities/exceptionhandling.h>
 
 // AngelScript lib dependencies
@@ -91,46 +92,46 @@ namespace NScriptSound
         // Register type
         Throw( pEngine->RegisterObjectType("CPlayList", 0, asOBJ_REF|asOBJ_NOCOUNT) );
 
-        Throw( pEngine->RegisterObjectMethod("CPlayList", "void play( int channel = -1, int loopCount = 0 )", WRAP_MFN(CPlayList, play),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPlayList", "void stop()",                                      WRAP_MFN(CPlayList, stop),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPlayList", "void pause()",                                     WRAP_MFN(CPlayList, pause),     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPlayList", "void resume()",                                    WRAP_MFN(CPlayList, resume),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPlayList", "void setVolume(int)",                              WRAP_MFN(CPlayList, setVolume), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPlayList", "int getVolume() const",                            WRAP_MFN(CPlayList, getVolume), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPlayList", "bool isPlaying() const",                           WRAP_MFN(CPlayList, isPlaying), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPlayList", "bool isPaused() const",                            WRAP_MFN(CPlayList, isPaused),  asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CPlayList", "void play( int channel = -1, int loopCount = 0 )", SCRIPT_MFN(CPlayList, play)) );
+        Throw( pEngine->RegisterObjectMethod("CPlayList", "void stop()",                                      SCRIPT_MFN(CPlayList, stop)) );
+        Throw( pEngine->RegisterObjectMethod("CPlayList", "void pause()",                                     SCRIPT_MFN(CPlayList, pause)) );
+        Throw( pEngine->RegisterObjectMethod("CPlayList", "void resume()",                                    SCRIPT_MFN(CPlayList, resume)) );
+        Throw( pEngine->RegisterObjectMethod("CPlayList", "void setVolume(int)",                              SCRIPT_MFN(CPlayList, setVolume)) );
+        Throw( pEngine->RegisterObjectMethod("CPlayList", "int getVolume() const",                            SCRIPT_MFN(CPlayList, getVolume)) );
+        Throw( pEngine->RegisterObjectMethod("CPlayList", "bool isPlaying() const",                           SCRIPT_MFN(CPlayList, isPlaying)) );
+        Throw( pEngine->RegisterObjectMethod("CPlayList", "bool isPaused() const",                            SCRIPT_MFN(CPlayList, isPaused)) );
 
         
         // Register type
         Throw( pEngine->RegisterObjectType("CSound", 0, asOBJ_REF|asOBJ_NOCOUNT) );
 
-        Throw( pEngine->RegisterObjectMethod("CSound", "void play( int channel = -1, int loopCount = 0 )", WRAP_MFN(CSound, play),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSound", "void stop()",                                      WRAP_MFN(CSound, stop),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSound", "void pause()",                                     WRAP_MFN(CSound, pause),     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSound", "void resume()",                                    WRAP_MFN(CSound, resume),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSound", "void setVolume(int)",                              WRAP_MFN(CSound, setVolume), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSound", "int getVolume() const",                            WRAP_MFN(CSound, getVolume), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSound", "bool isPlaying() const",                           WRAP_MFN(CSound, isPlaying), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSound", "bool isPaused() const",                            WRAP_MFN(CSound, isPaused),  asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSound", "void play( int channel = -1, int loopCount = 0 )", SCRIPT_MFN(CSound, play)) );
+        Throw( pEngine->RegisterObjectMethod("CSound", "void stop()",                                      SCRIPT_MFN(CSound, stop)) );
+        Throw( pEngine->RegisterObjectMethod("CSound", "void pause()",                                     SCRIPT_MFN(CSound, pause)) );
+        Throw( pEngine->RegisterObjectMethod("CSound", "void resume()",                                    SCRIPT_MFN(CSound, resume)) );
+        Throw( pEngine->RegisterObjectMethod("CSound", "void setVolume(int)",                              SCRIPT_MFN(CSound, setVolume)) );
+        Throw( pEngine->RegisterObjectMethod("CSound", "int getVolume() const",                            SCRIPT_MFN(CSound, getVolume)) );
+        Throw( pEngine->RegisterObjectMethod("CSound", "bool isPlaying() const",                           SCRIPT_MFN(CSound, isPlaying)) );
+        Throw( pEngine->RegisterObjectMethod("CSound", "bool isPaused() const",                            SCRIPT_MFN(CSound, isPaused)) );
         
         
         // Register type
         Throw( pEngine->RegisterObjectType( "CSoundMgr", 0, asOBJ_REF|asOBJ_NOCOUNT) );
         
-        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void loadListTable(string &in)",                     WRAP_OBJ_LAST(LoadListTable),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void loadGroup(string &in)",                         WRAP_OBJ_LAST(LoadGroup),          asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void freeGroup(string &in)",                         WRAP_OBJ_LAST(FreeGroup),          asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void stopAllSound()",                                WRAP_MFN(CSoundMgr, stopAllSound), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void play(string &in, string &in, int loopCount=0)", WRAP_MFN(CSoundMgr, play),         asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void pause(string &in, string &in)",                 WRAP_MFN(CSoundMgr, pause),        asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void resume(string &in, string &in)",                WRAP_MFN(CSoundMgr, resume),       asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void stop(string &in, string &in)",                  WRAP_MFN(CSoundMgr, stop),         asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void setVolume(string &in, string &in, int)",        WRAP_MFN(CSoundMgr, setVolume),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "int getVolume(string &in, string &in) const",        WRAP_MFN(CSoundMgr, getVolume),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "bool isPlaying(string &in, string &in) const",       WRAP_MFN(CSoundMgr, isPlaying),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "bool isPaused(string &in, string &in) const",        WRAP_MFN(CSoundMgr, isPaused),     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "CSound & getSound(string &in, string &in)",          WRAP_MFN(CSoundMgr, getSound),     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "CPlayList & getPlayList(string &in, string &in)",    WRAP_MFN(CSoundMgr, getPlayList),  asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void loadListTable(string &in)",                     SCRIPT_OBJ_LAST(LoadListTable)) );
+        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void loadGroup(string &in)",                         SCRIPT_OBJ_LAST(LoadGroup)) );
+        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void freeGroup(string &in)",                         SCRIPT_OBJ_LAST(FreeGroup)) );
+        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void stopAllSound()",                                SCRIPT_MFN(CSoundMgr, stopAllSound)) );
+        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void play(string &in, string &in, int loopCount=0)", SCRIPT_MFN(CSoundMgr, play)) );
+        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void pause(string &in, string &in)",                 SCRIPT_MFN(CSoundMgr, pause)) );
+        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void resume(string &in, string &in)",                SCRIPT_MFN(CSoundMgr, resume)) );
+        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void stop(string &in, string &in)",                  SCRIPT_MFN(CSoundMgr, stop)) );
+        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "void setVolume(string &in, string &in, int)",        SCRIPT_MFN(CSoundMgr, setVolume)) );
+        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "int getVolume(string &in, string &in) const",        SCRIPT_MFN(CSoundMgr, getVolume)) );
+        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "bool isPlaying(string &in, string &in) const",       SCRIPT_MFN(CSoundMgr, isPlaying)) );
+        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "bool isPaused(string &in, string &in) const",        SCRIPT_MFN(CSoundMgr, isPaused)) );
+        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "CSound & getSound(string &in, string &in)",          SCRIPT_MFN(CSoundMgr, getSound)) );
+        Throw( pEngine->RegisterObjectMethod("CSoundMgr", "CPlayList & getPlayList(string &in, string &in)",    SCRIPT_MFN(CSoundMgr, getPlayList)) );
         
         // Set this object registration as a global property to simulate a singleton
         Throw( pEngine->RegisterGlobalProperty("CSoundMgr SoundMgr", &CSoundMgr::Instance()) );
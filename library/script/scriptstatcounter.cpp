@@ -12,6 +12,7 @@
 #include <utilities/statcounter.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptwrap.h>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
@@ -31,7 +32,7 @@ namespace NScriptStatCounter
         // Register type
         Throw( pEngine->RegisterObjectType( "CStatCounter", 0, asOBJ_REF|asOBJ_NOCOUNT) );
         
-        Throw( pEngine->RegisterObjectMethod("CStatCounter", "void incCycle()",  WRAP_MFN(CStatCounter, incCycle), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CStatCounter", "void incCycle()",  SCRIPT_MFN(CStatCounter, incCycle)) );
 
         // Set this object registration as a global property to simulate a singleton
         Throw( pEngine->RegisterGlobalProperty("CStatCounter StatCounter", &CStatCounter::Instance()) );
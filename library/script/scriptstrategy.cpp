@@ -14,6 +14,7 @@
 #include <strategy/strategyloader.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptwrap.h>
 #include <utilities/exceptionhandling.h>
 #include <system/device.h>
 #include <node/inode.h>
@@ -33,8 +34,7 @@ namespace NScriptStrategy
     {
         try
         {
-            auto cmdBufVec = CDevice::Instance().createSecondaryCommandBuffers( cmdBufPoolId );
-            rStrategy.setCommandBuffers( cmdBufVec );
+            rStrategy.setCommandBuffers( cmdBufPoolId );
         }
         catch( NExcept::CCriticalException & ex )
         {
@@ -88,6 +88,65 @@ namespace NScriptStrategy
         return nullptr;
     }
     
+    /************************************************************************
+    *    DESC:  Activate a node
+    ************************************************************************/
+    iNode * ActivateNode( const std::string & instanceName, CStrategy & rStrategy )
+    {
+        try
+        {
+            return rStrategy.activateNode( instanceName );
+        }
+        catch( NExcept::CCriticalException & ex )
+        {
+            asGetActiveContext()->SetException(ex.getErrorMsg().c_str());
+        }
+        catch( std::exception const & ex )
+        {
+            asGetActiveContext()->SetException(ex.what());
+        }
+        
+        return nullptr;
+    }
+    
+    /************************************************************************
+    *    DESC:  Deactivate a node
+    ************************************************************************/
+    void DeactivateNode( const std::string & instanceName, CStrategy & rStrategy )
+    {
+        try
+        {
+            rStrategy.deactivateNode( instanceName );
+        }
+        catch( NExcept::CCriticalException & ex )
+        {
+            asGetActiveContext()->SetException(ex.getErrorMsg().c_str());
+        }
+        catch( std::exception const & ex )
+        {
+            asGetActiveContext()->SetException(ex.what());
+        }
+    }
+    
+    /************************************************************************
+    *    DESC:  Clear all the nodes
+    ************************************************************************/
+    void Clear( CStrategy & rStrategy )
+    {
+        try
+        {
+            rStrategy.clear();
+        }
+        catch( NExcept::CCriticalException & ex )
+        {
+            asGetActiveContext()->SetException(ex.getErrorMsg().c_str());
+        }
+        catch( std::exception const & ex )
+        {
+            asGetActiveContext()->SetException(ex.what());
+        }
+    }
+    
     /************************************************************************
     *    DESC:  Create a basic sprite strategy                                                            
     ************************************************************************/
@@ -134,6 +193,122 @@ namespace NScriptStrategy
         return pStrategy;
     }
 
+    /************************************************************************
+    *    DESC:  Activate a strategy
+    ************************************************************************/
+    CStrategy * ActivateStrategy( const std::string & strategyId, CStrategyMgr & rStrategyMgr )
+    {
+        try
+        {
+            return rStrategyMgr.activateStrategy( strategyId );
+        }
+        catch( NExcept::CCriticalException & ex )
+        {
+            asGetActiveContext()->SetException(ex.getErrorMsg().c_str());
+        }
+        catch( std::exception const & ex )
+        {
+            asGetActiveContext()->SetException(ex.what());
+        }
+        
+        return nullptr;
+    }
+    
+    /************************************************************************
+    *    DESC:  Activate a list of strategies
+    ************************************************************************/
+    void ActivateStrategyAry( const CScriptArray & strategyIdAry, CStrategyMgr & rStrategyMgr )
+    {
+        try
+        {
+            rStrategyMgr.activateStrategyAry( strategyIdAry );
+        }
+        catch( NExcept::CCriticalException & ex )
+        {
+            asGetActiveContext()->SetException(ex.getErrorMsg().c_str());
+        }
+        catch( std::exception const & ex )
+        {
+            asGetActiveContext()->SetException(ex.what());
+        }
+    }
+    
+    /************************************************************************
+    *    DESC:  Deactivate a strategy
+    ************************************************************************/
+    void DeactivateStrategy( const std::string & strategyId, CStrategyMgr & rStrategyMgr )
+    {
+        try
+        {
+            rStrategyMgr.deactivateStrategy( strategyId );
+        }
+        catch( NExcept::CCriticalException & ex )
+        {
+            asGetActiveContext()->SetException(ex.getErrorMsg().c_str());
+        }
+        catch( std::exception const & ex )
+        {
+            asGetActiveContext()->SetException(ex.what());
+        }
+    }
+    
+    /************************************************************************
+    *    DESC:  Deactivate a list of strategies
+    ************************************************************************/
+    void DeactivateStrategyAry( const CScriptArray & strategyIdAry, CStrategyMgr & rStrategyMgr )
+    {
+        try
+        {
+            rStrategyMgr.deactivateStrategyAry( strategyIdAry );
+        }
+        catch( NExcept::CCriticalException & ex )
+        {
+            asGetActiveContext()->SetException(ex.getErrorMsg().c_str());
+        }
+        catch( std::exception const & ex )
+        {
+            asGetActiveContext()->SetException(ex.what());
+        }
+    }
+    
+    /************************************************************************
+    *    DESC:  Delete a strategy
+    ************************************************************************/
+    void DeleteStrategy( const std::string & strategyId, CStrategyMgr & rStrategyMgr )
+    {
+        try
+        {
+            rStrategyMgr.deleteStrategy( strategyId );
+        }
+        catch( NExcept::CCriticalException & ex )
+        {
+            asGetActiveContext()->SetException(ex.getErrorMsg().c_str());
+        }
+        catch( std::exception const & ex )
+        {
+            asGetActiveContext()->SetException(ex.what());
+        }
+    }
+    
+    /************************************************************************
+    *    DESC:  Delete a list of strategies
+    ************************************************************************/
+    void DeleteStrategyAry( const CScriptArray & strategyIdAry, CStrategyMgr & rStrategyMgr )
+    {
+        try
+        {
+            rStrategyMgr.deleteStrategyAry( strategyIdAry );
+        }
+        catch( NExcept::CCriticalException & ex )
+        {
+            asGetActiveContext()->SetException(ex.getErrorMsg().c_str());
+        }
+        catch( std::exception const & ex )
+        {
+            asGetActiveContext()->SetException(ex.what());
+        }
+    }
+
     iNode * GetiNodeFromSprite(CSprite & sprite)
     {
         return dynamic_cast<iNode *>(&sprite);
@@ -157,54 +332,56 @@ namespace NScriptStrategy
         Throw( pEngine->RegisterObjectType( "iNode", 0, asOBJ_REF|asOBJ_NOCOUNT) );
 
         // iNode specific functions
-        Throw( pEngine->RegisterObjectMethod("iNode", "CSprite & getSprite()",            WRAP_MFN(iNode, getSprite),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("iNode", "CObject & getObject()",            WRAP_MFN(iNode, getObject),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("iNode", "uiControl & getControl()",         WRAP_MFN(iNode, getControl),     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("iNode", "iNode & next()",                   WRAP_MFN(iNode, next),           asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("iNode", "int getType()",                    WRAP_MFN(iNode, getType),        asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("iNode", "int getId()",                      WRAP_MFN(iNode, getId),          asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("iNode", "handle getHandle()",               WRAP_MFN(iNode, getHandle),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("iNode", "iNode & getChildNode(string &in)", WRAP_MFN(iNode, getChildNode),   asCALL_GENERIC) );
-
-        Throw( pEngine->RegisterObjectMethod("CSprite", "iNode & getNode()",                                     WRAP_OBJ_LAST(GetiNodeFromSprite), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObject", "iNode & getNode()",                                   WRAP_OBJ_LAST(GetiNodeFromObject), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("iNode", "CSprite & getSprite()",            SCRIPT_MFN(iNode, getSprite)) );
+        Throw( pEngine->RegisterObjectMethod("iNode", "CObject & getObject()",            SCRIPT_MFN(iNode, getObject)) );
+        Throw( pEngine->RegisterObjectMethod("iNode", "uiControl & getControl()",         SCRIPT_MFN(iNode, getControl)) );
+        Throw( pEngine->RegisterObjectMethod("iNode", "iNode & next()",                   SCRIPT_MFN(iNode, next)) );
+        Throw( pEngine->RegisterObjectMethod("iNode", "int getType()",                    SCRIPT_MFN(iNode, getType)) );
+        Throw( pEngine->RegisterObjectMethod("iNode", "int getId()",                      SCRIPT_MFN(iNode, getId)) );
+        Throw( pEngine->RegisterObjectMethod("iNode", "handle getHandle()",               SCRIPT_MFN(iNode, getHandle)) );
+        Throw( pEngine->RegisterObjectMethod("iNode", "iNode & getChildNode(string &in)", SCRIPT_MFN(iNode, getChildNode)) );
+
+        Throw( pEngine->RegisterObjectMethod("CSprite", "iNode & getNode()",                                     SCRIPT_OBJ_LAST(GetiNodeFromSprite)) );
+        Throw( pEngine->RegisterObjectMethod("CObject", "iNode & getNode()",                                   SCRIPT_OBJ_LAST(GetiNodeFromObject)) );
 
         // Register type
         Throw( pEngine->RegisterObjectType("Strategy", 0, asOBJ_REF|asOBJ_NOCOUNT) );
 
-        Throw( pEngine->RegisterObjectMethod("Strategy", "void setCommandBuffer(string &in)",           WRAP_OBJ_LAST(SetCommandBuffer), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("Strategy", "iNode & create(string &in, string &in = '', bool active = true, string &in = '')", WRAP_OBJ_LAST(Create), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("Strategy", "void destroy(handle)",                        WRAP_MFN(CStrategy, destroy),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("Strategy", "void setCamera(string &in)",                  WRAP_MFN(CStrategy, setCamera),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("Strategy", "iNode & getNode(string &in)",                 WRAP_OBJ_LAST(GetNode),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("Strategy", "iNode & activateNode(string &in)",            WRAP_MFN(CStrategy, activateNode),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("Strategy", "void deactivateNode(string &in)",             WRAP_MFN(CStrategy, deactivateNode),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("Strategy", "void clear()",                                WRAP_MFN(CStrategy, clear),  asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("Strategy", "void setCommandBuffer(string &in)",           SCRIPT_OBJ_LAST(SetCommandBuffer)) );
+        Throw( pEngine->RegisterObjectMethod("Strategy", "iNode & create(string &in, string &in = '', bool active = true, string &in = '')", SCRIPT_OBJ_LAST(Create)) );
+        Throw( pEngine->RegisterObjectMethod("Strategy", "void destroy(handle)",                        SCRIPT_MFN(CStrategy, destroy)) );
+        Throw( pEngine->RegisterObjectMethod("Strategy", "void setCamera(string &in)",                  SCRIPT_MFN(CStrategy, setCamera)) );
+        Throw( pEngine->RegisterObjectMethod("Strategy", "iNode & getNode(string &in)",                 SCRIPT_OBJ_LAST(GetNode)) );
+        Throw( pEngine->RegisterObjectMethod("Strategy", "iNode & activateNode(string &in)",            SCRIPT_OBJ_LAST(ActivateNode)) );
+        Throw( pEngine->RegisterObjectMethod("Strategy", "void deactivateNode(string &in)",             SCRIPT_OBJ_LAST(DeactivateNode)) );
+        Throw( pEngine->RegisterObjectMethod("Strategy", "void clear()",                                SCRIPT_OBJ_LAST(Clear)) );
+        Throw( pEngine->RegisterObjectMethod("Strategy", "void setSpatialGrid(float)",                  SCRIPT_MFN(CStrategy, setSpatialGrid)) );
+        Throw( pEngine->RegisterObjectMethod("Strategy", "void setParallelUpdate(bool)",                SCRIPT_MFN(CStrategy, setParallelUpdate)) );
         
         // Register type
         Throw( pEngine->RegisterObjectType( "CStrategyMgr", 0, asOBJ_REF|asOBJ_NOCOUNT) );
         
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void loadListTable(string &in)",                WRAP_MFN(CStrategyMgr, loadListTable),         asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void loadListTable(string &in)",                SCRIPT_MFN(CStrategyMgr, loadListTable)) );
         
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "Strategy & createActorStrategy(string &in)",    WRAP_OBJ_LAST(CreateStrategy),            asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "Strategy & activateStrategy(string &in)",       WRAP_MFN(CStrategyMgr, activateStrategy),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void activateStrategyAry(array<string> &in)",   WRAP_MFN(CStrategyMgr, activateStrategyAry),   asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void deactivateStrategy(string &in)",           WRAP_MFN(CStrategyMgr, deactivateStrategy),    asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "Strategy & createActorStrategy(string &in)",    SCRIPT_OBJ_LAST(CreateStrategy)) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "Strategy & activateStrategy(string &in)",       SCRIPT_OBJ_LAST(ActivateStrategy)) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void activateStrategyAry(array<string> &in)",   SCRIPT_OBJ_LAST(ActivateStrategyAry)) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void deactivateStrategy(string &in)",           SCRIPT_OBJ_LAST(DeactivateStrategy)) );
 
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void deactivateStrategyAry(array<string> &in)", WRAP_MFN(CStrategyMgr, deactivateStrategyAry), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void deactivateStrategyAry(array<string> &in)", SCRIPT_OBJ_LAST(DeactivateStrategyAry)) );
 
 
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "Strategy & getStrategy(string &in)",            WRAP_OBJ_LAST(GetStrategy),                    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void deleteStrategy(string &in)",               WRAP_MFN(CStrategyMgr, deleteStrategy),        asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void deleteStrategyAry(array<string> &in)",     WRAP_MFN(CStrategyMgr, deleteStrategyAry),     asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "Strategy & getStrategy(string &in)",            SCRIPT_OBJ_LAST(GetStrategy)) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void deleteStrategy(string &in)",               SCRIPT_OBJ_LAST(DeleteStrategy)) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void deleteStrategyAry(array<string> &in)",     SCRIPT_OBJ_LAST(DeleteStrategyAry)) );
 
 
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void update()",                                 WRAP_MFN(CStrategyMgr, update),                asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void transform()",                              WRAP_MFN(CStrategyMgr, transform),             asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void clear()",                                  WRAP_MFN(CStrategyMgr, clear),                 asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void update()",                                 SCRIPT_MFN(CStrategyMgr, update)) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void transform()",                              SCRIPT_MFN(CStrategyMgr, transform)) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void clear()",                                  SCRIPT_MFN(CStrategyMgr, clear)) );
 
         // Load the strategy
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void loadStrategy(string &in)",                 WRAP_MFN(CStrategyloader, load),               asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void loadStrategy(string &in)",                 SCRIPT_MFN(CStrategyloader, load)) );
 
         // Set this object registration as a global property to simulate a singleton
         Throw( pEngine->RegisterGlobalProperty("CStrategyMgr StrategyMgr", &CStrategyMgr::Instance()) );
@@ -12,6 +12,7 @@
 #include <common/visual.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptwrap.h>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
@@ -67,8 +68,8 @@ namespace NScriptVisual
         Throw( pEngine->RegisterObjectType("CVisual", sizeof(CVisual), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS | asOBJ_APP_CLASS_CONSTRUCTOR | asOBJ_APP_CLASS_DESTRUCTOR ) );
 
         // Class members
-        Throw( pEngine->RegisterObjectMethod("CVisual", "void setAdditiveColor(const CColor &in)",           WRAP_OBJ_LAST(SetAdditiveColor1), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CVisual", "void setAdditiveColor(float, float, float, float)", WRAP_OBJ_LAST(SetAdditiveColor2), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CVisual", "const CColor & getAdditiveColor() const",           WRAP_OBJ_LAST(GetAdditiveColor),  asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CVisual", "void setAdditiveColor(const CColor &in)",           SCRIPT_OBJ_LAST(SetAdditiveColor1)) );
+        Throw( pEngine->RegisterObjectMethod("CVisual", "void setAdditiveColor(float, float, float, float)", SCRIPT_OBJ_LAST(SetAdditiveColor2)) );
+        Throw( pEngine->RegisterObjectMethod("CVisual", "const CColor & getAdditiveColor() const",           SCRIPT_OBJ_LAST(GetAdditiveColor)) );
     }
 }
@@ -0,0 +1,60 @@
+
+/************************************************************************
+*    FILE NAME:       scriptwrap.h
+*
+*    DESCRIPTION:     Macros to register the script API with the native
+*                     calling conventions, or the generic ones when the
+*                     platform doesn't support native calls
+************************************************************************/
+
+#pragma once
+
+// AngelScript lib dependencies
+#include <angelscript.h>
+#include <autowrapper/aswrappedcall.h>
+
+// Standard lib dependencies
+#include <cstring>
+
+namespace NScriptWrap
+{
+    // Can the application functions be called directly by the script engine
+    // NOTE: AS_MAX_PORTABILITY is set when the library was built so it can only be checked at run time
+    inline bool UseNativeCalls()
+    {
+        #if defined(SCRIPT_NATIVE_CALLS)
+        static const bool nativeCalls( std::strstr( asGetLibraryOptions(), "AS_MAX_PORTABILITY" ) == nullptr );
+        return nativeCalls;
+        #else
+        return false;
+        #endif
+    }
+}
+
+// Each macro gives the function pointer and the calling convention
+#if defined(SCRIPT_NATIVE_CALLS)
+
+#define SCRIPT_FN(name) \
+    (NScriptWrap::UseNativeCalls() ? asFUNCTION(name) : WRAP_FN(name)), \
+    (NScriptWrap::UseNativeCalls() ? asCALL_CDECL : asCALL_GENERIC)
+
+#define SCRIPT_MFN(ClassType, name) \
+    (NScriptWrap::UseNativeCalls() ? asMETHOD(ClassType, name) : WRAP_MFN(ClassType, name)), \
+    (NScriptWrap::UseNativeCalls() ? asCALL_THISCALL : asCALL_GENERIC)
+
+#define SCRIPT_MFN_PR(ClassType, name, Parameters, ReturnType) \
+    (NScriptWrap::UseNativeCalls() ? asMETHODPR(ClassType, name, Parameters, ReturnType) : WRAP_MFN_PR(ClassType, name, Parameters, ReturnType)), \
+    (NScriptWrap::UseNativeCalls() ? asCALL_THISCALL : asCALL_GENERIC)
+
+#define SCRIPT_OBJ_LAST(name) \
+    (NScriptWrap::UseNativeCalls() ? asFUNCTION(name) : WRAP_OBJ_LAST(name)), \
+    (NScriptWrap::UseNativeCalls() ? asCALL_CDECL_OBJLAST : asCALL_GENERIC)
+
+#else
+
+#define SCRIPT_FN(name)                                        WRAP_FN(name), asCALL_GENERIC
+#define SCRIPT_MFN(ClassType, name)                            WRAP_MFN(ClassType, name), asCALL_GENERIC
+#define SCRIPT_MFN_PR(ClassType, name, Parameters, ReturnType) WRAP_MFN_PR(ClassType, name, Parameters, ReturnType), asCALL_GENERIC
+#define SCRIPT_OBJ_LAST(name)                                  WRAP_OBJ_LAST(name), asCALL_GENERIC
+
+#endif
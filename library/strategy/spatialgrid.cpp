@@ -0,0 +1,251 @@
+
+/************************************************************************
+*    FILE NAME:       spatialgrid.cpp
+*
+*    DESCRIPTION:     Uniform grid of the strategy's active nodes used to
+*                     narrow down the nodes a camera has to cull
+************************************************************************/
+
+// Physical component dependency
+#include <strategy/spatialgrid.h>
+
+// Game lib dependencies
+#include <node/inode.h>
+#include <common/object.h>
+#include <common/camera.h>
+
+// Standard lib dependencies
+#include <algorithm>
+#include <cmath>
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CSpatialGrid::CSpatialGrid( float cellSize ) :
+    m_cellSize( cellSize ),
+    m_maxAbsZ( 0.f )
+{
+}
+
+/************************************************************************
+*    DESC:  destructor
+************************************************************************/
+CSpatialGrid::~CSpatialGrid()
+{
+}
+
+/************************************************************************
+*    DESC:  Move the nodes that changed cells and handle added and removed nodes
+*
+*    NOTE:  Entries are matched to the node vector by index. A node added
+*           or removed shifts the ones after it so they get re-inserted.
+************************************************************************/
+void CSpatialGrid::update( const std::vector<iNode *> & pNodeVec )
+{
+    // Remove the entries past the end of the node vector
+    while( m_entryVec.size() > pNodeVec.size() )
+    {
+        remove( m_entryVec.size() - 1, m_entryVec.back() );
+        m_entryVec.pop_back();
+    }
+
+    if( pNodeVec.empty() )
+    {
+        clear();
+        return;
+    }
+
+    m_entryVec.resize( pNodeVec.size() );
+    m_maxAbsZ = 0.f;
+
+    for( size_t i = 0; i < pNodeVec.size(); ++i )
+    {
+        iNode * pNode = pNodeVec[i];
+        const CPoint<float> & transPos = pNode->getObject()->getTransPos();
+        const float radius = pNode->getRadius();
+
+        m_maxAbsZ = std::max( m_maxAbsZ, std::abs(transPos.z) );
+
+        CCellRange range;
+        range.x1 = toCell( transPos.x - radius );
+        range.y1 = toCell( transPos.y - radius );
+        range.x2 = toCell( transPos.x + radius );
+        range.y2 = toCell( transPos.y + radius );
+
+        CGridEntry & rEntry = m_entryVec[i];
+        if( (rEntry.m_pNode != pNode) || !(rEntry.m_range == range) )
+        {
+            remove( i, rEntry );
+
+            rEntry.m_pNode = pNode;
+            rEntry.m_range = range;
+            insert( i, rEntry );
+        }
+    }
+}
+
+/************************************************************************
+*    DESC:  Get the nodes the camera could see in draw order
+*
+*    NOTE:  The candidates still need the camera's exact cull test.
+*           Returns false if the grid can't do better than testing every node
+************************************************************************/
+bool CSpatialGrid::query( const CCamera & camera, const std::vector<iNode *> & pNodeVec, std::vector<iNode *> & candidateVec )
+{
+    candidateVec.clear();
+
+    // The grid is updated on transform so nodes added since can't be found
+    if( m_entryVec.size() != pNodeVec.size() )
+        return false;
+
+    if( m_entryVec.empty() )
+        return true;
+
+    CPoint<float> minPos, maxPos;
+    camera.getCullBounds( m_maxAbsZ, minPos, maxPos );
+
+    // Only look at the cells that have been used. Also keeps unbounded axes finite
+    const float usedMinX = m_usedRange.x1 * m_cellSize;
+    const float usedMinY = m_usedRange.y1 * m_cellSize;
+    const float usedMaxX = m_usedRange.x2 * m_cellSize;
+    const float usedMaxY = m_usedRange.y2 * m_cellSize;
+
+    if( (m_usedRange.x2 < m_usedRange.x1) || (maxPos.x < usedMinX) || (maxPos.y < usedMinY) || (minPos.x >= usedMaxX + m_cellSize) || (minPos.y >= usedMaxY + m_cellSize) )
+    {
+        // Nothing in the cells but the large nodes could still be seen
+        for( auto iter : m_largeVec )
+            m_indexVec.push_back( iter );
+    }
+    else
+    {
+        const int x1 = toCell( std::max( minPos.x, usedMinX ) );
+        const int y1 = toCell( std::max( minPos.y, usedMinY ) );
+        const int x2 = toCell( std::min( maxPos.x, usedMaxX ) );
+        const int y2 = toCell( std::min( maxPos.y, usedMaxY ) );
+
+        // Looking up more cells than there are nodes is slower than testing them all
+        if( ((size_t)(x2 - x1 + 1) * (size_t)(y2 - y1 + 1)) > m_entryVec.size() )
+            return false;
+
+        m_indexVec.assign( m_largeVec.begin(), m_largeVec.end() );
+
+        for( int y = y1; y <= y2; ++y )
+        {
+            for( int x = x1; x <= x2; ++x )
+            {
+                auto iter = m_cellMap.find( getKey( x, y ) );
+                if( iter != m_cellMap.end() )
+                    m_indexVec.insert( m_indexVec.end(), iter->second.begin(), iter->second.end() );
+            }
+        }
+    }
+
+    // Nodes can be in more than one cell. Sorting the indexes keeps the draw order.
+    std::sort( m_indexVec.begin(), m_indexVec.end() );
+    m_indexVec.erase( std::unique( m_indexVec.begin(), m_indexVec.end() ), m_indexVec.end() );
+
+    candidateVec.reserve( m_indexVec.size() );
+    for( auto iter : m_indexVec )
+        candidateVec.push_back( pNodeVec[iter] );
+
+    m_indexVec.clear();
+
+    return true;
+}
+
+/************************************************************************
+*    DESC:  Clear the grid
+************************************************************************/
+void CSpatialGrid::clear()
+{
+    m_cellMap.clear();
+    m_largeVec.clear();
+    m_entryVec.clear();
+    m_usedRange = CCellRange();
+    m_maxAbsZ = 0.f;
+}
+
+/************************************************************************
+*    DESC:  Add the node index to the cells of the entry
+************************************************************************/
+void CSpatialGrid::insert( uint32_t nodeIndex, CGridEntry & rEntry )
+{
+    const CCellRange & range = rEntry.m_range;
+
+    rEntry.m_large = ((range.x2 - range.x1 + 1) * (range.y2 - range.y1 + 1)) > MAX_NODE_CELLS;
+
+    if( rEntry.m_large )
+    {
+        m_largeVec.push_back( nodeIndex );
+        return;
+    }
+
+    for( int y = range.y1; y <= range.y2; ++y )
+        for( int x = range.x1; x <= range.x2; ++x )
+            m_cellMap[ getKey( x, y ) ].push_back( nodeIndex );
+
+    // Grow the used range
+    if( m_usedRange.x2 < m_usedRange.x1 )
+    {
+        m_usedRange = range;
+    }
+    else
+    {
+        m_usedRange.x1 = std::min( m_usedRange.x1, range.x1 );
+        m_usedRange.y1 = std::min( m_usedRange.y1, range.y1 );
+        m_usedRange.x2 = std::max( m_usedRange.x2, range.x2 );
+        m_usedRange.y2 = std::max( m_usedRange.y2, range.y2 );
+    }
+}
+
+/************************************************************************
+*    DESC:  Remove the node index from the cells of the entry
+************************************************************************/
+void CSpatialGrid::remove( uint32_t nodeIndex, CGridEntry & rEntry )
+{
+    if( rEntry.m_pNode == nullptr )
+        return;
+
+    if( rEntry.m_large )
+    {
+        auto iter = std::find( m_largeVec.begin(), m_largeVec.end(), nodeIndex );
+        if( iter != m_largeVec.end() )
+        {
+            *iter = m_largeVec.back();
+            m_largeVec.pop_back();
+        }
+    }
+    else
+    {
+        const CCellRange & range = rEntry.m_range;
+
+        for( int y = range.y1; y <= range.y2; ++y )
+        {
+            for( int x = range.x1; x <= range.x2; ++x )
+            {
+                auto mapIter = m_cellMap.find( getKey( x, y ) );
+                if( mapIter != m_cellMap.end() )
+                {
+                    // Order in a cell doesn't matter because the query sorts the indexes
+                    auto & rIndexVec = mapIter->second;
+                    auto iter = std::find( rIndexVec.begin(), rIndexVec.end(), nodeIndex );
+                    if( iter != rIndexVec.end() )
+                    {
+                        *iter = rIndexVec.back();
+                        rIndexVec.pop_back();
+                    }
+                }
+            }
+        }
+    }
+
+    rEntry.m_pNode = nullptr;
+}
+
+/************************************************************************
+*    DESC:  Get the cell of the position
+************************************************************************/
+int CSpatialGrid::toCell( float pos ) const
+{
+    return (int)std::floor( pos / m_cellSize );
+}
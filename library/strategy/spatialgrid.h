@@ -0,0 +1,108 @@
+
+/************************************************************************
+*    FILE NAME:       spatialgrid.h
+*
+*    DESCRIPTION:     Uniform grid of the strategy's active nodes used to
+*                     narrow down the nodes a camera has to cull
+************************************************************************/
+
+#pragma once
+
+// Game lib dependencies
+#include <common/point.h>
+
+// Boost lib dependencies
+#include <boost/noncopyable.hpp>
+
+// Standard lib dependencies
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+// Forward declaration(s)
+class iNode;
+class CCamera;
+
+class CSpatialGrid : boost::noncopyable
+{
+public:
+
+    // Constructor
+    CSpatialGrid( float cellSize );
+
+    // Destructor
+    ~CSpatialGrid();
+
+    // Move the nodes that changed cells and handle added and removed nodes
+    // NOTE: Called after the nodes have been transformed
+    void update( const std::vector<iNode *> & pNodeVec );
+
+    // Get the nodes the camera could see in draw order
+    // NOTE: Returns false if the grid can't do better than testing every node
+    bool query( const CCamera & camera, const std::vector<iNode *> & pNodeVec, std::vector<iNode *> & candidateVec );
+
+    // Clear the grid
+    void clear();
+
+private:
+
+    // Range of cells a node overlaps
+    class CCellRange
+    {
+    public:
+
+        bool operator == ( const CCellRange & obj ) const
+        { return (x1 == obj.x1) && (y1 == obj.y1) && (x2 == obj.x2) && (y2 == obj.y2); }
+
+        int x1 = 0, y1 = 0, x2 = -1, y2 = -1;
+    };
+
+    // Where a node is in the grid
+    class CGridEntry
+    {
+    public:
+
+        iNode * m_pNode = nullptr;
+        CCellRange m_range;
+
+        // Nodes that cover too many cells are kept in their own list
+        bool m_large = false;
+    };
+
+    // Add/Remove the node index to/from the cells of the entry
+    void insert( uint32_t nodeIndex, CGridEntry & rEntry );
+    void remove( uint32_t nodeIndex, CGridEntry & rEntry );
+
+    // Get the cell of the position
+    int toCell( float pos ) const;
+
+    // Get the key of the cell
+    static uint64_t getKey( int x, int y )
+    { return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y; }
+
+private:
+
+    // Size of a cell in world units
+    float m_cellSize;
+
+    // Node indexes in each cell
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_cellMap;
+
+    // Node indexes too large for the cells
+    std::vector<uint32_t> m_largeVec;
+
+    // Grid entry of each active node. Indexed the same as the strategy's node vector
+    std::vector<CGridEntry> m_entryVec;
+
+    // Cells that have been used. Only grows until the grid is cleared
+    CCellRange m_usedRange;
+
+    // Farthest z of the nodes. Used for the perspective view bounds
+    float m_maxAbsZ;
+
+    // Scratch vector of node indexes for the queries
+    std::vector<uint32_t> m_indexVec;
+
+    // Max number of cells a node can cover before it's put in the large list
+    static constexpr int MAX_NODE_CELLS = 64;
+};
@@ -8,10 +8,13 @@
 #include <strategy/strategy.h>
 
 // Game lib dependencies
+#include <strategy/spatialgrid.h>
 #include <utilities/exceptionhandling.h>
 #include <utilities/xmlParser.h>
 #include <utilities/deletefuncs.h>
 #include <utilities/genfunc.h>
+#include <utilities/threadpool.h>
+#include <utilities/statcounter.h>
 #include <objectdata/objectdatamanager.h>
 #include <node/nodefactory.h>
 #include <node/nodedatalist.h>
@@ -26,6 +29,12 @@
 // Boost lib dependencies
 #include <boost/format.hpp>
 
+// Standard lib dependencies
+#include <algorithm>
+#include <cstring>
+
+thread_local bool CStrategy::m_inUpdateLane = false;
+
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
@@ -101,6 +110,8 @@ void CStrategy::clearAllNodes()
  ************************************************************************/
 void CStrategy::clear()
 {
+    checkNotInUpdateLane( __FUNCTION__ );
+
     m_clearAllNodesFlag = true;
 }
 
@@ -128,6 +139,12 @@ void CStrategy::loadFromFile( const std::string & file )
 
         if( node.isAttributeSet( "defaultCamera" ) )
             m_pCamera = &CCameraMgr::Instance().get( node.getAttribute( "defaultCamera" ) );
+
+        if( node.isAttributeSet( "spatialGridCellSize" ) )
+            setSpatialGrid( std::atof(node.getAttribute( "spatialGridCellSize" )) );
+
+        if( node.isAttributeSet( "parallelUpdate" ) )
+            setParallelUpdate( std::strcmp( node.getAttribute( "parallelUpdate" ), "true" ) == 0 );
     
         for( int i = 0; i < node.nChildNode(); ++i )
         {
@@ -223,6 +240,8 @@ iNode * CStrategy::create(
     bool makeActive,
     const std::string & group )
 {
+    checkNotInUpdateLane( __FUNCTION__ );
+
     if( instanceName.empty() && !makeActive )
         throw NExcept::CCriticalException("Node Create Error!",
                 boost::str( boost::format("Need to supply an instance name if node is not active when created (%s).\n\n%s\nLine: %s")
@@ -271,6 +290,8 @@ iNode * CStrategy::create(
  ************************************************************************/
 iNode * CStrategy::activateNode( const std::string & instanceName )
 {
+    checkNotInUpdateLane( __FUNCTION__ );
+
     // Make sure the strategy we are looking for is available
     auto mapIter = m_pNodeMap.find( instanceName );
     if( mapIter != m_pNodeMap.end() )
@@ -299,6 +320,8 @@ iNode * CStrategy::activateNode( const std::string & instanceName )
  ************************************************************************/
 void CStrategy::deactivateNode( const std::string & instanceName )
 {
+    checkNotInUpdateLane( __FUNCTION__ );
+
     // Make sure the strategy we are looking for is available
     auto mapIter = m_pNodeMap.find( instanceName );
     if( mapIter != m_pNodeMap.end() )
@@ -360,11 +383,22 @@ void CStrategy::incActiveVecPos( const float x, const float y, float z )
 ************************************************************************/
 void CStrategy::destroy( const handle16_t handle )
 {
+    std::lock_guard<std::mutex> lock( m_deleteMutex );
+
     m_deleteVec.push_back( handle );
 }
 
 /***************************************************************************
 *    DESC:  Update the nodes
+*
+*    NOTE:  With the parallel update each active node and its children are
+*           updated in one lane so a node's scripts always run in order.
+*           A script running in a lane can change its own node and its
+*           children, destroy nodes, spawn scripts and read anything that
+*           isn't being changed this update. Creating nodes, changing other
+*           nodes, cameras, menus, sounds and loading have to be done from
+*           the main thread. The node and strategy entry points that aren't
+*           safe from a lane throw when called from one.
 ****************************************************************************/
 void CStrategy::update()
 {
@@ -372,8 +406,34 @@ void CStrategy::update()
     // Deleting it here allows for one cycle to complete before deleting
     deleteFromActiveList();
 
-    for( auto iter : m_pNodeVec )
-        iter->update();
+    if( m_parallelUpdate && (m_pNodeVec.size() > PARALLEL_UPDATE_GRAIN_SIZE) )
+    {
+        CThreadPool::Instance().parallelFor( m_pNodeVec.size(), PARALLEL_UPDATE_GRAIN_SIZE,
+            [this]( size_t begin, size_t end )
+            {
+                // Restored after because a waiting worker can pick up a lane of another job
+                const bool inUpdateLane = m_inUpdateLane;
+                m_inUpdateLane = true;
+
+                try
+                {
+                    for( size_t i = begin; i < end; ++i )
+                        m_pNodeVec[i]->update();
+                }
+                catch( ... )
+                {
+                    m_inUpdateLane = inUpdateLane;
+                    throw;
+                }
+
+                m_inUpdateLane = inUpdateLane;
+            } );
+    }
+    else
+    {
+        for( auto iter : m_pNodeVec )
+            iter->update();
+    }
     
     if( m_clearAllNodesFlag )
     {
@@ -395,8 +455,24 @@ void CStrategy::transform()
 {
     CObject::transform();
 
+    const bool transformed = wasTranformed();
+
+    // Nodes with nothing changed below them are skipped along with their children
     for( auto iter : m_pNodeVec )
-        iter->transform( *this );
+    {
+        CObject * pObject = iter->getObject();
+        if( transformed || pObject->isSubtreeDirty() )
+        {
+            iter->transform( *this );
+            pObject->subtreeVisited();
+        }
+    }
+
+    CStatCounter::Instance().publishTransformCounters();
+
+    // Keep the grid in step with the transformed positions
+    if( m_upSpatialGrid )
+        m_upSpatialGrid->update( m_pNodeVec );
 }
 
 /***************************************************************************
@@ -405,16 +481,73 @@ void CStrategy::transform()
 ****************************************************************************/
 void CStrategy::recordCommandBuffer( uint32_t index )
 {
-    auto cmdBuf( m_commandBufVec.at(index) );
+    // Narrow the nodes down to the ones the cameras could see
+    std::vector<iNode *> & rNodeVec = getCullCandidates( *m_pCamera, m_cullCandidateVec );
 
-    CDevice::Instance().beginCommandBuffer( index, cmdBuf );
+    std::vector<iNode *> * pExtraNodeVec = nullptr;
+    if(m_extraCamera != nullptr)
+        pExtraNodeVec = &getCullCandidates( *m_extraCamera, m_extraCullCandidateVec );
 
-    m_pCamera->recordCommandBuffer( index, cmdBuf, m_pNodeVec );
+    // Large node vectors are split into chunks that are recorded in parallel
+    size_t chunkCount = 0;
+    if( !m_parallelCmdBufVec.empty() )
+        chunkCount = std::min( m_parallelCmdBufVec.at(index).size() / 2, rNodeVec.size() / PARALLEL_CHUNK_MIN_NODES );
 
-    if(m_extraCamera != nullptr)
-        m_extraCamera->recordCommandBuffer( index, cmdBuf, m_pNodeVec );
-    
-    CDevice::Instance().endCommandBuffer( cmdBuf );
+    if( chunkCount > 1 )
+    {
+        CJobCounter counter;
+        const VkCommandBuffer * pCmdBuf = m_parallelCmdBufVec[index].data();
+        size_t cmdBufCount = chunkCount;
+
+        m_pCamera->recordCommandBuffer( index, pCmdBuf, chunkCount, rNodeVec, counter );
+
+        // The extra camera chunks follow the default camera chunks to keep the draw order
+        if(m_extraCamera != nullptr)
+        {
+            m_extraCamera->recordCommandBuffer( index, pCmdBuf + chunkCount, chunkCount, *pExtraNodeVec, counter );
+            cmdBufCount += chunkCount;
+        }
+
+        m_parallelCmdBufCountVec.at(index) = cmdBufCount;
+
+        CThreadPool::Instance().wait( counter );
+    }
+    else
+    {
+        auto cmdBuf( m_commandBufVec.at(index) );
+
+        if( !m_parallelCmdBufCountVec.empty() )
+            m_parallelCmdBufCountVec.at(index) = 0;
+
+        CDevice::Instance().beginCommandBuffer( index, cmdBuf );
+
+        m_pCamera->recordCommandBuffer( index, cmdBuf, rNodeVec );
+
+        if(m_extraCamera != nullptr)
+            m_extraCamera->recordCommandBuffer( index, cmdBuf, *pExtraNodeVec );
+
+        CDevice::Instance().endCommandBuffer( cmdBuf );
+    }
+}
+
+/***************************************************************************
+*    DESC:  Get the nodes the camera needs to cull
+*
+*    NOTE:  Returns the whole active node vector if there's no grid or
+*           the grid can't narrow it down. Nodes left out count as culled.
+****************************************************************************/
+std::vector<iNode *> & CStrategy::getCullCandidates( CCamera & camera, std::vector<iNode *> & candidateVec )
+{
+    if( m_upSpatialGrid &&
+        (camera.getCullType() != ECullType::_NULL_) &&
+        m_upSpatialGrid->query( camera, m_pNodeVec, candidateVec ) )
+    {
+        CStatCounter::Instance().incCullCounters( 0, m_pNodeVec.size() - candidateVec.size() );
+
+        return candidateVec;
+    }
+
+    return m_pNodeVec;
 }
 
 /***************************************************************************
@@ -422,7 +555,18 @@ void CStrategy::recordCommandBuffer( uint32_t index )
 ****************************************************************************/
 void CStrategy::updateSecondaryCmdBuf( uint32_t index )
 {
-    CDevice::Instance().updateSecondaryCmdBuf( m_commandBufVec.at(index) );
+    const size_t parallelCount = (m_parallelCmdBufCountVec.empty() ? 0 : m_parallelCmdBufCountVec.at(index));
+
+    // Add the parallel recorded command buffers in chunk order
+    if( parallelCount > 0 )
+    {
+        for( size_t i = 0; i < parallelCount; ++i )
+            CDevice::Instance().updateSecondaryCmdBuf( m_parallelCmdBufVec[index][i] );
+    }
+    else
+    {
+        CDevice::Instance().updateSecondaryCmdBuf( m_commandBufVec.at(index) );
+    }
 }
 
 /************************************************************************
@@ -430,6 +574,8 @@ void CStrategy::updateSecondaryCmdBuf( uint32_t index )
 ************************************************************************/
 iNode * CStrategy::getNode( const std::string & instanceName )
 {
+    checkNotInUpdateLane( __FUNCTION__ );
+
     auto iter = m_pNodeMap.find( instanceName );
     
     if( iter == m_pNodeMap.end() )
@@ -440,6 +586,20 @@ iNode * CStrategy::getNode( const std::string & instanceName )
     return iter->second;
 }
 
+/************************************************************************
+*    DESC:  Throw if called from a script running in a parallel update lane
+*
+*    NOTE:  The node map and the activate and deactivate vectors are only
+*           safe to change from the main thread
+************************************************************************/
+void CStrategy::checkNotInUpdateLane( const std::string & function )
+{
+    if( m_inUpdateLane )
+        throw NExcept::CCriticalException("Strategy Update Lane Error!",
+            boost::str( boost::format("Can't be called from a script running in a parallel update lane (%s). Do it from the main thread.\n\n%s\nLine: %s")
+                % function % __FUNCTION__ % __LINE__ ));
+}
+
 /************************************************************************
 *    DESC:  Find if the node is active
 ************************************************************************/
@@ -551,6 +711,27 @@ void CStrategy::deleteFromActiveList()
 void CStrategy::setCommandBuffers( std::vector<VkCommandBuffer> & commandBufVec )
 {
     m_commandBufVec = commandBufVec;
+
+    // No parallel command buffers so everything is recorded serially
+    m_parallelCmdBufVec.clear();
+    m_parallelCmdBufCountVec.clear();
+}
+
+void CStrategy::setCommandBuffers( const std::string & cmdBufPool )
+{
+    m_commandBufVec = CDevice::Instance().createSecondaryCommandBuffers( cmdBufPool );
+
+    m_parallelCmdBufVec.clear();
+    m_parallelCmdBufCountVec.clear();
+
+    // Create the command buffers used to split recording across the thread pool.
+    // The waiting thread helps out so allow one chunk more than the thread count.
+    // Doubled so the extra camera chunks can be recorded at the same time.
+    if( CThreadPool::Instance().isActive() )
+    {
+        m_parallelCmdBufVec = CDevice::Instance().createParallelCommandBuffers( cmdBufPool, (CThreadPool::Instance().threadCount() + 1) * 2 );
+        m_parallelCmdBufCountVec.resize( m_commandBufVec.size(), 0 );
+    }
 }
 
 /************************************************************************
@@ -574,3 +755,32 @@ void CStrategy::setExtraCamera( CCamera * pCamera )
 {
     m_extraCamera = pCamera;
 }
+
+
+/************************************************************************
+*    DESC:  Set the cell size of the spatial grid used for culling
+*
+*    NOTE:  Zero turns it off. Best for large scrolling worlds where most
+*           of the nodes are off screen. The grid is filled on the next transform.
+************************************************************************/
+void CStrategy::setSpatialGrid( float cellSize )
+{
+    if( cellSize > 0.f )
+        m_upSpatialGrid.reset( new CSpatialGrid( cellSize ) );
+    else
+        m_upSpatialGrid.reset();
+
+    m_cullCandidateVec.clear();
+    m_extraCullCandidateVec.clear();
+}
+
+/************************************************************************
+*    DESC:  Update the active nodes in parallel script lanes
+*
+*    NOTE:  Only for strategies where the node scripts don't depend on
+*           each other. See CStrategy::update for the rules.
+************************************************************************/
+void CStrategy::setParallelUpdate( bool enable )
+{
+    m_parallelUpdate = enable;
+}
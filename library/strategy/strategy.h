@@ -20,11 +20,14 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
+#include <mutex>
 
 // Forward Declarations
 class CNodeDataList;
 class iNode;
 class CCamera;
+class CSpatialGrid;
 
 class CStrategy : public CObject
 {
@@ -71,6 +74,7 @@ public:
 
     // Set the command buffers
     void setCommandBuffers( std::vector<VkCommandBuffer> & commandBufVec );
+    void setCommandBuffers( const std::string & cmdBufPool );
 
     // Record the command buffer for all the sprite objects that are to be rendered
     void recordCommandBuffer( uint32_t index );
@@ -97,6 +101,16 @@ public:
     // Increment tha active node vector position of all elements  
     void incActiveVecPos( const float x = 0.f, const float y = 0.f, float z = 0.f );
 
+    // Set the cell size of the spatial grid used for culling. Zero turns it off
+    void setSpatialGrid( float cellSize );
+
+    // Update the active nodes in parallel script lanes
+    // NOTE: See CStrategy::update for what the node scripts can do from a lane
+    void setParallelUpdate( bool enable );
+
+    // Throw if called from a script running in a parallel update lane
+    static void checkNotInUpdateLane( const std::string & function );
+
 protected:
 
     // Get the node data by name
@@ -116,6 +130,9 @@ private:
     // Clear all nodes
     void clearAllNodes();
 
+    // Get the nodes the camera needs to cull
+    std::vector<iNode *> & getCullCandidates( CCamera & camera, std::vector<iNode *> & candidateVec );
+
 protected:
 
     // World position value
@@ -156,4 +173,32 @@ protected:
     //       they are freed by deleting the pool they belong to
     //       and the pool will be freed at the end of the state
     std::vector<VkCommandBuffer> m_commandBufVec;
+
+    // Command buffers for recording large node vectors in parallel. Indexed by swap chain image.
+    std::vector< std::vector<VkCommandBuffer> > m_parallelCmdBufVec;
+
+    // Number of parallel command buffers recorded for each swap chain image. Zero if recorded serially.
+    std::vector<size_t> m_parallelCmdBufCountVec;
+
+    // Min number of nodes in a chunk before recording is split across threads
+    static constexpr size_t PARALLEL_CHUNK_MIN_NODES = 128;
+
+    // Optional grid of the active nodes so the cameras don't have to test them all
+    std::unique_ptr<CSpatialGrid> m_upSpatialGrid;
+
+    // Nodes the grid found for the default and extra camera
+    std::vector<iNode *> m_cullCandidateVec;
+    std::vector<iNode *> m_extraCullCandidateVec;
+
+    // Update each active node and its children in its own lane on the thread pool
+    bool m_parallelUpdate = false;
+
+    // Min number of nodes in a lane
+    static constexpr size_t PARALLEL_UPDATE_GRAIN_SIZE = 16;
+
+    // Nodes can be destroyed from the script lanes
+    std::mutex m_deleteMutex;
+
+    // Set while the thread is updating nodes in a parallel update lane
+    static thread_local bool m_inUpdateLane;
 };
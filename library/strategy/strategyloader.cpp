@@ -111,8 +111,7 @@ void CStrategyloader::load( const std::string & filePath )
                     if( cmdBufPoolName.empty() )
                         cmdBufPoolName = strategyName;
                     
-                    auto cmdBuf = CDevice::Instance().createSecondaryCommandBuffers( cmdBufPoolName );
-                    pStrategy->setCommandBuffers( cmdBuf );
+                    pStrategy->setCommandBuffers( cmdBufPoolName );
                     
                     // Load the nodes for the startegy
                     for( int node = 0; node < startegyXML.nChildNode(); ++node )
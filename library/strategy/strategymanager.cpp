@@ -40,6 +40,8 @@ CStrategyMgr::~CStrategyMgr()
  ************************************************************************/
 CStrategy * CStrategyMgr::addStrategy( const std::string & strategyId, CStrategy * pStrategy )
 {
+    CStrategy::checkNotInUpdateLane( __FUNCTION__ );
+
     auto mapIter = m_pStrategyMap.emplace( strategyId, pStrategy );
 
     // Check for duplicate groups being used
@@ -80,6 +82,8 @@ void CStrategyMgr::activateStrategyAry( const CScriptArray & strategyIdAry )
 
 CStrategy * CStrategyMgr::activateStrategy( const std::string & strategyId )
 {
+    CStrategy::checkNotInUpdateLane( __FUNCTION__ );
+
     // Make sure the strategy we are looking for is available
     auto mapIter = m_pStrategyMap.find( strategyId );
     if( mapIter != m_pStrategyMap.end() )
@@ -120,6 +124,8 @@ void CStrategyMgr::deactivateStrategyAry( const CScriptArray & strategyIdAry )
 
 void CStrategyMgr::deactivateStrategy( const std::string & strategyId )
 {
+    CStrategy::checkNotInUpdateLane( __FUNCTION__ );
+
     // Make sure the strategy we are looking for is available
     auto mapIter = m_pStrategyMap.find( strategyId );
     if( mapIter != m_pStrategyMap.end() )
@@ -162,6 +168,8 @@ void CStrategyMgr::deleteStrategyAry( const CScriptArray & strategyIdAry )
 
 void CStrategyMgr::deleteStrategy( const std::string & strategyId )
 {
+    CStrategy::checkNotInUpdateLane( __FUNCTION__ );
+
     // Make sure the strategy we are looking for is available
     auto mapIter = m_pStrategyMap.find( strategyId );
     if( mapIter != m_pStrategyMap.end() )
@@ -12,6 +12,7 @@
 // Standard lib dependencies
 #include <vector>
 #include <deque>
+#include <map>
 
 // Vulkan lib dependencies
 #include <system/vulkan.h>
@@ -22,4 +23,10 @@ public:
 
     std::vector<VkDescriptorPool> m_descriptorPoolVec;
     std::deque<std::vector<CDescriptorSet>> m_descriptorSetDeqVec;
+
+    // Recycled sets waiting to be reused, oldest first
+    std::deque<CDescriptorSet *> m_freeSetDeq;
+
+    // Sets shared by everything using the same texture, keyed by image view
+    std::map<VkImageView, CDescriptorSet *> m_sharedSetMap;
 };
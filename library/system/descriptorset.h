@@ -6,9 +6,15 @@
 
 #pragma once
 
+// Standard lib dependencies
+#include <vector>
+
 // Vulkan lib dependencies
 #include <system/vulkan.h>
 
+// Forward declaration(s)
+class CDescriptorAllocator;
+
 class CDescriptorSet
 {
 public:
@@ -28,4 +34,14 @@ public:
     // Flag to indicate this descriptor set is actively being used so as to not hand it out
     // NOTE: Defaulted to true because it will be active when first allocated
     bool m_active = true;
+
+    // Number of objects sharing this descriptor set
+    uint32_t m_refCount = 0;
+
+    // Image view this set was last updated with. Key for sharing the set
+    VkImageView m_imageView = VK_NULL_HANDLE;
+
+    // Allocator this set came from and if it's waiting in its free queue
+    CDescriptorAllocator * m_pAllocator = nullptr;
+    bool m_queued = false;
 };
@@ -14,6 +14,7 @@
 #include <utilities/genfunc.h>
 #include <utilities/xmlParser.h>
 #include <utilities/smartpointers.h>
+#include <utilities/statcounter.h>
 #include <common/texture.h>
 #include <common/color.h>
 #include <common/model.h>
@@ -32,6 +33,12 @@
 // SDL lib dependencies
 #include <SDL2/SDL_vulkan.h>
 
+// Standard lib dependencies
+#include <algorithm>
+#include <exception>
+
+thread_local std::vector<CDrawCommand> * CDevice::m_pCaptureDrawVec = nullptr;
+
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
@@ -45,6 +52,7 @@ CDevice::CDevice() :
 ************************************************************************/
 CDevice::~CDevice()
 {
+    stopSubmitThread();
 }
 
 /***************************************************************************
@@ -116,9 +124,22 @@ void CDevice::create( const std::string & pipelineCfg )
     // Create the Vulkan instance and graphics pipeline
     CDeviceVulkan::create( validationNameVec, instanceExtensionNameVec, physicalDeviceExtensionNameVec );
 
+    // Create the uniform ring buffers the UBO descriptors point into
+    m_uniformRingSize = CSettings::Instance().getUniformRingSize();
+    createUniformRingBuffers();
+
     // Create the pipelines
     createPipelines( pipelineCfg );
 
+    // Create the buffers used for batching quads into instanced draws
+    createInstanceBuffers();
+
+    // Create the buffers for vertex data streamed every frame
+    createDynamicVertexRingBuffers();
+
+    // Start the submit thread if frames are to be pipelined
+    setFramePipelineDepth( CSettings::Instance().getFramePipelineDepth() );
+
     // Set the full screen
     if( CSettings::Instance().getFullScreen() )
         setFullScreen( CSettings::Instance().getFullScreen() );
@@ -136,6 +157,8 @@ void CDevice::destroy()
     // Wait for all rendering to be finished
     waitForIdle();
 
+    stopSubmitThread();
+
     // Destroy the Vulkan instance
     CDeviceVulkan::destroy();
 
@@ -162,6 +185,12 @@ void CDevice::destroyAssets()
 
         m_commandPoolMap.clear();
 
+        for( auto & mapIter : m_parallelCommandPoolMap )
+            for( auto iter : mapIter.second )
+                vkDestroyCommandPool( m_logicalDevice, iter, nullptr );
+
+        m_parallelCommandPoolMap.clear();
+
         // Free all textures in all groups
         for( auto & mapIter : m_textureMapMap )
             for( auto & iter : mapIter.second )
@@ -175,6 +204,32 @@ void CDevice::destroyAssets()
                 vkDestroyDescriptorPool( m_logicalDevice, iter, nullptr );
 
         m_descriptorAllocatorMap.clear();
+        m_activeDescriptorSetCount = 0;
+        m_descriptorSetCapacity = 0;
+
+        // The shared instance descriptor sets were freed with the pools
+        m_instanceDescriptorSetMap.clear();
+
+        // Free the instance buffers
+        for( auto & iter : m_instanceBufVec )
+            iter.free( m_logicalDevice );
+
+        m_instanceBufVec.clear();
+        m_pInstanceDataVec.clear();
+
+        // Free the uniform ring buffers
+        for( auto & iter : m_uniformRingBufVec )
+            iter.free( m_logicalDevice );
+
+        m_uniformRingBufVec.clear();
+        m_pUniformRingDataVec.clear();
+
+        // Free the dynamic vertex ring buffers
+        for( auto & iter : m_dynamicVertexRingBufVec )
+            iter.free( m_logicalDevice );
+
+        m_dynamicVertexRingBufVec.clear();
+        m_pDynamicVertexRingDataVec.clear();
 
         // Free all memory buffer groups
         for( auto & mapIter : m_memoryBufferMapMap )
@@ -246,6 +301,23 @@ void CDevice::updateSecondaryCmdBuf( VkCommandBuffer cmdBuf )
 *   NOTE:  Can only record once per game object (sprite)
 ****************************************************************************/
 void CDevice::recordCommandBuffers( uint32_t cmdBufIndex )
+{
+    // Start a new frame of instance, uniform and dynamic vertex data
+    resetFrameData();
+
+    // Have the game sprites that are to be rendered update the vector with their command buffer
+    RecordCommandBufferCallback( cmdBufIndex );
+
+    recordPrimaryCommandBuffer( cmdBufIndex, m_secondaryCommandBufVec );
+
+    // Clear out the vector for the next round of command buffers
+    m_secondaryCommandBufVec.clear();
+}
+
+/***************************************************************************
+*   DESC:  Record the primary command buffer that executes the secondary command buffers
+****************************************************************************/
+void CDevice::recordPrimaryCommandBuffer( uint32_t cmdBufIndex, const std::vector<VkCommandBuffer> & secondaryCmdBufVec )
 {
     VkResult vkResult(VK_SUCCESS);
 
@@ -276,15 +348,9 @@ void CDevice::recordCommandBuffers( uint32_t cmdBufIndex )
 
     vkCmdBeginRenderPass( m_primaryCmdBufVec[cmdBufIndex], &renderPassInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS );
 
-    // Have the game sprites that are to be rendered update the vector with their command buffer
-    RecordCommandBufferCallback( cmdBufIndex );
-
     // Execute the secondary command buffers
-    if( !m_secondaryCommandBufVec.empty() )
-        vkCmdExecuteCommands( m_primaryCmdBufVec[cmdBufIndex], m_secondaryCommandBufVec.size(), m_secondaryCommandBufVec.data() );
-
-    // Clear out the vector for the next round of command buffers
-    m_secondaryCommandBufVec.clear();
+    if( !secondaryCmdBufVec.empty() )
+        vkCmdExecuteCommands( m_primaryCmdBufVec[cmdBufIndex], secondaryCmdBufVec.size(), secondaryCmdBufVec.data() );
 
     vkCmdEndRenderPass( m_primaryCmdBufVec[cmdBufIndex] );
 
@@ -294,6 +360,87 @@ void CDevice::recordCommandBuffers( uint32_t cmdBufIndex )
             boost::str( boost::format("Could not record command buffer! %s") % getError(vkResult) ) );
 }
 
+/***************************************************************************
+*   DESC:  Have the game capture the draws of the frame into the snapshot
+*
+*   NOTE:  The game does the culling and writes the frame's uniform, instance
+*          and dynamic vertex data as usual. Only the draws are kept so the
+*          submit thread can record the command buffers.
+****************************************************************************/
+void CDevice::captureFrame( uint32_t imageIndex )
+{
+    // Snapshots are indexed by the submit thread so they can only be added when it's idle
+    if( m_upFrameSnapshotVec.size() < m_framebufferVec.size() )
+    {
+        waitForSubmits( 0 );
+
+        while( m_upFrameSnapshotVec.size() < m_framebufferVec.size() )
+            m_upFrameSnapshotVec.push_back( std::make_unique<CFrameSnapshot>() );
+    }
+
+    CFrameSnapshot & rSnapshot = *m_upFrameSnapshotVec[m_currentFrame];
+    rSnapshot.begin( imageIndex );
+
+    // Start a new frame of instance, uniform and dynamic vertex data
+    resetFrameData();
+
+    m_pCaptureSnapshot = &rSnapshot;
+
+    try
+    {
+        // Have the game sprites that are to be rendered update the vector with their command buffer
+        RecordCommandBufferCallback( imageIndex );
+    }
+    catch( ... )
+    {
+        m_pCaptureSnapshot = nullptr;
+        m_pCaptureDrawVec = nullptr;
+        m_secondaryCommandBufVec.clear();
+        throw;
+    }
+
+    m_pCaptureSnapshot = nullptr;
+
+    // The snapshot takes the command buffers in the order they are executed
+    rSnapshot.setSecondaryCmdBufVec( m_secondaryCommandBufVec );
+}
+
+/***************************************************************************
+*   DESC:  Record the command buffers from the frame snapshot
+*
+*   NOTE:  Called from the submit thread
+****************************************************************************/
+void CDevice::recordFrameSnapshot( const CFrameSnapshot & snapshot )
+{
+    std::unique_lock<std::mutex> lock( m_recordMutex );
+
+    const uint32_t imageIndex = snapshot.getImageIndex();
+
+    for( size_t i = 0; i < snapshot.getDrawListCount(); ++i )
+    {
+        VkCommandBuffer cmdBuffer = snapshot.getCmdBuffer( i );
+
+        beginSecondaryCommandBuffer( imageIndex, cmdBuffer );
+
+        for( auto & iter : snapshot.getDrawVec( i ) )
+            iter.record( cmdBuffer );
+
+        vkEndCommandBuffer( cmdBuffer );
+    }
+
+    recordPrimaryCommandBuffer( imageIndex, snapshot.getSecondaryCmdBufVec() );
+}
+
+/***************************************************************************
+*   DESC:  Start a new frame of instance, uniform and dynamic vertex data
+****************************************************************************/
+void CDevice::resetFrameData()
+{
+    m_instanceCount = 0;
+    m_uniformRingOffset = 0;
+    m_dynamicVertexRingOffset = 0;
+}
+
 /***************************************************************************
 *   DESC:  Render the frame
 ****************************************************************************/
@@ -301,12 +448,30 @@ void CDevice::render()
 {
     VkResult vkResult(VK_SUCCESS);
 
+    // The submit thread needs to be done with the frame that last used this frame's fence
+    if( m_framePipelineDepth > 0 )
+    {
+        if( (vkResult = waitForSubmits( m_framePipelineDepth - 1 )) != VK_SUCCESS )
+        {
+            // Nothing can be queued when the swap chain is recreated
+            waitForSubmits( 0 );
+            handlePresentResult( vkResult );
+        }
+    }
+
     vkWaitForFences( m_logicalDevice, 1, &m_frameFenceVec[m_currentFrame], VK_TRUE, UINT64_MAX );
 
     uint32_t imageIndex(0);
-    vkResult = vkAcquireNextImageKHR( m_logicalDevice, m_swapchain, UINT64_MAX, m_imageAvailableSemaphoreVec[m_currentFrame], VK_NULL_HANDLE, &imageIndex );
+    if( m_framePipelineDepth > 0 )
+        vkResult = acquirePipelinedImage( imageIndex );
+    else
+    {
+        vkResult = vkAcquireNextImageKHR( m_logicalDevice, m_swapchain, UINT64_MAX, m_imageAvailableSemaphoreVec[m_currentFrame], VK_NULL_HANDLE, &imageIndex );
+    }
+
     if( (vkResult == VK_ERROR_OUT_OF_DATE_KHR) || (vkResult == VK_SUBOPTIMAL_KHR) )
     {
+        waitForSubmits( 0 );
         recreateSwapChain();
         return;
     }
@@ -318,13 +483,95 @@ void CDevice::render()
             "Vulkan Error!",
             boost::str( boost::format("Could not present swap chain image! %s") % getError(vkResult) ) );
 
-    // Record the command buffers
-    recordCommandBuffers( imageIndex );
+    // The last frame didn't fit in the uniform ring
+    if( m_uniformRingOffset > m_uniformRingSize )
+        growUniformRing( m_uniformRingOffset );
+
+    // Hand the frame off to the submit thread or record and submit it here
+    if( m_framePipelineDepth > 0 )
+    {
+        // Everything the frame needs is copied into the frame snapshot and the frame's
+        // ring buffers here so the game can move on to the next frame once this returns
+        captureFrame( imageIndex );
+
+        {
+            std::unique_lock<std::mutex> lock( m_submitMutex );
+            m_submitQueue.emplace_back( imageIndex, m_currentFrame );
+            ++m_submitPending;
+        }
+
+        m_submitCondVar.notify_all();
+    }
+    else
+    {
+        recordCommandBuffers( imageIndex );
+
+        handlePresentResult( submitFrame( imageIndex, m_currentFrame ) );
+    }
+    
+    // Handle memory operations based on frame counter
+    frameCounterMemoryOperations();
+
+    // Increment the current frame
+    m_currentFrame = (m_currentFrame + 1) % m_framebufferVec.size();
+
+    // Increment the frame counter
+    m_frameCounter++;
+}
+
+/***************************************************************************
+*   DESC:  Acquire the next swap chain image while the submit thread is presenting
+*
+*   NOTE:  The swap chain is shared with the present on the submit thread.
+*          The image could be waiting on one of the queued presents so the
+*          acquire can't block while holding the lock until they are out.
+*          Until then it only checks and sleeps until a frame is presented.
+****************************************************************************/
+VkResult CDevice::acquirePipelinedImage( uint32_t & imageIndex )
+{
+    VkResult vkResult(VK_SUCCESS);
+
+    while( true )
+    {
+        size_t pending(0);
+        {
+            std::unique_lock<std::mutex> lock( m_submitMutex );
+            pending = m_submitPending;
+        }
+
+        // Only render queues frames so once nothing is queued the acquire can block
+        {
+            std::unique_lock<std::mutex> lock( m_presentMutex );
+            vkResult = vkAcquireNextImageKHR(
+                m_logicalDevice, m_swapchain, (pending == 0) ? UINT64_MAX : 0,
+                m_imageAvailableSemaphoreVec[m_currentFrame], VK_NULL_HANDLE, &imageIndex );
+        }
+
+        if( (vkResult != VK_NOT_READY) && (vkResult != VK_TIMEOUT) )
+            break;
+
+        // Sleep until the submit thread presents another frame
+        std::unique_lock<std::mutex> lock( m_submitMutex );
+        m_submitCondVar.wait( lock, [this, pending] { return m_submitPending < pending; } );
+    }
+
+    return vkResult;
+}
+
+/***************************************************************************
+*   DESC:  Submit and present the recorded frame
+*
+*   NOTE:  Returns the result of the present. Called from the submit thread
+*          when the frames are pipelined.
+****************************************************************************/
+VkResult CDevice::submitFrame( uint32_t imageIndex, size_t frame )
+{
+    VkResult vkResult(VK_SUCCESS);
 
     VkSubmitInfo submitInfo = {};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
-    VkSemaphore waitSemaphores[] = {m_imageAvailableSemaphoreVec[m_currentFrame]};
+    VkSemaphore waitSemaphores[] = {m_imageAvailableSemaphoreVec[frame]};
     VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
     submitInfo.waitSemaphoreCount = 1;
     submitInfo.pWaitSemaphores = waitSemaphores;
@@ -332,13 +579,18 @@ void CDevice::render()
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &m_primaryCmdBufVec[imageIndex];
 
-    VkSemaphore signalSemaphores[] = {m_renderFinishedSemaphoreVec[m_currentFrame]};
+    VkSemaphore signalSemaphores[] = {m_renderFinishedSemaphoreVec[frame]};
     submitInfo.signalSemaphoreCount = 1;
     submitInfo.pSignalSemaphores = signalSemaphores;
 
-    vkResetFences( m_logicalDevice, 1, &m_frameFenceVec[m_currentFrame] );
+    // The transfer queue can be the graphics queue and access to a queue has to be synchronized
+    std::unique_lock<std::mutex> lock( m_transferMutex, std::defer_lock );
+    if( !isTransferQueueUnique() )
+        lock.lock();
 
-    if( (vkResult = vkQueueSubmit( m_graphicsQueue, 1, &submitInfo, m_frameFenceVec[m_currentFrame] )) )
+    vkResetFences( m_logicalDevice, 1, &m_frameFenceVec[frame] );
+
+    if( (vkResult = vkQueueSubmit( m_graphicsQueue, 1, &submitInfo, m_frameFenceVec[frame] )) )
         // NGenFunc::PostDebugMsg(boost::str(
         //         boost::format("Could not submit draw command buffer! %s") % getError(vkResult)));
         throw NExcept::CCriticalException(
@@ -356,7 +608,15 @@ void CDevice::render()
     presentInfo.pImageIndices = &imageIndex;
 
     // Present the swap chain
-    vkResult = vkQueuePresentKHR(m_presentQueue, &presentInfo);
+    std::unique_lock<std::mutex> presentLock( m_presentMutex );
+    return vkQueuePresentKHR(m_presentQueue, &presentInfo);
+}
+
+/***************************************************************************
+*   DESC:  Handle the result of presenting the swap chain
+****************************************************************************/
+void CDevice::handlePresentResult( VkResult vkResult )
+{
     if ((vkResult == VK_ERROR_OUT_OF_DATE_KHR) || (vkResult == VK_SUBOPTIMAL_KHR))
         recreateSwapChain();
 
@@ -368,15 +628,131 @@ void CDevice::render()
                 "Vulkan Error!",
                 boost::str(boost::format("Could not present swap chain image! %s") %
                            getError(vkResult)));
-    
-    // Handle memory operations based on frame counter
-    frameCounterMemoryOperations();
+}
 
-    // Increment the current frame
-    m_currentFrame = (m_currentFrame + 1) % m_framebufferVec.size();
+/***************************************************************************
+*   DESC:  Set the number of frames that can wait on the submit thread
+*
+*   NOTE:  Zero records and submits on the calling thread. Frames are then
+*          handled one at a time in order which is easier to debug. Can't be
+*          more than the number of frame fences minus one. Otherwise render
+*          only captures a snapshot of the frame's draws and the submit thread
+*          records the command buffers, submits and presents.
+****************************************************************************/
+void CDevice::setFramePipelineDepth( uint32_t depth )
+{
+    if( !m_framebufferVec.empty() )
+        depth = std::min( depth, (uint32_t)m_framebufferVec.size() - 1 );
 
-    // Increment the frame counter
-    m_frameCounter++;
+    // Let the current submit thread finish its frames
+    stopSubmitThread();
+
+    m_framePipelineDepth = depth;
+
+    if( m_framePipelineDepth > 0 )
+    {
+        m_submitStop = false;
+        m_submitThread = std::thread( &CDevice::submitLoop, this );
+    }
+
+    NGenFunc::PostDebugMsg( boost::str( boost::format("Frame pipeline depth: %d") % m_framePipelineDepth ) );
+}
+
+/***************************************************************************
+*   DESC:  Get the number of frames that can wait on the submit thread
+****************************************************************************/
+uint32_t CDevice::getFramePipelineDepth() const
+{
+    return m_framePipelineDepth;
+}
+
+/***************************************************************************
+*   DESC:  Record and submit the frames handed off by render
+****************************************************************************/
+void CDevice::submitLoop()
+{
+    std::unique_lock<std::mutex> lock( m_submitMutex );
+
+    while( true )
+    {
+        m_submitCondVar.wait( lock, [this] { return m_submitStop || !m_submitQueue.empty(); } );
+
+        // Only stop once the queued frames are submitted
+        if( m_submitQueue.empty() )
+            break;
+
+        const auto frame = m_submitQueue.front();
+        m_submitQueue.pop_front();
+
+        lock.unlock();
+
+        VkResult vkResult(VK_SUCCESS);
+        std::exception_ptr exception;
+
+        try
+        {
+            recordFrameSnapshot( *m_upFrameSnapshotVec[frame.second] );
+
+            vkResult = submitFrame( frame.first, frame.second );
+        }
+        catch( ... )
+        {
+            exception = std::current_exception();
+        }
+
+        lock.lock();
+
+        // Keep the first problem for render to handle
+        if( exception && !m_submitException )
+            m_submitException = exception;
+
+        if( (vkResult != VK_SUCCESS) && (m_submitResult == VK_SUCCESS) )
+            m_submitResult = vkResult;
+
+        --m_submitPending;
+        m_submitCondVar.notify_all();
+    }
+}
+
+/***************************************************************************
+*   DESC:  Wait for the submit thread to get down to this many queued frames
+*
+*   NOTE:  Rethrows any exception from the submit thread and returns the
+*          present result that needs to be handled
+****************************************************************************/
+VkResult CDevice::waitForSubmits( size_t maxPending )
+{
+    std::unique_lock<std::mutex> lock( m_submitMutex );
+    m_submitCondVar.wait( lock, [this, maxPending] { return m_submitPending <= maxPending; } );
+
+    if( m_submitException )
+    {
+        std::exception_ptr exception = m_submitException;
+        m_submitException = nullptr;
+        std::rethrow_exception( exception );
+    }
+
+    const VkResult vkResult = m_submitResult;
+    m_submitResult = VK_SUCCESS;
+
+    return vkResult;
+}
+
+/***************************************************************************
+*   DESC:  Stop the submit thread after it submits the queued frames
+****************************************************************************/
+void CDevice::stopSubmitThread()
+{
+    if( m_submitThread.joinable() )
+    {
+        {
+            std::unique_lock<std::mutex> lock( m_submitMutex );
+            m_submitStop = true;
+        }
+
+        m_submitCondVar.notify_all();
+        m_submitThread.join();
+    }
 }
 
 /************************************************************************
@@ -416,6 +792,9 @@ void CDevice::createSurface()
 ************************************************************************/
 std::vector<VkCommandBuffer> CDevice::createSecondaryCommandBuffers( const std::string & group )
 {
+    // The submit thread could be recording from this pool
+    std::unique_lock<std::mutex> lock( m_recordMutex );
+
     return CDeviceVulkan::createSecondaryCommandBuffers( createSecondaryCommandPool( group ) );
 }
 
@@ -438,45 +817,232 @@ VkCommandPool CDevice::createSecondaryCommandPool( const std::string & group )
     return iter->second;
 }
 
+/************************************************************************
+*    DESC:  Create secondary command buffers for parallel recording
+*
+*    NOTE:  Returns a vector per swap chain image holding count command
+*           buffers. Each of the count command buffers comes from it's own
+*           pool because a pool can only be used by one thread at a time.
+************************************************************************/
+std::vector< std::vector<VkCommandBuffer> > CDevice::createParallelCommandBuffers( const std::string & group, size_t count )
+{
+    std::vector< std::vector<VkCommandBuffer> > cmdBufVecVec( m_framebufferVec.size() );
+    auto & cmdPoolVec = m_parallelCommandPoolMap[group];
+
+    for( size_t i = 0; i < count; ++i )
+    {
+        VkCommandPool commandPool = CDeviceVulkan::createCommandPool( m_graphicsQueueFamilyIndex );
+        cmdPoolVec.push_back( commandPool );
+
+        auto cmdBufVec = CDeviceVulkan::createSecondaryCommandBuffers( commandPool );
+
+        for( size_t image = 0; image < cmdBufVec.size(); ++image )
+            cmdBufVecVec[image].push_back( cmdBufVec[image] );
+    }
+
+    return cmdBufVecVec;
+}
+
 /************************************************************************
 *    DESC:  Load the image from file path
 ************************************************************************/
 CTexture & CDevice::createTexture( const std::string & group, CTexture & rTexture )
 {
+    // See if this texture has already been loaded
+    {
+        std::unique_lock<std::mutex> lock( m_assetMutex );
+
+        auto mapIter = m_textureMapMap.find( group );
+        if( mapIter != m_textureMapMap.end() )
+        {
+            auto iter = mapIter->second.find( rTexture.textFilePath );
+            if( iter != mapIter->second.end() )
+                return iter->second;
+        }
+    }
+
+    //NGenFunc::PostDebugMsg( boost::str( boost::format("Create texture (%s - %s)") % group % filePath ));
+
+    // Load the image from file path
+    // NOTE: The lock isn't held here so other threads can decode and upload at the same time
+    CDeviceVulkan::createTexture( rTexture );
+
+    std::unique_lock<std::mutex> lock( m_assetMutex );
+
     // Create the map group if it doesn't already exist
     auto mapIter = m_textureMapMap.find( group );
     if( mapIter == m_textureMapMap.end() )
         mapIter = m_textureMapMap.emplace( group, std::map<const std::string, CTexture>() ).first;
 
-    // See if this texture has already been loaded
-    auto iter = mapIter->second.find( rTexture.textFilePath );
+    // Insert the new texture info. Free ours if another thread loaded it first.
+    // The upload may still be sitting in this thread's batch so submit it before freeing.
+    auto iter = mapIter->second.emplace( rTexture.textFilePath, rTexture );
+    if( !iter.second )
+    {
+        flushUploadBatch();
+        rTexture.free( m_logicalDevice );
+    }
+
+    return iter.first->second;
+}
+
+/***************************************************************************
+*   DESC:  Load the images into a texture array
+*          NOTE: The texture file path is only the name of the array in the group
+****************************************************************************/
+CTexture & CDevice::createTextureArray( const std::string & group, CTexture & rTexture, const std::vector<std::string> & filePathVec )
+{
+    // See if this texture array has already been loaded
+    {
+        std::unique_lock<std::mutex> lock( m_assetMutex );
+
+        auto mapIter = m_textureMapMap.find( group );
+        if( mapIter != m_textureMapMap.end() )
+        {
+            auto iter = mapIter->second.find( rTexture.textFilePath );
+            if( iter != mapIter->second.end() )
+                return iter->second;
+        }
+    }
+
+    // Load the images without the lock like createTexture
+    CDeviceVulkan::createTextureArray( rTexture, filePathVec );
 
-    // If it's not found, load the texture and add it to the list
-    if( iter == mapIter->second.end() )
+    std::unique_lock<std::mutex> lock( m_assetMutex );
+
+    auto mapIter = m_textureMapMap.find( group );
+    if( mapIter == m_textureMapMap.end() )
+        mapIter = m_textureMapMap.emplace( group, std::map<const std::string, CTexture>() ).first;
+
+    // Free ours if another thread loaded it first
+    auto iter = mapIter->second.emplace( rTexture.textFilePath, rTexture );
+    if( !iter.second )
     {
-        //NGenFunc::PostDebugMsg( boost::str( boost::format("Create texture (%s - %s)") % group % filePath ));
+        flushUploadBatch();
+        rTexture.free( m_logicalDevice );
+    }
 
-        // Load the image from file path
-        CDeviceVulkan::createTexture( rTexture );
+    return iter.first->second;
+}
+
+/***************************************************************************
+*   DESC:  Create the per frame uniform ring buffers
+*          NOTE: These stay mapped for the life of the device
+****************************************************************************/
+void CDevice::createUniformRingBuffers()
+{
+    m_uniformRingAlignment = std::max( 
+        m_uniformRingAlignment,
+        (uint32_t)m_phyDevVec[m_phyDevIndex].prop.limits.minUniformBufferOffsetAlignment );
+
+    m_uniformRingBufVec = CDeviceVulkan::createUniformBufferVec( m_uniformRingSize + UNIFORM_RING_SPILL_SIZE );
+    m_pUniformRingDataVec.resize( m_uniformRingBufVec.size() );
+
+    // Host visible memory is kept mapped by the allocator
+    for( size_t i = 0; i < m_uniformRingBufVec.size(); ++i )
+        m_pUniformRingDataVec[i] = static_cast<uint8_t *>(m_uniformRingBufVec[i].m_allocation.m_pMappedData);
+
+    m_uniformRingOffset = 0;
+}
+
+/***************************************************************************
+*   DESC:  Allocate space in this frame's uniform ring buffer
+*          NOTE: Thread safe. Returns the offset into the ring.
+****************************************************************************/
+uint32_t CDevice::allocUniformRing( uint32_t size )
+{
+    const uint32_t alignedSize = (size + m_uniformRingAlignment - 1) & ~(m_uniformRingAlignment - 1);
+    const uint32_t offset = m_uniformRingOffset.fetch_add( alignedSize, std::memory_order_relaxed );
+
+    // The draws that don't fit share the spill space for this frame. Render
+    // sees the offset went past the end and grows the ring before the next frame.
+    if( (offset + alignedSize) > m_uniformRingSize )
+    {
+        if( alignedSize > UNIFORM_RING_SPILL_SIZE )
+            throw NExcept::CCriticalException( "Vulkan Error!",
+                boost::str( boost::format("UBO is larger than the uniform ring spill space! (%d bytes)") % alignedSize ) );
 
-        // Insert the new texture info
-        iter = mapIter->second.emplace( rTexture.textFilePath, rTexture ).first;
+        return m_uniformRingSize;
     }
 
-    return iter->second;
+    return offset;
+}
+
+/***************************************************************************
+*   DESC:  Grow the uniform ring buffers to hold a frame of this size
+*          NOTE: Every UBO descriptor points into the ring buffers so
+*                the device has to be idle to update them
+****************************************************************************/
+void CDevice::growUniformRing( uint32_t frameSize )
+{
+    waitForIdle();
+
+    // Leave room for the frame to keep growing
+    const uint32_t size = frameSize + (frameSize / 2);
+    m_uniformRingSize = (size + m_uniformRingAlignment - 1) & ~(m_uniformRingAlignment - 1);
+
+    // The loading threads update descriptor sets with the ring buffers
+    std::unique_lock<std::recursive_mutex> lock( m_descriptorMutex );
+
+    for( auto & iter : m_uniformRingBufVec )
+        iter.free( m_logicalDevice );
+
+    createUniformRingBuffers();
+
+    // Point the UBO of every descriptor set at the new ring buffers
+    for( auto & allocIter : m_descriptorAllocatorMap )
+    {
+        const SDescriptorData & rDescData = getDescriptorData( allocIter.first );
+
+        for( auto & setVecIter : allocIter.second.m_descriptorSetDeqVec )
+            for( auto & setIter : setVecIter )
+                CDeviceVulkan::updateUniformDescriptorVec( setIter.m_descriptorVec, rDescData, m_uniformRingBufVec );
+    }
+
+    NGenFunc::PostDebugMsg( boost::str( boost::format("Uniform ring buffer grown to %d bytes") % m_uniformRingSize ) );
+}
+
+/***************************************************************************
+*   DESC:  Create the per frame dynamic vertex ring buffers
+*          NOTE: These stay mapped for the life of the device
+****************************************************************************/
+void CDevice::createDynamicVertexRingBuffers()
+{
+    m_dynamicVertexRingBufVec = CDeviceVulkan::createHostVertexBufferVec( DYNAMIC_VERTEX_RING_SIZE );
+    m_pDynamicVertexRingDataVec.resize( m_dynamicVertexRingBufVec.size() );
+
+    // Host visible memory is kept mapped by the allocator
+    for( size_t i = 0; i < m_dynamicVertexRingBufVec.size(); ++i )
+        m_pDynamicVertexRingDataVec[i] = static_cast<uint8_t *>(m_dynamicVertexRingBufVec[i].m_allocation.m_pMappedData);
+
+    m_dynamicVertexRingOffset = 0;
+}
+
+/***************************************************************************
+*   DESC:  Allocate space in this frame's dynamic vertex ring buffer
+*          NOTE: Thread safe. Returns the offset into the ring.
+****************************************************************************/
+uint32_t CDevice::allocDynamicVertexRing( uint32_t size )
+{
+    const uint32_t alignedSize = (size + DYNAMIC_VERTEX_RING_ALIGNMENT - 1) & ~(DYNAMIC_VERTEX_RING_ALIGNMENT - 1);
+    const uint32_t offset = m_dynamicVertexRingOffset.fetch_add( alignedSize, std::memory_order_relaxed );
+
+    if( (offset + alignedSize) > DYNAMIC_VERTEX_RING_SIZE )
+        throw NExcept::CCriticalException( "Vulkan Error!",
+            boost::str( boost::format("Dynamic vertex ring buffer is full! (%d bytes)") % DYNAMIC_VERTEX_RING_SIZE ) );
+
+    return offset;
 }
 
 /***************************************************************************
-*   DESC:  Create the uniform buffer
+*   DESC:  Get the dynamic vertex ring buffer for this frame
 ****************************************************************************/
-std::vector<CMemoryBuffer> CDevice::createUniformBufferVec( uint32_t pipelineIndex )
+VkBuffer CDevice::getDynamicVertexBuffer( uint32_t index )
 {
-    // Get the descriptor data from the pipeline id
-    const SPipelineData & rPipelineData = getPipelineData( pipelineIndex );
-    const SDescriptorData & rDescriptorData = getDescriptorData( rPipelineData.descriptorId );
+    if( index < m_dynamicVertexRingBufVec.size() )
+        return m_dynamicVertexRingBufVec[index].m_buffer;
 
-    // Create the uniform buffer
-    return CDeviceVulkan::createUniformBufferVec( rDescriptorData.m_descriptorVec.front().ubo.uboSize );
+    return VK_NULL_HANDLE;
 }
 
 /***************************************************************************
@@ -552,63 +1118,109 @@ void CDevice::createPushDescriptorSet(
 
 /***************************************************************************
 *   DESC:  Get the descriptor sets
+*          NOTE: UBOs are bound with dynamic offsets into the uniform ring so
+*                a descriptor set only depends on the texture. Objects using
+*                the same texture share one set.
 ****************************************************************************/
 CDescriptorSet * CDevice::getDescriptorSet(
     int pipelineIndex,
-    const CTexture & texture,
-    const std::vector<CMemoryBuffer> & uniformBufVec )
+    const CTexture & texture )
 {
+    std::unique_lock<std::recursive_mutex> lock( m_descriptorMutex );
+
     auto & rPipelineData = getPipelineData( pipelineIndex );
     auto & rDescData = getDescriptorData( rPipelineData.descriptorId );
 
     // Create the descriptor pool group if it doesn't already exist
     auto allocIter = m_descriptorAllocatorMap.find( rPipelineData.descriptorId );
     if( allocIter == m_descriptorAllocatorMap.end() )
-    {
         allocIter = m_descriptorAllocatorMap.emplace( rPipelineData.descriptorId, CDescriptorAllocator() ).first;
-        return allocateDescriptorPoolSet( allocIter, texture, uniformBufVec, rPipelineData, rDescData );
-    }
 
-    // See if there are any free descriptors sets available to reuse and return
-    for( auto & descVecIter : allocIter->second.m_descriptorSetDeqVec )
-    {
-        if( !descVecIter.empty() )
-        {
-            for( auto & descSetIter : descVecIter )
-            {
-                if( descSetIter.m_frameRecycleOffset < m_frameCounter && !descSetIter.m_active )
-                {
-                    // Set the active state to indicate this descriptor set is in use
-                    descSetIter.m_active = true;
+    auto & rAllocator = allocIter->second;
 
-                    // Update it with the new info
-                    CDeviceVulkan::updateDescriptorSetVec( descSetIter.m_descriptorVec, texture, rDescData, uniformBufVec );
+    // Share the set already holding this texture
+    auto sharedIter = rAllocator.m_sharedSetMap.find( texture.textureImageView );
+    if( sharedIter != rAllocator.m_sharedSetMap.end() )
+    {
+        CDescriptorSet * pDescriptorSet = sharedIter->second;
 
-                    return &descSetIter;
-                }
-            }
+        // A set with no users is waiting in the free queue but it still holds this texture so just pick it back up
+        if( pDescriptorSet->m_refCount++ == 0 )
+        {
+            pDescriptorSet->m_active = true;
+            ++m_activeDescriptorSetCount;
+            updateDescriptorSetCounters();
         }
+
+        return pDescriptorSet;
     }
 
-    // See if there are any open spots that can be allocated
-    for( size_t i = 0; i < allocIter->second.m_descriptorSetDeqVec.size(); ++i )
+    CDescriptorSet * pDescriptorSet = nullptr;
+
+    // Reuse the oldest recycled set if it's been out of the command buffers long enough
+    // NOTE: Sets are queued in the order they were recycled so if the front isn't ready, none are
+    while( !rAllocator.m_freeSetDeq.empty() )
     {
-        if( allocIter->second.m_descriptorSetDeqVec[i].size() < rDescData.descPoolMax )
+        CDescriptorSet * pFreeSet = rAllocator.m_freeSetDeq.front();
+
+        // Picked back up through the shared map while waiting in the queue
+        if( pFreeSet->m_active )
+        {
+            pFreeSet->m_queued = false;
+            rAllocator.m_freeSetDeq.pop_front();
+        }
+        else if( pFreeSet->m_frameRecycleOffset < m_frameCounter )
         {
-            // Get the pool for this descriptor index
-            auto descPool = allocIter->second.m_descriptorPoolVec.at(i);
+            pFreeSet->m_queued = false;
+            rAllocator.m_freeSetDeq.pop_front();
 
-            // Allocate another descriptor set
-            auto descSetVec = CDeviceVulkan::allocateDescriptorSetVec( rPipelineData, descPool );
-            CDeviceVulkan::updateDescriptorSetVec( descSetVec, texture, rDescData, uniformBufVec );
-            allocIter->second.m_descriptorSetDeqVec[i].emplace_back( descSetVec );
+            // This set no longer holds its old texture
+            auto oldIter = rAllocator.m_sharedSetMap.find( pFreeSet->m_imageView );
+            if( (oldIter != rAllocator.m_sharedSetMap.end()) && (oldIter->second == pFreeSet) )
+                rAllocator.m_sharedSetMap.erase( oldIter );
 
-            return &allocIter->second.m_descriptorSetDeqVec[i].back();
+            // Update it with the new info
+            CDeviceVulkan::updateDescriptorSetVec( pFreeSet->m_descriptorVec, texture, rDescData, m_uniformRingBufVec );
+
+            pDescriptorSet = pFreeSet;
+            break;
+        }
+        else
+        {
+            break;
         }
     }
 
+    // Pools are filled in order so only the last one can have open spots
+    if( (pDescriptorSet == nullptr) &&
+        !rAllocator.m_descriptorSetDeqVec.empty() &&
+        (rAllocator.m_descriptorSetDeqVec.back().size() < rDescData.descPoolMax) )
+    {
+        // Allocate another descriptor set
+        auto descSetVec = CDeviceVulkan::allocateDescriptorSetVec( rPipelineData, rAllocator.m_descriptorPoolVec.back() );
+        CDeviceVulkan::updateDescriptorSetVec( descSetVec, texture, rDescData, m_uniformRingBufVec );
+        rAllocator.m_descriptorSetDeqVec.back().emplace_back( descSetVec );
+
+        pDescriptorSet = &rAllocator.m_descriptorSetDeqVec.back().back();
+    }
+
     // If we made it this far, we need to allocate a new pool for more descriptor sets
-    return allocateDescriptorPoolSet( allocIter, texture, uniformBufVec, rPipelineData, rDescData );
+    if( pDescriptorSet == nullptr )
+        pDescriptorSet = allocateDescriptorPoolSet( allocIter, texture, rPipelineData, rDescData );
+
+    // Set the active state to indicate this descriptor set is in use
+    pDescriptorSet->m_active = true;
+    pDescriptorSet->m_refCount = 1;
+    pDescriptorSet->m_imageView = texture.textureImageView;
+    pDescriptorSet->m_pAllocator = &rAllocator;
+
+    // Share it with anything else using this texture
+    rAllocator.m_sharedSetMap[ texture.textureImageView ] = pDescriptorSet;
+
+    ++m_activeDescriptorSetCount;
+    updateDescriptorSetCounters();
+
+    return pDescriptorSet;
 }
 
 /***************************************************************************
@@ -617,19 +1229,19 @@ CDescriptorSet * CDevice::getDescriptorSet(
 CDescriptorSet * CDevice::allocateDescriptorPoolSet(
     std::map< const std::string, CDescriptorAllocator >::iterator & allocIter,
     const CTexture & texture,
-    const std::vector<CMemoryBuffer> & uniformBufVec,
     const SPipelineData & rPipelineData,
     const SDescriptorData & rDescData )
 {
     // Allocate a new descriptor pool and add it to the list
     auto descPool = CDeviceVulkan::createDescriptorPool( rDescData );
     allocIter->second.m_descriptorPoolVec.push_back( descPool );
+    m_descriptorSetCapacity += rDescData.descPoolMax;
 
     NGenFunc::PostDebugMsg( boost::str( boost::format("Descriptor pool allocated: %s, %d") % rPipelineData.descriptorId % rDescData.descPoolMax ) );
 
     // Allocate the first descriptor set of this new pool
     auto descSetVec = CDeviceVulkan::allocateDescriptorSetVec( rPipelineData, descPool );
-    CDeviceVulkan::updateDescriptorSetVec( descSetVec, texture, rDescData, uniformBufVec );
+    CDeviceVulkan::updateDescriptorSetVec( descSetVec, texture, rDescData, m_uniformRingBufVec );
 
     // Allocate a new spot for more descriptor sets and add the first one
     // NOTE: Reserve the vec so that the memory location doesn't change after a push_back
@@ -646,27 +1258,50 @@ CDescriptorSet * CDevice::allocateDescriptorPoolSet(
 void CDevice::updateDescriptorSet(
     CDescriptorSet * pDescriptorSet,
     int pipelineIndex,
-    const CTexture & texture,
-    const std::vector<CMemoryBuffer> & uniformBufVec )
+    const CTexture & texture )
 {
     auto & rPipelineData = getPipelineData( pipelineIndex );
     auto & rDescData = getDescriptorData( rPipelineData.descriptorId );
 
-    CDeviceVulkan::updateDescriptorSetVec( pDescriptorSet->m_descriptorVec, texture, rDescData, uniformBufVec );
+    CDeviceVulkan::updateDescriptorSetVec( pDescriptorSet->m_descriptorVec, texture, rDescData, m_uniformRingBufVec );
 }
 
 /***************************************************************************
 *   DESC:  Recycle the descriptor set
+*          NOTE: Shared sets are only queued for reuse once the last user is done
 ****************************************************************************/
 void CDevice::recycleDescriptorSet( CDescriptorSet * pDescriptorSet )
 {
-    if( pDescriptorSet != nullptr )
+    std::unique_lock<std::recursive_mutex> lock( m_descriptorMutex );
+
+    if( (pDescriptorSet != nullptr) && (pDescriptorSet->m_refCount > 0) )
     {
-        pDescriptorSet->m_active = false;
-        pDescriptorSet->m_frameRecycleOffset = m_frameCounter + m_framebufferVec.size();
+        if( --pDescriptorSet->m_refCount == 0 )
+        {
+            pDescriptorSet->m_active = false;
+            pDescriptorSet->m_frameRecycleOffset = m_frameCounter + m_framebufferVec.size();
+
+            // It could still be in the queue if it was picked back up before being reused
+            if( !pDescriptorSet->m_queued && (pDescriptorSet->m_pAllocator != nullptr) )
+            {
+                pDescriptorSet->m_queued = true;
+                pDescriptorSet->m_pAllocator->m_freeSetDeq.push_back( pDescriptorSet );
+            }
+
+            --m_activeDescriptorSetCount;
+            updateDescriptorSetCounters();
+        }
     }
 }
 
+/***************************************************************************
+*   DESC:  Update the descriptor set pool occupancy stats
+****************************************************************************/
+void CDevice::updateDescriptorSetCounters()
+{
+    CStatCounter::Instance().setDescriptorSetCounters( m_activeDescriptorSetCount, m_descriptorSetCapacity );
+}
+
 /************************************************************************
 *    DESC:  Create the pipelines from config file
 ************************************************************************/
@@ -807,6 +1442,7 @@ void CDevice::createPipelines( const std::string & filePath )
         const std::string vertexInputDescrId = pipelineNode.getAttribute("vertexInputDescrId");
         pipelineData.vertInputBindingDesc = NVertex::getBindingDesc( vertexInputDescrId );
         pipelineData.vertInputAttrDescVec = NVertex::getAttributeDesc( vertexInputDescrId );
+        pipelineData.instanceInputBindingDesc = NVertex::getInstanceBindingDesc( vertexInputDescrId );
 
         // Get the attribute from the "colorBlendAttachment" node
         const XMLNode colorBlendAttachmentNode = pipelineNode.getChildNode("colorBlendAttachment");
@@ -930,15 +1566,105 @@ void CDevice::createPipelines( const std::string & filePath )
             }
         }
 
-        // Create the graphics pipeline
-        CDeviceVulkan::createPipeline( pipelineData );
-
         // Map for holding index of the pipeline in the vector
         m_pipelineIndexMap.emplace( pipelineData.id, i );
 
         // Vector of pipeline data for quick access
         m_pipelineDataVec.emplace_back( pipelineData );
     }
+
+    // Create the graphics pipelines
+    CDeviceVulkan::createPipelineVec( m_pipelineDataVec );
+
+    // Link the pipelines to their instanced version now that they all exist
+    for( int i = 0; i < pipelineLstNode.nChildNode(); ++i )
+    {
+        const XMLNode pipelineNode = pipelineLstNode.getChildNode(i);
+
+        if( pipelineNode.isAttributeSet("instancedPipelineId") )
+        {
+            const std::string instancedPipelineId = pipelineNode.getAttribute("instancedPipelineId");
+            const int instancedIndex = getPipelineIndex( instancedPipelineId );
+
+            if( m_pipelineDataVec[instancedIndex].instanceInputBindingDesc.stride == 0 )
+                throw NExcept::CCriticalException(
+                    "Vulkan Error!",
+                    boost::str( boost::format("Pipeline is not instanced! %s") % instancedPipelineId ) );
+
+            m_pipelineDataVec[i].instancedPipelineIndex = instancedIndex;
+        }
+    }
+}
+
+/************************************************************************
+*    DESC:  Create the persistently mapped per frame instance buffers
+************************************************************************/
+void CDevice::createInstanceBuffers()
+{
+    const VkDeviceSize bufferSize = sizeof(NVertex::quad_instance) * MAX_INSTANCES;
+
+    m_instanceBufVec = CDeviceVulkan::createHostVertexBufferVec( bufferSize );
+    m_pInstanceDataVec.resize( m_instanceBufVec.size() );
+
+    // Host visible memory is kept mapped by the allocator
+    for( size_t i = 0; i < m_instanceBufVec.size(); ++i )
+        m_pInstanceDataVec[i] = static_cast<NVertex::quad_instance *>(m_instanceBufVec[i].m_allocation.m_pMappedData);
+
+    m_instanceCount = 0;
+}
+
+/************************************************************************
+*    DESC:  Allocate a block of instances from this frame's instance buffer
+*
+*    NOTE:  Thread safe. Returns false if the buffer is used up.
+************************************************************************/
+bool CDevice::allocInstanceBlock( uint32_t count, uint32_t & firstInstance )
+{
+    firstInstance = m_instanceCount.fetch_add( count, std::memory_order_relaxed );
+
+    return ((firstInstance + count) <= MAX_INSTANCES);
+}
+
+/************************************************************************
+*    DESC:  Get the mapped instance data for this frame
+************************************************************************/
+NVertex::quad_instance * CDevice::getInstanceData( uint32_t index )
+{
+    if( index < m_pInstanceDataVec.size() )
+        return m_pInstanceDataVec[index];
+
+    return nullptr;
+}
+
+/************************************************************************
+*    DESC:  Get the instance buffer for this frame
+************************************************************************/
+VkBuffer CDevice::getInstanceBuffer( uint32_t index )
+{
+    if( index < m_instanceBufVec.size() )
+        return m_instanceBufVec[index].m_buffer;
+
+    return VK_NULL_HANDLE;
+}
+
+/************************************************************************
+*    DESC:  Get the descriptor set shared by all instanced draws
+*           using this pipeline and texture
+*
+*    NOTE:  Instanced pipelines only bind the texture so one descriptor
+*           set can be shared by every quad using the same texture.
+************************************************************************/
+CDescriptorSet * CDevice::getInstanceDescriptorSet( int pipelineIndex, const CTexture & texture )
+{
+    std::unique_lock<std::recursive_mutex> lock( m_descriptorMutex );
+
+    const auto key = std::make_pair( pipelineIndex, texture.textureImageView );
+
+    auto iter = m_instanceDescriptorSetMap.find( key );
+    if( iter == m_instanceDescriptorSetMap.end() )
+        iter = m_instanceDescriptorSetMap.emplace( key, getDescriptorSet( pipelineIndex, texture ) ).first;
+
+    return iter->second;
 }
 
 /************************************************************************
@@ -1000,8 +1726,7 @@ VkStencilOp CDevice::selectVkStencilOp( const std::string modeStr, VkStencilOp d
 ************************************************************************/
 void CDevice::recreatePipelines()
 {
-    for( auto & iter : m_pipelineDataVec )
-        CDeviceVulkan::createPipeline( iter );
+    CDeviceVulkan::createPipelineVec( m_pipelineDataVec );
 }
 
 /***************************************************************************
@@ -1025,6 +1750,8 @@ VkShaderModule CDevice::createShader( const std::string & filePath )
 ************************************************************************/
 void CDevice::deleteGroupAssets( const std::string & group )
 {
+    std::unique_lock<std::mutex> lock( m_assetMutex );
+
     // Delete all textures and related assets
     deleteTextureGroup( group );
 
@@ -1033,6 +1760,52 @@ void CDevice::deleteGroupAssets( const std::string & group )
     
     // Delete the model group
     deleteModelGroup( group );
+
+    NGenFunc::PostDebugMsg( boost::str( boost::format("Group deleted: %s, %s, %s")
+        % group % m_memoryAllocator.getStatsStr() % m_samplerCache.getStatsStr() ) );
+}
+
+/************************************************************************
+*    DESC:  Get the number of bytes of device memory used by a group
+************************************************************************/
+VkDeviceSize CDevice::getGroupMemorySize( const std::string & group )
+{
+    std::unique_lock<std::mutex> lock( m_assetMutex );
+
+    VkDeviceSize size = 0;
+
+    auto textMapIter = m_textureMapMap.find( group );
+    if( textMapIter != m_textureMapMap.end() )
+        for( auto & iter : textMapIter->second )
+            size += iter.second.textureImageAllocation.m_size;
+
+    auto memMapIter = m_memoryBufferMapMap.find( group );
+    if( memMapIter != m_memoryBufferMapMap.end() )
+        for( auto & iter : memMapIter->second )
+            size += iter.second.m_allocation.m_size;
+
+    return size;
+}
+
+/************************************************************************
+*    DESC:  Get the device memory allocator statistics
+************************************************************************/
+CMemoryStats CDevice::getMemoryStats()
+{
+    return m_memoryAllocator.getStats();
+}
+
+/************************************************************************
+*    DESC:  Get the sampler cache statistics
+************************************************************************/
+CSamplerStats CDevice::getSamplerStats()
+{
+    return m_samplerCache.getStats();
+}
+
+std::string CDevice::getSamplerStatsStr()
+{
+    return m_samplerCache.getStatsStr();
 }
 
 /************************************************************************
@@ -1044,9 +1817,32 @@ void CDevice::deleteTextureGroup( const std::string & group )
     auto mapIter = m_textureMapMap.find( group );
     if( mapIter != m_textureMapMap.end() )
     {
+        std::unique_lock<std::recursive_mutex> lock( m_descriptorMutex );
+
         // Delete all the textures in this group
         for( auto & iter : mapIter->second )
+        {
+            // Recycle the shared instance descriptor sets using this texture
+            for( auto descIter = m_instanceDescriptorSetMap.begin(); descIter != m_instanceDescriptorSetMap.end(); )
+            {
+                if( descIter->first.second == iter.second.textureImageView )
+                {
+                    recycleDescriptorSet( descIter->second );
+                    descIter = m_instanceDescriptorSetMap.erase( descIter );
+                }
+                else
+                {
+                    ++descIter;
+                }
+            }
+
+            // Stop sharing the descriptor sets holding this texture. Sets still
+            // in use get recycled by their owners as usual.
+            for( auto & allocIter : m_descriptorAllocatorMap )
+                allocIter.second.m_sharedSetMap.erase( iter.second.textureImageView );
+
             AddToDeleteQueue( iter.second );
+        }
 
         // Erase this group
         m_textureMapMap.erase( mapIter );
@@ -1068,6 +1864,16 @@ void CDevice::deleteCommandPoolGroup( const std::string & group )
         // Erase this group
         m_commandPoolMap.erase( iter );
     }
+
+    // Free the parallel command pools of this group
+    auto parallelIter = m_parallelCommandPoolMap.find( group );
+    if( parallelIter != m_parallelCommandPoolMap.end() )
+    {
+        for( auto cmdPool : parallelIter->second )
+            AddToDeleteQueue( [cmdPool](VkDevice logicalDevice) { vkDestroyCommandPool( logicalDevice, cmdPool, nullptr ); } );
+
+        m_parallelCommandPoolMap.erase( parallelIter );
+    }
 }
 
 /************************************************************************
@@ -1237,6 +2043,9 @@ void CDevice::showWindow( bool visible )
 ****************************************************************************/
 void CDevice::waitForIdle()
 {
+    // Get the frames waiting on the submit thread to the GPU first
+    waitForSubmits( 0 );
+
     // Wait for the logical device to be idle before doing the clean up
     if( m_logicalDevice != VK_NULL_HANDLE )
         vkDeviceWaitIdle( m_logicalDevice );
@@ -1286,6 +2095,18 @@ const SDescriptorData & CDevice::getDescriptorData( const std::string & id ) con
 *   DESC:  Begin the recording of the command buffer
 ****************************************************************************/
 void CDevice::beginCommandBuffer( uint32_t index, VkCommandBuffer cmdBuffer )
+{
+    // The submit thread records the command buffer from the frame snapshot
+    if( m_pCaptureSnapshot != nullptr )
+        m_pCaptureDrawVec = &m_pCaptureSnapshot->addDrawList( cmdBuffer );
+    else
+        beginSecondaryCommandBuffer( index, cmdBuffer );
+}
+
+/***************************************************************************
+*   DESC:  Begin recording the secondary command buffer
+****************************************************************************/
+void CDevice::beginSecondaryCommandBuffer( uint32_t index, VkCommandBuffer cmdBuffer )
 {
     // Setup to begin recording the command buffer
     VkCommandBufferInheritanceInfo cmdBufInheritanceInfo = {};
@@ -1306,15 +2127,34 @@ void CDevice::beginCommandBuffer( uint32_t index, VkCommandBuffer cmdBuffer )
 ****************************************************************************/
 void CDevice::endCommandBuffer( VkCommandBuffer cmdBuffer )
 {
+    if( m_pCaptureDrawVec != nullptr )
+    {
+        m_pCaptureDrawVec = nullptr;
+        return;
+    }
+
     // Stop recording the command buffer
     vkEndCommandBuffer( cmdBuffer );
 }
 
+/***************************************************************************
+*   DESC:  Record the draw or add it to the frame snapshot when the frames are pipelined
+****************************************************************************/
+void CDevice::recordDraw( VkCommandBuffer cmdBuffer, const CDrawCommand & drawCmd )
+{
+    if( m_pCaptureDrawVec != nullptr )
+        m_pCaptureDrawVec->push_back( drawCmd );
+    else
+        drawCmd.record( cmdBuffer );
+}
+
 /************************************************************************
 *    DESC: Get the memory buffer if it exists
 ************************************************************************/
 CMemoryBuffer CDevice::getMemoryBuffer( const std::string & group, const std::string & id )
 {
+    std::unique_lock<std::mutex> lock( m_assetMutex );
+
     // See if the group exists
     auto mapMapIter = m_memoryBufferMapMap.find( group );
     if( mapMapIter == m_memoryBufferMapMap.end() )
@@ -1406,24 +2246,37 @@ void CDevice::createModel(
     const std::string & filePath,
     CModel & model )
 {
-    // Create the map group if it doesn't already exist
-    auto mapMapIter = m_modelMapMap.find( group );
-    if( mapMapIter == m_modelMapMap.end() )
-        mapMapIter = m_modelMapMap.emplace( group, std::map<const std::string, CModel>() ).first;
-
     // See if the ID has already been loaded
-    auto mapIter = mapMapIter->second.find( filePath );
-
-    // If it's not found, create the mesh buffer and add it to the list
-    if( mapIter == mapMapIter->second.end() )
     {
-        mapIter = mapMapIter->second.emplace( filePath, CModel() ).first;
+        std::unique_lock<std::mutex> lock( m_assetMutex );
 
-        loadFrom3DM( group, filePath, mapIter->second );
+        auto mapMapIter = m_modelMapMap.find( group );
+        if( mapMapIter != m_modelMapMap.end() )
+        {
+            auto mapIter = mapMapIter->second.find( filePath );
+            if( mapIter != mapMapIter->second.end() )
+            {
+                // Copy the mesh data to the passed in mesh vector
+                model = mapIter->second;
+                return;
+            }
+        }
     }
 
+    // Load the model without the lock. The textures and buffers it creates are shared
+    // through their own group maps so a model loaded twice by two threads doesn't leak.
+    CModel newModel;
+    loadFrom3DM( group, filePath, newModel );
+
+    std::unique_lock<std::mutex> lock( m_assetMutex );
+
+    // Create the map group if it doesn't already exist
+    auto mapMapIter = m_modelMapMap.find( group );
+    if( mapMapIter == m_modelMapMap.end() )
+        mapMapIter = m_modelMapMap.emplace( group, std::map<const std::string, CModel>() ).first;
+
     // Copy the mesh data to the passed in mesh vector
-    model = mapIter->second;
+    model = mapMapIter->second.emplace( filePath, newModel ).first->second;
 }
 
 /************************************************************************
@@ -1434,6 +2287,9 @@ void CDevice::loadFrom3DM(
     const std::string & filePath,
     CModel & model )
 {
+    // Submit all the uploads of the model together
+    CUploadBatchScope uploadBatch( *this );
+
     // Open file for reading
     NSmart::scoped_SDL_filehandle_ptr<SDL_RWops> scpFile( SDL_RWFromFile( filePath.c_str(), "rb" ) );
     if( scpFile.isNull() )
@@ -1457,6 +2313,8 @@ void CDevice::loadFrom3DM(
     //else
         // Load without textures
         //LoadFromFile( scpFile.get(), fileHeader, filePath, modelVec );
+
+    uploadBatch.end();
 }
 
 /************************************************************************
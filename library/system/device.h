@@ -12,6 +12,7 @@
 
 // Standard lib dependencies
 #include <system/descriptorallocator.h>
+#include <system/framesnapshot.h>
 #include <common/size.h>
 #include <common/color.h>
 
@@ -20,6 +21,16 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <exception>
+#include <utility>
+#include <cstring>
+#include <cstdint>
 
 // SDL lib dependencies
 #include <SDL2/SDL.h>
@@ -36,6 +47,7 @@ class CTexture;
 class CModel;
 class CMeshBinaryFileHeader;
 struct SDL_RWops;
+namespace NVertex { class quad_instance; }
 
 class CDevice : public CDeviceVulkan
 {
@@ -63,12 +75,20 @@ public:
     // Render the frame
     void render();
 
+    // Set/Get the number of frames that can wait on the submit thread
+    // NOTE: Zero records and submits on the calling thread
+    void setFramePipelineDepth( uint32_t depth );
+    uint32_t getFramePipelineDepth() const;
+
     // Create secondary command buffers
     std::vector<VkCommandBuffer> createSecondaryCommandBuffers( const std::string & group );
     
     // Create the command pool group
     VkCommandPool createSecondaryCommandPool( const std::string & group );
 
+    // Create secondary command buffers for parallel recording
+    std::vector< std::vector<VkCommandBuffer> > createParallelCommandBuffers( const std::string & group, size_t count );
+
     // Create push descriptor set
     void createPushDescriptorSet(
         uint32_t pipelineIndex,
@@ -79,8 +99,7 @@ public:
     // Get the descriptor sets
     CDescriptorSet * getDescriptorSet(
         int pipelineIndex,
-        const CTexture & texture,
-        const std::vector<CMemoryBuffer> & uniformBufVec );
+        const CTexture & texture );
 
     // Recycle the descriptor set
     void recycleDescriptorSet( CDescriptorSet * pDescriptorSet );
@@ -88,40 +107,80 @@ public:
     // Load the image from file path
     CTexture & createTexture( const std::string & group, CTexture & rTexture );
 
-    // Create uniform buffer
-    std::vector<CMemoryBuffer> createUniformBufferVec( uint32_t pipelineIndex );
+    // Load the images into a texture array. The texture file path is the name it's kept under
+    CTexture & createTextureArray( const std::string & group, CTexture & rTexture, const std::vector<std::string> & filePathVec );
+
+    // Get the descriptor set shared by all instanced draws using this pipeline and texture
+    CDescriptorSet * getInstanceDescriptorSet( int pipelineIndex, const CTexture & texture );
+
+    // Allocate a block of instances from this frame's instance buffer
+    bool allocInstanceBlock( uint32_t count, uint32_t & firstInstance );
+
+    // Get the mapped instance data and buffer for this frame
+    NVertex::quad_instance * getInstanceData( uint32_t index );
+    VkBuffer getInstanceBuffer( uint32_t index );
+
+    // Get the dynamic vertex ring buffer for this frame
+    VkBuffer getDynamicVertexBuffer( uint32_t index );
 
     // Delete group assets
     void deleteGroupAssets( const std::string & group );
 
+    // Get the number of bytes of device memory used by a group
+    VkDeviceSize getGroupMemorySize( const std::string & group );
+
+    // Get the device memory allocator statistics
+    CMemoryStats getMemoryStats();
+
+    // Get the sampler cache statistics
+    CSamplerStats getSamplerStats();
+
+    // Get the sampler cache statistics as a string for debug output
+    std::string getSamplerStatsStr();
+
     // Delete the command pool group
     void deleteCommandPoolGroup( const std::string & group );
 
     // Load a buffer into video card memory
+    // NOTE: Can be called from the loading threads. The lock is not held during the upload.
     template <typename T>
     CMemoryBuffer & creatMemoryBuffer( const std::string & group, const std::string & id, std::vector<T> dataVec, VkBufferUsageFlagBits bufferUsageFlag )
     {
+        // See if this memory buffer has already been loaded
+        {
+            std::unique_lock<std::mutex> lock( m_assetMutex );
+
+            auto mapIter = m_memoryBufferMapMap.find( group );
+            if( mapIter != m_memoryBufferMapMap.end() )
+            {
+                auto iter = mapIter->second.find( id );
+                if( iter != mapIter->second.end() )
+                    return iter->second;
+            }
+        }
+
+        CMemoryBuffer memoryBuffer;
+
+        // Load buffer into video memory
+        CDeviceVulkan::creatMemoryBuffer( dataVec, memoryBuffer, bufferUsageFlag );
+
+        std::unique_lock<std::mutex> lock( m_assetMutex );
+
         // Create the map group if it doesn't already exist
         auto mapIter = m_memoryBufferMapMap.find( group );
         if( mapIter == m_memoryBufferMapMap.end() )
             mapIter = m_memoryBufferMapMap.emplace( group, std::map<const std::string, CMemoryBuffer>() ).first;
 
-        // See if this memory buffer has already been loaded
-        auto iter = mapIter->second.find( id );
-
-        // If it's not found, create the memory buffer and add it to the list
-        if( iter == mapIter->second.end() )
+        // Insert the buffer into the map. Another thread may have beaten us to it.
+        // The copy may still be sitting in this thread's batch so submit it before freeing.
+        auto iter = mapIter->second.emplace( id, memoryBuffer );
+        if( !iter.second )
         {
-            CMemoryBuffer memoryBuffer;
-
-            // Load buffer into video memory
-            CDeviceVulkan::creatMemoryBuffer( dataVec, memoryBuffer, bufferUsageFlag );
-
-            // Insert the buffer into the map
-            iter = mapIter->second.emplace( id, memoryBuffer ).first;
+            flushUploadBatch();
+            memoryBuffer.free( m_logicalDevice );
         }
 
-        return iter->second;
+        return iter.first->second;
     }
     
     template <typename T>
@@ -131,14 +190,27 @@ public:
         CDeviceVulkan::creatMemoryBuffer( dataVec, memoryBuffer, bufferUsageFlag );
     }
 
-    // Update the uniform buffer
+    // Write the ubo to this frame's uniform ring buffer
+    // NOTE: Returns the dynamic offset to use when binding the descriptor set
+    template <typename T>
+    uint32_t updateUniformBuffer( uint32_t index, const T & ubo )
+    {
+        const uint32_t offset = allocUniformRing( sizeof(ubo) );
+        std::memcpy( m_pUniformRingDataVec[index] + offset, &ubo, sizeof(ubo) );
+
+        return offset;
+    }
+
+    // Write the vertex data to this frame's dynamic vertex ring buffer
+    // NOTE: Returns the offset to use when binding the vertex buffer
     template <typename T>
-    void updateUniformBuffer( T & ubo, VkDeviceMemory deviceMemory )
+    uint32_t updateDynamicVertexBuffer( uint32_t index, const std::vector<T> & dataVec )
     {
-        void* data;
-        vkMapMemory( m_logicalDevice, deviceMemory, 0, sizeof(ubo), 0, &data );
-        std::memcpy( data, &ubo, sizeof(ubo));
-        vkUnmapMemory( m_logicalDevice, deviceMemory );
+        const uint32_t size = sizeof(T) * dataVec.size();
+        const uint32_t offset = allocDynamicVertexRing( size );
+        std::memcpy( m_pDynamicVertexRingDataVec[index] + offset, dataVec.data(), size );
+
+        return offset;
     }
 
     // Get the memory buffer if it exists
@@ -199,6 +271,9 @@ public:
     // End the recording of the command buffer
     void endCommandBuffer( VkCommandBuffer cmdBuffer );
 
+    // Record the draw or add it to the frame snapshot when the frames are pipelined
+    void recordDraw( VkCommandBuffer cmdBuffer, const CDrawCommand & drawCmd );
+
     // Create the shared font IBO buffer
     void createSharedFontIBO( std::vector<uint16_t> & iboVec );
 
@@ -253,6 +328,9 @@ private:
     // Create the pipelines from config file
     void createPipelines( const std::string & filePath );
 
+    // Create the persistently mapped per frame instance buffers
+    void createInstanceBuffers();
+
     // Create the shader
     VkShaderModule createShader( const std::string & filePath );
 
@@ -275,6 +353,39 @@ private:
     // Record the command buffers
     void recordCommandBuffers( uint32_t cmdBufIndex );
 
+    // Record the primary command buffer that executes the secondary command buffers
+    void recordPrimaryCommandBuffer( uint32_t cmdBufIndex, const std::vector<VkCommandBuffer> & secondaryCmdBufVec );
+
+    // Have the game capture the draws of the frame into the snapshot
+    void captureFrame( uint32_t imageIndex );
+
+    // Begin recording the secondary command buffer
+    void beginSecondaryCommandBuffer( uint32_t index, VkCommandBuffer cmdBuffer );
+
+    // Record the command buffers from the frame snapshot
+    void recordFrameSnapshot( const CFrameSnapshot & snapshot );
+
+    // Start a new frame of instance, uniform and dynamic vertex data
+    void resetFrameData();
+
+    // Acquire the next swap chain image while the submit thread is presenting
+    VkResult acquirePipelinedImage( uint32_t & imageIndex );
+
+    // Submit and present the recorded frame
+    VkResult submitFrame( uint32_t imageIndex, size_t frame );
+
+    // Handle the result of presenting the swap chain
+    void handlePresentResult( VkResult vkResult );
+
+    // Submit the frames handed off by render
+    void submitLoop();
+
+    // Wait for the submit thread to get down to this many queued frames
+    VkResult waitForSubmits( size_t maxPending );
+
+    // Stop the submit thread after it submits the queued frames
+    void stopSubmitThread();
+
     // A controlled way to destroy the assets
     void destroyAssets() override;
 
@@ -302,7 +413,6 @@ private:
     CDescriptorSet * allocateDescriptorPoolSet(
         std::map< const std::string, CDescriptorAllocator >::iterator & allocIter,
         const CTexture & texture,
-        const std::vector<CMemoryBuffer> & uniformBufVec,
         const SPipelineData & rPipelineData,
         const SDescriptorData & rDescData );
 
@@ -310,8 +420,25 @@ private:
     void updateDescriptorSet(
         CDescriptorSet * pDescriptorSet,
         int pipelineIndex,
-        const CTexture & texture,
-        const std::vector<CMemoryBuffer> & uniformBufVec );
+        const CTexture & texture );
+
+    // Update the descriptor set pool occupancy stats
+    void updateDescriptorSetCounters();
+
+    // Create the per frame uniform ring buffers
+    void createUniformRingBuffers();
+
+    // Allocate space in this frame's uniform ring buffer
+    uint32_t allocUniformRing( uint32_t size );
+
+    // Grow the uniform ring buffers to hold a frame of this size
+    void growUniformRing( uint32_t frameSize );
+
+    // Create the per frame dynamic vertex ring buffers
+    void createDynamicVertexRingBuffers();
+
+    // Allocate space in this frame's dynamic vertex ring buffer
+    uint32_t allocDynamicVertexRing( uint32_t size );
 
     // Handle memory operations based on frame counter
     void frameCounterMemoryOperations();
@@ -339,12 +466,19 @@ private:
     // Map containing a group of command pools
     std::map< const std::string, VkCommandPool > m_commandPoolMap;
 
+    // Map containing a group of command pools used for parallel recording
+    std::map< const std::string, std::vector<VkCommandPool> > m_parallelCommandPoolMap;
+
     // Map containing a group of texture handles
     std::map< const std::string, std::map< const std::string, CTexture > > m_textureMapMap;
 
     // Map containing a group of descriptor allocator
     std::map< const std::string, CDescriptorAllocator > m_descriptorAllocatorMap;
 
+    // Descriptor sets in use and the total the pools can hold
+    int m_activeDescriptorSetCount = 0;
+    int m_descriptorSetCapacity = 0;
+
     // Map containing a group of memory buffer handles
     std::map< const std::string, std::map< const std::string, CMemoryBuffer > > m_memoryBufferMapMap;
 
@@ -384,12 +518,104 @@ private:
     // Shared font IBO
     CMemoryBuffer m_sharedFontIbo;
 
+    // Per frame instance buffers for batched quads and their mapped data
+    std::vector<CMemoryBuffer> m_instanceBufVec;
+    std::vector<NVertex::quad_instance *> m_pInstanceDataVec;
+
+    // Number of instances allocated this frame
+    // NOTE: Atomic because command buffers are recorded from multiple threads
+    std::atomic_uint32_t m_instanceCount{0};
+
+    // Max number of instances per frame
+    static constexpr uint32_t MAX_INSTANCES = 16384;
+
+    // Per frame uniform ring buffers and their mapped data
+    // NOTE: All UBO descriptors point into these using dynamic offsets
+    std::vector<CMemoryBuffer> m_uniformRingBufVec;
+    std::vector<uint8_t *> m_pUniformRingDataVec;
+
+    // Offset of the next free spot in this frame's uniform ring
+    // NOTE: Atomic because command buffers are recorded from multiple threads
+    std::atomic_uint32_t m_uniformRingOffset{0};
+
+    // Required alignment of the dynamic offsets
+    uint32_t m_uniformRingAlignment = 256;
+
+    // Size of each frame's uniform ring buffer. Starts at the size in the settings
+    // NOTE: Grows when a frame needs more than this
+    uint32_t m_uniformRingSize = 4 * 1024 * 1024;
+
+    // Space past the end of the ring shared by the draws of a frame that don't fit
+    static constexpr uint32_t UNIFORM_RING_SPILL_SIZE = 4096;
+
+    // Per frame ring buffers for vertex data written every frame and their mapped data
+    std::vector<CMemoryBuffer> m_dynamicVertexRingBufVec;
+    std::vector<uint8_t *> m_pDynamicVertexRingDataVec;
+
+    // Offset of the next free spot in this frame's dynamic vertex ring
+    // NOTE: Atomic because command buffers are recorded from multiple threads
+    std::atomic_uint32_t m_dynamicVertexRingOffset{0};
+
+    // Alignment of the allocations in the dynamic vertex ring
+    static constexpr uint32_t DYNAMIC_VERTEX_RING_ALIGNMENT = 16;
+
+    // Size of each frame's dynamic vertex ring buffer
+    static constexpr uint32_t DYNAMIC_VERTEX_RING_SIZE = 1024 * 1024;
+
+    // Descriptor sets shared by instanced draws. Keyed by pipeline index and texture image view
+    std::map< std::pair<int, VkImageView>, CDescriptorSet * > m_instanceDescriptorSetMap;
+
+    // Guards the texture, memory buffer and model maps so groups can be loaded from worker threads
+    std::mutex m_assetMutex;
+
+    // Guards the descriptor allocators and the shared instance descriptor sets. Components are
+    // created on the loading threads too. Recursive because the instance sets come from getDescriptorSet
+    // NOTE: Lock order is m_assetMutex then m_descriptorMutex
+    std::recursive_mutex m_descriptorMutex;
+
     // counter that increments for each frame
     uint32_t m_frameCounter = 0;
 
     // The current frame
     size_t m_currentFrame = 0;
 
+    // Number of captured frames that can wait on the submit thread. Zero records and submits on the render thread
+    uint32_t m_framePipelineDepth = 0;
+
+    // Thread that records, submits and presents the captured frames
+    std::thread m_submitThread;
+    std::mutex m_submitMutex;
+    std::condition_variable m_submitCondVar;
+
+    // Acquiring and presenting use the swap chain from different threads
+    std::mutex m_presentMutex;
+
+    // Draws of the frames handed off to the submit thread. One per frame
+    std::vector< std::unique_ptr<CFrameSnapshot> > m_upFrameSnapshotVec;
+
+    // Snapshot the frame's draws are added to while render captures the frame
+    CFrameSnapshot * m_pCaptureSnapshot = nullptr;
+
+    // Draws of the command buffer the thread is capturing
+    static thread_local std::vector<CDrawCommand> * m_pCaptureDrawVec;
+
+    // Held while the submit thread records the command buffers because
+    // access to a command pool has to be synchronized
+    std::mutex m_recordMutex;
+
+    // Captured frames waiting to be recorded and submitted. Swap chain image index and frame
+    std::deque< std::pair<uint32_t, size_t> > m_submitQueue;
+
+    // Number of frames queued or being submitted
+    size_t m_submitPending = 0;
+
+    // Flag to stop the submit thread
+    bool m_submitStop = false;
+
+    // First present result and exception from the submit thread for render to handle
+    VkResult m_submitResult = VK_SUCCESS;
+    std::exception_ptr m_submitException;
+
     // The clear color
     CColor m_clearColor;
 };
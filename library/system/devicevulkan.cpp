@@ -15,14 +15,28 @@
 #include <utilities/settings.h>
 #include <utilities/genfunc.h>
 #include <common/texture.h>
+#include <common/ktx2file.h>
 #include <system/pipeline.h>
+#include <utilities/smartpointers.h>
+#include <utilities/threadpool.h>
 #include <soil/SOIL.h>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
 
+// SDL lib dependencies
+#include <SDL2/SDL.h>
+
 // Standard lib dependencies
 #include <bitset>
+#include <chrono>
+#include <exception>
+
+thread_local CUploadBatch CDeviceVulkan::m_uploadBatch;
+
+// Extensions of the pre-compressed versions of a texture in the order they are tried
+// NOTE: The plain KTX2 file holds RGBA8 for devices that can't sample any of the compressed formats
+static const std::vector<std::string> KTX2_EXTENSION_VEC = { ".astc.ktx2", ".bc.ktx2", ".etc2.ktx2", ".ktx2" };
 
 /************************************************************************
 *    DESC:  Validation layer callback
@@ -59,10 +73,10 @@ CDeviceVulkan::CDeviceVulkan() :
     m_swapchain(VK_NULL_HANDLE),
     m_renderPass(VK_NULL_HANDLE),
     m_primaryCmdPool(VK_NULL_HANDLE),
-    m_transferCmdPool(VK_NULL_HANDLE),
     m_depthImage(VK_NULL_HANDLE),
-    m_depthImageMemory(VK_NULL_HANDLE),
     m_depthImageView(VK_NULL_HANDLE),
+    m_pipelineCache(VK_NULL_HANDLE),
+    m_pipelineCacheWarm(false),
     vkDestroySwapchainKHR(VK_NULL_HANDLE),
     vkGetSwapchainImagesKHR(VK_NULL_HANDLE),
     vkDebugReportCallbackEXT(VK_NULL_HANDLE),
@@ -131,6 +145,18 @@ void CDeviceVulkan::create(
     // Create the logical device
     createLogicalDevice( validationNameVec, physicalDeviceExtensionNameVec );
 
+    // Init the allocator all buffer and image memory comes from
+    m_memoryAllocator.init( m_phyDevVec[m_phyDevIndex].pDev, m_logicalDevice );
+
+    // Init the cache the texture samplers are shared from
+    m_samplerCache.init( m_logicalDevice );
+
+    // Create the staging ring all the uploads go through
+    createStagingRing();
+
+    // Create the pipeline cache before any pipelines are created
+    createPipelineCache();
+
     // Setup the swap chain to be created
     setupSwapChain();
 
@@ -195,14 +221,21 @@ void CDeviceVulkan::destroy()
             m_primaryCmdPool = VK_NULL_HANDLE;
         }
 
-        if( m_transferCmdPool != VK_NULL_HANDLE )
-        {
-            vkDestroyCommandPool( m_logicalDevice, m_transferCmdPool, nullptr );
-            m_transferCmdPool = VK_NULL_HANDLE;
-        }
+        destroyTransferContexts();
+
+        destroyStagingRing();
 
         destroyAssets();
 
+        // Save the pipeline cache for the next run
+        destroyPipelineCache();
+
+        // Destroy the samplers now that all the textures have released them
+        m_samplerCache.destroy();
+
+        // Free the memory blocks now that all the assets have returned their memory
+        m_memoryAllocator.destroy();
+
         vkDestroyDevice( m_logicalDevice, nullptr );
         m_logicalDevice = VK_NULL_HANDLE;
     }
@@ -253,11 +286,7 @@ void CDeviceVulkan::destroySwapChain()
             m_depthImage = VK_NULL_HANDLE;
         }
 
-        if( m_depthImageMemory != VK_NULL_HANDLE )
-        {
-            vkFreeMemory( m_logicalDevice, m_depthImageMemory, nullptr );
-            m_depthImageMemory = VK_NULL_HANDLE;
-        }
+        m_depthImageAllocation.free();
 
         if( m_swapchain != VK_NULL_HANDLE )
         {
@@ -886,7 +915,6 @@ void CDeviceVulkan::createRenderPass()
 void CDeviceVulkan::createPrimaryCommandPool()
 {
     m_primaryCmdPool = createCommandPool( m_graphicsQueueFamilyIndex );
-    m_transferCmdPool = createCommandPool( m_transferQueueFamilyIndex );
 }
 
 /***************************************************************************
@@ -910,7 +938,7 @@ void CDeviceVulkan::createDepthResources()
             VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
             VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
             m_depthImage,
-            m_depthImageMemory );
+            m_depthImageAllocation );
 
         VkImageAspectFlags aspectFlags = VK_IMAGE_ASPECT_DEPTH_BIT;
 
@@ -919,7 +947,9 @@ void CDeviceVulkan::createDepthResources()
 
         m_depthImageView = createImageView( m_depthImage, depthFormat, 1, aspectFlags );
 
-        transitionImageLayout( m_depthImage, depthFormat, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, 1 );
+        VkCommandBuffer commandBuffer = beginSingleTimeCommands();
+        transitionImageLayout( commandBuffer, m_depthImage, depthFormat, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, 1 );
+        endSingleTimeCommands( commandBuffer );
     }
 }
 
@@ -1029,13 +1059,14 @@ VkDescriptorSetLayout CDeviceVulkan::createDescriptorSetLayout( SDescriptorData
     for( auto & descIdIter : descData.m_descriptorVec )
     {
         // There can be multiple uniform buffers
+        // NOTE: Uniform buffers are dynamic because they point into the per frame uniform ring
         if( descIdIter.descrId == "UNIFORM_BUFFER" )
         {
             VkDescriptorSetLayoutBinding binding = {};
             binding.binding = bindingOffset++;
             binding.descriptorCount = 1;
             binding.pImmutableSamplers = nullptr;
-            binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
 
             bindings.push_back( binding );
@@ -1088,10 +1119,52 @@ VkPipelineLayout CDeviceVulkan::createPipelineLayout( VkDescriptorSetLayout desc
     return pipelineLayout;
 }
 
+/***************************************************************************
+*   DESC:  Create the pipelines of the vector on the worker threads
+****************************************************************************/
+void CDeviceVulkan::createPipelineVec( std::vector<SPipelineData> & pipelineDataVec )
+{
+    const auto startTime = std::chrono::steady_clock::now();
+
+    // The viewports are setup here so the registered slots are only called from this thread
+    std::vector<VkViewport> viewportVec( pipelineDataVec.size() );
+    for( size_t i = 0; i < pipelineDataVec.size(); ++i )
+    {
+        VkViewport & viewport = viewportVec[i];
+        viewport.x = 0.f;
+        viewport.y = 0.f;
+        viewport.width = m_swapchainInfo.imageExtent.width;
+        viewport.height = m_swapchainInfo.imageExtent.height;
+        viewport.minDepth = 0.f;
+        viewport.maxDepth = 1.f;
+
+        // Allow the viewport data to be changed by a registered slot
+        m_deviceViewportSignal(viewport, pipelineDataVec[i].id);
+    }
+
+    // Pipeline creation is mostly shader compiling in the driver so each pipeline is a job
+    // NOTE: The pipeline cache is synchronized by the driver
+    CThreadPool::Instance().parallelFor( pipelineDataVec.size(), 1,
+        [this, &pipelineDataVec, &viewportVec]( size_t begin, size_t end )
+        {
+            for( size_t i = begin; i < end; ++i )
+                createPipeline( pipelineDataVec[i], viewportVec[i] );
+        } );
+
+    const float createTime = std::chrono::duration<float, std::milli>( std::chrono::steady_clock::now() - startTime ).count();
+
+    NGenFunc::PostDebugMsg( boost::str( boost::format("Pipelines created: %d in %.1fms (%s cache)")
+        % pipelineDataVec.size() % createTime % (m_pipelineCacheWarm ? "warm" : "cold") ) );
+
+    // The cache now holds these pipelines for when they're recreated
+    if( m_pipelineCache != VK_NULL_HANDLE )
+        m_pipelineCacheWarm = true;
+}
+
 /***************************************************************************
 *   DESC:  Create the pipeline
 ****************************************************************************/
-void CDeviceVulkan::createPipeline( SPipelineData & pipelineData )
+void CDeviceVulkan::createPipeline( SPipelineData & pipelineData, const VkViewport & viewport )
 {
     VkResult vkResult(VK_SUCCESS);
 
@@ -1119,11 +1192,16 @@ void CDeviceVulkan::createPipeline( SPipelineData & pipelineData )
 
     std::vector<VkPipelineShaderStageCreateInfo> shaderStages = {vertShaderStageInfo, fragShaderStageInfo};
 
+    // Instanced pipelines have a second binding for the per instance data
+    std::vector<VkVertexInputBindingDescription> bindingDescVec = { pipelineData.vertInputBindingDesc };
+    if( pipelineData.instanceInputBindingDesc.stride > 0 )
+        bindingDescVec.push_back( pipelineData.instanceInputBindingDesc );
+
     VkPipelineVertexInputStateCreateInfo vertexInputInfo = {};
     vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-    vertexInputInfo.vertexBindingDescriptionCount = 1;
+    vertexInputInfo.vertexBindingDescriptionCount = bindingDescVec.size();
     vertexInputInfo.vertexAttributeDescriptionCount = pipelineData.vertInputAttrDescVec.size();
-    vertexInputInfo.pVertexBindingDescriptions = &pipelineData.vertInputBindingDesc;
+    vertexInputInfo.pVertexBindingDescriptions = bindingDescVec.data();
     vertexInputInfo.pVertexAttributeDescriptions = pipelineData.vertInputAttrDescVec.data();
 
     VkPipelineInputAssemblyStateCreateInfo inputAssembly = {};
@@ -1131,17 +1209,6 @@ void CDeviceVulkan::createPipeline( SPipelineData & pipelineData )
     inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
     inputAssembly.primitiveRestartEnable = VK_FALSE;
 
-    VkViewport viewport = {};
-    viewport.x = 0.f;
-    viewport.y = 0.f;
-    viewport.width = m_swapchainInfo.imageExtent.width;
-    viewport.height = m_swapchainInfo.imageExtent.height;
-    viewport.minDepth = 0.f;
-    viewport.maxDepth = 1.f;
-
-    // Allow the viewport data to be changed by a registered slot
-    m_deviceViewportSignal(viewport, pipelineData.id);
-
     VkRect2D scissor = {};
     scissor.offset = {0, 0};
     scissor.extent = m_swapchainInfo.imageExtent;
@@ -1226,10 +1293,122 @@ void CDeviceVulkan::createPipeline( SPipelineData & pipelineData )
     if( CSettings::Instance().activateDepthBuffer() )
         pipelineInfo.pDepthStencilState = &depthStencil;
 
-    if( (vkResult = vkCreateGraphicsPipelines( m_logicalDevice, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipelineData.pipeline )) )
+    if( (vkResult = vkCreateGraphicsPipelines( m_logicalDevice, m_pipelineCache, 1, &pipelineInfo, nullptr, &pipelineData.pipeline )) )
         throw NExcept::CCriticalException( "Vulkan Error!", boost::str( boost::format("Failed to create graphics pipeline! %s") % getError(vkResult) ) );
 }
 
+/***************************************************************************
+*   DESC:  Create the pipeline cache from the data saved by the last run
+*          NOTE: Data from another device or driver is thrown away and
+*                the cache starts out empty
+****************************************************************************/
+void CDeviceVulkan::createPipelineCache()
+{
+    VkResult vkResult(VK_SUCCESS);
+    std::vector<char> cacheDataVec;
+
+    const std::string & cacheFile = CSettings::Instance().getPipelineCacheFile();
+    if( cacheFile.empty() )
+        return;
+
+    // The preference path is the one place that's writable on all platforms
+    char * pPrefPath = SDL_GetPrefPath( CSettings::Instance().getEngineName().c_str(), CSettings::Instance().getGameName().c_str() );
+    if( pPrefPath != nullptr )
+    {
+        m_pipelineCachePath = std::string(pPrefPath) + cacheFile;
+        SDL_free( pPrefPath );
+
+        NSmart::scoped_SDL_filehandle_ptr<SDL_RWops> scpFile( SDL_RWFromFile( m_pipelineCachePath.c_str(), "rb" ) );
+        if( !scpFile.isNull() )
+        {
+            const Sint64 sizeInBytes = SDL_RWsize( scpFile.get() );
+            if( sizeInBytes > 0 )
+            {
+                cacheDataVec.resize( (size_t)sizeInBytes );
+                if( SDL_RWread( scpFile.get(), cacheDataVec.data(), 1, cacheDataVec.size() ) != cacheDataVec.size() )
+                    cacheDataVec.clear();
+            }
+        }
+    }
+
+    if( !cacheDataVec.empty() && !isPipelineCacheValid( cacheDataVec ) )
+    {
+        NGenFunc::PostDebugMsg( "Pipeline cache is from a different device or driver. Starting with an empty cache." );
+        cacheDataVec.clear();
+    }
+
+    VkPipelineCacheCreateInfo cacheInfo = {};
+    cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    cacheInfo.initialDataSize = cacheDataVec.size();
+    cacheInfo.pInitialData = cacheDataVec.empty() ? nullptr : cacheDataVec.data();
+
+    if( (vkResult = vkCreatePipelineCache( m_logicalDevice, &cacheInfo, nullptr, &m_pipelineCache )) )
+        throw NExcept::CCriticalException( "Vulkan Error!", boost::str( boost::format("Failed to create pipeline cache! %s") % getError(vkResult) ) );
+
+    m_pipelineCacheWarm = !cacheDataVec.empty();
+}
+
+/***************************************************************************
+*   DESC:  Save the pipeline cache data and destroy the cache
+*          NOTE: Failing to save only means a cold start next run
+****************************************************************************/
+void CDeviceVulkan::destroyPipelineCache()
+{
+    if( m_pipelineCache == VK_NULL_HANDLE )
+        return;
+
+    if( !m_pipelineCachePath.empty() )
+    {
+        size_t sizeInBytes(0);
+        std::vector<char> cacheDataVec;
+
+        if( (vkGetPipelineCacheData( m_logicalDevice, m_pipelineCache, &sizeInBytes, nullptr ) == VK_SUCCESS) && (sizeInBytes > 0) )
+        {
+            cacheDataVec.resize( sizeInBytes );
+            if( vkGetPipelineCacheData( m_logicalDevice, m_pipelineCache, &sizeInBytes, cacheDataVec.data() ) != VK_SUCCESS )
+                cacheDataVec.clear();
+            else
+                cacheDataVec.resize( sizeInBytes );
+        }
+
+        if( !cacheDataVec.empty() )
+        {
+            NSmart::scoped_SDL_filehandle_ptr<SDL_RWops> scpFile( SDL_RWFromFile( m_pipelineCachePath.c_str(), "wb" ) );
+            if( scpFile.isNull() || (SDL_RWwrite( scpFile.get(), cacheDataVec.data(), 1, cacheDataVec.size() ) != cacheDataVec.size()) )
+                NGenFunc::PostDebugMsg( boost::str( boost::format("Pipeline cache could not be saved (%s)") % m_pipelineCachePath ) );
+        }
+    }
+
+    vkDestroyPipelineCache( m_logicalDevice, m_pipelineCache, nullptr );
+    m_pipelineCache = VK_NULL_HANDLE;
+    m_pipelineCacheWarm = false;
+}
+
+/***************************************************************************
+*   DESC:  Is the saved pipeline cache data from this device and driver
+*          NOTE: Checks the header every version of the cache data starts with
+****************************************************************************/
+bool CDeviceVulkan::isPipelineCacheValid( const std::vector<char> & cacheDataVec )
+{
+    // Header size, header version, vendor id and device id followed by the cache UUID
+    uint32_t header[4];
+    const size_t headerSize = sizeof(header) + VK_UUID_SIZE;
+
+    if( cacheDataVec.size() < headerSize )
+        return false;
+
+    std::memcpy( header, cacheDataVec.data(), sizeof(header) );
+
+    const VkPhysicalDeviceProperties & rProp = m_phyDevVec[m_phyDevIndex].prop;
+
+    return (header[0] >= headerSize) &&
+           (header[0] <= cacheDataVec.size()) &&
+           (header[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE) &&
+           (header[2] == rProp.vendorID) &&
+           (header[3] == rProp.deviceID) &&
+           (std::memcmp( cacheDataVec.data() + sizeof(header), rProp.pipelineCacheUUID, VK_UUID_SIZE ) == 0);
+}
+
 /***************************************************************************
 *   DESC:  Create the shader
 ****************************************************************************/
@@ -1427,7 +1606,8 @@ void CDeviceVulkan::createImage(
     VkImageUsageFlags usage,
     VkMemoryPropertyFlags properties,
     VkImage & image,
-    VkDeviceMemory & imageMemory )
+    CMemoryAllocation & imageAllocation,
+    uint32_t arrayLayers )
 {
     VkResult vkResult(VK_SUCCESS);
     VkImageCreateInfo imageInfo = {};
@@ -1437,7 +1617,7 @@ void CDeviceVulkan::createImage(
     imageInfo.extent.height = height;
     imageInfo.extent.depth = 1;
     imageInfo.mipLevels = mipLevels;
-    imageInfo.arrayLayers = 1;
+    imageInfo.arrayLayers = arrayLayers;
     imageInfo.format = format;
     imageInfo.tiling = tiling;
     imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
@@ -1451,15 +1631,9 @@ void CDeviceVulkan::createImage(
     VkMemoryRequirements memRequirements;
     vkGetImageMemoryRequirements( m_logicalDevice, image, &memRequirements );
 
-    VkMemoryAllocateInfo allocInfo = {};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
-
-    if( (vkResult = vkAllocateMemory( m_logicalDevice, &allocInfo, nullptr, &imageMemory )) )
-        throw NExcept::CCriticalException( "Vulkan Error!", boost::str( boost::format("Could not allocate image memory! %s") % getError(vkResult) ) );
+    imageAllocation = m_memoryAllocator.allocate( memRequirements, findMemoryType(memRequirements.memoryTypeBits, properties), true );
 
-    if( (vkResult = vkBindImageMemory( m_logicalDevice, image, imageMemory, 0 ) ) )
+    if( (vkResult = vkBindImageMemory( m_logicalDevice, image, imageAllocation.m_memory, imageAllocation.m_offset ) ) )
         throw NExcept::CCriticalException( "Vulkan Error!", boost::str( boost::format("Could not bind image memory! %s") % getError(vkResult) ) );
 }
 
@@ -1471,7 +1645,7 @@ void CDeviceVulkan::createBuffer(
     VkBufferUsageFlags usage,
     VkMemoryPropertyFlags properties,
     VkBuffer & buffer,
-    VkDeviceMemory & bufferMemory )
+    CMemoryAllocation & bufferAllocation )
 {
     VkResult vkResult(VK_SUCCESS);
     VkBufferCreateInfo bufferInfo = {};
@@ -1486,41 +1660,221 @@ void CDeviceVulkan::createBuffer(
     VkMemoryRequirements memRequirements;
     vkGetBufferMemoryRequirements( m_logicalDevice, buffer, &memRequirements );
 
-    VkMemoryAllocateInfo allocInfo = {};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
-
-    if( (vkResult = vkAllocateMemory( m_logicalDevice, &allocInfo, nullptr, &bufferMemory )) )
-        throw NExcept::CCriticalException( "Vulkan Error!", boost::str( boost::format("Could not allocate buffer memory! %s") % getError(vkResult) ) );
+    bufferAllocation = m_memoryAllocator.allocate( memRequirements, findMemoryType(memRequirements.memoryTypeBits, properties), false );
 
-    if( (vkResult = vkBindBufferMemory( m_logicalDevice, buffer, bufferMemory, 0) ) )
+    if( (vkResult = vkBindBufferMemory( m_logicalDevice, buffer, bufferAllocation.m_memory, bufferAllocation.m_offset ) ) )
         throw NExcept::CCriticalException( "Vulkan Error!", boost::str( boost::format("Could not bind buffer memory! %s") % getError(vkResult) ) );
 }
 
 /***************************************************************************
 *   DESC:  Copy a buffer
 ****************************************************************************/
-void CDeviceVulkan::copyBuffer( VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size )
+void CDeviceVulkan::copyBuffer( VkCommandBuffer commandBuffer, VkBuffer srcBuffer, VkDeviceSize srcOffset, VkBuffer dstBuffer, VkDeviceSize size )
 {
-    VkCommandBuffer commandBuffer = beginSingleTimeCommands();
-
     VkBufferCopy copyRegion = {};
+    copyRegion.srcOffset = srcOffset;
     copyRegion.size = size;
     vkCmdCopyBuffer( commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion );
+}
+
+/***************************************************************************
+*   DESC:  Create the persistently mapped staging ring
+****************************************************************************/
+void CDeviceVulkan::createStagingRing()
+{
+    createBuffer(
+        STAGING_RING_SIZE,
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        m_stagingRingBuffer.m_buffer,
+        m_stagingRingBuffer.m_allocation );
+
+    m_stagingRing.init( STAGING_RING_SIZE );
+}
+
+/***************************************************************************
+*   DESC:  Destroy the staging ring
+****************************************************************************/
+void CDeviceVulkan::destroyStagingRing()
+{
+    m_stagingRingBuffer.free( m_logicalDevice );
+}
+
+/***************************************************************************
+*   DESC:  Begin the upload batch of the calling thread
+****************************************************************************/
+void CDeviceVulkan::beginUploadBatch()
+{
+    ++m_uploadBatch.m_depth;
+}
 
-    endSingleTimeCommands( commandBuffer );
+/***************************************************************************
+*   DESC:  End the upload batch of the calling thread
+****************************************************************************/
+void CDeviceVulkan::endUploadBatch()
+{
+    if( --m_uploadBatch.m_depth == 0 )
+        flushUploadBatch();
 }
 
 /***************************************************************************
-*   DESC:  Find the queue family index
+*   DESC:  Get the command buffer of this thread's upload batch
+*          NOTE: allocStaging can flush the batch and free this command
+*                buffer so get it after all the staging is allocated
+****************************************************************************/
+VkCommandBuffer CDeviceVulkan::getUploadCmdBuffer()
+{
+    if( m_uploadBatch.m_cmdBuffer == VK_NULL_HANDLE )
+        m_uploadBatch.m_cmdBuffer = beginSingleTimeCommands();
+
+    return m_uploadBatch.m_cmdBuffer;
+}
+
+/***************************************************************************
+*   DESC:  Get staging memory for an upload
+****************************************************************************/
+void * CDeviceVulkan::allocStaging( VkDeviceSize size, VkBuffer & buffer, VkDeviceSize & offset )
+{
+    // Too big for the ring so it gets its own staging buffer that's freed with the batch
+    if( size > m_stagingRing.getSize() )
+    {
+        CMemoryBuffer stagingBuffer;
+
+        createBuffer(
+            size,
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            stagingBuffer.m_buffer,
+            stagingBuffer.m_allocation );
+
+        m_uploadBatch.m_dedicatedStagingVec.push_back( stagingBuffer );
+
+        buffer = stagingBuffer.m_buffer;
+        offset = 0;
+
+        return stagingBuffer.m_allocation.m_pMappedData;
+    }
+
+    uint64_t id(0);
+    std::unique_lock<std::mutex> lock( m_stagingMutex );
+
+    while( !m_stagingRing.alloc( size, STAGING_ALIGNMENT, offset, id ) )
+    {
+        // Submit this batch so its own ranges can be reused. Only wait on the
+        // other threads when this one holds nothing or they could all end up waiting.
+        if( !m_uploadBatch.m_stagingIdVec.empty() )
+        {
+            lock.unlock();
+            flushUploadBatch();
+            lock.lock();
+        }
+        else
+        {
+            m_stagingCondition.wait( lock );
+        }
+    }
+
+    m_uploadBatch.m_stagingIdVec.push_back( id );
+
+    buffer = m_stagingRingBuffer.m_buffer;
+
+    return static_cast<uint8_t *>(m_stagingRingBuffer.m_allocation.m_pMappedData) + offset;
+}
+
+/***************************************************************************
+*   DESC:  Submit the uploads recorded so far by this thread and wait for them
+****************************************************************************/
+void CDeviceVulkan::flushUploadBatch()
+{
+    std::exception_ptr submitError;
+
+    if( m_uploadBatch.m_cmdBuffer != VK_NULL_HANDLE )
+    {
+        VkCommandBuffer commandBuffer = m_uploadBatch.m_cmdBuffer;
+        m_uploadBatch.m_cmdBuffer = VK_NULL_HANDLE;
+
+        // Hold on to the error until the staging memory is given back or the other threads could wait on it forever
+        try
+        {
+            endSingleTimeCommands( commandBuffer );
+        }
+        catch( ... )
+        {
+            submitError = std::current_exception();
+        }
+    }
+
+    // The transfer is done so the staging memory can be reused
+    if( !m_uploadBatch.m_stagingIdVec.empty() )
+    {
+        std::unique_lock<std::mutex> lock( m_stagingMutex );
+
+        for( auto iter : m_uploadBatch.m_stagingIdVec )
+            m_stagingRing.retire( iter );
+
+        m_uploadBatch.m_stagingIdVec.clear();
+        m_stagingCondition.notify_all();
+    }
+
+    for( auto & iter : m_uploadBatch.m_dedicatedStagingVec )
+        iter.free( m_logicalDevice );
+
+    m_uploadBatch.m_dedicatedStagingVec.clear();
+
+    if( submitError )
+        std::rethrow_exception( submitError );
+}
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CUploadBatchScope::CUploadBatchScope( CDeviceVulkan & rDevice ) :
+    m_rDevice( rDevice )
+{
+    m_rDevice.beginUploadBatch();
+}
+
+/************************************************************************
+*    DESC:  destructor
+*           NOTE: Only ends a batch left open by an exception. That exception
+*                 is already on its way to the caller so a failed submit is posted.
+************************************************************************/
+CUploadBatchScope::~CUploadBatchScope()
+{
+    if( !m_ended )
+    {
+        try
+        {
+            end();
+        }
+        catch( NExcept::CCriticalException & ex )
+        {
+            NGenFunc::PostDebugMsg( ex.getErrorMsg() );
+        }
+    }
+}
+
+/************************************************************************
+*    DESC:  End the batch. The outermost scope submits here so a failed upload throws.
+************************************************************************/
+void CUploadBatchScope::end()
+{
+    if( !m_ended )
+    {
+        m_ended = true;
+        m_rDevice.endUploadBatch();
+    }
+}
+
+/***************************************************************************
+*   DESC:  Begin recording a one time transfer command buffer
 ****************************************************************************/
 VkCommandBuffer CDeviceVulkan::beginSingleTimeCommands()
 {
     VkCommandBufferAllocateInfo allocInfo = {};
     allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
     allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandPool = m_transferCmdPool;
+    allocInfo.commandPool = getTransferContext().m_cmdPool;
     allocInfo.commandBufferCount = 1;
 
     VkCommandBuffer commandBuffer;
@@ -1535,8 +1889,16 @@ VkCommandBuffer CDeviceVulkan::beginSingleTimeCommands()
     return commandBuffer;
 }
 
+/***************************************************************************
+*   DESC:  Submit the one time transfer command buffer and wait for it
+*          NOTE: Only this submit is waited on so loading threads don't
+*                stall on each other's uploads
+****************************************************************************/
 void CDeviceVulkan::endSingleTimeCommands( VkCommandBuffer commandBuffer )
 {
+    VkResult vkResult(VK_SUCCESS);
+    CTransferContext & rContext = getTransferContext();
+
     vkEndCommandBuffer(commandBuffer);
 
     VkSubmitInfo submitInfo = {};
@@ -1544,19 +1906,75 @@ void CDeviceVulkan::endSingleTimeCommands( VkCommandBuffer commandBuffer )
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &commandBuffer;
 
-    vkQueueSubmit( m_transferQueue, 1, &submitInfo, VK_NULL_HANDLE );
-    vkQueueWaitIdle( m_transferQueue );
+    {
+        // The queue is shared by all the loading threads
+        std::unique_lock<std::mutex> lock( m_transferMutex );
+        vkResult = vkQueueSubmit( m_transferQueue, 1, &submitInfo, rContext.m_fence );
+    }
+
+    if( vkResult == VK_SUCCESS )
+    {
+        vkResult = vkWaitForFences( m_logicalDevice, 1, &rContext.m_fence, VK_TRUE, UINT64_MAX );
+        vkResetFences( m_logicalDevice, 1, &rContext.m_fence );
+    }
+
+    vkFreeCommandBuffers( m_logicalDevice, rContext.m_cmdPool, 1, &commandBuffer);
 
-    vkFreeCommandBuffers( m_logicalDevice, m_transferCmdPool, 1, &commandBuffer);
+    if( vkResult )
+        throw NExcept::CCriticalException( "Vulkan Error!", boost::str( boost::format("Transfer submit failed! %s") % getError(vkResult) ) );
 }
 
 /***************************************************************************
-*   DESC:  Transition image layout
+*   DESC:  Get the transfer command pool and fence of the calling thread
+****************************************************************************/
+CTransferContext & CDeviceVulkan::getTransferContext()
+{
+    std::unique_lock<std::mutex> lock( m_transferMutex );
+
+    auto iter = m_transferContextMap.find( std::this_thread::get_id() );
+    if( iter == m_transferContextMap.end() )
+    {
+        VkResult vkResult(VK_SUCCESS);
+        CTransferContext context;
+
+        context.m_cmdPool = createCommandPool( m_transferQueueFamilyIndex );
+
+        VkFenceCreateInfo fenceInfo = {};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+        if( (vkResult = vkCreateFence( m_logicalDevice, &fenceInfo, nullptr, &context.m_fence )) )
+        {
+            vkDestroyCommandPool( m_logicalDevice, context.m_cmdPool, nullptr );
+            throw NExcept::CCriticalException( "Vulkan Error!", boost::str( boost::format("Could not create transfer fence! %s") % getError(vkResult) ) );
+        }
+
+        iter = m_transferContextMap.emplace( std::this_thread::get_id(), context ).first;
+    }
+
+    return iter->second;
+}
+
+/***************************************************************************
+*   DESC:  Destroy the transfer command pools and fences
 ****************************************************************************/
-void CDeviceVulkan::transitionImageLayout( VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t mipLevels )
+void CDeviceVulkan::destroyTransferContexts()
 {
-    VkCommandBuffer commandBuffer = beginSingleTimeCommands();
+    std::unique_lock<std::mutex> lock( m_transferMutex );
 
+    for( auto & iter : m_transferContextMap )
+    {
+        vkDestroyFence( m_logicalDevice, iter.second.m_fence, nullptr );
+        vkDestroyCommandPool( m_logicalDevice, iter.second.m_cmdPool, nullptr );
+    }
+
+    m_transferContextMap.clear();
+}
+
+/***************************************************************************
+*   DESC:  Transition image layout
+****************************************************************************/
+void CDeviceVulkan::transitionImageLayout( VkCommandBuffer commandBuffer, VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t mipLevels, uint32_t layerCount )
+{
     VkImageMemoryBarrier barrier = {};
     barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
     barrier.oldLayout = oldLayout;
@@ -1567,7 +1985,7 @@ void CDeviceVulkan::transitionImageLayout( VkImage image, VkFormat format, VkIma
     barrier.subresourceRange.baseMipLevel = 0;
     barrier.subresourceRange.levelCount = mipLevels;
     barrier.subresourceRange.baseArrayLayer = 0;
-    barrier.subresourceRange.layerCount = 1;
+    barrier.subresourceRange.layerCount = layerCount;
 
     if( newLayout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL )
     {
@@ -1621,24 +2039,20 @@ void CDeviceVulkan::transitionImageLayout( VkImage image, VkFormat format, VkIma
         0, nullptr,
         1, &barrier
     );
-
-    endSingleTimeCommands( commandBuffer );
 }
 
 /***************************************************************************
 *   DESC:  Copy a buffer to an image
 ****************************************************************************/
-void CDeviceVulkan::copyBufferToImage( VkBuffer buffer, VkImage image, uint32_t width, uint32_t height )
+void CDeviceVulkan::copyBufferToImage( VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize bufferOffset, VkImage image, uint32_t width, uint32_t height, uint32_t mipLevel, uint32_t arrayLayer )
 {
-    VkCommandBuffer commandBuffer = beginSingleTimeCommands();
-
     VkBufferImageCopy region = {};
-    region.bufferOffset = 0;
+    region.bufferOffset = bufferOffset;
     region.bufferRowLength = 0;
     region.bufferImageHeight = 0;
     region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    region.imageSubresource.mipLevel = 0;
-    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.mipLevel = mipLevel;
+    region.imageSubresource.baseArrayLayer = arrayLayer;
     region.imageSubresource.layerCount = 1;
     region.imageOffset = {0, 0, 0};
     region.imageExtent = {
@@ -1648,7 +2062,6 @@ void CDeviceVulkan::copyBufferToImage( VkBuffer buffer, VkImage image, uint32_t
     };
 
     vkCmdCopyBufferToImage( commandBuffer, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region );
-    endSingleTimeCommands( commandBuffer );
 }
 
 /***************************************************************************
@@ -1674,6 +2087,14 @@ VkCommandPool CDeviceVulkan::createCommandPool( uint32_t queueFamilyIndex )
 ****************************************************************************/
 void CDeviceVulkan::createTexture( CTexture & texture )
 {
+    // Use the pre-compressed version of the texture if there is one
+    CKtx2File ktx2File;
+    if( loadKtx2File( texture.textFilePath, ktx2File ) )
+    {
+        createTexture( texture, ktx2File );
+        return;
+    }
+
     int channels(0);
     unsigned char * pixels = SOIL_load_image(
         texture.textFilePath.c_str(),
@@ -1689,20 +2110,13 @@ void CDeviceVulkan::createTexture( CTexture & texture )
 
     VkDeviceSize imageSize = texture.size.w * texture.size.h * SOIL_LOAD_RGBA;
 
-    VkBuffer stagingBuffer;
-    VkDeviceMemory stagingBufferMemory;
-
-    createBuffer(
-        imageSize,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-        stagingBuffer,
-        stagingBufferMemory );
+    // The upload is submitted with the rest of this thread's uploads
+    CUploadBatchScope uploadBatch( *this );
 
-    void* data;
-    vkMapMemory( m_logicalDevice, stagingBufferMemory, 0, imageSize, 0, &data );
-    std::memcpy( data, pixels, static_cast<size_t>(imageSize));
-    vkUnmapMemory( m_logicalDevice, stagingBufferMemory );
+    // Copy the pixels into the staging ring
+    VkBuffer stagingBuffer;
+    VkDeviceSize stagingOffset;
+    std::memcpy( allocStaging( imageSize, stagingBuffer, stagingOffset ), pixels, static_cast<size_t>(imageSize));
 
     SOIL_free_image_data( pixels );
 
@@ -1724,30 +2138,246 @@ void CDeviceVulkan::createTexture( CTexture & texture )
         imageUsageFlags,
         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
         texture.textureImage,
-        texture.textureImageMemory );
+        texture.textureImageAllocation );
+
+    VkCommandBuffer commandBuffer = getUploadCmdBuffer();
 
-    transitionImageLayout( texture.textureImage, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, texture.mipLevels );
-    copyBufferToImage( stagingBuffer, texture.textureImage, static_cast<uint32_t>(texture.size.w), static_cast<uint32_t>(texture.size.h) );
+    transitionImageLayout( commandBuffer, texture.textureImage, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, texture.mipLevels );
+    copyBufferToImage( commandBuffer, stagingBuffer, stagingOffset, texture.textureImage, static_cast<uint32_t>(texture.size.w), static_cast<uint32_t>(texture.size.h) );
 
     if( texture.genMipLevels )
-        generateMipmaps( texture.textureImage, VK_FORMAT_R8G8B8A8_UNORM, texture.size.w, texture.size.h, texture.mipLevels );
+        generateMipmaps( commandBuffer, texture.textureImage, VK_FORMAT_R8G8B8A8_UNORM, texture.size.w, texture.size.h, texture.mipLevels );
     else
-        transitionImageLayout( texture.textureImage, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, texture.mipLevels );
-
-    vkDestroyBuffer( m_logicalDevice, stagingBuffer, nullptr );
-    vkFreeMemory( m_logicalDevice, stagingBufferMemory, nullptr );
+        transitionImageLayout( commandBuffer, texture.textureImage, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, texture.mipLevels );
     
     // create the image view
     texture.textureImageView = createImageView( texture.textureImage, VK_FORMAT_R8G8B8A8_UNORM, texture.mipLevels, VK_IMAGE_ASPECT_COLOR_BIT );
 
-    // Create the texture sampler
-    texture.textureSampler = createTextureSampler( texture );
+    // Get the texture sampler
+    createTextureSampler( texture );
+
+    uploadBatch.end();
+}
+
+/***************************************************************************
+*   DESC:  Create a texture array with one layer per image
+*          NOTE: The layers all need to be the same size. The images are always
+*                loaded from the source files and the array doesn't get mip levels
+****************************************************************************/
+void CDeviceVulkan::createTextureArray( CTexture & texture, const std::vector<std::string> & filePathVec )
+{
+    // Load all the images first because the image can't be created until the size is known
+    std::vector<unsigned char *> pixelsVec;
+    pixelsVec.reserve( filePathVec.size() );
+
+    // Free the loaded images on the way out
+    auto freePixels = [&pixelsVec]()
+    {
+        for( auto iter : pixelsVec )
+            SOIL_free_image_data( iter );
+    };
+
+    for( auto & iter : filePathVec )
+    {
+        CSize<int32_t> size;
+        int channels(0);
+        unsigned char * pixels = SOIL_load_image( iter.c_str(), &size.w, &size.h, &channels, SOIL_LOAD_RGBA );
+
+        if( pixels == nullptr )
+        {
+            freePixels();
+            throw NExcept::CCriticalException(
+                "SOIL Error!",
+                boost::str( boost::format("Error loading image! %s") % iter ));
+        }
+
+        pixelsVec.push_back( pixels );
+
+        if( pixelsVec.size() == 1 )
+        {
+            texture.size = size;
+        }
+        else if( size != texture.size )
+        {
+            freePixels();
+            throw NExcept::CCriticalException(
+                "Texture Array Error!",
+                boost::str( boost::format("Texture array images need to be the same size! %s") % iter ));
+        }
+    }
+
+    const VkDeviceSize layerSize = texture.size.w * texture.size.h * SOIL_LOAD_RGBA;
+    texture.mipLevels = 1;
+    texture.layerCount = static_cast<uint32_t>(pixelsVec.size());
+
+    // The upload is submitted with the rest of this thread's uploads
+    CUploadBatchScope uploadBatch( *this );
+
+    // Copy the layers one after the other into the staging ring
+    VkBuffer stagingBuffer;
+    VkDeviceSize stagingOffset;
+    uint8_t * pStaging = static_cast<uint8_t *>(allocStaging( layerSize * texture.layerCount, stagingBuffer, stagingOffset ));
+
+    for( size_t i = 0; i < pixelsVec.size(); ++i )
+        std::memcpy( pStaging + (layerSize * i), pixelsVec[i], static_cast<size_t>(layerSize) );
+
+    freePixels();
+
+    createImage(
+        texture.size.w,
+        texture.size.h,
+        texture.mipLevels,
+        VK_FORMAT_R8G8B8A8_UNORM,
+        VK_IMAGE_TILING_OPTIMAL,
+        VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        texture.textureImage,
+        texture.textureImageAllocation,
+        texture.layerCount );
+
+    VkCommandBuffer commandBuffer = getUploadCmdBuffer();
+
+    transitionImageLayout( commandBuffer, texture.textureImage, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, texture.mipLevels, texture.layerCount );
+
+    for( uint32_t i = 0; i < texture.layerCount; ++i )
+        copyBufferToImage(
+            commandBuffer, stagingBuffer, stagingOffset + (layerSize * i), texture.textureImage,
+            static_cast<uint32_t>(texture.size.w), static_cast<uint32_t>(texture.size.h), 0, i );
+
+    transitionImageLayout( commandBuffer, texture.textureImage, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, texture.mipLevels, texture.layerCount );
+
+    // create the image view
+    texture.textureImageView = createImageView( texture.textureImage, VK_FORMAT_R8G8B8A8_UNORM, texture.mipLevels, VK_IMAGE_ASPECT_COLOR_BIT, texture.layerCount );
+
+    // Get the texture sampler
+    createTextureSampler( texture );
+
+    uploadBatch.end();
+}
+
+/***************************************************************************
+*   DESC:  Load the pre-compressed KTX2 version of the texture the device can sample
+*          NOTE: The KTX2 files sit next to the source image and keep its extension
+*                (image.png.bc.ktx2). Returns false if there are none so the source
+*                image is loaded instead
+****************************************************************************/
+bool CDeviceVulkan::loadKtx2File( const std::string & filePath, CKtx2File & ktx2File )
+{
+    for( auto & iter : KTX2_EXTENSION_VEC )
+    {
+        const std::string ktx2Path = filePath + iter;
+
+        // SDL is used so the files are also found in the Android assets
+        NSmart::scoped_SDL_filehandle_ptr<SDL_RWops> scpFile( SDL_RWFromFile( ktx2Path.c_str(), "rb" ) );
+        if( scpFile.isNull() )
+            continue;
+
+        std::vector<char> dataVec( (size_t)SDL_RWsize( scpFile.get() ) );
+        if( SDL_RWread( scpFile.get(), dataVec.data(), 1, dataVec.size() ) != dataVec.size() )
+            throw NExcept::CCriticalException( "KTX2 Load Error!",
+                boost::str( boost::format("Error reading texture file (%s).\n\n%s\nLine: %s") % ktx2Path % __FUNCTION__ % __LINE__ ) );
+
+        ktx2File.parse( std::move(dataVec), ktx2Path );
+
+        if( isFormatSampled( ktx2File.getFormat() ) )
+            return true;
+    }
+
+    return false;
+}
+
+/***************************************************************************
+*   DESC:  Create texture from the levels of a KTX2 file
+*          NOTE: Compressed images can't be blitted so their mips need to be baked
+****************************************************************************/
+void CDeviceVulkan::createTexture( CTexture & texture, const CKtx2File & ktx2File )
+{
+    texture.format = ktx2File.getFormat();
+    texture.size.w = ktx2File.getWidth();
+    texture.size.h = ktx2File.getHeight();
+    texture.mipLevels = (texture.genMipLevels ? ktx2File.getLevelCount() : 1);
+
+    // An uncompressed file without baked mips gets them generated like a source image
+    const bool genMipLevels = texture.genMipLevels && (texture.mipLevels == 1) && !CKtx2File::isCompressed( texture.format );
+
+    uint32_t imageUsageFlags( VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT );
+
+    if( genMipLevels )
+    {
+        imageUsageFlags |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        texture.mipLevels = std::floor(std::log2(std::max(texture.size.w, texture.size.h))) + 1;
+    }
+
+    // The upload is submitted with the rest of this thread's uploads
+    CUploadBatchScope uploadBatch( *this );
+
+    createImage(
+        texture.size.w,
+        texture.size.h,
+        texture.mipLevels,
+        texture.format,
+        VK_IMAGE_TILING_OPTIMAL,
+        imageUsageFlags,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        texture.textureImage,
+        texture.textureImageAllocation );
+
+    // Stage all the baked levels with one allocation. Allocating can flush this thread's
+    // batch, which frees its command buffer, so it has to happen before recording starts.
+    const uint32_t copyLevels = (genMipLevels ? 1 : texture.mipLevels);
+    std::vector<VkDeviceSize> levelOffsetVec( copyLevels );
+    VkDeviceSize stagingSize(0);
+    for( uint32_t i = 0; i < copyLevels; ++i )
+    {
+        levelOffsetVec[i] = stagingSize;
+        stagingSize += (ktx2File.getLevelSize( i ) + STAGING_ALIGNMENT - 1) & ~(STAGING_ALIGNMENT - 1);
+    }
+
+    VkBuffer stagingBuffer;
+    VkDeviceSize stagingOffset;
+    uint8_t * pStaging = static_cast<uint8_t *>(allocStaging( stagingSize, stagingBuffer, stagingOffset ));
+
+    for( uint32_t i = 0; i < copyLevels; ++i )
+        std::memcpy( pStaging + levelOffsetVec[i], ktx2File.getLevelData( i ), ktx2File.getLevelSize( i ) );
+
+    VkCommandBuffer commandBuffer = getUploadCmdBuffer();
+
+    transitionImageLayout( commandBuffer, texture.textureImage, texture.format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, texture.mipLevels );
+
+    for( uint32_t i = 0; i < copyLevels; ++i )
+        copyBufferToImage( commandBuffer, stagingBuffer, stagingOffset + levelOffsetVec[i], texture.textureImage, ktx2File.getLevelWidth( i ), ktx2File.getLevelHeight( i ), i );
+
+    if( genMipLevels )
+        generateMipmaps( commandBuffer, texture.textureImage, texture.format, texture.size.w, texture.size.h, texture.mipLevels );
+    else
+        transitionImageLayout( commandBuffer, texture.textureImage, texture.format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, texture.mipLevels );
+
+    // create the image view
+    texture.textureImageView = createImageView( texture.textureImage, texture.format, texture.mipLevels, VK_IMAGE_ASPECT_COLOR_BIT );
+
+    // Get the texture sampler
+    createTextureSampler( texture );
+
+    uploadBatch.end();
+}
+
+/***************************************************************************
+*   DESC:  Can the device sample images of this format
+****************************************************************************/
+bool CDeviceVulkan::isFormatSampled( VkFormat format )
+{
+    const VkFormatFeatureFlags features = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+
+    VkFormatProperties props;
+    vkGetPhysicalDeviceFormatProperties( m_phyDevVec[m_phyDevIndex].pDev, format, &props );
+
+    return ((props.optimalTilingFeatures & features) == features);
 }
 
 /***************************************************************************
 *   DESC:  Generate Mipmaps
 ****************************************************************************/
-void CDeviceVulkan::generateMipmaps( VkImage image, VkFormat imageFormat, int32_t width, int32_t height, uint32_t mipLevels )
+void CDeviceVulkan::generateMipmaps( VkCommandBuffer commandBuffer, VkImage image, VkFormat imageFormat, int32_t width, int32_t height, uint32_t mipLevels )
 {
     // Check if image format supports linear blitting
     VkFormatProperties formatProperties;
@@ -1756,8 +2386,6 @@ void CDeviceVulkan::generateMipmaps( VkImage image, VkFormat imageFormat, int32_
     if (!(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT))
         throw NExcept::CCriticalException( "Vulkan Error!", "texture image format does not support linear blitting!" );
 
-    VkCommandBuffer commandBuffer = beginSingleTimeCommands();
-
     VkImageMemoryBarrier barrier = {};
     barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
     barrier.image = image;
@@ -1830,16 +2458,14 @@ void CDeviceVulkan::generateMipmaps( VkImage image, VkFormat imageFormat, int32_
         0, nullptr,
         0, nullptr,
         1, &barrier);
-
-    endSingleTimeCommands(commandBuffer);
 }
 
 /***************************************************************************
-*   DESC:  Create texture sampler
+*   DESC:  Get the texture sampler from the sampler cache
+*          NOTE: Most textures use the same settings so they share a few samplers
 ****************************************************************************/
-VkSampler CDeviceVulkan::createTextureSampler( CTexture & texture )
+void CDeviceVulkan::createTextureSampler( CTexture & texture )
 {
-    VkResult vkResult(VK_SUCCESS);
     VkSamplerCreateInfo samplerInfo = {};
     samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
     samplerInfo.magFilter = texture.magFilter;  // Default: VK_FILTER_LINEAR
@@ -1858,26 +2484,25 @@ VkSampler CDeviceVulkan::createTextureSampler( CTexture & texture )
     samplerInfo.mipmapMode = texture.mipmapMode;  // Default: VK_SAMPLER_MIPMAP_MODE_LINEAR
     samplerInfo.mipLodBias = texture.mipLodBias;  // Default: 0.0f
     samplerInfo.minLod = texture.minLod;          // Default: 0.0f
-    samplerInfo.maxLod = ((texture.mipLevels > 1) ? texture.mipLevels : 0.f);
-
-    VkSampler textureSampler;
-
-    if( (vkResult = vkCreateSampler( m_logicalDevice, &samplerInfo, nullptr, &textureSampler )) )
-        throw NExcept::CCriticalException( "Vulkan Error!", boost::str( boost::format("Could not create texture sampler! %s") % getError(vkResult) ) );
+    // Not tied to the mip count so textures of any size can share the sampler.
+    // The LOD is clamped to the mip levels of the image view anyway.
+    // Unnormalized coordinates require a max LOD of zero.
+    samplerInfo.maxLod = (texture.unnormalizedCoordinates ? 0.f : VK_LOD_CLAMP_NONE);
 
-    return textureSampler;
+    texture.textureSampler = m_samplerCache.acquire( samplerInfo );
+    texture.pSamplerCache = &m_samplerCache;
 }
 
 /***************************************************************************
 *   DESC:  Create the image view
 ****************************************************************************/
-VkImageView CDeviceVulkan::createImageView( VkImage image, VkFormat format, uint32_t mipLevels, VkImageAspectFlags aspectFlags )
+VkImageView CDeviceVulkan::createImageView( VkImage image, VkFormat format, uint32_t mipLevels, VkImageAspectFlags aspectFlags, uint32_t layerCount )
 {
     VkResult vkResult(VK_SUCCESS);
     VkImageViewCreateInfo viewInfo = {};
     viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
     viewInfo.image = image;
-    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.viewType = (layerCount > 1) ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;
     viewInfo.format = format;
     // imageViewCreateInfo.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
     // imageViewCreateInfo.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
@@ -1887,7 +2512,7 @@ VkImageView CDeviceVulkan::createImageView( VkImage image, VkFormat format, uint
     viewInfo.subresourceRange.baseMipLevel = 0;
     viewInfo.subresourceRange.levelCount = mipLevels;
     viewInfo.subresourceRange.baseArrayLayer = 0;
-    viewInfo.subresourceRange.layerCount = 1;
+    viewInfo.subresourceRange.layerCount = layerCount;
 
     VkImageView imageView;
     if( (vkResult = vkCreateImageView( m_logicalDevice, &viewInfo, nullptr, &imageView )) )
@@ -1913,7 +2538,7 @@ VkDescriptorPool CDeviceVulkan::createDescriptorPool( const SDescriptorData & de
         if( descIdIter.descrId == "UNIFORM_BUFFER" )
         {
             VkDescriptorPoolSize uniformBufferPoolSize = {};
-            uniformBufferPoolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            uniformBufferPoolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             uniformBufferPoolSize.descriptorCount = MAX_POOL_SIZE;
 
             descriptorPoolVec.push_back( uniformBufferPoolSize );
@@ -2010,7 +2635,7 @@ void CDeviceVulkan::updateDescriptorSetVec(
                 writeDescriptorSet.dstSet = descriptorSetVec[i];
                 writeDescriptorSet.dstBinding = bindingOffset++;
                 writeDescriptorSet.dstArrayElement = 0;
-                writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+                writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
                 writeDescriptorSet.descriptorCount = 1;
                 writeDescriptorSet.pBufferInfo = &descriptorBufferInfoVec.back();
 
@@ -2046,6 +2671,56 @@ void CDeviceVulkan::updateDescriptorSetVec(
     }
 }
 
+/***************************************************************************
+*   DESC:  Point the uniform buffer descriptors of the sets at the uniform buffers
+*          NOTE: The image descriptors are left as is
+****************************************************************************/
+void CDeviceVulkan::updateUniformDescriptorVec(
+    std::vector<VkDescriptorSet> & descriptorSetVec,
+    const SDescriptorData & descData,
+    const std::vector<CMemoryBuffer> & uniformBufVec )
+{
+    for( size_t i = 0; i < descriptorSetVec.size(); ++i )
+    {
+        std::vector<VkWriteDescriptorSet> writeDescriptorSetVec;
+
+        // Keep the data alive until the call to vkUpdateDescriptorSets
+        std::vector<VkDescriptorBufferInfo> descriptorBufferInfoVec;
+        descriptorBufferInfoVec.reserve( descData.m_descriptorVec.size() );
+
+        int bindingOffset = 0;
+
+        for( auto & descIdIter : descData.m_descriptorVec )
+        {
+            if( descIdIter.descrId == "UNIFORM_BUFFER" )
+            {
+                VkDescriptorBufferInfo bufferInfo = {};
+                bufferInfo.buffer = uniformBufVec[i].m_buffer;
+                bufferInfo.offset = 0;
+                bufferInfo.range = descIdIter.ubo.uboSize;
+
+                descriptorBufferInfoVec.emplace_back( bufferInfo );
+
+                VkWriteDescriptorSet writeDescriptorSet = {};
+                writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                writeDescriptorSet.dstSet = descriptorSetVec[i];
+                writeDescriptorSet.dstBinding = bindingOffset;
+                writeDescriptorSet.dstArrayElement = 0;
+                writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+                writeDescriptorSet.descriptorCount = 1;
+                writeDescriptorSet.pBufferInfo = &descriptorBufferInfoVec.back();
+
+                writeDescriptorSetVec.push_back( writeDescriptorSet );
+            }
+
+            ++bindingOffset;
+        }
+
+        if( !writeDescriptorSetVec.empty() )
+            vkUpdateDescriptorSets( m_logicalDevice, writeDescriptorSetVec.size(), writeDescriptorSetVec.data(), 0, nullptr );
+    }
+}
+
 /***************************************************************************
 *   DESC:  Create the uniform buffer Vec for ubo buffer writes
 ****************************************************************************/
@@ -2059,11 +2734,30 @@ std::vector<CMemoryBuffer> CDeviceVulkan::createUniformBufferVec( VkDeviceSize s
             VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
             uniformBufVec[i].m_buffer,
-            uniformBufVec[i].m_deviceMemory );
+            uniformBufVec[i].m_allocation );
 
     return uniformBufVec;
 }
 
+/***************************************************************************
+*   DESC:  Create the host visible vertex buffer Vec for per frame
+*          instance and streamed vertex data
+****************************************************************************/
+std::vector<CMemoryBuffer> CDeviceVulkan::createHostVertexBufferVec( VkDeviceSize sizeOfVertexBuf )
+{
+    std::vector<CMemoryBuffer> vertexBufVec( m_framebufferVec.size() );
+
+    for( size_t i = 0; i < m_framebufferVec.size(); ++i )
+        CDeviceVulkan::createBuffer(
+            sizeOfVertexBuf,
+            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            vertexBufVec[i].m_buffer,
+            vertexBufVec[i].m_allocation );
+
+    return vertexBufVec;
+}
+
 /***************************************************************************
 *   DESC:  Get Vulkan error
 ****************************************************************************/
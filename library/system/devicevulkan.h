@@ -11,6 +11,9 @@
 
 // Game lib dependencies
 #include <system/memorybuffer.h>
+#include <system/memoryallocator.h>
+#include <system/samplercache.h>
+#include <system/stagingring.h>
 
 // Standard lib dependencies
 #include <cstring>
@@ -18,6 +21,8 @@
 #include <vector>
 #include <map>
 #include <mutex>
+#include <thread>
+#include <condition_variable>
 
 // Vulkan lib dependencies
 #include <system/vulkan.h>
@@ -27,12 +32,74 @@
 #include <boost/signals2.hpp>
 
 // Forward declaration(s)
+class CDeviceVulkan;
 class CTexture;
+class CKtx2File;
 class SPipelineData;
 class SDescriptorData;
 
+/************************************************************************
+*    Transfer command pool and fence owned by one loading thread
+************************************************************************/
+class CTransferContext
+{
+public:
+
+    VkCommandPool m_cmdPool = VK_NULL_HANDLE;
+    VkFence m_fence = VK_NULL_HANDLE;
+};
+
+/************************************************************************
+*    Uploads recorded by one thread waiting to be submitted together
+************************************************************************/
+class CUploadBatch
+{
+public:
+
+    // Command buffer the copies are recorded into. Allocated on first use.
+    VkCommandBuffer m_cmdBuffer = VK_NULL_HANDLE;
+
+    // Staging ring ranges to retire once the batch has been submitted
+    std::vector<uint64_t> m_stagingIdVec;
+
+    // Staging buffers for uploads too big for the ring
+    std::vector<CMemoryBuffer> m_dedicatedStagingVec;
+
+    // Nesting depth of the batch scopes
+    int m_depth = 0;
+};
+
+/************************************************************************
+*    Uploads made by the calling thread while the outermost scope is
+*    alive are recorded into one command buffer and submitted together
+************************************************************************/
+class CUploadBatchScope
+{
+public:
+
+    // Constructor
+    CUploadBatchScope( CDeviceVulkan & rDevice );
+
+    // Destructor
+    ~CUploadBatchScope();
+
+    // End the batch. The outermost scope submits here so a failed upload throws.
+    // NOTE: Call before the scope closes. The destructor only ends a batch left open by an exception.
+    void end();
+
+private:
+
+    CDeviceVulkan & m_rDevice;
+
+    // Was the batch ended by the owner
+    bool m_ended = false;
+};
+
 class CDeviceVulkan
 {
+    // The batch scope begins and ends the upload batch of its thread
+    friend class CUploadBatchScope;
+
 protected:
 
     // Boost signal defination
@@ -70,9 +137,15 @@ protected:
     
     // Create the uniform buffer Vec for ubo buffer writes
     std::vector<CMemoryBuffer> createUniformBufferVec( VkDeviceSize sizeOfUniformBuf );
+
+    // Create the host visible vertex buffer Vec for per frame instance and streamed vertex data
+    std::vector<CMemoryBuffer> createHostVertexBufferVec( VkDeviceSize sizeOfVertexBuf );
     
     // Create texture
     void createTexture( CTexture & texture );
+
+    // Create a texture array with one layer per image
+    void createTextureArray( CTexture & texture, const std::vector<std::string> & filePathVec );
     
     // Create descriptor pool
     VkDescriptorPool createDescriptorPool( const SDescriptorData & descData );
@@ -88,6 +161,12 @@ protected:
         const CTexture & texture,
         const SDescriptorData & descData,
         const std::vector<CMemoryBuffer> & uniformBufVec );
+
+    // Point the uniform buffer descriptors of the sets at the uniform buffers
+    void updateUniformDescriptorVec(
+        std::vector<VkDescriptorSet> & descriptorSetVec,
+        const SDescriptorData & descData,
+        const std::vector<CMemoryBuffer> & uniformBufVec );
     
     // Create the shader
     VkShaderModule createShader( const std::string & filePath );
@@ -98,8 +177,20 @@ protected:
     // Create the pipeline layout
     VkPipelineLayout createPipelineLayout( VkDescriptorSetLayout descriptorSetLayout );
     
+    // Create the pipelines of the vector on the worker threads
+    void createPipelineVec( std::vector<SPipelineData> & pipelineDataVec );
+
     // Create the pipeline
-    void createPipeline( SPipelineData & pipelineData );
+    void createPipeline( SPipelineData & pipelineData, const VkViewport & viewport );
+
+    // Create the pipeline cache from the data saved by the last run
+    void createPipelineCache();
+
+    // Save the pipeline cache data and destroy the cache
+    void destroyPipelineCache();
+
+    // Is the saved pipeline cache data from this device and driver
+    bool isPipelineCacheValid( const std::vector<char> & cacheDataVec );
     
     // Get Vulkan error
     const char * getError( VkResult result );
@@ -110,33 +201,30 @@ protected:
     {
         VkDeviceSize bufferSize = sizeof(dataVec.back()) * dataVec.size();
 
-        VkBuffer stagingBuffer;
-        VkDeviceMemory stagingBufferMemory;
-        createBuffer(
-            bufferSize,
-            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-            stagingBuffer,
-            stagingBufferMemory );
+        // The copy is submitted with the rest of this thread's uploads
+        CUploadBatchScope uploadBatch( *this );
 
-        void* data;
-        vkMapMemory( m_logicalDevice, stagingBufferMemory, 0, bufferSize, 0, &data );
-        std::memcpy( data, dataVec.data(), (size_t) bufferSize );
-        vkUnmapMemory( m_logicalDevice, stagingBufferMemory );
+        // Copy the data into the staging ring
+        VkBuffer stagingBuffer;
+        VkDeviceSize stagingOffset;
+        std::memcpy( allocStaging( bufferSize, stagingBuffer, stagingOffset ), dataVec.data(), (size_t) bufferSize );
 
         createBuffer(
             bufferSize,
             VK_BUFFER_USAGE_TRANSFER_DST_BIT | bufferUsageFlag,
             VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
             memoryBuffer.m_buffer,
-            memoryBuffer.m_deviceMemory );
+            memoryBuffer.m_allocation );
 
-        copyBuffer( stagingBuffer, memoryBuffer.m_buffer, bufferSize );
+        copyBuffer( getUploadCmdBuffer(), stagingBuffer, stagingOffset, memoryBuffer.m_buffer, bufferSize );
 
-        vkDestroyBuffer( m_logicalDevice, stagingBuffer, nullptr );
-        vkFreeMemory( m_logicalDevice, stagingBufferMemory, nullptr );
+        uploadBatch.end();
     }
 
+    // Submit the uploads recorded so far by this thread and wait for them
+    // NOTE: Needed before freeing a resource that has a copy recorded in the batch
+    void flushUploadBatch();
+
     // Handle the resolution change
     virtual void handleResolutionChange( int width, int height ) = 0;
     
@@ -207,7 +295,8 @@ private:
         VkImageUsageFlags usage,
         VkMemoryPropertyFlags properties,
         VkImage & image,
-        VkDeviceMemory & imageMemory );
+        CMemoryAllocation & imageAllocation,
+        uint32_t arrayLayers = 1 );
     
     // Create a buffer
     void createBuffer(
@@ -215,29 +304,60 @@ private:
         VkBufferUsageFlags usage,
         VkMemoryPropertyFlags properties,
         VkBuffer & buffer,
-        VkDeviceMemory & bufferMemory );
+        CMemoryAllocation & bufferAllocation );
     
     // Copy a buffer
-    void copyBuffer( VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size );
+    void copyBuffer( VkCommandBuffer commandBuffer, VkBuffer srcBuffer, VkDeviceSize srcOffset, VkBuffer dstBuffer, VkDeviceSize size );
     
     // Copy buffer helper functions
+    // NOTE: Each thread records into its own transfer command pool and waits on its own fence
     VkCommandBuffer beginSingleTimeCommands();
     void endSingleTimeCommands( VkCommandBuffer commandBuffer );
     
     // Transition image layout
-    void transitionImageLayout( VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t mipLevels );
+    void transitionImageLayout( VkCommandBuffer commandBuffer, VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t mipLevels, uint32_t layerCount = 1 );
     
     // Copy a buffer to an image
-    void copyBufferToImage( VkBuffer buffer, VkImage image, uint32_t width, uint32_t height );
+    void copyBufferToImage( VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize bufferOffset, VkImage image, uint32_t width, uint32_t height, uint32_t mipLevel = 0, uint32_t arrayLayer = 0 );
     
     // Create the image view
-    VkImageView createImageView( VkImage image, VkFormat format, uint32_t mipLevels, VkImageAspectFlags aspectFlags );
+    VkImageView createImageView( VkImage image, VkFormat format, uint32_t mipLevels, VkImageAspectFlags aspectFlags, uint32_t layerCount = 1 );
+    
+    // Load the pre-compressed KTX2 version of the texture the device can sample if there is one
+    bool loadKtx2File( const std::string & filePath, CKtx2File & ktx2File );
+
+    // Create texture from the levels of a KTX2 file
+    void createTexture( CTexture & texture, const CKtx2File & ktx2File );
+
+    // Can the device sample images of this format
+    bool isFormatSampled( VkFormat format );
     
     // Generate Mipmaps
-    void generateMipmaps( VkImage image, VkFormat imageFormat, int32_t width, int32_t height, uint32_t mipLevels );
+    void generateMipmaps( VkCommandBuffer commandBuffer, VkImage image, VkFormat imageFormat, int32_t width, int32_t height, uint32_t mipLevels );
     
-    // Create texture sampler
-    VkSampler createTextureSampler( CTexture & texture );
+    // Get the transfer command pool and fence of the calling thread
+    CTransferContext & getTransferContext();
+    
+    // Destroy the transfer command pools and fences
+    void destroyTransferContexts();
+    
+    // Create/destroy the persistently mapped staging ring
+    void createStagingRing();
+    void destroyStagingRing();
+    
+    // Begin/end the upload batch of the calling thread
+    // NOTE: Batches nest. The outermost end submits and waits on the fence.
+    void beginUploadBatch();
+    void endUploadBatch();
+    
+    // Get the command buffer of this thread's upload batch
+    VkCommandBuffer getUploadCmdBuffer();
+    
+    // Get staging memory for an upload. Returns the mapped pointer to copy to.
+    void * allocStaging( VkDeviceSize size, VkBuffer & buffer, VkDeviceSize & offset );
+    
+    // Get the texture sampler from the sampler cache
+    void createTextureSampler( CTexture & texture );
     
     // Find supported format
     VkFormat findSupportedFormat( const std::vector<VkFormat> & candidates, VkImageTiling tiling, VkFormatFeatureFlags features );
@@ -317,14 +437,39 @@ protected:
     // Primary Command pool. Only use for primary command buffers
     VkCommandPool m_primaryCmdPool;
     
-    // Command pool for loading assets from a thread
-    VkCommandPool m_transferCmdPool;
+    // Transfer command pool and fence of each thread that loads assets
+    // NOTE: Command pools can't be shared between threads without a lock held while recording
+    std::map< std::thread::id, CTransferContext > m_transferContextMap;
+    
+    // Guards the transfer context map and the transfer queue submits
+    std::mutex m_transferMutex;
     
     // Command pool
     std::vector<VkCommandBuffer> m_primaryCmdBufVec;
     
     // Map of Vulkan errors
     std::map<VkResult, const char *> m_vulkanErrorMap;
+
+    // Sub-allocator for all buffer and image memory
+    CMemoryAllocator m_memoryAllocator;
+
+    // Samplers shared by the textures using the same sampler settings
+    CSamplerCache m_samplerCache;
+
+    // Persistently mapped staging buffer shared by all uploads
+    CMemoryBuffer m_stagingRingBuffer;
+    CStagingRing m_stagingRing;
+
+    // Guards the staging ring. Threads wait on the condition for ranges to be retired.
+    std::mutex m_stagingMutex;
+    std::condition_variable m_stagingCondition;
+
+    // Size of the staging ring and the alignment of the ranges
+    static constexpr VkDeviceSize STAGING_RING_SIZE = 32 * 1024 * 1024;
+    static constexpr VkDeviceSize STAGING_ALIGNMENT = 16;
+
+    // Upload batch of each thread
+    static thread_local CUploadBatch m_uploadBatch;
     
     // Semaphores
     std::vector<VkSemaphore> m_imageAvailableSemaphoreVec;
@@ -338,8 +483,15 @@ protected:
     
     // Depth buffer members
     VkImage m_depthImage;
-    VkDeviceMemory m_depthImageMemory;
+    CMemoryAllocation m_depthImageAllocation;
     VkImageView m_depthImageView;
+
+    // Pipeline cache kept between runs and the path of the file it's saved to
+    VkPipelineCache m_pipelineCache;
+    std::string m_pipelineCachePath;
+
+    // Does the pipeline cache have data from a previous run or a previous create
+    bool m_pipelineCacheWarm;
     
     // Vulkan functions
     PFN_vkDestroySwapchainKHR vkDestroySwapchainKHR;
@@ -0,0 +1,115 @@
+/************************************************************************
+*    FILE NAME:       framesnapshot.cpp
+*
+*    DESCRIPTION:     Draws of a frame captured by render so the command
+*                     buffers can be recorded on the submit thread while
+*                     the game moves on to the next frame.
+************************************************************************/
+
+// Physical component dependency
+#include <system/framesnapshot.h>
+
+/************************************************************************
+*    DESC:  Record the draw into the command buffer
+************************************************************************/
+void CDrawCommand::record( VkCommandBuffer cmdBuffer ) const
+{
+    // Bind the pipeline
+    vkCmdBindPipeline( cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline );
+
+    // Bind the vertex buffers
+    vkCmdBindVertexBuffers( cmdBuffer, 0, m_vertexBufferCount, m_vertexBuffer, m_vertexOffset );
+
+    // Bind the index buffer
+    vkCmdBindIndexBuffer( cmdBuffer, m_indexBuffer, 0, VK_INDEX_TYPE_UINT16 );
+
+    // Bind the descriptor set with the UBO's dynamic offset
+    vkCmdBindDescriptorSets(
+        cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 0, 1, &m_descriptorSet,
+        (m_useDynamicOffset ? 1 : 0), (m_useDynamicOffset ? &m_dynamicOffset : nullptr) );
+
+    // Do the draw
+    vkCmdDrawIndexed( cmdBuffer, m_indexCount, m_instanceCount, 0, 0, m_firstInstance );
+}
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CFrameSnapshot::CFrameSnapshot() :
+    m_drawListCount(0),
+    m_imageIndex(0)
+{
+}
+
+/************************************************************************
+*    DESC:  Start capturing a frame that renders to this swap chain image
+************************************************************************/
+void CFrameSnapshot::begin( uint32_t imageIndex )
+{
+    m_imageIndex = imageIndex;
+    m_drawListCount = 0;
+    m_secondaryCmdBufVec.clear();
+}
+
+/************************************************************************
+*    DESC:  Add the draw list of a secondary command buffer
+************************************************************************/
+std::vector<CDrawCommand> & CFrameSnapshot::addDrawList( VkCommandBuffer cmdBuffer )
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+
+    if( m_drawListCount == m_drawListDeq.size() )
+        m_drawListDeq.emplace_back();
+
+    CDrawList & rDrawList = m_drawListDeq[m_drawListCount++];
+    rDrawList.m_cmdBuffer = cmdBuffer;
+    rDrawList.m_drawVec.clear();
+
+    return rDrawList.m_drawVec;
+}
+
+/************************************************************************
+*    DESC:  Take the secondary command buffers in the order they are executed
+************************************************************************/
+void CFrameSnapshot::setSecondaryCmdBufVec( std::vector<VkCommandBuffer> & cmdBufVec )
+{
+    m_secondaryCmdBufVec.swap( cmdBufVec );
+    cmdBufVec.clear();
+}
+
+/************************************************************************
+*    DESC:  Get the secondary command buffers in the order they are executed
+************************************************************************/
+const std::vector<VkCommandBuffer> & CFrameSnapshot::getSecondaryCmdBufVec() const
+{
+    return m_secondaryCmdBufVec;
+}
+
+/************************************************************************
+*    DESC:  Get the swap chain image the frame renders to
+************************************************************************/
+uint32_t CFrameSnapshot::getImageIndex() const
+{
+    return m_imageIndex;
+}
+
+/************************************************************************
+*    DESC:  Get the number of draw lists captured
+************************************************************************/
+size_t CFrameSnapshot::getDrawListCount() const
+{
+    return m_drawListCount;
+}
+
+/************************************************************************
+*    DESC:  Get the command buffer and the draws of a draw list
+************************************************************************/
+VkCommandBuffer CFrameSnapshot::getCmdBuffer( size_t index ) const
+{
+    return m_drawListDeq[index].m_cmdBuffer;
+}
+
+const std::vector<CDrawCommand> & CFrameSnapshot::getDrawVec( size_t index ) const
+{
+    return m_drawListDeq[index].m_drawVec;
+}
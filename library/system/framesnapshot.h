@@ -0,0 +1,107 @@
+/************************************************************************
+*    FILE NAME:       framesnapshot.h
+*
+*    DESCRIPTION:     Draws of a frame captured by render so the command
+*                     buffers can be recorded on the submit thread while
+*                     the game moves on to the next frame.
+************************************************************************/
+
+#pragma once
+
+// Vulkan lib dependencies
+#include <system/vulkan.h>
+
+// Standard lib dependencies
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <cstdint>
+
+class CDrawCommand
+{
+public:
+
+    // Record the draw into the command buffer
+    void record( VkCommandBuffer cmdBuffer ) const;
+
+    VkPipeline m_pipeline = VK_NULL_HANDLE;
+    VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;
+
+    // Vertex buffers and their offsets. Batched quads add the per instance buffer
+    VkBuffer m_vertexBuffer[2] = {VK_NULL_HANDLE, VK_NULL_HANDLE};
+    VkDeviceSize m_vertexOffset[2] = {0, 0};
+    uint32_t m_vertexBufferCount = 1;
+
+    // 16 bit index buffer
+    VkBuffer m_indexBuffer = VK_NULL_HANDLE;
+    uint32_t m_indexCount = 0;
+
+    uint32_t m_instanceCount = 1;
+    uint32_t m_firstInstance = 0;
+
+    // Descriptor set and the dynamic offset of the UBO in the frame's uniform ring
+    // NOTE: Batched quads don't have a UBO so they don't use the offset
+    VkDescriptorSet m_descriptorSet = VK_NULL_HANDLE;
+    uint32_t m_dynamicOffset = 0;
+    bool m_useDynamicOffset = true;
+};
+
+class CFrameSnapshot
+{
+public:
+
+    // Constructor
+    CFrameSnapshot();
+
+    // Start capturing a frame that renders to this swap chain image
+    void begin( uint32_t imageIndex );
+
+    // Add the draw list of a secondary command buffer
+    // NOTE: Called from the threads recording the strategies
+    std::vector<CDrawCommand> & addDrawList( VkCommandBuffer cmdBuffer );
+
+    // Take the secondary command buffers in the order they are executed
+    void setSecondaryCmdBufVec( std::vector<VkCommandBuffer> & cmdBufVec );
+
+    // Get the secondary command buffers in the order they are executed
+    const std::vector<VkCommandBuffer> & getSecondaryCmdBufVec() const;
+
+    // Get the swap chain image the frame renders to
+    uint32_t getImageIndex() const;
+
+    // Get the number of draw lists captured
+    size_t getDrawListCount() const;
+
+    // Get the command buffer and the draws of a draw list
+    VkCommandBuffer getCmdBuffer( size_t index ) const;
+    const std::vector<CDrawCommand> & getDrawVec( size_t index ) const;
+
+private:
+
+    class CDrawList
+    {
+    public:
+
+        // Secondary command buffer the draws are recorded into
+        VkCommandBuffer m_cmdBuffer = VK_NULL_HANDLE;
+
+        // Draws in recording order
+        std::vector<CDrawCommand> m_drawVec;
+    };
+
+    // Draw lists of the frame. A deque so the lists don't move while other threads add to it.
+    // Lists are kept between frames to reuse the memory of the draw vectors.
+    std::deque<CDrawList> m_drawListDeq;
+
+    // Number of draw lists used this frame
+    size_t m_drawListCount;
+
+    // Guards adding draw lists
+    std::mutex m_mutex;
+
+    // Swap chain image the frame renders to
+    uint32_t m_imageIndex;
+
+    // Secondary command buffers in the order they are executed
+    std::vector<VkCommandBuffer> m_secondaryCmdBufVec;
+};
@@ -0,0 +1,359 @@
+
+/************************************************************************
+*    FILE NAME:       memoryallocator.cpp
+*
+*    DESCRIPTION:     Sub-allocates buffers and images from large blocks
+*                     of device memory using a buddy scheme per memory type
+************************************************************************/
+
+// Physical component dependency
+#include <system/memoryallocator.h>
+
+// Game lib dependencies
+#include <utilities/exceptionhandling.h>
+#include <utilities/genfunc.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
+
+// Standard lib dependencies
+#include <algorithm>
+
+/************************************************************************
+*    Block of device memory split up with a buddy scheme
+************************************************************************/
+class CMemoryBlock
+{
+public:
+
+    CMemoryBlock( uint32_t orderCount ) : m_freeSetVec( orderCount )
+    {}
+
+    // Find a free range of this order, splitting larger ranges as needed
+    bool alloc( uint32_t order, VkDeviceSize minSize, VkDeviceSize & offset )
+    {
+        uint32_t freeOrder = order;
+        while( (freeOrder < m_freeSetVec.size()) && m_freeSetVec[freeOrder].empty() )
+            ++freeOrder;
+
+        if( freeOrder == m_freeSetVec.size() )
+            return false;
+
+        offset = *m_freeSetVec[freeOrder].begin();
+        m_freeSetVec[freeOrder].erase( m_freeSetVec[freeOrder].begin() );
+
+        // Put the unused upper halves back on the free lists
+        while( freeOrder > order )
+        {
+            --freeOrder;
+            m_freeSetVec[freeOrder].insert( offset + (minSize << freeOrder) );
+        }
+
+        m_usedBytes += (minSize << order);
+        ++m_allocationCount;
+
+        return true;
+    }
+
+    // Return the range and merge it with its buddy while the buddy is free
+    void free( uint32_t order, VkDeviceSize minSize, VkDeviceSize offset )
+    {
+        m_usedBytes -= (minSize << order);
+        --m_allocationCount;
+
+        while( order < (m_freeSetVec.size() - 1) )
+        {
+            const VkDeviceSize buddy = offset ^ (minSize << order);
+
+            auto iter = m_freeSetVec[order].find( buddy );
+            if( iter == m_freeSetVec[order].end() )
+                break;
+
+            m_freeSetVec[order].erase( iter );
+            offset = std::min( offset, buddy );
+            ++order;
+        }
+
+        m_freeSetVec[order].insert( offset );
+    }
+
+    // Size of the largest free range
+    VkDeviceSize getLargestFree( VkDeviceSize minSize ) const
+    {
+        for( size_t i = m_freeSetVec.size(); i-- > 0; )
+            if( !m_freeSetVec[i].empty() )
+                return (minSize << i);
+
+        return 0;
+    }
+
+    // Device memory of the block
+    VkDeviceMemory m_memory = VK_NULL_HANDLE;
+
+    // Mapped pointer if the block is host visible
+    void * m_pMappedData = nullptr;
+
+    // Key of the block vector this belongs to
+    std::pair<uint32_t, bool> m_key;
+
+    // Free offsets for each buddy order
+    std::vector<std::set<VkDeviceSize>> m_freeSetVec;
+
+    // Bytes handed out and number of live allocations
+    VkDeviceSize m_usedBytes = 0;
+    uint32_t m_allocationCount = 0;
+};
+
+/************************************************************************
+*    DESC:  Return the range to the allocator
+************************************************************************/
+void CMemoryAllocation::free()
+{
+    if( m_pAllocator != nullptr )
+        m_pAllocator->free( *this );
+
+    *this = CMemoryAllocation();
+}
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CMemoryAllocator::CMemoryAllocator() :
+    m_logicalDevice(VK_NULL_HANDLE),
+    m_memProperties{},
+    m_dedicatedCount(0),
+    m_dedicatedBytes(0)
+{
+}
+
+/************************************************************************
+*    DESC:  destructor
+************************************************************************/
+CMemoryAllocator::~CMemoryAllocator()
+{
+}
+
+/************************************************************************
+*    DESC:  Init with the devices
+************************************************************************/
+void CMemoryAllocator::init( VkPhysicalDevice physicalDevice, VkDevice logicalDevice )
+{
+    m_logicalDevice = logicalDevice;
+    vkGetPhysicalDeviceMemoryProperties( physicalDevice, &m_memProperties );
+}
+
+/************************************************************************
+*    DESC:  Allocate memory for a resource
+************************************************************************/
+CMemoryAllocation CMemoryAllocator::allocate(
+    const VkMemoryRequirements & memRequirements,
+    uint32_t memoryTypeIndex,
+    bool image )
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+
+    CMemoryAllocation allocation;
+    allocation.m_pAllocator = this;
+
+    // Buddy ranges are aligned to their size so a range at least as big as the alignment is always aligned
+    const VkDeviceSize size = std::max( memRequirements.size, memRequirements.alignment );
+
+    // Resources too large for a block get their own memory
+    if( size > (BLOCK_SIZE / 2) )
+    {
+        allocation.m_memory = allocateDeviceMemory( memRequirements.size, memoryTypeIndex, &allocation.m_pMappedData );
+        allocation.m_size = memRequirements.size;
+
+        ++m_dedicatedCount;
+        m_dedicatedBytes += memRequirements.size;
+
+        return allocation;
+    }
+
+    while( (MIN_ALLOC_SIZE << allocation.m_order) < size )
+        ++allocation.m_order;
+
+    allocation.m_size = (MIN_ALLOC_SIZE << allocation.m_order);
+
+    // Try the existing blocks first
+    auto & rBlockVec = m_blockVecMap[ std::make_pair( memoryTypeIndex, image ) ];
+    for( auto & iter : rBlockVec )
+    {
+        if( iter->alloc( allocation.m_order, MIN_ALLOC_SIZE, allocation.m_offset ) )
+        {
+            allocation.m_pBlock = iter.get();
+            break;
+        }
+    }
+
+    // Add another block if they are all full
+    if( allocation.m_pBlock == nullptr )
+    {
+        allocation.m_pBlock = allocateBlock( memoryTypeIndex, image );
+        allocation.m_pBlock->alloc( allocation.m_order, MIN_ALLOC_SIZE, allocation.m_offset );
+    }
+
+    allocation.m_memory = allocation.m_pBlock->m_memory;
+
+    if( allocation.m_pBlock->m_pMappedData != nullptr )
+        allocation.m_pMappedData = static_cast<uint8_t *>(allocation.m_pBlock->m_pMappedData) + allocation.m_offset;
+
+    return allocation;
+}
+
+/************************************************************************
+*    DESC:  Return memory to the allocator
+************************************************************************/
+void CMemoryAllocator::free( CMemoryAllocation & allocation )
+{
+    if( allocation.m_memory == VK_NULL_HANDLE )
+        return;
+
+    std::unique_lock<std::mutex> lock( m_mutex );
+
+    // Dedicated allocation
+    if( allocation.m_pBlock == nullptr )
+    {
+        vkFreeMemory( m_logicalDevice, allocation.m_memory, nullptr );
+
+        --m_dedicatedCount;
+        m_dedicatedBytes -= allocation.m_size;
+
+        return;
+    }
+
+    CMemoryBlock * pBlock = allocation.m_pBlock;
+    pBlock->free( allocation.m_order, MIN_ALLOC_SIZE, allocation.m_offset );
+
+    // Give empty blocks back to the driver but keep one around to avoid thrashing
+    if( pBlock->m_allocationCount == 0 )
+    {
+        auto & rBlockVec = m_blockVecMap[ pBlock->m_key ];
+        if( rBlockVec.size() > 1 )
+        {
+            vkFreeMemory( m_logicalDevice, pBlock->m_memory, nullptr );
+
+            rBlockVec.erase( std::find_if( rBlockVec.begin(), rBlockVec.end(),
+                [pBlock](const std::unique_ptr<CMemoryBlock> & rBlock) { return rBlock.get() == pBlock; } ) );
+        }
+    }
+}
+
+/************************************************************************
+*    DESC:  Free all the device memory
+*           NOTE: All allocations need to be freed before this is called
+************************************************************************/
+void CMemoryAllocator::destroy()
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+
+    for( auto & mapIter : m_blockVecMap )
+        for( auto & iter : mapIter.second )
+            vkFreeMemory( m_logicalDevice, iter->m_memory, nullptr );
+
+    m_blockVecMap.clear();
+}
+
+/************************************************************************
+*    DESC:  Get the allocator statistics
+************************************************************************/
+CMemoryStats CMemoryAllocator::getStats()
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+
+    CMemoryStats stats;
+    VkDeviceSize freeBytes = 0;
+    VkDeviceSize largestFreeBytes = 0;
+
+    stats.m_dedicatedCount = m_dedicatedCount;
+    stats.m_allocationCount = m_dedicatedCount;
+    stats.m_reservedBytes = m_dedicatedBytes;
+    stats.m_usedBytes = m_dedicatedBytes;
+
+    for( auto & mapIter : m_blockVecMap )
+    {
+        for( auto & iter : mapIter.second )
+        {
+            ++stats.m_blockCount;
+            stats.m_allocationCount += iter->m_allocationCount;
+            stats.m_reservedBytes += BLOCK_SIZE;
+            stats.m_usedBytes += iter->m_usedBytes;
+
+            freeBytes += BLOCK_SIZE - iter->m_usedBytes;
+            largestFreeBytes += iter->getLargestFree( MIN_ALLOC_SIZE );
+        }
+    }
+
+    if( freeBytes > 0 )
+        stats.m_fragmentation = 1.f - ((float)largestFreeBytes / (float)freeBytes);
+
+    return stats;
+}
+
+/************************************************************************
+*    DESC:  Get the statistics as a string for debug output
+************************************************************************/
+std::string CMemoryAllocator::getStatsStr()
+{
+    const CMemoryStats stats = getStats();
+
+    return boost::str( boost::format("blocks: %d - dedicated: %d - allocs: %d - reserved: %dkb - used: %dkb - frag: %.2f")
+        % stats.m_blockCount
+        % stats.m_dedicatedCount
+        % stats.m_allocationCount
+        % (stats.m_reservedBytes / 1024)
+        % (stats.m_usedBytes / 1024)
+        % stats.m_fragmentation );
+}
+
+/************************************************************************
+*    DESC:  Allocate a new block of device memory
+************************************************************************/
+CMemoryBlock * CMemoryAllocator::allocateBlock( uint32_t memoryTypeIndex, bool image )
+{
+    std::unique_ptr<CMemoryBlock> upBlock( new CMemoryBlock( ORDER_COUNT ) );
+    upBlock->m_key = std::make_pair( memoryTypeIndex, image );
+    upBlock->m_memory = allocateDeviceMemory( BLOCK_SIZE, memoryTypeIndex, &upBlock->m_pMappedData );
+
+    // The whole block starts out as one free range
+    upBlock->m_freeSetVec.back().insert( 0 );
+
+    auto & rBlockVec = m_blockVecMap[ upBlock->m_key ];
+    rBlockVec.push_back( std::move(upBlock) );
+
+    NGenFunc::PostDebugMsg( boost::str( boost::format("Memory block allocated: type %d, %s, %d blocks")
+        % memoryTypeIndex % (image ? "image" : "buffer") % rBlockVec.size() ) );
+
+    return rBlockVec.back().get();
+}
+
+/************************************************************************
+*    DESC:  Allocate device memory from the driver
+*           NOTE: Host visible memory stays mapped for its whole life
+************************************************************************/
+VkDeviceMemory CMemoryAllocator::allocateDeviceMemory( VkDeviceSize size, uint32_t memoryTypeIndex, void ** ppMappedData )
+{
+    VkResult vkResult(VK_SUCCESS);
+    VkDeviceMemory memory(VK_NULL_HANDLE);
+
+    VkMemoryAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = size;
+    allocInfo.memoryTypeIndex = memoryTypeIndex;
+
+    if( (vkResult = vkAllocateMemory( m_logicalDevice, &allocInfo, nullptr, &memory )) )
+        throw NExcept::CCriticalException( "Vulkan Error!",
+            boost::str( boost::format("Could not allocate device memory! (%d bytes, error %d)") % size % vkResult ) );
+
+    if( m_memProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT )
+    {
+        if( (vkResult = vkMapMemory( m_logicalDevice, memory, 0, VK_WHOLE_SIZE, 0, ppMappedData )) )
+        {
+            vkFreeMemory( m_logicalDevice, memory, nullptr );
+            throw NExcept::CCriticalException( "Vulkan Error!",
+                boost::str( boost::format("Could not map device memory! (error %d)") % vkResult ) );
+        }
+    }
+
+    return memory;
+}
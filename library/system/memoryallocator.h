@@ -0,0 +1,147 @@
+
+/************************************************************************
+*    FILE NAME:       memoryallocator.h
+*
+*    DESCRIPTION:     Sub-allocates buffers and images from large blocks
+*                     of device memory using a buddy scheme per memory type
+************************************************************************/
+
+#pragma once
+
+// Vulkan lib dependencies
+#include <system/vulkan.h>
+
+// Boost lib dependencies
+#include <boost/noncopyable.hpp>
+
+// Standard lib dependencies
+#include <vector>
+#include <set>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <cstdint>
+
+// Forward declaration(s)
+class CMemoryAllocator;
+class CMemoryBlock;
+
+/************************************************************************
+*    Range of device memory handed out by the allocator
+************************************************************************/
+class CMemoryAllocation
+{
+public:
+
+    // Device memory the range lives in and where it starts
+    VkDeviceMemory m_memory = VK_NULL_HANDLE;
+    VkDeviceSize m_offset = 0;
+
+    // Size of the range
+    VkDeviceSize m_size = 0;
+
+    // Pointer to the mapped range if the memory is host visible
+    void * m_pMappedData = nullptr;
+
+    // Allocator and block this came from. Block is null for a dedicated allocation
+    CMemoryAllocator * m_pAllocator = nullptr;
+    CMemoryBlock * m_pBlock = nullptr;
+
+    // Buddy order of the range within the block
+    uint32_t m_order = 0;
+
+    bool isEmpty() const
+    { return (m_memory == VK_NULL_HANDLE); }
+
+    // Return the range to the allocator
+    void free();
+};
+
+/************************************************************************
+*    Allocator statistics
+************************************************************************/
+class CMemoryStats
+{
+public:
+
+    // Number of blocks and dedicated allocations
+    uint32_t m_blockCount = 0;
+    uint32_t m_dedicatedCount = 0;
+
+    // Number of live allocations
+    uint32_t m_allocationCount = 0;
+
+    // Bytes allocated from the driver and bytes handed out
+    VkDeviceSize m_reservedBytes = 0;
+    VkDeviceSize m_usedBytes = 0;
+
+    // 0 means all the free memory of a block is in one piece
+    float m_fragmentation = 0.f;
+};
+
+class CMemoryAllocator : boost::noncopyable
+{
+public:
+
+    // Constructor
+    CMemoryAllocator();
+
+    // Destructor
+    ~CMemoryAllocator();
+
+    // Init with the devices
+    void init( VkPhysicalDevice physicalDevice, VkDevice logicalDevice );
+
+    // Allocate memory for a resource
+    // NOTE: Images and buffers use separate blocks so bufferImageGranularity never comes into play
+    CMemoryAllocation allocate(
+        const VkMemoryRequirements & memRequirements,
+        uint32_t memoryTypeIndex,
+        bool image );
+
+    // Return memory to the allocator
+    void free( CMemoryAllocation & allocation );
+
+    // Free all the device memory
+    void destroy();
+
+    // Get the allocator statistics
+    CMemoryStats getStats();
+
+    // Get the statistics as a string for debug output
+    std::string getStatsStr();
+
+private:
+
+    // Allocate a new block of device memory
+    CMemoryBlock * allocateBlock( uint32_t memoryTypeIndex, bool image );
+
+    // Allocate device memory from the driver
+    VkDeviceMemory allocateDeviceMemory( VkDeviceSize size, uint32_t memoryTypeIndex, void ** ppMappedData );
+
+private:
+
+    // Size of the blocks and the smallest range handed out
+    static constexpr VkDeviceSize BLOCK_SIZE = 64 * 1024 * 1024;
+    static constexpr VkDeviceSize MIN_ALLOC_SIZE = 256;
+
+    // Number of buddy orders in a block. Order 0 is MIN_ALLOC_SIZE and the top order is the whole block
+    static constexpr uint32_t ORDER_COUNT = 19;
+
+    // Logical device
+    VkDevice m_logicalDevice;
+
+    // Memory properties of the physical device
+    VkPhysicalDeviceMemoryProperties m_memProperties;
+
+    // Blocks keyed by memory type index and image flag
+    std::map< std::pair<uint32_t, bool>, std::vector<std::unique_ptr<CMemoryBlock>> > m_blockVecMap;
+
+    // Resources too large for a block get their own device memory
+    uint32_t m_dedicatedCount;
+    VkDeviceSize m_dedicatedBytes;
+
+    // Allocations may come from the load thread
+    std::mutex m_mutex;
+};
@@ -6,6 +6,9 @@
 
 #pragma once
 
+// Game lib dependencies
+#include <system/memoryallocator.h>
+
 // Vulkan lib dependencies
 #include <system/vulkan.h>
 
@@ -14,11 +17,11 @@ class CMemoryBuffer
 public:
 
     VkBuffer m_buffer = VK_NULL_HANDLE;
-    VkDeviceMemory m_deviceMemory = VK_NULL_HANDLE;
+    CMemoryAllocation m_allocation;
     
     bool isEmpty()
     {
-        if( m_buffer == VK_NULL_HANDLE && m_deviceMemory == VK_NULL_HANDLE )
+        if( m_buffer == VK_NULL_HANDLE && m_allocation.isEmpty() )
             return true;
         
         return false;
@@ -35,10 +38,7 @@ public:
             m_buffer = VK_NULL_HANDLE;
         }
 
-        if( m_deviceMemory != VK_NULL_HANDLE )
-        {
-            vkFreeMemory( logicalDevice, m_deviceMemory, nullptr );
-            m_deviceMemory = VK_NULL_HANDLE;
-        }
+        // Return the memory to the allocator
+        m_allocation.free();
     }
 };
@@ -88,6 +88,12 @@ struct SPipelineData
     // Vertex input attribute description
     std::vector<VkVertexInputAttributeDescription> vertInputAttrDescVec;
 
+    // Per instance input binding description. Stride is zero if not an instanced pipeline
+    VkVertexInputBindingDescription instanceInputBindingDesc = {};
+
+    // Index of the instanced version of this pipeline used for batching. -1 if none
+    int instancedPipelineIndex = -1;
+
     // Color blend mode members
     VkColorComponentFlags colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
     bool blendEnable = true;
@@ -0,0 +1,200 @@
+
+/************************************************************************
+*    FILE NAME:       samplercache.cpp
+*
+*    DESCRIPTION:     Shares one sampler between all the textures that
+*                     use the same sampler settings
+************************************************************************/
+
+// Physical component dependency
+#include <system/samplercache.h>
+
+// Game lib dependencies
+#include <utilities/exceptionhandling.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
+#include <boost/functional/hash.hpp>
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CSamplerKey::CSamplerKey( const VkSamplerCreateInfo & samplerInfo ) :
+    magFilter(samplerInfo.magFilter),
+    minFilter(samplerInfo.minFilter),
+    mipmapMode(samplerInfo.mipmapMode),
+    addressModeU(samplerInfo.addressModeU),
+    addressModeV(samplerInfo.addressModeV),
+    addressModeW(samplerInfo.addressModeW),
+    mipLodBias(samplerInfo.mipLodBias),
+    anisotropyEnable(samplerInfo.anisotropyEnable),
+    maxAnisotropy(samplerInfo.maxAnisotropy),
+    compareEnable(samplerInfo.compareEnable),
+    compareOp(samplerInfo.compareOp),
+    minLod(samplerInfo.minLod),
+    maxLod(samplerInfo.maxLod),
+    borderColor(samplerInfo.borderColor),
+    unnormalizedCoordinates(samplerInfo.unnormalizedCoordinates)
+{
+}
+
+/************************************************************************
+*    DESC:  Are the settings the same
+************************************************************************/
+bool CSamplerKey::operator == ( const CSamplerKey & key ) const
+{
+    return (magFilter == key.magFilter) &&
+           (minFilter == key.minFilter) &&
+           (mipmapMode == key.mipmapMode) &&
+           (addressModeU == key.addressModeU) &&
+           (addressModeV == key.addressModeV) &&
+           (addressModeW == key.addressModeW) &&
+           (mipLodBias == key.mipLodBias) &&
+           (anisotropyEnable == key.anisotropyEnable) &&
+           (maxAnisotropy == key.maxAnisotropy) &&
+           (compareEnable == key.compareEnable) &&
+           (compareOp == key.compareOp) &&
+           (minLod == key.minLod) &&
+           (maxLod == key.maxLod) &&
+           (borderColor == key.borderColor) &&
+           (unnormalizedCoordinates == key.unnormalizedCoordinates);
+}
+
+/************************************************************************
+*    DESC:  Hash of the settings
+************************************************************************/
+size_t CSamplerKey::hash() const
+{
+    size_t seed = 0;
+    boost::hash_combine( seed, static_cast<int>(magFilter) );
+    boost::hash_combine( seed, static_cast<int>(minFilter) );
+    boost::hash_combine( seed, static_cast<int>(mipmapMode) );
+    boost::hash_combine( seed, static_cast<int>(addressModeU) );
+    boost::hash_combine( seed, static_cast<int>(addressModeV) );
+    boost::hash_combine( seed, static_cast<int>(addressModeW) );
+    boost::hash_combine( seed, mipLodBias );
+    boost::hash_combine( seed, anisotropyEnable );
+    boost::hash_combine( seed, maxAnisotropy );
+    boost::hash_combine( seed, compareEnable );
+    boost::hash_combine( seed, static_cast<int>(compareOp) );
+    boost::hash_combine( seed, minLod );
+    boost::hash_combine( seed, maxLod );
+    boost::hash_combine( seed, static_cast<int>(borderColor) );
+    boost::hash_combine( seed, unnormalizedCoordinates );
+
+    return seed;
+}
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CSamplerCache::CSamplerCache() :
+    m_logicalDevice(VK_NULL_HANDLE)
+{
+}
+
+/************************************************************************
+*    DESC:  destructor
+************************************************************************/
+CSamplerCache::~CSamplerCache()
+{
+}
+
+/************************************************************************
+*    DESC:  Init with the device
+************************************************************************/
+void CSamplerCache::init( VkDevice logicalDevice )
+{
+    m_logicalDevice = logicalDevice;
+}
+
+/************************************************************************
+*    DESC:  Get a sampler for the settings
+************************************************************************/
+VkSampler CSamplerCache::acquire( const VkSamplerCreateInfo & samplerInfo )
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+
+    const CSamplerKey key( samplerInfo );
+
+    auto iter = m_samplerMap.find( key );
+    if( iter == m_samplerMap.end() )
+    {
+        VkResult vkResult(VK_SUCCESS);
+        CSamplerRef samplerRef;
+
+        if( (vkResult = vkCreateSampler( m_logicalDevice, &samplerInfo, nullptr, &samplerRef.m_sampler )) )
+            throw NExcept::CCriticalException( "Vulkan Error!",
+                boost::str( boost::format("Could not create texture sampler! (error %d, %d samplers)") % vkResult % m_samplerMap.size() ) );
+
+        iter = m_samplerMap.emplace( key, samplerRef ).first;
+        m_keyMap.emplace( samplerRef.m_sampler, key );
+    }
+
+    ++iter->second.m_refCount;
+
+    return iter->second.m_sampler;
+}
+
+/************************************************************************
+*    DESC:  Release a sampler
+************************************************************************/
+void CSamplerCache::release( VkSampler sampler )
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+
+    auto keyIter = m_keyMap.find( sampler );
+    if( keyIter == m_keyMap.end() )
+        return;
+
+    auto iter = m_samplerMap.find( keyIter->second );
+    if( --iter->second.m_refCount == 0 )
+    {
+        vkDestroySampler( m_logicalDevice, sampler, nullptr );
+
+        m_samplerMap.erase( iter );
+        m_keyMap.erase( keyIter );
+    }
+}
+
+/************************************************************************
+*    DESC:  Destroy all the samplers
+************************************************************************/
+void CSamplerCache::destroy()
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+
+    for( auto & iter : m_samplerMap )
+        vkDestroySampler( m_logicalDevice, iter.second.m_sampler, nullptr );
+
+    m_samplerMap.clear();
+    m_keyMap.clear();
+}
+
+/************************************************************************
+*    DESC:  Get the cache statistics
+************************************************************************/
+CSamplerStats CSamplerCache::getStats()
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+
+    CSamplerStats stats;
+    stats.m_uniqueCount = m_samplerMap.size();
+
+    for( auto & iter : m_samplerMap )
+        stats.m_requestedCount += iter.second.m_refCount;
+
+    return stats;
+}
+
+/************************************************************************
+*    DESC:  Get the statistics as a string for debug output
+************************************************************************/
+std::string CSamplerCache::getStatsStr()
+{
+    const CSamplerStats stats = getStats();
+
+    return boost::str( boost::format("samplers: %d - requested: %d")
+        % stats.m_uniqueCount
+        % stats.m_requestedCount );
+}
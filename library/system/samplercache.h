@@ -0,0 +1,123 @@
+
+/************************************************************************
+*    FILE NAME:       samplercache.h
+*
+*    DESCRIPTION:     Shares one sampler between all the textures that
+*                     use the same sampler settings
+************************************************************************/
+
+#pragma once
+
+// Vulkan lib dependencies
+#include <system/vulkan.h>
+
+// Boost lib dependencies
+#include <boost/noncopyable.hpp>
+
+// Standard lib dependencies
+#include <unordered_map>
+#include <mutex>
+#include <string>
+#include <cstdint>
+
+/************************************************************************
+*    Sampler settings the samplers are shared by
+************************************************************************/
+class CSamplerKey
+{
+public:
+
+    CSamplerKey( const VkSamplerCreateInfo & samplerInfo );
+
+    bool operator == ( const CSamplerKey & key ) const;
+
+    // Hash of the settings
+    size_t hash() const;
+
+    VkFilter magFilter;
+    VkFilter minFilter;
+    VkSamplerMipmapMode mipmapMode;
+    VkSamplerAddressMode addressModeU;
+    VkSamplerAddressMode addressModeV;
+    VkSamplerAddressMode addressModeW;
+    float mipLodBias;
+    VkBool32 anisotropyEnable;
+    float maxAnisotropy;
+    VkBool32 compareEnable;
+    VkCompareOp compareOp;
+    float minLod;
+    float maxLod;
+    VkBorderColor borderColor;
+    VkBool32 unnormalizedCoordinates;
+};
+
+/************************************************************************
+*    Sampler cache statistics
+************************************************************************/
+class CSamplerStats
+{
+public:
+
+    // Number of samplers created and number of textures using them
+    uint32_t m_uniqueCount = 0;
+    uint32_t m_requestedCount = 0;
+};
+
+class CSamplerCache : boost::noncopyable
+{
+public:
+
+    // Constructor
+    CSamplerCache();
+
+    // Destructor
+    ~CSamplerCache();
+
+    // Init with the device
+    void init( VkDevice logicalDevice );
+
+    // Get a sampler for the settings. Creates it if none use these settings yet.
+    // NOTE: Each call needs to be matched by a release
+    VkSampler acquire( const VkSamplerCreateInfo & samplerInfo );
+
+    // Release a sampler. Destroyed once no texture is using it.
+    void release( VkSampler sampler );
+
+    // Destroy all the samplers
+    // NOTE: All textures need to be freed before this is called
+    void destroy();
+
+    // Get the cache statistics
+    CSamplerStats getStats();
+
+    // Get the statistics as a string for debug output
+    std::string getStatsStr();
+
+private:
+
+    class CKeyHash
+    {
+    public:
+        size_t operator()( const CSamplerKey & key ) const
+        { return key.hash(); }
+    };
+
+    class CSamplerRef
+    {
+    public:
+        VkSampler m_sampler = VK_NULL_HANDLE;
+        uint32_t m_refCount = 0;
+    };
+
+    // Logical device
+    VkDevice m_logicalDevice;
+
+    // Samplers keyed by their settings
+    std::unordered_map<CSamplerKey, CSamplerRef, CKeyHash> m_samplerMap;
+
+    // Settings of each sampler so it can be found when released
+    std::unordered_map<VkSampler, CSamplerKey> m_keyMap;
+
+    // Textures are created on the load threads
+    std::mutex m_mutex;
+};
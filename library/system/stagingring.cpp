@@ -0,0 +1,115 @@
+
+/************************************************************************
+*    FILE NAME:       stagingring.cpp
+*
+*    DESCRIPTION:     Ring allocator for the persistently mapped staging
+*                     buffer. Ranges are handed out in order and retired
+*                     once the transfer using them has completed.
+************************************************************************/
+
+// Physical component dependency
+#include <system/stagingring.h>
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CStagingRing::CStagingRing() :
+    m_size(0),
+    m_head(0),
+    m_tail(0),
+    m_frontId(0)
+{
+}
+
+/************************************************************************
+*    DESC:  Set the size of the ring
+************************************************************************/
+void CStagingRing::init( VkDeviceSize size )
+{
+    m_size = size;
+    m_head = m_tail = 0;
+    m_frontId += m_rangeDeq.size();
+    m_rangeDeq.clear();
+}
+
+/************************************************************************
+*    DESC:  Allocate a range from the ring
+************************************************************************/
+bool CStagingRing::alloc( VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize & offset, uint64_t & id )
+{
+    if( (size == 0) || (size > m_size) )
+        return false;
+
+    const VkDeviceSize alignedHead = ((m_head + alignment - 1) / alignment) * alignment;
+
+    // The head has wrapped around behind the tail when the ring isn't empty and the head isn't past the tail
+    if( !m_rangeDeq.empty() && (m_head <= m_tail) )
+    {
+        if( alignedHead + size > m_tail )
+            return false;
+
+        offset = alignedHead;
+    }
+    // Use the space after the head or wrap around to the start if it doesn't fit
+    else if( alignedHead + size <= m_size )
+    {
+        offset = alignedHead;
+    }
+    else if( size <= m_tail )
+    {
+        offset = 0;
+    }
+    else
+    {
+        return false;
+    }
+
+    m_head = offset + size;
+
+    CRange range;
+    range.m_end = m_head;
+    m_rangeDeq.push_back( range );
+
+    id = m_frontId + m_rangeDeq.size() - 1;
+
+    return true;
+}
+
+/************************************************************************
+*    DESC:  Retire a range once the transfer reading it has completed
+************************************************************************/
+void CStagingRing::retire( uint64_t id )
+{
+    if( (id < m_frontId) || (id - m_frontId >= m_rangeDeq.size()) )
+        return;
+
+    m_rangeDeq[id - m_frontId].m_retired = true;
+
+    // Reclaim the space of the retired ranges at the front
+    while( !m_rangeDeq.empty() && m_rangeDeq.front().m_retired )
+    {
+        m_tail = m_rangeDeq.front().m_end;
+        m_rangeDeq.pop_front();
+        ++m_frontId;
+    }
+
+    // Start over at the beginning once everything is retired
+    if( m_rangeDeq.empty() )
+        m_head = m_tail = 0;
+}
+
+/************************************************************************
+*    DESC:  Get the size of the ring
+************************************************************************/
+VkDeviceSize CStagingRing::getSize() const
+{
+    return m_size;
+}
+
+/************************************************************************
+*    DESC:  Is anything in the ring waiting to be retired
+************************************************************************/
+bool CStagingRing::isEmpty() const
+{
+    return m_rangeDeq.empty();
+}
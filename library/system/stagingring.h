@@ -0,0 +1,65 @@
+
+/************************************************************************
+*    FILE NAME:       stagingring.h
+*
+*    DESCRIPTION:     Ring allocator for the persistently mapped staging
+*                     buffer. Ranges are handed out in order and retired
+*                     once the transfer using them has completed.
+************************************************************************/
+
+#pragma once
+
+// Vulkan lib dependencies
+#include <system/vulkan.h>
+
+// Standard lib dependencies
+#include <deque>
+#include <cstdint>
+
+class CStagingRing
+{
+public:
+
+    // Constructor
+    CStagingRing();
+
+    // Set the size of the ring
+    void init( VkDeviceSize size );
+
+    // Allocate a range from the ring. Returns false if there's no room right now.
+    bool alloc( VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize & offset, uint64_t & id );
+
+    // Retire a range once the transfer reading it has completed
+    // NOTE: Ranges can be retired in any order. Space is reclaimed in allocation order.
+    void retire( uint64_t id );
+
+    // Get the size of the ring
+    VkDeviceSize getSize() const;
+
+    // Is anything in the ring waiting to be retired
+    bool isEmpty() const;
+
+private:
+
+    class CRange
+    {
+    public:
+
+        // End of the range in the ring
+        VkDeviceSize m_end = 0;
+
+        // Set once the transfer using the range has completed
+        bool m_retired = false;
+    };
+
+    // Size of the ring
+    VkDeviceSize m_size;
+
+    // Next free offset and the start of the oldest range still in use
+    VkDeviceSize m_head;
+    VkDeviceSize m_tail;
+
+    // Ranges in allocation order and the id of the one at the front
+    std::deque<CRange> m_rangeDeq;
+    uint64_t m_frontId;
+};
@@ -24,6 +24,9 @@ namespace NUBO
         if( ubo == "model_viewProj_color_additive" )
             return sizeof(model_viewProj_color_additive);
         
+        else if( ubo == "model_viewProj_color_additive_layer" )
+            return sizeof(model_viewProj_color_additive_layer);
+        
         else if( ubo == "model_viewProj_color_additive_glyph" )
             return sizeof(model_viewProj_color_additive_glyph);
         
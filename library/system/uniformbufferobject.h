@@ -26,6 +26,18 @@ namespace NUBO
         CColor additive;
     };
     
+    // The layer picks the frame of a texture array
+    class model_viewProj_color_additive_layer
+    {
+    public:
+
+        CMatrix model;
+        CMatrix viewProj;
+        CColor color;
+        CColor additive;
+        float layer;
+    };
+    
     class model_viewProj_color_additive_glyph
     {
     public:
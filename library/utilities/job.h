@@ -0,0 +1,239 @@
+/************************************************************************
+*    FILE NAME:       job.h
+*
+*    DESCRIPTION:     Allocation free job and job counter classes
+*                     used by the thread pool job system
+************************************************************************/
+
+#pragma once
+
+// Standard lib dependencies
+#include <atomic>
+#include <mutex>
+#include <exception>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Boost lib dependencies
+#include <boost/noncopyable.hpp>
+
+/************************************************************************
+*    DESC:  Counter used to wait on a group of jobs (fork-join)
+*           Incremented when a job is posted, decremented when it finishes
+************************************************************************/
+class CJobCounter : public boost::noncopyable
+{
+public:
+
+    // Constructor
+    CJobCounter() : m_count(0)
+    {}
+
+    // Add to the count of outstanding jobs
+    void inc( int value = 1 )
+    {
+        m_count.fetch_add( value, std::memory_order_relaxed );
+    }
+
+    // A job has finished
+    void dec()
+    {
+        m_count.fetch_sub( 1, std::memory_order_release );
+    }
+
+    // Have all the jobs finished
+    bool isDone() const
+    {
+        return (m_count.load( std::memory_order_acquire ) == 0);
+    }
+
+    // Save the first exception thrown by a job of this counter
+    void setException( std::exception_ptr exception )
+    {
+        std::unique_lock<std::mutex> lock( m_mutex );
+        if( !m_exception )
+            m_exception = exception;
+    }
+
+    // Rethrow the saved exception on the waiting thread
+    void rethrow()
+    {
+        std::exception_ptr exception;
+        {
+            std::unique_lock<std::mutex> lock( m_mutex );
+            std::swap( exception, m_exception );
+        }
+
+        if( exception )
+            std::rethrow_exception( exception );
+    }
+
+private:
+
+    // Count of outstanding jobs
+    std::atomic_int m_count;
+
+    // Exception thrown from a job. Only locked on the error path
+    std::mutex m_mutex;
+    std::exception_ptr m_exception;
+};
+
+/************************************************************************
+*    DESC:  Type erased job that stores the callable inline so that
+*           posting a job never touches the heap
+************************************************************************/
+class CJob : public boost::noncopyable
+{
+public:
+
+    // Max size of the callable stored inside the job.
+    // Capture large data by pointer or reference.
+    static constexpr size_t STORAGE_SIZE = 64;
+
+    // Constructor
+    CJob()
+    {}
+
+    template<typename F>
+    CJob( F && func, CJobCounter * pCounter )
+    {
+        set( std::forward<F>(func), pCounter );
+    }
+
+    // Move constructor/assignment
+    CJob( CJob && other ) noexcept
+    {
+        moveFrom( other );
+    }
+
+    CJob & operator=( CJob && other ) noexcept
+    {
+        if( this != &other )
+        {
+            reset();
+            moveFrom( other );
+        }
+
+        return *this;
+    }
+
+    // Destructor
+    ~CJob()
+    {
+        reset();
+    }
+
+    /************************************************************************
+    *    DESC:  Set the callable of this job
+    ************************************************************************/
+    template<typename F>
+    void set( F && func, CJobCounter * pCounter )
+    {
+        using func_t = typename std::decay<F>::type;
+
+        static_assert( sizeof(func_t) <= STORAGE_SIZE, "Job callable too large. Capture by reference or pointer." );
+        static_assert( alignof(func_t) <= alignof(std::max_align_t), "Job callable alignment not supported." );
+
+        reset();
+
+        new (m_storage) func_t( std::forward<F>(func) );
+        m_pOps = &SOps<func_t>::ops;
+        m_pCounter = pCounter;
+    }
+
+    /************************************************************************
+    *    DESC:  Execute the job and signal the counter
+    ************************************************************************/
+    void operator()()
+    {
+        try
+        {
+            m_pOps->invoke( m_storage );
+        }
+        catch( ... )
+        {
+            if( m_pCounter == nullptr )
+                throw;
+
+            m_pCounter->setException( std::current_exception() );
+        }
+
+        if( m_pCounter != nullptr )
+            m_pCounter->dec();
+
+        reset();
+    }
+
+    /************************************************************************
+    *    DESC:  Is this job empty
+    ************************************************************************/
+    bool isEmpty() const
+    {
+        return (m_pOps == nullptr);
+    }
+
+private:
+
+    // Function table for the stored callable type
+    struct SFuncOps
+    {
+        void (*invoke)( void * pStorage );
+        void (*move)( void * pDst, void * pSrc );
+        void (*destroy)( void * pStorage );
+    };
+
+    template<typename T>
+    struct SOps
+    {
+        static void invoke( void * pStorage )
+        { (*static_cast<T *>(pStorage))(); }
+
+        static void move( void * pDst, void * pSrc )
+        { new (pDst) T( std::move(*static_cast<T *>(pSrc)) ); }
+
+        static void destroy( void * pStorage )
+        { static_cast<T *>(pStorage)->~T(); }
+
+        static constexpr SFuncOps ops = { &invoke, &move, &destroy };
+    };
+
+    /************************************************************************
+    *    DESC:  Destroy the stored callable
+    ************************************************************************/
+    void reset()
+    {
+        if( m_pOps != nullptr )
+        {
+            m_pOps->destroy( m_storage );
+            m_pOps = nullptr;
+            m_pCounter = nullptr;
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  Take the callable from another job
+    ************************************************************************/
+    void moveFrom( CJob & other )
+    {
+        if( other.m_pOps != nullptr )
+        {
+            other.m_pOps->move( m_storage, other.m_storage );
+            m_pOps = other.m_pOps;
+            m_pCounter = other.m_pCounter;
+            other.reset();
+        }
+    }
+
+private:
+
+    // Function table of the stored callable
+    const SFuncOps * m_pOps = nullptr;
+
+    // Counter to signal when this job is done
+    CJobCounter * m_pCounter = nullptr;
+
+    // Inline storage for the callable
+    alignas(std::max_align_t) unsigned char m_storage[STORAGE_SIZE];
+};
@@ -0,0 +1,116 @@
+/************************************************************************
+*    FILE NAME:       jobqueue.h
+*
+*    DESCRIPTION:     Fixed size work stealing job queue. The owning
+*                     worker pushes and pops from the back while other
+*                     workers steal from the front.
+************************************************************************/
+
+#pragma once
+
+// Game lib dependencies
+#include <utilities/job.h>
+
+// Standard lib dependencies
+#include <vector>
+#include <mutex>
+
+// Boost lib dependencies
+#include <boost/noncopyable.hpp>
+
+class CJobQueue : public boost::noncopyable
+{
+public:
+
+    // Constructor
+    // NOTE: Capacity is rounded up to a power of 2. This is the only allocation.
+    CJobQueue( size_t capacity )
+    {
+        size_t size = 1;
+        while( size < capacity )
+            size <<= 1;
+
+        m_jobVec.resize( size );
+        m_mask = size - 1;
+    }
+
+    /************************************************************************
+    *    DESC:  Push a job on the back of the queue
+    *           Returns false if the queue is full
+    ************************************************************************/
+    bool push( CJob && job )
+    {
+        std::unique_lock<std::mutex> lock( m_mutex );
+
+        if( (m_tail - m_head) > m_mask )
+            return false;
+
+        m_jobVec[m_tail & m_mask] = std::move(job);
+        ++m_tail;
+
+        return true;
+    }
+
+    /************************************************************************
+    *    DESC:  Pop a job from the back of the queue. Owner only.
+    *           Newest job first for cache friendliness.
+    ************************************************************************/
+    bool pop( CJob & job )
+    {
+        std::unique_lock<std::mutex> lock( m_mutex );
+
+        if( m_tail == m_head )
+            return false;
+
+        --m_tail;
+        job = std::move(m_jobVec[m_tail & m_mask]);
+
+        return true;
+    }
+
+    /************************************************************************
+    *    DESC:  Steal a job from the front of the queue
+    *           Oldest job first as it's most likely the largest chunk of work
+    ************************************************************************/
+    bool steal( CJob & job )
+    {
+        // Don't wait on the owner. Try another queue instead.
+        std::unique_lock<std::mutex> lock( m_mutex, std::try_to_lock );
+
+        if( !lock.owns_lock() || (m_tail == m_head) )
+            return false;
+
+        job = std::move(m_jobVec[m_head & m_mask]);
+        ++m_head;
+
+        return true;
+    }
+
+    /************************************************************************
+    *    DESC:  Clear out the queue
+    ************************************************************************/
+    void clear()
+    {
+        std::unique_lock<std::mutex> lock( m_mutex );
+
+        for( ; m_head != m_tail; ++m_head )
+            m_jobVec[m_head & m_mask] = CJob();
+
+        m_head = m_tail = 0;
+    }
+
+private:
+
+    // Ring buffer of jobs
+    std::vector<CJob> m_jobVec;
+
+    // Mask for wrapping the ring buffer index
+    size_t m_mask = 0;
+
+    // Front and back of the ring buffer
+    size_t m_head = 0;
+    size_t m_tail = 0;
+
+    // Per queue lock. Only contended when a job is being stolen.
+    std::mutex m_mutex;
+};
@@ -18,6 +18,65 @@
 #include <math.h>
 #include <cstring>
 
+// The vector kernels are picked at build time. Define MATRIX_SCALAR to use the scalar code.
+// NOTE: Only the point/normal transforms and multiply3x3 use them. tools/matrixBench measured the
+//       4x4 multiplies, the quad transform and inverse no faster than the scalar code at -O3.
+#if !defined(MATRIX_SCALAR) && (defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1)))
+    #define MATRIX_SIMD
+    #define MATRIX_SIMD_SSE
+    #include <xmmintrin.h>
+#elif !defined(MATRIX_SCALAR) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+    #define MATRIX_SIMD
+    #define MATRIX_SIMD_NEON
+    #include <arm_neon.h>
+#endif
+
+#if defined(MATRIX_SIMD)
+namespace
+{
+    // NOTE: Multiplies and adds are kept separate and in the same order as the
+    //       scalar code so both give the same results. No fused multiply-add.
+    #if defined(MATRIX_SIMD_SSE)
+    typedef __m128 vec4_t;
+
+    inline vec4_t Load( const float * pData ) { return _mm_loadu_ps( pData ); }
+    inline void Store( float * pData, vec4_t vec ) { _mm_storeu_ps( pData, vec ); }
+    inline vec4_t Splat( float value ) { return _mm_set1_ps( value ); }
+    inline vec4_t Mul( vec4_t a, vec4_t b ) { return _mm_mul_ps( a, b ); }
+    inline vec4_t Add( vec4_t a, vec4_t b ) { return _mm_add_ps( a, b ); }
+    #else
+    typedef float32x4_t vec4_t;
+
+    inline vec4_t Load( const float * pData ) { return vld1q_f32( pData ); }
+    inline void Store( float * pData, vec4_t vec ) { vst1q_f32( pData, vec ); }
+    inline vec4_t Splat( float value ) { return vdupq_n_f32( value ); }
+    inline vec4_t Mul( vec4_t a, vec4_t b ) { return vmulq_f32( a, b ); }
+    inline vec4_t Add( vec4_t a, vec4_t b ) { return vaddq_f32( a, b ); }
+    #endif
+
+    /************************************************************************
+    *    DESC:  Transform the point by the rotation/scale rows and
+    *           optionally the translation row
+    ************************************************************************/
+    inline void TransformPoint( const float * pMat, float & x, float & y, float & z, bool translate )
+    {
+        vec4_t vec = Mul( Splat( x ), Load( pMat ) );
+        vec = Add( vec, Mul( Splat( y ), Load( pMat + 4 ) ) );
+        vec = Add( vec, Mul( Splat( z ), Load( pMat + 8 ) ) );
+
+        if( translate )
+            vec = Add( vec, Load( pMat + 12 ) );
+
+        float result[4];
+        Store( result, vec );
+
+        x = result[0];
+        y = result[1];
+        z = result[2];
+    }
+}
+#endif
+
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
@@ -225,6 +284,10 @@ void CMatrix::translate( const CSize<int16_t> & size )
 ************************************************************************/
 void CMatrix::transform( CPoint<float> & dest, const CPoint<float> & source ) const
 {
+#if defined(MATRIX_SIMD)
+    dest = source;
+    TransformPoint( matrix, dest.x, dest.y, dest.z, true );
+#else
     // Transform vertex by master matrix:
     dest.x = ( source.x * matrix[ 0 ] )
            + ( source.y * matrix[ 4 ] )
@@ -240,6 +303,7 @@ void CMatrix::transform( CPoint<float> & dest, const CPoint<float> & source ) co
            + ( source.y * matrix[ 6 ] )
            + ( source.z * matrix[ 10 ] )
            + matrix[ 14 ];
+#endif
 }
 
 /************************************************************************
@@ -248,6 +312,10 @@ void CMatrix::transform( CPoint<float> & dest, const CPoint<float> & source ) co
 ************************************************************************/
 void CMatrix::transform( CPoint<float> * pDest, const CPoint<float> * pSource ) const
 {
+#if defined(MATRIX_SIMD)
+    *pDest = *pSource;
+    TransformPoint( matrix, pDest->x, pDest->y, pDest->z, true );
+#else
     // Transform vertex by master matrix:
     pDest->x = ( pSource->x * matrix[ 0 ] )
            + ( pSource->y * matrix[ 4 ] )
@@ -263,6 +331,7 @@ void CMatrix::transform( CPoint<float> * pDest, const CPoint<float> * pSource )
            + ( pSource->y * matrix[ 6 ] )
            + ( pSource->z * matrix[ 10 ] )
            + matrix[ 14 ];
+#endif
 }
 
 /************************************************************************
@@ -296,6 +365,10 @@ void CMatrix::transform( CRect<float> & dest, const CRect<float> & source ) cons
 ************************************************************************/
 void CMatrix::transform( CNormal<float> & dest, const CNormal<float> & source ) const
 {
+#if defined(MATRIX_SIMD)
+    dest = source;
+    TransformPoint( matrix, dest.x, dest.y, dest.z, false );
+#else
     // Transform vertex by master matrix:
     dest.x = ( source.x * matrix[ 0 ])
            + ( source.y * matrix[ 4 ])
@@ -308,6 +381,7 @@ void CMatrix::transform( CNormal<float> & dest, const CNormal<float> & source )
     dest.z = ( source.x * matrix[ 2 ])
            + ( source.y * matrix[ 6 ])
            + ( source.z * matrix[ 10 ]);
+#endif
 }
 
 /************************************************************************
@@ -317,6 +391,10 @@ void CMatrix::transform( CNormal<float> & dest, const CNormal<float> & source )
 ************************************************************************/
 void CMatrix::transform3x3( CPoint<float> & dest, const CPoint<float> & source ) const
 {
+#if defined(MATRIX_SIMD)
+    dest = source;
+    TransformPoint( matrix, dest.x, dest.y, dest.z, false );
+#else
     // Transform vertex by master matrix:
     dest.x = ( source.x * matrix[ 0 ])
            + ( source.y * matrix[ 4 ])
@@ -329,7 +407,7 @@ void CMatrix::transform3x3( CPoint<float> & dest, const CPoint<float> & source )
     dest.z = ( source.x * matrix[ 2 ])
            + ( source.y * matrix[ 6 ])
            + ( source.z * matrix[ 10 ]);
-
+#endif
 }
 
 /************************************************************************
@@ -883,6 +961,27 @@ void CMatrix::perspectiveFovLH( float fovy, float aspect, float zn, float zf )
 ************************************************************************/
 void CMatrix::multiply3x3( const CMatrix & obj )
 {
+#if defined(MATRIX_SIMD)
+    // Last lanes of the rows are masked off below
+    const vec4_t b0 = Load( obj() );
+    const vec4_t b1 = Load( obj() + 4 );
+    const vec4_t b2 = Load( obj() + 8 );
+
+    for( int i = 0; i < 12; i += 4 )
+    {
+        vec4_t row = Mul( Splat( matrix[i] ), b0 );
+        row = Add( row, Mul( Splat( matrix[i+1] ), b1 ) );
+        row = Add( row, Mul( Splat( matrix[i+2] ), b2 ) );
+
+        Store( matrix + i, row );
+        matrix[i+3] = 0.0f;
+    }
+
+    matrix[m30] = 0.0f;
+    matrix[m31] = 0.0f;
+    matrix[m32] = 0.0f;
+    matrix[m33] = 1.0f;
+#else
     float tmp[mMax];
 
     // init the matrix
@@ -900,6 +999,7 @@ void CMatrix::multiply3x3( const CMatrix & obj )
 
     // Copy the tmp matrix to the class's matrix
     std::memcpy( matrix, tmp, sizeof(matrix) );
+#endif
 }
 
 /************************************************************************
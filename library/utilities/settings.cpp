@@ -16,6 +16,7 @@
 
 // Standard lib dependencies
 #include <cstring>
+#include <algorithm>
 
 // SDL lib dependencies
 #include <SDL2/SDL_mixer.h>
@@ -58,8 +59,12 @@ CSettings::CSettings() :
     m_projectionType(EProjectionType::PERSPECTIVE),
     m_debugStrVisible(false),
     m_tripleBuffering(false),
+    m_framePipelineDepth(0),
+    m_uniformRingSize(4 * 1024 * 1024),
+    m_pipelineCacheFile("pipeline.cache"),
     m_saveByteCode(false),
     m_loadByteCode(false),
+    m_byteCodeCache(true),
     m_stripDebugInfo(false)
 {
     CWorldValue::setSectorSize( 512 );
@@ -249,7 +254,24 @@ void CSettings::loadXML()
                 {
                     m_tripleBuffering = ( std::strcmp( backBufferNode.getAttribute("tripleBuffering"), "true" ) == 0 );
                     m_vSync = ( std::strcmp( backBufferNode.getAttribute("VSync"), "true" ) == 0 );
-                }                
+                }
+
+                if( backBufferNode.isAttributeSet("framePipelineDepth") )
+                    m_framePipelineDepth = std::atoi(backBufferNode.getAttribute("framePipelineDepth"));
+            }
+
+            const XMLNode uniformRingNode = deviceNode.getChildNode("uniformRing");
+            if( !uniformRingNode.isEmpty() )
+            {
+                if( uniformRingNode.isAttributeSet("sizeKB") )
+                    m_uniformRingSize = std::max( 64, std::atoi(uniformRingNode.getAttribute("sizeKB")) ) * 1024;
+            }
+
+            const XMLNode pipelineCacheNode = deviceNode.getChildNode("pipelineCache");
+            if( !pipelineCacheNode.isEmpty() )
+            {
+                if( pipelineCacheNode.isAttributeSet("file") )
+                    m_pipelineCacheFile = pipelineCacheNode.getAttribute("file");
             }
 
             const XMLNode joypadNode = deviceNode.getChildNode("joypad");
@@ -302,6 +324,9 @@ void CSettings::loadXML()
                 if( scriptNode.isAttributeSet("loadByteCode") )
                     m_loadByteCode = ( std::strcmp( scriptNode.getAttribute("loadByteCode"), "true" ) == 0 );
 
+                if( scriptNode.isAttributeSet("byteCodeCache") )
+                    m_byteCodeCache = ( std::strcmp( scriptNode.getAttribute("byteCodeCache"), "true" ) == 0 );
+
                 if( scriptNode.isAttributeSet("stripDebugInfo") )
                     m_stripDebugInfo = ( std::strcmp( scriptNode.getAttribute("stripDebugInfo"), "true" ) == 0 );
             }
@@ -631,6 +656,11 @@ bool CSettings::getLoadByteCode() const
     return m_loadByteCode;
 }
 
+bool CSettings::getByteCodeCache() const
+{
+    return m_byteCodeCache;
+}
+
 bool CSettings::getStripDebugInfo() const
 {
     return m_stripDebugInfo;
@@ -754,6 +784,31 @@ bool CSettings::getTripleBuffering() const
     return m_tripleBuffering;
 }
 
+/************************************************************************
+*    DESC:  Number of captured frames that can wait to be recorded and submitted
+*           Zero records and submits on the render thread
+************************************************************************/
+int CSettings::getFramePipelineDepth() const
+{
+    return m_framePipelineDepth;
+}
+
+/************************************************************************
+*    DESC:  Starting size of each frame's uniform ring buffer in bytes
+************************************************************************/
+uint32_t CSettings::getUniformRingSize() const
+{
+    return m_uniformRingSize;
+}
+
+/************************************************************************
+*    DESC:  Get the pipeline cache file name. Empty if the cache is disabled
+************************************************************************/
+const std::string & CSettings::getPipelineCacheFile() const
+{
+    return m_pipelineCacheFile;
+}
+
 /************************************************************************
 *    DESC:  Save the settings file
 ************************************************************************/
@@ -14,6 +14,7 @@
 
 // Standard lib dependencies
 #include <string>
+#include <cstdint>
 
 class CSettings
 {
@@ -113,6 +114,7 @@ public:
     const std::string & getScriptMain() const;
     bool getSaveByteCode() const;
     bool getLoadByteCode() const;
+    bool getByteCodeCache() const;
     bool getStripDebugInfo() const;
     
     // Get the sound frequency
@@ -156,6 +158,15 @@ public:
     // Do we want tripple buffering?
     bool getTripleBuffering() const;
 
+    // Number of captured frames that can wait to be recorded and submitted
+    int getFramePipelineDepth() const;
+
+    // Starting size of each frame's uniform ring buffer in bytes
+    uint32_t getUniformRingSize() const;
+
+    // Get the pipeline cache file name. Empty if the cache is disabled
+    const std::string & getPipelineCacheFile() const;
+
 private:
 
     // Constructor
@@ -268,6 +279,15 @@ private:
     
     // Triple buffering flag
     bool m_tripleBuffering;
+
+    // Number of captured frames that can wait to be recorded and submitted. Zero records and submits on the render thread
+    int m_framePipelineDepth;
+
+    // Starting size of each frame's uniform ring buffer in bytes. The device grows it as needed
+    uint32_t m_uniformRingSize;
+
+    // Pipeline cache file name. Saved in the user's preference path
+    std::string m_pipelineCacheFile;
     
     // Scripting string members
     std::string m_scriptListTable;
@@ -275,5 +295,8 @@ private:
     std::string m_scriptMain;
     bool m_saveByteCode;
     bool m_loadByteCode;
+
+    // Cache the byte code and rebuild it when the scripts or the engine interface change
+    bool m_byteCodeCache;
     bool m_stripDebugInfo;
 };
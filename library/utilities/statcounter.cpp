@@ -15,16 +15,28 @@
 // Boost lib dependencies
 #include <boost/format.hpp>
 
+thread_local int CStatCounter::m_transVisitLocal = 0;
+thread_local int CStatCounter::m_transRecompLocal = 0;
+
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
 CStatCounter::CStatCounter() :
     m_vObjCounter(0),
+    m_batchCounter(0),
+    m_batchSpriteCounter(0),
+    m_inViewCounter(0),
+    m_culledCounter(0),
+    m_transVisitCounter(0),
+    m_transRecompCounter(0),
     m_physicsObjCounter(0),
     m_elapsedFPSCounter(0),
     m_cycleCounter(0),
     m_poolContexCounter(0),
     m_activeContexCounter(0),
+    m_scriptLoadTime(0),
+    m_activeDescSetCounter(0),
+    m_descSetCapacityCounter(0),
     m_statsDisplayTimer(2000)
 {
     resetCounters();
@@ -68,6 +80,9 @@ void CStatCounter::incCycle()
     // each game loop cycle
     m_elapsedFPSCounter += CHighResTimer::Instance().getFPS();
 
+    // Pick up the transforms done on this thread since the last publish
+    publishTransformCounters();
+
     ++m_cycleCounter;
 
     // update the stats every 1000 miliseconds
@@ -88,6 +103,12 @@ void CStatCounter::incCycle()
 void CStatCounter::resetCounters()
 {
     m_vObjCounter = 0;
+    m_batchCounter = 0;
+    m_batchSpriteCounter = 0;
+    m_inViewCounter = 0;
+    m_culledCounter = 0;
+    m_transVisitCounter = 0;
+    m_transRecompCounter = 0;
     m_physicsObjCounter = 0;
     m_elapsedFPSCounter = 0.0;
     m_cycleCounter = 0;
@@ -99,12 +120,21 @@ void CStatCounter::resetCounters()
 ************************************************************************/
 void CStatCounter::formatStatString()
 {
-    m_statStr = boost::str( boost::format("fps: %d - sca: %d - scp: %d - vis: %d - phy: %d - res: %d x %d")
+    m_statStr = boost::str( boost::format("fps: %d - sca: %d - scp: %d - vis: %d - bat: %d - bsp: %d - inv: %d - cul: %d - trv: %d - trc: %d - dsc: %d/%d - phy: %d - sld: %.1fms - res: %d x %d")
         % ((int)(m_elapsedFPSCounter / (double)m_cycleCounter))
-        % m_activeContexCounter
-        % m_poolContexCounter
+        % m_activeContexCounter.load()
+        % m_poolContexCounter.load()
         % (m_vObjCounter / m_cycleCounter)
+        % (m_batchCounter / m_cycleCounter)
+        % (m_batchSpriteCounter / m_cycleCounter)
+        % (m_inViewCounter / m_cycleCounter)
+        % (m_culledCounter / m_cycleCounter)
+        % (m_transVisitCounter / m_cycleCounter)
+        % (m_transRecompCounter / m_cycleCounter)
+        % m_activeDescSetCounter
+        % m_descSetCapacityCounter
         % (m_physicsObjCounter / m_cycleCounter)
+        % m_scriptLoadTime
         % CSettings::Instance().getSize().w
         % CSettings::Instance().getSize().h
         //% (playerPos.x)
@@ -122,6 +152,44 @@ void CStatCounter::incDisplayCounter( int value )
 }
 
 
+/************************************************************************
+*    DESC:  Inc the instanced batch counter
+************************************************************************/
+void CStatCounter::incBatchCounter( int spriteCount )
+{
+    ++m_batchCounter;
+    m_batchSpriteCounter += spriteCount;
+}
+
+
+/************************************************************************
+*    DESC:  Inc the counters of nodes that passed and failed camera culling
+************************************************************************/
+void CStatCounter::incCullCounters( int visible, int culled )
+{
+    m_inViewCounter += visible;
+    m_culledCounter += culled;
+}
+
+
+/************************************************************************
+*    DESC:  Add the transforms counted on this thread to the frame counters
+*
+*    NOTE:  Called once per transform pass or per chunk of a parallel pass
+************************************************************************/
+void CStatCounter::publishTransformCounters()
+{
+    if( m_transVisitLocal > 0 )
+    {
+        m_transVisitCounter += m_transVisitLocal;
+        m_transRecompCounter += m_transRecompLocal;
+
+        m_transVisitLocal = 0;
+        m_transRecompLocal = 0;
+    }
+}
+
+
 /************************************************************************
 *    DESC:  Inc the physics objects counter
 ************************************************************************/
@@ -147,3 +215,20 @@ void CStatCounter::setActiveContexCounter( int value )
 {
     m_activeContexCounter = value;
 }
+
+/************************************************************************
+*    DESC:  Add the time it took to load a script group
+************************************************************************/
+void CStatCounter::addScriptLoadTime( float milliseconds )
+{
+    m_scriptLoadTime += milliseconds;
+}
+
+/************************************************************************
+*    DESC:  Set the descriptor set pool occupancy counters
+************************************************************************/
+void CStatCounter::setDescriptorSetCounters( int active, int capacity )
+{
+    m_activeDescSetCounter = active;
+    m_descSetCapacityCounter = capacity;
+}
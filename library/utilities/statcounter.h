@@ -14,6 +14,7 @@
 
 // Standard lib dependencies
 #include <string>
+#include <atomic>
 
 class CStatCounter
 {
@@ -34,6 +35,23 @@ public:
 
     // Inc the display counter
     void incDisplayCounter( int value = 1 );
+
+    // Inc the instanced batch counter
+    void incBatchCounter( int spriteCount );
+
+    // Inc the counters of nodes that passed and failed camera culling
+    void incCullCounters( int visible, int culled );
+
+    // Count an object visited by the transform on this thread
+    // NOTE: Only added to the frame counters by publishTransformCounters
+    void countTransform( bool recomputed )
+    {
+        ++m_transVisitLocal;
+        m_transRecompLocal += recomputed;
+    }
+
+    // Add the transforms counted on this thread to the frame counters
+    void publishTransformCounters();
     
     // Inc the physics objects counter
     void incPhysicsObjectsCounter();
@@ -41,6 +59,12 @@ public:
     // Set the contex counters
     void setPoolContexCounter( size_t value );
     void setActiveContexCounter( int value );
+
+    // Add the time it took to load a script group
+    void addScriptLoadTime( float milliseconds );
+
+    // Set the descriptor set pool occupancy counters
+    void setDescriptorSetCounters( int active, int capacity );
     
     // Connect/Disconnect to the signal
     void connect( const statCounterSignal_t::slot_type & slot );
@@ -60,10 +84,29 @@ private:
 private:
 
     // Counter for visual objects
-    int m_vObjCounter;
+    // NOTE: Atomic because command buffers are recorded from multiple threads
+    std::atomic_int m_vObjCounter;
+
+    // Counters for instanced batches and the sprites drawn by them
+    std::atomic_int m_batchCounter;
+    std::atomic_int m_batchSpriteCounter;
+
+    // Counters for nodes that passed and failed camera culling
+    std::atomic_int m_inViewCounter;
+    std::atomic_int m_culledCounter;
+
+    // Counters for objects visited and recomputed by the transform
+    std::atomic_int m_transVisitCounter;
+    std::atomic_int m_transRecompCounter;
+
+    // Transforms counted on this thread and not yet published
+    // NOTE: Per thread so the transform doesn't do an atomic add per object
+    static thread_local int m_transVisitLocal;
+    static thread_local int m_transRecompLocal;
     
     // Counter for physics objects
-    int m_physicsObjCounter;
+    // NOTE: Atomic because sprites can be updated from the script lanes
+    std::atomic_int m_physicsObjCounter;
 
     // Elapsed time counter
     double m_elapsedFPSCounter;
@@ -72,8 +115,15 @@ private:
     uint m_cycleCounter;
 
     // Angle Script contex counter
-    size_t m_poolContexCounter;
-    int m_activeContexCounter;
+    std::atomic_size_t m_poolContexCounter;
+    std::atomic_int m_activeContexCounter;
+
+    // Total time spent loading script groups. This counter is never reset
+    float m_scriptLoadTime;
+
+    // Descriptor sets in use and the total the pools can hold
+    int m_activeDescSetCounter;
+    int m_descSetCapacityCounter;
 
     // Stat string
     std::string m_statStr;
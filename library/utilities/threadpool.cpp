@@ -2,7 +2,7 @@
 /************************************************************************
 *    FILE NAME:       threadpool.cpp
 *
-*    DESCRIPTION:     Class to manage a thread pool
+*    DESCRIPTION:     Class to manage a work stealing thread pool
 ************************************************************************/
 
 // Physical component dependency
@@ -15,10 +15,16 @@
 // Boost lib dependencies
 #include <boost/format.hpp>
 
+thread_local int CThreadPool::m_workerIndex = -1;
+thread_local bool CThreadPool::m_inBackgroundJob = false;
+
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
 CThreadPool::CThreadPool() :
+    m_nextQueue(0),
+    m_pendingJobs(0),
+    m_pendingBackgroundJobs(0),
     m_stop(false)
 {
 }
@@ -93,40 +99,224 @@ void CThreadPool::init( const int minThreads, const int maxThreads )
             % threads ));
 
     m_threadVec.reserve( threads );
+    m_queueVec.reserve( threads );
+
+    // Each worker gets it's own job queue
+    for( int i = 0; i < threads; ++i )
+        m_queueVec.emplace_back( std::make_unique<CJobQueue>( QUEUE_CAPACITY ) );
 
     // create all the threads for the pool
     for( int i = 0; i < threads; ++i )
+        m_threadVec.emplace_back( &CThreadPool::workerLoop, this, i );
+    #endif
+}
+
+/************************************************************************
+*    DESC:  The worker thread loop
+************************************************************************/
+void CThreadPool::workerLoop( int workerIndex )
+{
+    m_workerIndex = workerIndex;
+
+    CJob job;
+
+    for(;;)
     {
-        m_threadVec.emplace_back(
-            [this] {
-                for (;;)
-                {
-                    std::function<void() > task;
+        // Run jobs from our own queue first then try stealing from the others
+        if( findJob( job ) )
+        {
+            job();
+            continue;
+        }
 
-                    {
-                        // Locks this whole section with a mutex
-                        std::unique_lock<std::mutex> lock(this->m_queue_mutex);
+        // Frame jobs are done so pick up a long running one
+        if( findBackgroundJob( job ) )
+        {
+            runBackgroundJob( job );
+            continue;
+        }
 
-                        // Wait here until the task queue is not empty or we need to stop the thread pool
-                        this->m_condition.wait(lock,
-                            [this] { return this->m_stop || !this->m_tasks.empty(); });
+        // Get out now if we are to stop and there's no more work
+        if( m_stop )
+            return;
 
-                        // Get out now if we are to stop and the task queue is empty
-                        if (this->m_stop && this->m_tasks.empty())
-                            return;
+        // Sleep until there's work to do or we need to stop the thread pool
+        std::unique_lock<std::mutex> lock( m_sleepMutex );
+        m_condition.wait( lock,
+            [this] { return m_stop ||
+                (m_pendingJobs.load( std::memory_order_acquire ) > 0) ||
+                (m_pendingBackgroundJobs.load( std::memory_order_acquire ) > 0); });
+    }
+}
 
-                        // Get the top most task and pop it from the queue to be executed
-                        task = std::move(this->m_tasks.front());
-                        this->m_tasks.pop();
-                    }
+/************************************************************************
+*    DESC:  Add the job to a queue
+************************************************************************/
+void CThreadPool::postJob( CJob && job )
+{
+    // No workers so just do the job now
+    if( m_queueVec.empty() )
+    {
+        job();
+        return;
+    }
 
-                    // Execute the task
-                    task();
-                }
-            }
-        );
+    // Jobs split off of a long running job stay out of reach of the frame waits
+    if( m_inBackgroundJob )
+    {
+        postBackgroundJob( std::move(job) );
+        return;
+    }
+
+    // Workers post to their own queue. Other threads spread the jobs around.
+    int index = m_workerIndex;
+    if( index < 0 )
+        index = m_nextQueue.fetch_add( 1, std::memory_order_relaxed ) % m_queueVec.size();
+
+    // If the queue is full, just do the job now
+    if( !m_queueVec[index]->push( std::move(job) ) )
+    {
+        job();
+        return;
+    }
+
+    m_pendingJobs.fetch_add( 1, std::memory_order_release );
+
+    // Lock and release to make sure a worker about to sleep doesn't miss the notify
+    {
+        std::unique_lock<std::mutex> lock( m_sleepMutex );
+    }
+
+    m_condition.notify_one();
+}
+
+/************************************************************************
+*    DESC:  Add the job to the background queue
+************************************************************************/
+void CThreadPool::postBackgroundJob( CJob && job )
+{
+    // No workers so just do the job now
+    if( m_queueVec.empty() )
+    {
+        runBackgroundJob( job );
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock( m_backgroundMutex );
+        m_backgroundJobDeq.emplace_back( std::move(job) );
+    }
+
+    m_pendingBackgroundJobs.fetch_add( 1, std::memory_order_release );
+
+    // Lock and release to make sure a worker about to sleep doesn't miss the notify
+    {
+        std::unique_lock<std::mutex> lock( m_sleepMutex );
+    }
+
+    m_condition.notify_one();
+}
+
+/************************************************************************
+*    DESC:  Find a job from this threads queue or steal one from another
+************************************************************************/
+bool CThreadPool::findJob( CJob & job )
+{
+    if( m_pendingJobs.load( std::memory_order_acquire ) <= 0 )
+        return false;
+
+    const int queueCount = m_queueVec.size();
+    const int workerIndex = m_workerIndex;
+
+    if( (workerIndex > -1) && m_queueVec[workerIndex]->pop( job ) )
+    {
+        m_pendingJobs.fetch_sub( 1, std::memory_order_relaxed );
+        return true;
+    }
+
+    // Start stealing from the queue next to ours so workers don't all hit the same one
+    const int start = (workerIndex > -1) ? workerIndex + 1 : 0;
+
+    for( int i = 0; i < queueCount; ++i )
+    {
+        const int index = (start + i) % queueCount;
+
+        if( (index != workerIndex) && m_queueVec[index]->steal( job ) )
+        {
+            m_pendingJobs.fetch_sub( 1, std::memory_order_relaxed );
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/************************************************************************
+*    DESC:  Take the oldest job from the background queue
+************************************************************************/
+bool CThreadPool::findBackgroundJob( CJob & job )
+{
+    if( m_pendingBackgroundJobs.load( std::memory_order_acquire ) <= 0 )
+        return false;
+
+    std::unique_lock<std::mutex> lock( m_backgroundMutex );
+
+    if( m_backgroundJobDeq.empty() )
+        return false;
+
+    job = std::move( m_backgroundJobDeq.front() );
+    m_backgroundJobDeq.pop_front();
+    m_pendingBackgroundJobs.fetch_sub( 1, std::memory_order_relaxed );
+
+    return true;
+}
+
+/************************************************************************
+*    DESC:  Run a background job. Anything it posts goes to the background queue.
+************************************************************************/
+void CThreadPool::runBackgroundJob( CJob & job )
+{
+    const bool inBackgroundJob = m_inBackgroundJob;
+    m_inBackgroundJob = true;
+
+    try
+    {
+        job();
+    }
+    catch( ... )
+    {
+        m_inBackgroundJob = inBackgroundJob;
+        throw;
+    }
+
+    m_inBackgroundJob = inBackgroundJob;
+}
+
+/************************************************************************
+*    DESC:  Wait for the jobs of this counter to complete
+*           The calling thread runs queued jobs while waiting
+*
+*    NOTE:  Only a thread that is running a background job helps with the
+*           background queue. The jobs it waits on were posted there and a
+*           frame wait must never pick up a whole group load.
+************************************************************************/
+void CThreadPool::wait( CJobCounter & counter )
+{
+    #if !defined(__thread_disable__)
+    CJob job;
+
+    while( !counter.isDone() )
+    {
+        if( findJob( job ) )
+            job();
+        else if( m_inBackgroundJob && findBackgroundJob( job ) )
+            runBackgroundJob( job );
+        else
+            std::this_thread::yield();
     }
     #endif
+
+    counter.rethrow();
 }
 
 /************************************************************************
@@ -158,7 +348,7 @@ void CThreadPool::stop()
     {
         #if !defined(__thread_disable__)
         {
-            std::unique_lock<std::mutex> lock( m_queue_mutex );
+            std::unique_lock<std::mutex> lock( m_sleepMutex );
             m_stop = true;
         }
 
@@ -168,7 +358,14 @@ void CThreadPool::stop()
             iter.join();
         #endif
 
-        m_tasks = std::queue< std::function<void()> >();
+        for( auto & iter : m_queueVec )
+            iter->clear();
+
+        m_backgroundJobDeq.clear();
+
+        m_pendingJobs = 0;
+        m_pendingBackgroundJobs = 0;
+        m_queueVec.clear();
         m_threadVec.clear();
     }
 }
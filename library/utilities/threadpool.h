@@ -1,36 +1,43 @@
-
 /************************************************************************
 *    FILE NAME:       threadpool.h
 *
-*    DESCRIPTION:     Class to manage a thread pool
+*    DESCRIPTION:     Class to manage a work stealing thread pool
 ************************************************************************/
 
 /* Implementation example
 int main()
 {
-    std::vector< std::future<void> > jobs;
-    
-    auto & mutex = CThreadPool::Instance().getMutex();
     CThreadPool::Instance().init( 2, 4 );
-    
+
+    // Fork-join using a job counter. No allocations are made posting these jobs.
+    CJobCounter counter;
+
     for( int i = 0; i < 8; ++i )
     {
-        jobs.emplace_back(
-            CThreadPool::Instance().postRetFut([&mutex] {
-                
-                std::this_thread::sleep_for(std::chrono::seconds(1));
-                
-                std::unique_lock<std::mutex> lock( mutex );
-                std::cout << "Task finished in thread: " << std::this_thread::get_id() << std::endl;
-            })
-        );
+        CThreadPool::Instance().post( counter, [i] {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        });
     }
 
-    std::this_thread::sleep_for(std::chrono::seconds(2));
+    // Wait for all the jobs to finish. The waiting thread helps run jobs.
+    CThreadPool::Instance().wait( counter );
+
+    // Split a range into chunks that are run in parallel
+    std::vector<float> dataVec( 10000 );
+    CThreadPool::Instance().parallelFor( dataVec.size(), 256,
+        [&dataVec]( size_t begin, size_t end ) {
+            for( size_t i = begin; i < end; ++i )
+                dataVec[i] *= 2.f;
+        });
+
+    // Post to the work queue and return future
+    auto future = CThreadPool::Instance().post([] { return 42; });
+    future.get();
 
-    // Wait for all the jobs to finish
-    // get() is a blocking call, waiting for each job to return
-    for( auto && iter : jobs ) iter.get();
+    // Long running jobs go to the background queue so a thread waiting on
+    // frame jobs never picks them up. Jobs they post are background jobs too.
+    auto loadFuture = CThreadPool::Instance().postBackground([] { return 42; });
+    loadFuture.get();
 
     return 0;
 }
@@ -38,9 +45,12 @@ int main()
 
 #pragma once
 
+// Game lib dependencies
+#include <utilities/job.h>
+#include <utilities/jobqueue.h>
+
 // Standard lib dependencies
 #include <vector>
-#include <queue>
 #include <thread>
 #include <memory>
 #include <mutex>
@@ -49,6 +59,7 @@ int main()
 #include <stdexcept>
 #include <future>
 #include <atomic>
+#include <deque>
 
 // Thread disable flag for testing purposes
 //#define __thread_disable__
@@ -56,7 +67,7 @@ int main()
 class CThreadPool
 {
 public:
-    
+
     static CThreadPool & Instance()
     {
         static CThreadPool threadPool;
@@ -64,25 +75,41 @@ public:
     }
 
     // Post to the work queue and return future
+    // NOTE: Allocates a shared task and future. Use the counter version for per frame jobs.
     template<typename F, typename... Args>
     auto post(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>>;
-    
+
+    // Post a job to the work queue that signals the counter when done
+    template<typename F>
+    void post( CJobCounter & counter, F && func );
+
+    // Post a long running job to the background queue and return future
+    // NOTE: Background jobs are only run by the workers, never by a thread waiting on frame jobs
+    template<typename F, typename... Args>
+    auto postBackground(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>>;
+
+    // Split the range into chunks of grain size and run them in parallel. Blocks until done.
+    // The function signature is void( size_t begin, size_t end )
+    template<typename F>
+    void parallelFor( size_t count, size_t grainSize, F && func );
+
     // Thread pool init
     void init( const int minThreads, const int maxThreads );
-    
-    // Wait for the jobs to complete
-    // NOTE: Only works when the futures are stored internally
-    void wait();
-    
+
+    // Wait for the jobs of this counter to complete
+    // NOTE: The calling thread runs queued jobs while waiting. Background jobs are
+    //       only picked up if the calling thread is itself running a background job.
+    void wait( CJobCounter & counter );
+
     // Lock mutex for Synchronization
     void lock();
-    
+
     // Unlock mutex for Synchronization
     void unlock();
 
     // Stop the thread pool
     void stop();
-    
+
     // Get the mutex
     std::mutex & getMutex();
 
@@ -93,28 +120,66 @@ public:
     bool isActive();
 
 private:
-    
+
     // Constructor
     CThreadPool();
-    
+
     // Destructor
     ~CThreadPool();
-    
+
+    // Add the job to a queue
+    void postJob( CJob && job );
+
+    // Add the job to the background queue
+    void postBackgroundJob( CJob && job );
+
+    // Find a job from this threads queue or steal one from another
+    bool findJob( CJob & job );
+
+    // Take the oldest job from the background queue
+    bool findBackgroundJob( CJob & job );
+
+    // Run a background job. Anything it posts goes to the background queue.
+    void runBackgroundJob( CJob & job );
+
+    // The worker thread loop
+    void workerLoop( int workerIndex );
+
 private:
-    
+
+    // Max jobs each worker queue can hold before jobs are run by the posting thread
+    static constexpr size_t QUEUE_CAPACITY = 1024;
+
     // need to keep track of threads so we can join them
     std::vector< std::thread> m_threadVec;
-    
-    // the task queue
-    std::queue< std::function<void()> > m_tasks;
+
+    // A job queue per worker
+    std::vector< std::unique_ptr<CJobQueue> > m_queueVec;
+
+    // Queue index for jobs posted from outside of the pool
+    std::atomic_uint m_nextQueue;
+
+    // Number of jobs waiting in the queues
+    std::atomic_int m_pendingJobs;
+
+    // Long running jobs. Only taken by the workers and other background jobs
+    std::deque<CJob> m_backgroundJobDeq;
+    std::mutex m_backgroundMutex;
+    std::atomic_int m_pendingBackgroundJobs;
 
     // synchronization
-    std::mutex m_queue_mutex;
+    std::mutex m_sleepMutex;
     std::mutex m_mutex;
     std::condition_variable m_condition;
-    
+
     // Thread pool stop flag
     std::atomic_bool m_stop;
+
+    // Index of the worker running on this thread. -1 if not a worker
+    static thread_local int m_workerIndex;
+
+    // Is this thread running a background job
+    static thread_local bool m_inBackgroundJob;
 };
 
 /************************************************************************
@@ -124,7 +189,7 @@ template<typename F, typename... Args>
 auto CThreadPool::post(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>>
 {
     using return_type = std::invoke_result_t<F, Args...>;
-    
+
     auto task = std::make_shared < std::packaged_task < return_type()> >(
         std::bind(std::forward<F>(f), std::forward<Args>(args)...) );
 
@@ -133,20 +198,92 @@ auto CThreadPool::post(F&& f, Args&&... args) -> std::future<std::invoke_result_
     #if defined(__thread_disable__)
     (*task)();
     #else
-    {
-        std::unique_lock<std::mutex> lock(m_queue_mutex);
+    // don't allow enqueueing after stopping the pool
+    if( m_stop )
+        throw std::runtime_error("enqueue on stopped ThreadPool");
 
-        // don't allow enqueueing after stopping the pool
-        if( m_stop )
-            throw std::runtime_error("enqueue on stopped ThreadPool");
+    postJob( CJob( [task]() { (*task)(); }, nullptr ) );
+    #endif
 
-        m_tasks.emplace([task]() {
-            (*task)(); });
-    }
-    
-    m_condition.notify_one();
-    
+    return res;
+}
+
+/************************************************************************
+*    desc:  Post a job to the work queue that signals the counter when done
+************************************************************************/
+template<typename F>
+void CThreadPool::post( CJobCounter & counter, F && func )
+{
+    counter.inc();
+
+    CJob job( std::forward<F>(func), &counter );
+
+    #if defined(__thread_disable__)
+    job();
+    #else
+    if( m_stop )
+        job();
+    else
+        postJob( std::move(job) );
+    #endif
+}
+
+/************************************************************************
+*    desc:  Post a long running job to the background queue and return future
+************************************************************************/
+template<typename F, typename... Args>
+auto CThreadPool::postBackground(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>>
+{
+    using return_type = std::invoke_result_t<F, Args...>;
+
+    auto task = std::make_shared < std::packaged_task < return_type()> >(
+        std::bind(std::forward<F>(f), std::forward<Args>(args)...) );
+
+    std::future<return_type> res = task->get_future();
+
+    #if defined(__thread_disable__)
+    (*task)();
+    #else
+    if( m_stop )
+        throw std::runtime_error("enqueue on stopped ThreadPool");
+
+    postBackgroundJob( CJob( [task]() { (*task)(); }, nullptr ) );
     #endif
 
     return res;
 }
+
+/************************************************************************
+*    desc:  Split the range into chunks of grain size and run them in parallel
+************************************************************************/
+template<typename F>
+void CThreadPool::parallelFor( size_t count, size_t grainSize, F && func )
+{
+    if( grainSize == 0 )
+        grainSize = 1;
+
+    CJobCounter counter;
+    size_t begin = 0;
+
+    // Post all but the last chunk. The calling thread does the last one.
+    while( count - begin > grainSize )
+    {
+        const size_t end = begin + grainSize;
+        post( counter, [&func, begin, end]() { func( begin, end ); } );
+        begin = end;
+    }
+
+    if( begin < count )
+    {
+        try
+        {
+            func( begin, count );
+        }
+        catch( ... )
+        {
+            counter.setException( std::current_exception() );
+        }
+    }
+
+    wait( counter );
+}
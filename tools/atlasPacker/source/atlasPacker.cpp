@@ -0,0 +1,513 @@
+
+/************************************************************************
+*    FILE NAME:       atlasPacker.cpp
+*
+*    DESCRIPTION:     Packs the textures of the quads of an object data
+*                     group into a few atlases. Writes the atlas images
+*                     and the XML of the regions the engine loads when
+*                     the group's list table entry has the textureAtlas
+*                     attribute
+*
+*    NOTE:            Only quads using the default sampler are packed.
+*                     Textures with sampler or mip settings keep their
+*                     own image
+************************************************************************/
+
+// Game lib dependencies
+#include <utilities/xmlParser.h>
+#include <utilities/exceptionhandling.h>
+#include <soil/SOIL.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
+
+// Standard lib dependencies
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <fstream>
+#include <algorithm>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+/************************************************************************
+*    Texture to pack
+************************************************************************/
+class CPackImage
+{
+public:
+
+    std::string filePath;
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> pixelVec;
+
+    // Atlas it was packed into and its position. Atlas is -1 if it didn't fit
+    int atlas = -1;
+    int x = 0;
+    int y = 0;
+};
+
+/************************************************************************
+*    Atlas being packed. Filled in rows of images sorted by height.
+************************************************************************/
+class CPackAtlas
+{
+public:
+
+    int width = 0;
+    int height = 0;
+
+    // Current row
+    int rowX = 0;
+    int rowY = 0;
+    int rowHeight = 0;
+
+    // Area of the images packed into it
+    int64_t regionArea = 0;
+
+    std::vector<uint8_t> pixelVec;
+};
+
+/************************************************************************
+*    DESC:  Get the attributes of a node
+************************************************************************/
+void GetAttributes( const XMLNode & node, std::map<std::string, std::string> & rAttrMap )
+{
+    if( !node.isEmpty() )
+        for( int i = 0; i < node.nAttribute(); ++i )
+            rAttrMap[ node.getAttributeName(i) ] = node.getAttributeValue(i);
+}
+
+/************************************************************************
+*    DESC:  Get the attributes of the visual data the same way the engine
+*           does, the object's attributes on top of the defaults
+************************************************************************/
+void GetVisualAttributes(
+    const XMLNode & objectNode,
+    std::map<std::string, std::string> & rMeshAttrMap,
+    std::map<std::string, std::string> & rTextureAttrMap )
+{
+    const XMLNode visualNode = objectNode.getChildNode( "visual" );
+    if( !visualNode.isEmpty() )
+    {
+        GetAttributes( visualNode.getChildNode( "mesh" ), rMeshAttrMap );
+        GetAttributes( visualNode.getChildNode( "texture" ), rTextureAttrMap );
+    }
+}
+
+/************************************************************************
+*    DESC:  Collect the textures of the quads using the default sampler
+************************************************************************/
+void CollectTextures( const fs::path & gamePath, const std::string & filePath, std::set<std::string> & rTextureSet, int & rSkipCount )
+{
+    const XMLNode mainNode = XMLNode::openFileHelper( (gamePath / filePath).string().c_str(), "objectDataList2D" );
+
+    std::map<std::string, std::string> defMeshAttrMap;
+    std::map<std::string, std::string> defTextureAttrMap;
+    GetVisualAttributes( mainNode.getChildNode( "default" ), defMeshAttrMap, defTextureAttrMap );
+
+    const XMLNode objectListNode = mainNode.getChildNode( "objectList" );
+
+    for( int i = 0; i < objectListNode.nChildNode(); ++i )
+    {
+        std::map<std::string, std::string> meshAttrMap( defMeshAttrMap );
+        std::map<std::string, std::string> textureAttrMap( defTextureAttrMap );
+        GetVisualAttributes( objectListNode.getChildNode(i), meshAttrMap, textureAttrMap );
+
+        if( (meshAttrMap["genType"] != "quad") || textureAttrMap["file"].empty() )
+            continue;
+
+        // Any other texture attribute changes the sampler
+        bool defaultSampler(true);
+        for( auto & iter : textureAttrMap )
+            if( (iter.first != "file") && (iter.first != "count") )
+                defaultSampler = false;
+
+        if( !defaultSampler )
+        {
+            ++rSkipCount;
+            continue;
+        }
+
+        const std::string & textureFilePath = textureAttrMap["file"];
+        const int count = std::atoi( textureAttrMap["count"].c_str() );
+
+        if( count > 0 )
+        {
+            for( int j = 0; j < count; ++j )
+                rTextureSet.insert( boost::str( boost::format(textureFilePath) % j ) );
+        }
+        else
+        {
+            rTextureSet.insert( textureFilePath );
+        }
+    }
+}
+
+/************************************************************************
+*    DESC:  Get the file list of the group from the list table
+************************************************************************/
+std::vector<std::string> GetGroupFileList( const fs::path & gamePath, const std::string & listTablePath, const std::string & group )
+{
+    const XMLNode node = XMLNode::openFileHelper( (gamePath / listTablePath).string().c_str(), "listTable" );
+
+    for( int i = 0; i < node.nChildNode("groupList"); ++i )
+    {
+        const XMLNode groupListNode = node.getChildNode( "groupList", i );
+
+        if( group == groupListNode.getAttribute( "groupName" ) )
+        {
+            std::vector<std::string> fileVec;
+
+            for( int j = 0; j < groupListNode.nChildNode("file"); ++j )
+                fileVec.push_back( groupListNode.getChildNode( "file", j ).getAttribute( "path" ) );
+
+            return fileVec;
+        }
+    }
+
+    throw NExcept::CCriticalException( "Atlas Packer Error!", "Group not found in list table: " + group );
+}
+
+/************************************************************************
+*    DESC:  Get the next power of two
+************************************************************************/
+int NextPow2( int value )
+{
+    int result = 1;
+    while( result < value )
+        result <<= 1;
+
+    return result;
+}
+
+/************************************************************************
+*    DESC:  Find a spot for the image in the atlas
+************************************************************************/
+bool PlaceImage( CPackAtlas & atlas, int width, int height, int & x, int & y )
+{
+    // Fits at the end of the current row
+    if( ((atlas.rowX + width) <= atlas.width) && ((atlas.rowY + height) <= atlas.height) )
+    {
+        x = atlas.rowX;
+        y = atlas.rowY;
+
+        atlas.rowX += width;
+        atlas.rowHeight = std::max( atlas.rowHeight, height );
+
+        return true;
+    }
+
+    // Start a new row below. The current row is only closed if the image fits there
+    if( (width <= atlas.width) && ((atlas.rowY + atlas.rowHeight + height) <= atlas.height) )
+    {
+        atlas.rowY += atlas.rowHeight;
+        atlas.rowHeight = height;
+        atlas.rowX = width;
+
+        x = 0;
+        y = atlas.rowY;
+
+        return true;
+    }
+
+    return false;
+}
+
+/************************************************************************
+*    DESC:  Pack the images into atlases of the given width
+*           The atlases are trimmed to the power of two that fits the
+*           images placed in them
+************************************************************************/
+std::vector<CPackAtlas> PackImages( std::vector<CPackImage> & imageVec, int atlasWidth, int maxSize, int padding )
+{
+    std::vector<CPackAtlas> atlasVec;
+
+    for( auto & iter : imageVec )
+    {
+        iter.atlas = -1;
+
+        const int paddedW = iter.width + (padding * 2);
+        const int paddedH = iter.height + (padding * 2);
+
+        // Images too large for the atlas keep their own texture
+        if( (paddedW > atlasWidth) || (paddedH > maxSize) )
+            continue;
+
+        int x(0), y(0);
+        for( size_t i = 0; (i < atlasVec.size()) && (iter.atlas < 0); ++i )
+            if( PlaceImage( atlasVec[i], paddedW, paddedH, x, y ) )
+                iter.atlas = i;
+
+        if( iter.atlas < 0 )
+        {
+            CPackAtlas atlas;
+            atlas.width = atlasWidth;
+            atlas.height = maxSize;
+            atlasVec.push_back( atlas );
+
+            PlaceImage( atlasVec.back(), paddedW, paddedH, x, y );
+            iter.atlas = atlasVec.size() - 1;
+        }
+
+        iter.x = x + padding;
+        iter.y = y + padding;
+        atlasVec[iter.atlas].regionArea += (int64_t)iter.width * iter.height;
+    }
+
+    // Trim the atlases to the used area
+    std::vector<int> usedWidthVec( atlasVec.size(), 0 );
+    for( auto & iter : imageVec )
+        if( iter.atlas >= 0 )
+            usedWidthVec[iter.atlas] = std::max( usedWidthVec[iter.atlas], iter.x + iter.width + padding );
+
+    for( size_t i = 0; i < atlasVec.size(); ++i )
+    {
+        atlasVec[i].width = NextPow2( usedWidthVec[i] );
+        atlasVec[i].height = NextPow2( atlasVec[i].rowY + atlasVec[i].rowHeight );
+    }
+
+    return atlasVec;
+}
+
+/************************************************************************
+*    DESC:  Get the total area of the atlases
+************************************************************************/
+int64_t GetAtlasArea( const std::vector<CPackAtlas> & atlasVec )
+{
+    int64_t area(0);
+    for( auto & iter : atlasVec )
+        area += (int64_t)iter.width * iter.height;
+
+    return area;
+}
+
+/************************************************************************
+*    DESC:  Copy the image into the atlas
+*           The edge pixels are extruded into the padding so filtering
+*           at the edge of the region doesn't pick up the neighbours
+************************************************************************/
+void CopyImage( CPackAtlas & atlas, const CPackImage & image, int padding )
+{
+    for( int y = -padding; y < (image.height + padding); ++y )
+    {
+        const int srcY = std::clamp( y, 0, image.height - 1 );
+        const int dstY = image.y + y;
+
+        for( int x = -padding; x < (image.width + padding); ++x )
+        {
+            const int srcX = std::clamp( x, 0, image.width - 1 );
+            const int dstX = image.x + x;
+
+            std::memcpy(
+                &atlas.pixelVec[((dstY * atlas.width) + dstX) * 4],
+                &image.pixelVec[((srcY * image.width) + srcX) * 4],
+                4 );
+        }
+    }
+}
+
+/************************************************************************
+*    DESC:  The main function
+************************************************************************/
+int main( int argc, char * argv[] )
+{
+    std::vector<std::string> argVec;
+    int maxSize(2048);
+    int padding(2);
+
+    for( int i = 1; i < argc; ++i )
+    {
+        if( (std::strcmp( argv[i], "--max-size" ) == 0) && ((i + 1) < argc) )
+            maxSize = std::atoi( argv[++i] );
+        else if( (std::strcmp( argv[i], "--padding" ) == 0) && ((i + 1) < argc) )
+            padding = std::atoi( argv[++i] );
+        else
+            argVec.push_back( argv[i] );
+    }
+
+    if( (argVec.size() != 4) || (maxSize <= 0) || (padding < 0) )
+    {
+        printf( "Usage: atlasPacker <game folder> <list table> <group> <output path> [--max-size 2048] [--padding 2]\n" );
+        printf( "       The list table and output path are relative to the game folder\n" );
+        return 1;
+    }
+
+    const fs::path gamePath( argVec[0] );
+    const std::string & listTablePath = argVec[1];
+    const std::string & group = argVec[2];
+    const std::string & outputPath = argVec[3];
+
+    try
+    {
+        // Collect the textures of the group's quads
+        std::set<std::string> textureSet;
+        int skipCount(0);
+
+        for( auto & iter : GetGroupFileList( gamePath, listTablePath, group ) )
+            CollectTextures( gamePath, iter, textureSet, skipCount );
+
+        // Load the images the same way the engine does
+        std::vector<CPackImage> imageVec;
+        imageVec.reserve( textureSet.size() );
+
+        for( auto & iter : textureSet )
+        {
+            CPackImage image;
+            image.filePath = iter;
+
+            int channels(0);
+            unsigned char * pPixels = SOIL_load_image(
+                (gamePath / iter).string().c_str(), &image.width, &image.height, &channels, SOIL_LOAD_RGBA );
+
+            if( pPixels == nullptr )
+                throw NExcept::CCriticalException( "Atlas Packer Error!", "Error loading image: " + iter );
+
+            image.pixelVec.assign( pPixels, pPixels + (image.width * image.height * 4) );
+            SOIL_free_image_data( pPixels );
+
+            imageVec.push_back( std::move(image) );
+        }
+
+        // Tallest first keeps the rows tight
+        std::sort( imageVec.begin(), imageVec.end(),
+            []( const CPackImage & a, const CPackImage & b )
+            { return (a.height != b.height) ? (a.height > b.height) : (a.width > b.width); } );
+
+        // Try the narrower atlas widths that still fit all the images. Fewest atlases first, then the least area.
+        int bestWidth(maxSize);
+        std::vector<CPackAtlas> atlasVec = PackImages( imageVec, maxSize, maxSize, padding );
+
+        auto isPacked = []( const CPackImage & image ) { return image.atlas >= 0; };
+        const int packableCount = std::count_if( imageVec.begin(), imageVec.end(), isPacked );
+
+        for( int width = maxSize / 2; width >= 64; width /= 2 )
+        {
+            std::vector<CPackAtlas> tryAtlasVec = PackImages( imageVec, width, maxSize, padding );
+
+            if( std::count_if( imageVec.begin(), imageVec.end(), isPacked ) < packableCount )
+                break;
+
+            if( (tryAtlasVec.size() < atlasVec.size()) ||
+                ((tryAtlasVec.size() == atlasVec.size()) && (GetAtlasArea( tryAtlasVec ) < GetAtlasArea( atlasVec ))) )
+            {
+                bestWidth = width;
+                atlasVec.swap( tryAtlasVec );
+            }
+        }
+
+        atlasVec = PackImages( imageVec, bestWidth, maxSize, padding );
+
+        // An atlas of one image saves nothing
+        std::vector<int> regionCountVec( atlasVec.size(), 0 );
+        for( auto & iter : imageVec )
+            if( iter.atlas >= 0 )
+                ++regionCountVec[iter.atlas];
+
+        std::vector<int> atlasIndexVec( atlasVec.size(), -1 );
+        std::vector<CPackAtlas> keptAtlasVec;
+
+        for( size_t i = 0; i < atlasVec.size(); ++i )
+        {
+            if( regionCountVec[i] > 1 )
+            {
+                atlasIndexVec[i] = keptAtlasVec.size();
+                keptAtlasVec.push_back( atlasVec[i] );
+            }
+        }
+
+        atlasVec.swap( keptAtlasVec );
+
+        int unpackedCount(0);
+        for( auto & iter : imageVec )
+        {
+            if( iter.atlas >= 0 )
+                iter.atlas = atlasIndexVec[iter.atlas];
+
+            if( iter.atlas < 0 )
+                ++unpackedCount;
+        }
+
+        for( auto & iter : atlasVec )
+            iter.pixelVec.assign( iter.width * iter.height * 4, 0 );
+
+        for( auto & iter : imageVec )
+            if( iter.atlas >= 0 )
+                CopyImage( atlasVec[iter.atlas], iter, padding );
+
+        // Write the atlas images and the XML of the regions
+        std::string xmlStr = "<?xml version=\"1.0\"?>\n<textureAtlas>\n";
+        int64_t atlasArea(0), regionArea(0);
+        int packedCount(0);
+
+        for( size_t i = 0; i < atlasVec.size(); ++i )
+        {
+            const CPackAtlas & atlas = atlasVec[i];
+            const std::string atlasFilePath = boost::str( boost::format("%s_%d.tga") % outputPath % i );
+
+            if( !SOIL_save_image( (gamePath / atlasFilePath).string().c_str(),
+                    SOIL_SAVE_TYPE_TGA, atlas.width, atlas.height, 4, atlas.pixelVec.data() ) )
+                throw NExcept::CCriticalException( "Atlas Packer Error!", "Error writing atlas: " + atlasFilePath );
+
+            xmlStr += boost::str( boost::format("    <atlas file=\"%s\" width=\"%d\" height=\"%d\">\n")
+                % atlasFilePath % atlas.width % atlas.height );
+
+            for( auto & iter : imageVec )
+            {
+                if( iter.atlas == (int)i )
+                {
+                    xmlStr += boost::str( boost::format("        <region file=\"%s\" x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\"/>\n")
+                        % iter.filePath % iter.x % iter.y % iter.width % iter.height );
+
+                    ++packedCount;
+                }
+            }
+
+            xmlStr += "    </atlas>\n";
+
+            const int64_t area = (int64_t)atlas.width * atlas.height;
+            atlasArea += area;
+            regionArea += atlas.regionArea;
+
+            printf( "%-48s %4dx%-4d  fill: %5.1f%%\n",
+                atlasFilePath.c_str(), atlas.width, atlas.height, 100.0 * atlas.regionArea / area );
+        }
+
+        xmlStr += "</textureAtlas>\n";
+
+        const std::string xmlFilePath = outputPath + ".xml";
+        std::ofstream file( gamePath / xmlFilePath, std::ios::trunc );
+        file << xmlStr;
+
+        if( !file )
+            throw NExcept::CCriticalException( "Atlas Packer Error!", "Error writing file: " + xmlFilePath );
+
+        // The textures left out still need their own image
+        const int textureCount = imageVec.size();
+        printf( "\nGroup %s\n", group.c_str() );
+        printf( "Textures:     %d before, %d after (%d packed into %zu atlases)\n",
+            textureCount, (textureCount - packedCount) + (int)atlasVec.size(), packedCount, atlasVec.size() );
+        printf( "Fill:         %.1f%%\n", (atlasArea > 0) ? (100.0 * regionArea / atlasArea) : 0.0 );
+        printf( "Not packed:   %d with sampler settings, %d too large or alone in an atlas\n", skipCount, unpackedCount );
+        printf( "\nAdd to the group's list table entry:\n    <groupList groupName=\"%s\" textureAtlas=\"%s\">\n",
+            group.c_str(), xmlFilePath.c_str() );
+    }
+    catch( NExcept::CCriticalException & ex )
+    {
+        printf( "%s\n%s\n", ex.getErrorTitle().c_str(), ex.getErrorMsg().c_str() );
+        return 1;
+    }
+    catch( std::exception & ex )
+    {
+        printf( "Atlas Packer Error!\n%s\n", ex.what() );
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,1022 @@
+
+/************************************************************************
+*    FILE NAME:       drawOrderTest.cpp
+*
+*    DESCRIPTION:     Draws the same strategy of overlapping, alpha blended
+*                     quads recorded serially into one secondary command
+*                     buffer and recorded in chunks on separate threads
+*                     like CStrategy::recordCommandBuffer and CCamera, and
+*                     checks the two images are the same
+*
+*                     drawOrderTest [--nodes N] [--threads N] [--shaders dir]
+*
+*    NOTE:            Runs on any Vulkan device. For lavapipe point
+*                     VK_ICD_FILENAMES at its icd json. Returns non-zero if
+*                     the chunked draw order doesn't match the serial one
+************************************************************************/
+
+// Game lib dependencies
+#include <utilities/exceptionhandling.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
+
+// Vulkan lib dependencies
+#include <vulkan/vulkan.h>
+
+// Standard lib dependencies
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <thread>
+#include <fstream>
+#include <exception>
+#include <algorithm>
+
+// Same as CStrategy::PARALLEL_CHUNK_MIN_NODES
+const size_t PARALLEL_CHUNK_MIN_NODES = 128;
+
+// Size of the offscreen render target
+const uint32_t TARGET_WIDTH = 256;
+const uint32_t TARGET_HEIGHT = 256;
+
+// The largest minUniformBufferOffsetAlignment the spec allows
+const VkDeviceSize UBO_STRIDE = 256;
+
+// Layout of the UBO in the engine's quad_no_txt.vert
+class CUniformBufferObject
+{
+public:
+    float m_model[16];
+    float m_viewProj[16];
+    float m_color[4];
+    float m_additive[4];
+};
+
+/************************************************************************
+*    DESC:  Throw if a Vulkan call failed
+************************************************************************/
+void checkResult( VkResult result, const char * pCall )
+{
+    if( result != VK_SUCCESS )
+        throw NExcept::CCriticalException("Vulkan Error!",
+            boost::str( boost::format("%s failed (%d).\n") % pCall % result ));
+}
+
+/************************************************************************
+*    Offscreen device that draws solid quads with the engine's 2d_solid
+*    shaders, pipeline settings and dynamic offset UBOs
+************************************************************************/
+class CTestDevice
+{
+public:
+
+    CTestDevice( const std::string & shaderDir, size_t uboCount, size_t parallelCmdBufCount );
+    ~CTestDevice();
+
+    // Record a range of nodes like CDrawCommand::record
+    void recordNodes( VkCommandBuffer cmdBuffer, const std::vector<uint32_t> & nodeVec, size_t begin, size_t end );
+
+    // Begin and end a secondary command buffer like CDevice::beginSecondaryCommandBuffer
+    void beginCommandBuffer( VkCommandBuffer cmdBuffer );
+    void endCommandBuffer( VkCommandBuffer cmdBuffer );
+
+    // Execute the secondary command buffers in a render pass and read back the image
+    std::vector<uint8_t> render( const std::vector<VkCommandBuffer> & secondaryCmdBufVec );
+
+    // Get the UBO of a node to fill in
+    CUniformBufferObject & getUBO( uint32_t slot );
+
+    // Get the serial and the parallel command buffers
+    VkCommandBuffer getSerialCmdBuf() const;
+    const std::vector<VkCommandBuffer> & getParallelCmdBufVec() const;
+
+private:
+
+    void createDevice();
+    void createRenderTarget();
+    void createPipeline( const std::string & shaderDir );
+    void createBuffers( size_t uboCount );
+    void createCommandBuffers( size_t parallelCmdBufCount );
+    uint32_t findMemoryType( uint32_t typeFilter, VkMemoryPropertyFlags properties );
+    void createBuffer( VkDeviceSize size, VkBufferUsageFlags usage, VkBuffer & buffer, VkDeviceMemory & memory, void ** ppData );
+    VkShaderModule createShaderModule( const std::string & filePath );
+    VkCommandBuffer createCommandBuffer( VkCommandBufferLevel level, VkCommandPool & commandPool );
+
+private:
+
+    VkInstance m_instance = VK_NULL_HANDLE;
+    VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
+    VkDevice m_device = VK_NULL_HANDLE;
+    VkQueue m_queue = VK_NULL_HANDLE;
+    uint32_t m_queueFamilyIndex = 0;
+
+    VkImage m_image = VK_NULL_HANDLE;
+    VkDeviceMemory m_imageMemory = VK_NULL_HANDLE;
+    VkImageView m_imageView = VK_NULL_HANDLE;
+    VkRenderPass m_renderPass = VK_NULL_HANDLE;
+    VkFramebuffer m_framebuffer = VK_NULL_HANDLE;
+
+    VkDescriptorSetLayout m_descriptorSetLayout = VK_NULL_HANDLE;
+    VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;
+    VkPipeline m_pipeline = VK_NULL_HANDLE;
+    VkDescriptorPool m_descriptorPool = VK_NULL_HANDLE;
+    VkDescriptorSet m_descriptorSet = VK_NULL_HANDLE;
+
+    VkBuffer m_vertexBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory m_vertexMemory = VK_NULL_HANDLE;
+    VkBuffer m_indexBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory m_indexMemory = VK_NULL_HANDLE;
+    VkBuffer m_uniformBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory m_uniformMemory = VK_NULL_HANDLE;
+    uint8_t * m_pUniformData = nullptr;
+    VkBuffer m_readBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory m_readMemory = VK_NULL_HANDLE;
+    uint8_t * m_pReadData = nullptr;
+
+    // Primary and serial command buffers
+    VkCommandPool m_commandPool = VK_NULL_HANDLE;
+    VkCommandBuffer m_primaryCmdBuf = VK_NULL_HANDLE;
+    VkCommandBuffer m_serialCmdBuf = VK_NULL_HANDLE;
+
+    // Each parallel command buffer comes from its own pool like CDevice::createParallelCommandBuffers
+    std::vector<VkCommandPool> m_parallelCmdPoolVec;
+    std::vector<VkCommandBuffer> m_parallelCmdBufVec;
+};
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CTestDevice::CTestDevice( const std::string & shaderDir, size_t uboCount, size_t parallelCmdBufCount )
+{
+    createDevice();
+    createRenderTarget();
+    createPipeline( shaderDir );
+    createBuffers( uboCount );
+    createCommandBuffers( parallelCmdBufCount );
+}
+
+/************************************************************************
+*    DESC:  destructor
+************************************************************************/
+CTestDevice::~CTestDevice()
+{
+    if( m_device != VK_NULL_HANDLE )
+    {
+        vkDeviceWaitIdle( m_device );
+
+        for( auto iter : m_parallelCmdPoolVec )
+            vkDestroyCommandPool( m_device, iter, nullptr );
+
+        vkDestroyCommandPool( m_device, m_commandPool, nullptr );
+
+        vkDestroyBuffer( m_device, m_readBuffer, nullptr );
+        vkFreeMemory( m_device, m_readMemory, nullptr );
+        vkDestroyBuffer( m_device, m_uniformBuffer, nullptr );
+        vkFreeMemory( m_device, m_uniformMemory, nullptr );
+        vkDestroyBuffer( m_device, m_indexBuffer, nullptr );
+        vkFreeMemory( m_device, m_indexMemory, nullptr );
+        vkDestroyBuffer( m_device, m_vertexBuffer, nullptr );
+        vkFreeMemory( m_device, m_vertexMemory, nullptr );
+
+        vkDestroyDescriptorPool( m_device, m_descriptorPool, nullptr );
+        vkDestroyPipeline( m_device, m_pipeline, nullptr );
+        vkDestroyPipelineLayout( m_device, m_pipelineLayout, nullptr );
+        vkDestroyDescriptorSetLayout( m_device, m_descriptorSetLayout, nullptr );
+
+        vkDestroyFramebuffer( m_device, m_framebuffer, nullptr );
+        vkDestroyRenderPass( m_device, m_renderPass, nullptr );
+        vkDestroyImageView( m_device, m_imageView, nullptr );
+        vkDestroyImage( m_device, m_image, nullptr );
+        vkFreeMemory( m_device, m_imageMemory, nullptr );
+
+        vkDestroyDevice( m_device, nullptr );
+    }
+
+    if( m_instance != VK_NULL_HANDLE )
+        vkDestroyInstance( m_instance, nullptr );
+}
+
+/************************************************************************
+*    DESC:  Create the instance and the device on the first physical
+*           device with a graphics queue
+************************************************************************/
+void CTestDevice::createDevice()
+{
+    VkApplicationInfo appInfo = {};
+    appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+    appInfo.pApplicationName = "drawOrderTest";
+    appInfo.apiVersion = VK_API_VERSION_1_0;
+
+    VkInstanceCreateInfo instanceInfo = {};
+    instanceInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+    instanceInfo.pApplicationInfo = &appInfo;
+
+    checkResult( vkCreateInstance( &instanceInfo, nullptr, &m_instance ), "vkCreateInstance" );
+
+    uint32_t deviceCount(0);
+    vkEnumeratePhysicalDevices( m_instance, &deviceCount, nullptr );
+    std::vector<VkPhysicalDevice> physicalDeviceVec( deviceCount );
+    vkEnumeratePhysicalDevices( m_instance, &deviceCount, physicalDeviceVec.data() );
+
+    for( auto iter : physicalDeviceVec )
+    {
+        uint32_t queueFamilyCount(0);
+        vkGetPhysicalDeviceQueueFamilyProperties( iter, &queueFamilyCount, nullptr );
+        std::vector<VkQueueFamilyProperties> queueFamilyVec( queueFamilyCount );
+        vkGetPhysicalDeviceQueueFamilyProperties( iter, &queueFamilyCount, queueFamilyVec.data() );
+
+        for( uint32_t i = 0; i < queueFamilyCount; ++i )
+        {
+            if( queueFamilyVec[i].queueFlags & VK_QUEUE_GRAPHICS_BIT )
+            {
+                m_physicalDevice = iter;
+                m_queueFamilyIndex = i;
+                break;
+            }
+        }
+
+        if( m_physicalDevice != VK_NULL_HANDLE )
+            break;
+    }
+
+    if( m_physicalDevice == VK_NULL_HANDLE )
+        throw NExcept::CCriticalException("Vulkan Error!", "No device with a graphics queue found.");
+
+    const float queuePriority(1.f);
+
+    VkDeviceQueueCreateInfo queueInfo = {};
+    queueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    queueInfo.queueFamilyIndex = m_queueFamilyIndex;
+    queueInfo.queueCount = 1;
+    queueInfo.pQueuePriorities = &queuePriority;
+
+    VkDeviceCreateInfo deviceInfo = {};
+    deviceInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    deviceInfo.queueCreateInfoCount = 1;
+    deviceInfo.pQueueCreateInfos = &queueInfo;
+
+    checkResult( vkCreateDevice( m_physicalDevice, &deviceInfo, nullptr, &m_device ), "vkCreateDevice" );
+
+    vkGetDeviceQueue( m_device, m_queueFamilyIndex, 0, &m_queue );
+}
+
+/************************************************************************
+*    DESC:  Create the image, render pass and frame buffer to draw into
+************************************************************************/
+void CTestDevice::createRenderTarget()
+{
+    VkImageCreateInfo imageInfo = {};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+    imageInfo.extent = { TARGET_WIDTH, TARGET_HEIGHT, 1 };
+    imageInfo.mipLevels = 1;
+    imageInfo.arrayLayers = 1;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    checkResult( vkCreateImage( m_device, &imageInfo, nullptr, &m_image ), "vkCreateImage" );
+
+    VkMemoryRequirements memRequirements;
+    vkGetImageMemoryRequirements( m_device, m_image, &memRequirements );
+
+    VkMemoryAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = findMemoryType( memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
+
+    checkResult( vkAllocateMemory( m_device, &allocInfo, nullptr, &m_imageMemory ), "vkAllocateMemory" );
+    checkResult( vkBindImageMemory( m_device, m_image, m_imageMemory, 0 ), "vkBindImageMemory" );
+
+    VkImageViewCreateInfo viewInfo = {};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = m_image;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    viewInfo.subresourceRange.levelCount = 1;
+    viewInfo.subresourceRange.layerCount = 1;
+
+    checkResult( vkCreateImageView( m_device, &viewInfo, nullptr, &m_imageView ), "vkCreateImageView" );
+
+    VkAttachmentDescription colorAttachment = {};
+    colorAttachment.format = VK_FORMAT_R8G8B8A8_UNORM;
+    colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+    colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+    VkAttachmentReference colorAttachmentRef = {};
+    colorAttachmentRef.attachment = 0;
+    colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+    VkSubpassDescription subpass = {};
+    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachmentCount = 1;
+    subpass.pColorAttachments = &colorAttachmentRef;
+
+    // The image is copied out after the render pass
+    VkSubpassDependency dependency = {};
+    dependency.srcSubpass = 0;
+    dependency.dstSubpass = VK_SUBPASS_EXTERNAL;
+    dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dependency.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    dependency.dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    dependency.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+    VkRenderPassCreateInfo renderPassInfo = {};
+    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    renderPassInfo.attachmentCount = 1;
+    renderPassInfo.pAttachments = &colorAttachment;
+    renderPassInfo.subpassCount = 1;
+    renderPassInfo.pSubpasses = &subpass;
+    renderPassInfo.dependencyCount = 1;
+    renderPassInfo.pDependencies = &dependency;
+
+    checkResult( vkCreateRenderPass( m_device, &renderPassInfo, nullptr, &m_renderPass ), "vkCreateRenderPass" );
+
+    VkFramebufferCreateInfo framebufferInfo = {};
+    framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+    framebufferInfo.renderPass = m_renderPass;
+    framebufferInfo.attachmentCount = 1;
+    framebufferInfo.pAttachments = &m_imageView;
+    framebufferInfo.width = TARGET_WIDTH;
+    framebufferInfo.height = TARGET_HEIGHT;
+    framebufferInfo.layers = 1;
+
+    checkResult( vkCreateFramebuffer( m_device, &framebufferInfo, nullptr, &m_framebuffer ), "vkCreateFramebuffer" );
+}
+
+/************************************************************************
+*    DESC:  Create the 2d_solid pipeline with the engine's blend settings
+************************************************************************/
+void CTestDevice::createPipeline( const std::string & shaderDir )
+{
+    // One dynamic offset UBO like the engine's "ubo" descriptor
+    VkDescriptorSetLayoutBinding uboBinding = {};
+    uboBinding.binding = 0;
+    uboBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    uboBinding.descriptorCount = 1;
+    uboBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = 1;
+    layoutInfo.pBindings = &uboBinding;
+
+    checkResult( vkCreateDescriptorSetLayout( m_device, &layoutInfo, nullptr, &m_descriptorSetLayout ), "vkCreateDescriptorSetLayout" );
+
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
+    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount = 1;
+    pipelineLayoutInfo.pSetLayouts = &m_descriptorSetLayout;
+
+    checkResult( vkCreatePipelineLayout( m_device, &pipelineLayoutInfo, nullptr, &m_pipelineLayout ), "vkCreatePipelineLayout" );
+
+    VkShaderModule vertShader = createShaderModule( shaderDir + "/quad_no_txt_vert.spv" );
+    VkShaderModule fragShader = createShaderModule( shaderDir + "/quad_no_txt_frag.spv" );
+
+    VkPipelineShaderStageCreateInfo shaderStages[2] = {};
+    shaderStages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    shaderStages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+    shaderStages[0].module = vertShader;
+    shaderStages[0].pName = "main";
+    shaderStages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    shaderStages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+    shaderStages[1].module = fragShader;
+    shaderStages[1].pName = "main";
+
+    // The engine's "vert" vertex input description
+    VkVertexInputBindingDescription bindingDesc = {};
+    bindingDesc.binding = 0;
+    bindingDesc.stride = sizeof(float) * 3;
+    bindingDesc.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+    VkVertexInputAttributeDescription attributeDesc = {};
+    attributeDesc.location = 0;
+    attributeDesc.binding = 0;
+    attributeDesc.format = VK_FORMAT_R32G32B32_SFLOAT;
+    attributeDesc.offset = 0;
+
+    VkPipelineVertexInputStateCreateInfo vertexInputInfo = {};
+    vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertexInputInfo.vertexBindingDescriptionCount = 1;
+    vertexInputInfo.pVertexBindingDescriptions = &bindingDesc;
+    vertexInputInfo.vertexAttributeDescriptionCount = 1;
+    vertexInputInfo.pVertexAttributeDescriptions = &attributeDesc;
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly = {};
+    inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    VkViewport viewport = {};
+    viewport.width = (float)TARGET_WIDTH;
+    viewport.height = (float)TARGET_HEIGHT;
+    viewport.maxDepth = 1.f;
+
+    VkRect2D scissor = {};
+    scissor.extent = { TARGET_WIDTH, TARGET_HEIGHT };
+
+    VkPipelineViewportStateCreateInfo viewportState = {};
+    viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewportState.viewportCount = 1;
+    viewportState.pViewports = &viewport;
+    viewportState.scissorCount = 1;
+    viewportState.pScissors = &scissor;
+
+    VkPipelineRasterizationStateCreateInfo rasterizer = {};
+    rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterizer.cullMode = VK_CULL_MODE_NONE;
+    rasterizer.frontFace = VK_FRONT_FACE_CLOCKWISE;
+    rasterizer.lineWidth = 1.f;
+
+    VkPipelineMultisampleStateCreateInfo multisampling = {};
+    multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    // Same as CDeviceVulkan::createPipeline so the result depends on the draw order
+    VkPipelineColorBlendAttachmentState colorBlendAttachment = {};
+    colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    colorBlendAttachment.blendEnable = VK_TRUE;
+    colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+    colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+    colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+    colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+
+    VkPipelineColorBlendStateCreateInfo colorBlending = {};
+    colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    colorBlending.logicOp = VK_LOGIC_OP_COPY;
+    colorBlending.attachmentCount = 1;
+    colorBlending.pAttachments = &colorBlendAttachment;
+
+    VkGraphicsPipelineCreateInfo pipelineInfo = {};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineInfo.stageCount = 2;
+    pipelineInfo.pStages = shaderStages;
+    pipelineInfo.pVertexInputState = &vertexInputInfo;
+    pipelineInfo.pInputAssemblyState = &inputAssembly;
+    pipelineInfo.pViewportState = &viewportState;
+    pipelineInfo.pRasterizationState = &rasterizer;
+    pipelineInfo.pMultisampleState = &multisampling;
+    pipelineInfo.pColorBlendState = &colorBlending;
+    pipelineInfo.layout = m_pipelineLayout;
+    pipelineInfo.renderPass = m_renderPass;
+    pipelineInfo.subpass = 0;
+
+    const VkResult result = vkCreateGraphicsPipelines( m_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_pipeline );
+
+    vkDestroyShaderModule( m_device, fragShader, nullptr );
+    vkDestroyShaderModule( m_device, vertShader, nullptr );
+
+    checkResult( result, "vkCreateGraphicsPipelines" );
+
+    VkDescriptorPoolSize poolSize = {};
+    poolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    poolSize.descriptorCount = 1;
+
+    VkDescriptorPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets = 1;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
+
+    checkResult( vkCreateDescriptorPool( m_device, &poolInfo, nullptr, &m_descriptorPool ), "vkCreateDescriptorPool" );
+
+    VkDescriptorSetAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = m_descriptorPool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &m_descriptorSetLayout;
+
+    checkResult( vkAllocateDescriptorSets( m_device, &allocInfo, &m_descriptorSet ), "vkAllocateDescriptorSets" );
+}
+
+/************************************************************************
+*    DESC:  Create the quad, the UBOs and the read back buffer
+************************************************************************/
+void CTestDevice::createBuffers( size_t uboCount )
+{
+    const float vertices[] = { -0.5f,-0.5f,0.f,  0.5f,-0.5f,0.f,  0.5f,0.5f,0.f,  -0.5f,0.5f,0.f };
+    const uint16_t indices[] = { 0, 1, 2, 2, 3, 0 };
+    void * pData;
+
+    createBuffer( sizeof(vertices), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, m_vertexBuffer, m_vertexMemory, &pData );
+    std::memcpy( pData, vertices, sizeof(vertices) );
+
+    createBuffer( sizeof(indices), VK_BUFFER_USAGE_INDEX_BUFFER_BIT, m_indexBuffer, m_indexMemory, &pData );
+    std::memcpy( pData, indices, sizeof(indices) );
+
+    createBuffer( uboCount * UBO_STRIDE, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, m_uniformBuffer, m_uniformMemory, &pData );
+    m_pUniformData = static_cast<uint8_t *>(pData);
+
+    createBuffer( TARGET_WIDTH * TARGET_HEIGHT * 4, VK_BUFFER_USAGE_TRANSFER_DST_BIT, m_readBuffer, m_readMemory, &pData );
+    m_pReadData = static_cast<uint8_t *>(pData);
+
+    VkDescriptorBufferInfo bufferInfo = {};
+    bufferInfo.buffer = m_uniformBuffer;
+    bufferInfo.offset = 0;
+    bufferInfo.range = sizeof(CUniformBufferObject);
+
+    VkWriteDescriptorSet descriptorWrite = {};
+    descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrite.dstSet = m_descriptorSet;
+    descriptorWrite.dstBinding = 0;
+    descriptorWrite.descriptorCount = 1;
+    descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    descriptorWrite.pBufferInfo = &bufferInfo;
+
+    vkUpdateDescriptorSets( m_device, 1, &descriptorWrite, 0, nullptr );
+}
+
+/************************************************************************
+*    DESC:  Create the primary, the serial and the parallel command buffers
+************************************************************************/
+void CTestDevice::createCommandBuffers( size_t parallelCmdBufCount )
+{
+    VkCommandPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    poolInfo.queueFamilyIndex = m_queueFamilyIndex;
+
+    checkResult( vkCreateCommandPool( m_device, &poolInfo, nullptr, &m_commandPool ), "vkCreateCommandPool" );
+
+    m_primaryCmdBuf = createCommandBuffer( VK_COMMAND_BUFFER_LEVEL_PRIMARY, m_commandPool );
+    m_serialCmdBuf = createCommandBuffer( VK_COMMAND_BUFFER_LEVEL_SECONDARY, m_commandPool );
+
+    m_parallelCmdPoolVec.resize( parallelCmdBufCount, VK_NULL_HANDLE );
+
+    for( auto & iter : m_parallelCmdPoolVec )
+    {
+        checkResult( vkCreateCommandPool( m_device, &poolInfo, nullptr, &iter ), "vkCreateCommandPool" );
+        m_parallelCmdBufVec.push_back( createCommandBuffer( VK_COMMAND_BUFFER_LEVEL_SECONDARY, iter ) );
+    }
+}
+
+/************************************************************************
+*    DESC:  Allocate a command buffer from the pool
+************************************************************************/
+VkCommandBuffer CTestDevice::createCommandBuffer( VkCommandBufferLevel level, VkCommandPool & commandPool )
+{
+    VkCommandBufferAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.commandPool = commandPool;
+    allocInfo.level = level;
+    allocInfo.commandBufferCount = 1;
+
+    VkCommandBuffer cmdBuffer;
+    checkResult( vkAllocateCommandBuffers( m_device, &allocInfo, &cmdBuffer ), "vkAllocateCommandBuffers" );
+
+    return cmdBuffer;
+}
+
+/************************************************************************
+*    DESC:  Find the memory type
+************************************************************************/
+uint32_t CTestDevice::findMemoryType( uint32_t typeFilter, VkMemoryPropertyFlags properties )
+{
+    VkPhysicalDeviceMemoryProperties memProperties;
+    vkGetPhysicalDeviceMemoryProperties( m_physicalDevice, &memProperties );
+
+    for( uint32_t i = 0; i < memProperties.memoryTypeCount; ++i )
+        if( (typeFilter & (1 << i)) && ((memProperties.memoryTypes[i].propertyFlags & properties) == properties) )
+            return i;
+
+    throw NExcept::CCriticalException("Vulkan Error!", "Failed to find suitable memory type.");
+}
+
+/************************************************************************
+*    DESC:  Create a host visible buffer and map it
+************************************************************************/
+void CTestDevice::createBuffer( VkDeviceSize size, VkBufferUsageFlags usage, VkBuffer & buffer, VkDeviceMemory & memory, void ** ppData )
+{
+    VkBufferCreateInfo bufferInfo = {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = usage;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    checkResult( vkCreateBuffer( m_device, &bufferInfo, nullptr, &buffer ), "vkCreateBuffer" );
+
+    VkMemoryRequirements memRequirements;
+    vkGetBufferMemoryRequirements( m_device, buffer, &memRequirements );
+
+    VkMemoryAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = findMemoryType(
+        memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT );
+
+    checkResult( vkAllocateMemory( m_device, &allocInfo, nullptr, &memory ), "vkAllocateMemory" );
+    checkResult( vkBindBufferMemory( m_device, buffer, memory, 0 ), "vkBindBufferMemory" );
+    checkResult( vkMapMemory( m_device, memory, 0, size, 0, ppData ), "vkMapMemory" );
+}
+
+/************************************************************************
+*    DESC:  Create a shader module from a SPIR-V file
+************************************************************************/
+VkShaderModule CTestDevice::createShaderModule( const std::string & filePath )
+{
+    std::ifstream file( filePath, std::ios::binary | std::ios::ate );
+    if( !file.is_open() )
+        throw NExcept::CCriticalException("Shader Load Error!",
+            boost::str( boost::format("Can't open shader (%s).\n\n%s\nLine: %s\n") % filePath % __FUNCTION__ % __LINE__ ));
+
+    std::vector<uint32_t> codeVec( ((size_t)file.tellg() + 3) / 4 );
+    file.seekg( 0 );
+    file.read( reinterpret_cast<char *>(codeVec.data()), codeVec.size() * 4 );
+
+    VkShaderModuleCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    createInfo.codeSize = codeVec.size() * 4;
+    createInfo.pCode = codeVec.data();
+
+    VkShaderModule shaderModule;
+    checkResult( vkCreateShaderModule( m_device, &createInfo, nullptr, &shaderModule ), "vkCreateShaderModule" );
+
+    return shaderModule;
+}
+
+/************************************************************************
+*    DESC:  Record a range of nodes
+*
+*    NOTE:  Every draw binds its state like CDrawCommand::record. The node
+*           is the slot of its UBO
+************************************************************************/
+void CTestDevice::recordNodes( VkCommandBuffer cmdBuffer, const std::vector<uint32_t> & nodeVec, size_t begin, size_t end )
+{
+    const VkDeviceSize offset(0);
+
+    for( size_t i = begin; i < end; ++i )
+    {
+        const uint32_t dynamicOffset = nodeVec[i] * UBO_STRIDE;
+
+        vkCmdBindPipeline( cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline );
+        vkCmdBindVertexBuffers( cmdBuffer, 0, 1, &m_vertexBuffer, &offset );
+        vkCmdBindIndexBuffer( cmdBuffer, m_indexBuffer, 0, VK_INDEX_TYPE_UINT16 );
+        vkCmdBindDescriptorSets( cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 0, 1, &m_descriptorSet, 1, &dynamicOffset );
+        vkCmdDrawIndexed( cmdBuffer, 6, 1, 0, 0, 0 );
+    }
+}
+
+/************************************************************************
+*    DESC:  Begin the recording of a secondary command buffer
+************************************************************************/
+void CTestDevice::beginCommandBuffer( VkCommandBuffer cmdBuffer )
+{
+    VkCommandBufferInheritanceInfo cmdBufInheritanceInfo = {};
+    cmdBufInheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    cmdBufInheritanceInfo.framebuffer = m_framebuffer;
+    cmdBufInheritanceInfo.renderPass = m_renderPass;
+
+    VkCommandBufferBeginInfo cmdBeginInfo = {};
+    cmdBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    cmdBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    cmdBeginInfo.pInheritanceInfo = &cmdBufInheritanceInfo;
+
+    checkResult( vkBeginCommandBuffer( cmdBuffer, &cmdBeginInfo ), "vkBeginCommandBuffer" );
+}
+
+/************************************************************************
+*    DESC:  End the recording of a secondary command buffer
+************************************************************************/
+void CTestDevice::endCommandBuffer( VkCommandBuffer cmdBuffer )
+{
+    checkResult( vkEndCommandBuffer( cmdBuffer ), "vkEndCommandBuffer" );
+}
+
+/************************************************************************
+*    DESC:  Execute the secondary command buffers in array order like
+*           CDevice::recordPrimaryCommandBuffer and read back the image
+************************************************************************/
+std::vector<uint8_t> CTestDevice::render( const std::vector<VkCommandBuffer> & secondaryCmdBufVec )
+{
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    checkResult( vkBeginCommandBuffer( m_primaryCmdBuf, &beginInfo ), "vkBeginCommandBuffer" );
+
+    VkClearValue clearValue = {};
+    clearValue.color.float32[0] = 0.1f;
+    clearValue.color.float32[1] = 0.2f;
+    clearValue.color.float32[2] = 0.3f;
+    clearValue.color.float32[3] = 1.f;
+
+    VkRenderPassBeginInfo renderPassInfo = {};
+    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    renderPassInfo.renderPass = m_renderPass;
+    renderPassInfo.framebuffer = m_framebuffer;
+    renderPassInfo.renderArea.extent = { TARGET_WIDTH, TARGET_HEIGHT };
+    renderPassInfo.clearValueCount = 1;
+    renderPassInfo.pClearValues = &clearValue;
+
+    vkCmdBeginRenderPass( m_primaryCmdBuf, &renderPassInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS );
+
+    if( !secondaryCmdBufVec.empty() )
+        vkCmdExecuteCommands( m_primaryCmdBuf, secondaryCmdBufVec.size(), secondaryCmdBufVec.data() );
+
+    vkCmdEndRenderPass( m_primaryCmdBuf );
+
+    VkBufferImageCopy region = {};
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.layerCount = 1;
+    region.imageExtent = { TARGET_WIDTH, TARGET_HEIGHT, 1 };
+
+    vkCmdCopyImageToBuffer( m_primaryCmdBuf, m_image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, m_readBuffer, 1, &region );
+
+    // Make the copy visible to the host
+    VkMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+
+    vkCmdPipelineBarrier( m_primaryCmdBuf, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr );
+
+    checkResult( vkEndCommandBuffer( m_primaryCmdBuf ), "vkEndCommandBuffer" );
+
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &m_primaryCmdBuf;
+
+    checkResult( vkQueueSubmit( m_queue, 1, &submitInfo, VK_NULL_HANDLE ), "vkQueueSubmit" );
+    checkResult( vkQueueWaitIdle( m_queue ), "vkQueueWaitIdle" );
+
+    return std::vector<uint8_t>( m_pReadData, m_pReadData + (TARGET_WIDTH * TARGET_HEIGHT * 4) );
+}
+
+/************************************************************************
+*    DESC:  Get the UBO of a node to fill in
+************************************************************************/
+CUniformBufferObject & CTestDevice::getUBO( uint32_t slot )
+{
+    return *reinterpret_cast<CUniformBufferObject *>(m_pUniformData + (slot * UBO_STRIDE));
+}
+
+/************************************************************************
+*    DESC:  Get the serial and the parallel command buffers
+************************************************************************/
+VkCommandBuffer CTestDevice::getSerialCmdBuf() const
+{
+    return m_serialCmdBuf;
+}
+
+const std::vector<VkCommandBuffer> & CTestDevice::getParallelCmdBufVec() const
+{
+    return m_parallelCmdBufVec;
+}
+
+/************************************************************************
+*    DESC:  Fill in the UBOs of a camera's nodes. Every node is a half
+*           transparent quad at a random spot so the image depends on
+*           the draw order
+************************************************************************/
+void createNodes( CTestDevice & device, std::vector<uint32_t> & nodeVec, uint32_t firstSlot, size_t count, const float * pViewProj, uint32_t & seed )
+{
+    auto random = [&seed]( float min, float max )
+    {
+        seed = (seed * 1664525) + 1013904223;
+        return min + ((seed >> 8) * (1.f / 16777216.f) * (max - min));
+    };
+
+    nodeVec.clear();
+
+    for( size_t i = 0; i < count; ++i )
+    {
+        const uint32_t slot = firstSlot + i;
+        CUniformBufferObject & rUBO = device.getUBO( slot );
+
+        std::memset( rUBO.m_model, 0, sizeof(rUBO.m_model) );
+        rUBO.m_model[0] = random( 8.f, 64.f );
+        rUBO.m_model[5] = random( 8.f, 64.f );
+        rUBO.m_model[10] = 1.f;
+        rUBO.m_model[12] = random( 0.f, TARGET_WIDTH );
+        rUBO.m_model[13] = random( 0.f, TARGET_HEIGHT );
+        rUBO.m_model[15] = 1.f;
+
+        std::memcpy( rUBO.m_viewProj, pViewProj, sizeof(rUBO.m_viewProj) );
+
+        rUBO.m_color[0] = random( 0.f, 1.f );
+        rUBO.m_color[1] = random( 0.f, 1.f );
+        rUBO.m_color[2] = random( 0.f, 1.f );
+        rUBO.m_color[3] = 0.5f;
+
+        for( int j = 0; j < 4; ++j )
+            rUBO.m_additive[j] = 1.f;
+
+        nodeVec.push_back( slot );
+    }
+}
+
+/************************************************************************
+*    DESC:  Record the node vector in chunks on separate threads
+*
+*    NOTE:  Same split as CCamera::recordCommandBuffer. Empty chunks are
+*           still recorded because they are executed with the others
+************************************************************************/
+void recordChunks(
+    CTestDevice & device,
+    const VkCommandBuffer * pCmdBufArray,
+    size_t chunkCount,
+    const std::vector<uint32_t> & nodeVec,
+    std::vector<std::thread> & threadVec,
+    std::vector<std::exception_ptr> & exceptionVec )
+{
+    const size_t nodeCount = nodeVec.size();
+    const size_t chunkSize = (nodeCount + chunkCount - 1) / chunkCount;
+
+    for( size_t chunk = 0; chunk < chunkCount; ++chunk )
+    {
+        const size_t begin = std::min( chunk * chunkSize, nodeCount );
+        const size_t end = std::min( begin + chunkSize, nodeCount );
+        VkCommandBuffer cmdBuffer = pCmdBufArray[chunk];
+        std::exception_ptr & rException = exceptionVec[threadVec.size()];
+
+        threadVec.emplace_back(
+            [&device, cmdBuffer, &nodeVec, begin, end, &rException]()
+            {
+                try
+                {
+                    device.beginCommandBuffer( cmdBuffer );
+                    device.recordNodes( cmdBuffer, nodeVec, begin, end );
+                    device.endCommandBuffer( cmdBuffer );
+                }
+                catch( ... )
+                {
+                    rException = std::current_exception();
+                }
+            } );
+    }
+}
+
+/************************************************************************
+*    DESC:  Draw a strategy with a default and an extra camera serially
+*           and in chunks and compare the images
+*
+*    NOTE:  The chunks are also executed in reverse to make sure the
+*           scene can show a wrong draw order at all
+************************************************************************/
+bool runCase( CTestDevice & device, size_t nodeCount, size_t extraNodeCount, uint32_t seed )
+{
+    // Pixel space camera and a smaller extra camera drawn in the middle
+    const float viewProj[16] = {
+        2.f / TARGET_WIDTH,0,0,0,  0,2.f / TARGET_HEIGHT,0,0,  0,0,1,0,  -1,-1,0,1 };
+    const float extraViewProj[16] = {
+        1.f / TARGET_WIDTH,0,0,0,  0,1.f / TARGET_HEIGHT,0,0,  0,0,1,0,  -0.5f,-0.5f,0,1 };
+
+    std::vector<uint32_t> nodeVec;
+    std::vector<uint32_t> extraNodeVec;
+
+    createNodes( device, nodeVec, 0, nodeCount, viewProj, seed );
+    createNodes( device, extraNodeVec, nodeCount, extraNodeCount, extraViewProj, seed );
+
+    // Serial path of CStrategy::recordCommandBuffer
+    VkCommandBuffer serialCmdBuf = device.getSerialCmdBuf();
+
+    device.beginCommandBuffer( serialCmdBuf );
+    device.recordNodes( serialCmdBuf, nodeVec, 0, nodeVec.size() );
+    device.recordNodes( serialCmdBuf, extraNodeVec, 0, extraNodeVec.size() );
+    device.endCommandBuffer( serialCmdBuf );
+
+    const std::vector<uint8_t> serialImage = device.render( { serialCmdBuf } );
+
+    // Parallel path. The extra camera chunks follow the default camera chunks
+    const std::vector<VkCommandBuffer> & parallelCmdBufVec = device.getParallelCmdBufVec();
+    const size_t chunkCount = std::min( parallelCmdBufVec.size() / 2, nodeVec.size() / PARALLEL_CHUNK_MIN_NODES );
+
+    if( chunkCount < 2 )
+    {
+        std::printf( "%7zu nodes + %5zu extra: too few nodes to split\n", nodeCount, extraNodeCount );
+        return true;
+    }
+
+    std::vector<std::thread> threadVec;
+    std::vector<std::exception_ptr> exceptionVec( chunkCount * 2 );
+
+    recordChunks( device, parallelCmdBufVec.data(), chunkCount, nodeVec, threadVec, exceptionVec );
+    recordChunks( device, parallelCmdBufVec.data() + chunkCount, chunkCount, extraNodeVec, threadVec, exceptionVec );
+
+    for( auto & iter : threadVec )
+        iter.join();
+
+    for( auto & iter : exceptionVec )
+        if( iter )
+            std::rethrow_exception( iter );
+
+    std::vector<VkCommandBuffer> chunkCmdBufVec( parallelCmdBufVec.begin(), parallelCmdBufVec.begin() + (chunkCount * 2) );
+    const std::vector<uint8_t> chunkImage = device.render( chunkCmdBufVec );
+
+    std::reverse( chunkCmdBufVec.begin(), chunkCmdBufVec.end() );
+    const std::vector<uint8_t> reverseImage = device.render( chunkCmdBufVec );
+
+    size_t diffPixels(0);
+    for( size_t i = 0; i < serialImage.size(); i += 4 )
+        if( std::memcmp( &serialImage[i], &chunkImage[i], 4 ) != 0 )
+            ++diffPixels;
+
+    const bool orderVisible = (serialImage != reverseImage);
+
+    std::printf( "%7zu nodes + %5zu extra, %2zu chunks per camera: %s\n",
+        nodeCount, extraNodeCount, chunkCount,
+        (!orderVisible ? "the scene doesn't show the draw order" :
+        ((diffPixels == 0) ? "match" : boost::str( boost::format("%d pixels differ") % diffPixels ).c_str())) );
+
+    return orderVisible && (diffPixels == 0);
+}
+
+/************************************************************************
+*    DESC:  main
+************************************************************************/
+int main( int argc, char ** argv )
+{
+    int nodes = 2000;
+    int threads = std::max( 1u, std::thread::hardware_concurrency() );
+    std::string shaderDir = DEFAULT_SHADER_DIR;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        const std::string arg( argv[i] );
+
+        if( (i + 1) == argc )
+        {
+            nodes = 0;
+            break;
+        }
+        else if( arg == "--nodes" )
+            nodes = std::atoi( argv[++i] );
+        else if( arg == "--threads" )
+            threads = std::atoi( argv[++i] );
+        else if( arg == "--shaders" )
+            shaderDir = argv[++i];
+        else
+        {
+            nodes = 0;
+            break;
+        }
+    }
+
+    if( (nodes < (int)PARALLEL_CHUNK_MIN_NODES * 2) || (threads <= 0) )
+    {
+        std::printf( "Usage: drawOrderTest [--nodes N] [--threads N] [--shaders dir]\n" );
+        std::printf( "--nodes has to be at least %zu so the strategy gets split\n", PARALLEL_CHUNK_MIN_NODES * 2 );
+        return 1;
+    }
+
+    // Node counts of the default and the extra camera. A few extra nodes
+    // leave empty chunks and an odd count leaves a short last chunk
+    const size_t caseArray[][2] = {
+        { (size_t)nodes, 0 },
+        { (size_t)nodes, 3 },
+        { (size_t)nodes + 1, (size_t)nodes / 2 },
+        { PARALLEL_CHUNK_MIN_NODES * 2, PARALLEL_CHUNK_MIN_NODES } };
+
+    try
+    {
+        size_t uboCount(0);
+        for( auto & iter : caseArray )
+            uboCount = std::max( uboCount, iter[0] + iter[1] );
+
+        // Same command buffer count as CStrategy::createCommandBuffers
+        CTestDevice device( shaderDir, uboCount, (threads + 1) * 2 );
+
+        std::printf( "%d threads, %d command buffers\n\n", threads, (threads + 1) * 2 );
+
+        bool match(true);
+        uint32_t seed(1);
+
+        for( auto & iter : caseArray )
+            match = runCase( device, iter[0], iter[1], seed++ ) && match;
+
+        if( !match )
+        {
+            std::printf( "\nThe chunked recording doesn't draw like the serial recording\n" );
+            return 1;
+        }
+
+        std::printf( "\nThe chunked recording draws like the serial recording\n" );
+    }
+    catch( NExcept::CCriticalException & ex )
+    {
+        std::printf( "%s\n%s\n", ex.getErrorTitle().c_str(), ex.getErrorMsg().c_str() );
+        return 1;
+    }
+    catch( std::exception & ex )
+    {
+        std::printf( "Draw Order Test Error!\n%s\n", ex.what() );
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+
+/************************************************************************
+*    FILE NAME:       SDL.h
+*
+*    DESCRIPTION:     Stands in for SDL2 in the tools when it isn't
+*                     installed. SOIL and the XML parser only use the
+*                     SDL_RWops file calls, which map straight onto stdio
+************************************************************************/
+
+#ifndef __tool_sdl_stdio_h__
+#define __tool_sdl_stdio_h__
+
+// Standard lib dependencies
+#include <stdio.h>
+#include <stdint.h>
+
+typedef uint8_t Uint8;
+typedef uint16_t Uint16;
+typedef uint32_t Uint32;
+typedef int64_t Sint64;
+
+typedef FILE SDL_RWops;
+
+#define RW_SEEK_SET SEEK_SET
+#define RW_SEEK_CUR SEEK_CUR
+#define RW_SEEK_END SEEK_END
+
+static inline SDL_RWops * SDL_RWFromFile( const char * file, const char * mode )
+{
+    return fopen( file, mode );
+}
+
+static inline size_t SDL_RWread( SDL_RWops * context, void * ptr, size_t size, size_t maxnum )
+{
+    return fread( ptr, size, maxnum, context );
+}
+
+static inline size_t SDL_RWwrite( SDL_RWops * context, const void * ptr, size_t size, size_t num )
+{
+    return fwrite( ptr, size, num, context );
+}
+
+// Like SDL, returns the new position or -1 on error
+static inline Sint64 SDL_RWseek( SDL_RWops * context, Sint64 offset, int whence )
+{
+    if( fseek( context, (long)offset, whence ) != 0 )
+        return -1;
+
+    return ftell( context );
+}
+
+static inline Sint64 SDL_RWtell( SDL_RWops * context )
+{
+    return ftell( context );
+}
+
+static inline int SDL_RWclose( SDL_RWops * context )
+{
+    return fclose( context );
+}
+
+static inline Uint16 SDL_Swap16( Uint16 x )
+{
+    return (Uint16)((x << 8) | (x >> 8));
+}
+
+static inline Uint32 SDL_Swap32( Uint32 x )
+{
+    return (x << 24) | ((x << 8) & 0x00FF0000) | ((x >> 8) & 0x0000FF00) | (x >> 24);
+}
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define SDL_SwapLE16(x) SDL_Swap16(x)
+#define SDL_SwapLE32(x) SDL_Swap32(x)
+#define SDL_SwapBE16(x) (x)
+#define SDL_SwapBE32(x) (x)
+#else
+#define SDL_SwapLE16(x) (x)
+#define SDL_SwapLE32(x) (x)
+#define SDL_SwapBE16(x) SDL_Swap16(x)
+#define SDL_SwapBE32(x) SDL_Swap32(x)
+#endif
+
+#endif
@@ -0,0 +1,32 @@
+
+/************************************************************************
+*    FILE NAME:       vulkan.h
+*
+*    DESCRIPTION:     Stands in for the Vulkan SDK header in the tools that
+*                     only need the VkFormat values of the KTX2 container
+*
+*    NOTE:            The values come from the Vulkan spec and never change.
+*                     Only the formats CKtx2File knows about are listed
+************************************************************************/
+
+#ifndef __tool_vulkan_formats_h__
+#define __tool_vulkan_formats_h__
+
+typedef enum VkFormat
+{
+    VK_FORMAT_UNDEFINED = 0,
+    VK_FORMAT_R8G8B8A8_UNORM = 37,
+    VK_FORMAT_BC1_RGB_UNORM_BLOCK = 131,
+    VK_FORMAT_BC1_RGBA_UNORM_BLOCK = 133,
+    VK_FORMAT_BC3_UNORM_BLOCK = 137,
+    VK_FORMAT_BC7_UNORM_BLOCK = 145,
+    VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK = 147,
+    VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK = 149,
+    VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK = 151,
+    VK_FORMAT_ASTC_4x4_UNORM_BLOCK = 157,
+    VK_FORMAT_ASTC_6x6_UNORM_BLOCK = 165,
+    VK_FORMAT_ASTC_8x8_UNORM_BLOCK = 171,
+    VK_FORMAT_MAX_ENUM = 0x7FFFFFFF
+} VkFormat;
+
+#endif
@@ -0,0 +1,163 @@
+
+/************************************************************************
+*    FILE NAME:       matrixBench.cpp
+*
+*    DESCRIPTION:     Runs every matrix function that has a SIMD path
+*                     on the same random data through the SIMD and the
+*                     scalar builds of CMatrix, checks the results agree
+*                     within an epsilon and times both
+*
+*                     matrixBench [count] [passes]
+*
+*    NOTE:            Returns non-zero if any result is out of range
+************************************************************************/
+
+// Game lib dependencies
+#include <matrixkernels.h>
+
+// Standard lib dependencies
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+
+// The allowed difference relative to the size of the values
+const float EPSILON = 1e-4f;
+
+/************************************************************************
+*    DESC:  Fill the matrices with the kind the engine builds, a well
+*           conditioned rotation/scale part and a translation
+************************************************************************/
+void fillMatrices( std::vector<float> & matVec, size_t count, std::mt19937 & rng )
+{
+    std::uniform_real_distribution<float> dist( -1.f, 1.f );
+
+    matVec.resize( count * 16 );
+
+    for( size_t i = 0; i < count; ++i )
+    {
+        float * pMat = matVec.data() + (i * 16);
+
+        for( int row = 0; row < 3; ++row )
+        {
+            for( int col = 0; col < 3; ++col )
+                pMat[(row * 4) + col] = dist( rng ) + ((row == col) ? 3.f : 0.f);
+
+            pMat[(row * 4) + 3] = 0.f;
+        }
+
+        pMat[12] = dist( rng ) * 100.f;
+        pMat[13] = dist( rng ) * 100.f;
+        pMat[14] = dist( rng ) * 100.f;
+        pMat[15] = 1.f;
+    }
+}
+
+/************************************************************************
+*    DESC:  Run a kernel over the data for the number of passes and
+*           return the nanoseconds per item
+************************************************************************/
+double timeKernel( const CMatrixKernel & kernel, const CKernelData & data, std::vector<float> & outVec, int passes )
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    for( int i = 0; i < passes; ++i )
+        kernel.pRun( data, outVec.data() );
+
+    const auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>( end - start ).count() / (double(data.count) * passes);
+}
+
+/************************************************************************
+*    DESC:  Compare the results and return the number out of range
+************************************************************************/
+size_t compare( const std::vector<float> & simdVec, const std::vector<float> & scalarVec, float & maxError )
+{
+    size_t failed = 0;
+
+    for( size_t i = 0; i < simdVec.size(); ++i )
+    {
+        const float scale = std::max( 1.f, std::max( std::fabs(simdVec[i]), std::fabs(scalarVec[i]) ) );
+        const float error = std::fabs( simdVec[i] - scalarVec[i] ) / scale;
+
+        maxError = std::max( maxError, error );
+
+        if( !(error <= EPSILON) )
+            ++failed;
+    }
+
+    return failed;
+}
+
+/************************************************************************
+*    DESC:  main
+************************************************************************/
+int main( int argc, char ** argv )
+{
+    const size_t count = (argc > 1) ? std::strtoul( argv[1], nullptr, 10 ) : 4096;
+    const int passes = (argc > 2) ? std::atoi( argv[2] ) : 200;
+
+    if( (count == 0) || (passes <= 0) )
+    {
+        std::printf( "Usage: matrixBench [count] [passes]\n" );
+        return 1;
+    }
+
+    std::mt19937 rng( 1234 );
+
+    std::vector<float> matAVec, matBVec;
+    fillMatrices( matAVec, count, rng );
+    fillMatrices( matBVec, count, rng );
+
+    std::uniform_real_distribution<float> dist( -500.f, 500.f );
+    std::vector<float> pointVec( count * 12 );
+    for( auto & iter : pointVec )
+        iter = dist( rng );
+
+    CKernelData data;
+    data.pMatA = matAVec.data();
+    data.pMatB = matBVec.data();
+    data.pPoints = pointVec.data();
+    data.count = count;
+
+    const std::vector<CMatrixKernel> & simdVec = getSimdKernels();
+    const std::vector<CMatrixKernel> & scalarVec = getScalarKernels();
+
+    std::printf( "%zu items, %d passes, epsilon %g\n\n", count, passes, EPSILON );
+    std::printf( "%-22s %12s %12s %9s %12s  %s\n", "function", "simd ns", "scalar ns", "speedup", "max error", "result" );
+
+    size_t totalFailed = 0;
+
+    for( size_t i = 0; i < simdVec.size(); ++i )
+    {
+        std::vector<float> simdOutVec( count * simdVec[i].stride );
+        std::vector<float> scalarOutVec( count * scalarVec[i].stride );
+
+        // One untimed run of each to check the results and warm the caches
+        simdVec[i].pRun( data, simdOutVec.data() );
+        scalarVec[i].pRun( data, scalarOutVec.data() );
+
+        float maxError = 0.f;
+        const size_t failed = compare( simdOutVec, scalarOutVec, maxError );
+        totalFailed += failed;
+
+        const double simdTime = timeKernel( simdVec[i], data, simdOutVec, passes );
+        const double scalarTime = timeKernel( scalarVec[i], data, scalarOutVec, passes );
+
+        std::printf( "%-22s %12.2f %12.2f %8.2fx %12.3g  %s\n",
+            simdVec[i].pName, simdTime, scalarTime, scalarTime / simdTime, maxError,
+            (failed == 0) ? "ok" : "FAILED" );
+    }
+
+    if( totalFailed > 0 )
+    {
+        std::printf( "\n%zu values differ by more than the epsilon\n", totalFailed );
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,52 @@
+
+/************************************************************************
+*    FILE NAME:       matrixkernels.h
+*
+*    DESCRIPTION:     The matrix functions with a SIMD path, wrapped so
+*                     the SIMD and the scalar builds of CMatrix can be
+*                     run on the same data
+************************************************************************/
+
+#ifndef __matrix_kernels_h__
+#define __matrix_kernels_h__
+
+// Standard lib dependencies
+#include <cstddef>
+#include <vector>
+
+/************************************************************************
+*    The data every kernel works on. Matrices are 16 floats each and
+*    points are 4 x,y,z triples each so a quad can use them
+************************************************************************/
+class CKernelData
+{
+public:
+
+    const float * pMatA = nullptr;
+    const float * pMatB = nullptr;
+    const float * pPoints = nullptr;
+    size_t count = 0;
+};
+
+/************************************************************************
+*    A kernel runs one matrix function over all the items in the data
+************************************************************************/
+class CMatrixKernel
+{
+public:
+
+    const char * pName;
+
+    // The number of floats written per item
+    size_t stride;
+
+    void (*pRun)( const CKernelData & data, float * pOut );
+};
+
+// The kernels of the SIMD build of CMatrix
+const std::vector<CMatrixKernel> & getSimdKernels();
+
+// The kernels of the scalar build of CMatrix
+const std::vector<CMatrixKernel> & getScalarKernels();
+
+#endif
@@ -0,0 +1,201 @@
+
+/************************************************************************
+*    FILE NAME:       matrixkernels.inl
+*
+*    DESCRIPTION:     The kernel bodies. Included by simdkernels.cpp and
+*                     scalarkernels.cpp after CMatrix is declared so
+*                     each one binds to its own build of the matrix
+************************************************************************/
+
+namespace
+{
+    /************************************************************************
+    *    DESC:  operator *
+    ************************************************************************/
+    void multiply( const CKernelData & data, float * pOut )
+    {
+        for( size_t i = 0; i < data.count; ++i )
+        {
+            const CMatrix matA( const_cast<float *>(data.pMatA + (i * 16)) );
+            const CMatrix matB( const_cast<float *>(data.pMatB + (i * 16)) );
+
+            const CMatrix result = matA * matB;
+            std::memcpy( pOut + (i * 16), result(), sizeof(float) * 16 );
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  operator *=
+    ************************************************************************/
+    void multiplyAssign( const CKernelData & data, float * pOut )
+    {
+        for( size_t i = 0; i < data.count; ++i )
+        {
+            CMatrix matA( const_cast<float *>(data.pMatA + (i * 16)) );
+            const CMatrix matB( const_cast<float *>(data.pMatB + (i * 16)) );
+
+            matA *= matB;
+            std::memcpy( pOut + (i * 16), matA(), sizeof(float) * 16 );
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  mergeMatrix
+    ************************************************************************/
+    void mergeMatrix( const CKernelData & data, float * pOut )
+    {
+        for( size_t i = 0; i < data.count; ++i )
+        {
+            CMatrix matA( const_cast<float *>(data.pMatA + (i * 16)) );
+            const CMatrix matB( const_cast<float *>(data.pMatB + (i * 16)) );
+
+            matA.mergeMatrix( matB );
+            std::memcpy( pOut + (i * 16), matA(), sizeof(float) * 16 );
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  multiply3x3
+    ************************************************************************/
+    void multiply3x3( const CKernelData & data, float * pOut )
+    {
+        for( size_t i = 0; i < data.count; ++i )
+        {
+            CMatrix matA( const_cast<float *>(data.pMatA + (i * 16)) );
+            const CMatrix matB( const_cast<float *>(data.pMatB + (i * 16)) );
+
+            matA.multiply3x3( matB );
+            std::memcpy( pOut + (i * 16), matA(), sizeof(float) * 16 );
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  inverse. The last float is the returned flag
+    ************************************************************************/
+    void inverse( const CKernelData & data, float * pOut )
+    {
+        for( size_t i = 0; i < data.count; ++i )
+        {
+            CMatrix matA( const_cast<float *>(data.pMatA + (i * 16)) );
+
+            const bool result = matA.inverse();
+            std::memcpy( pOut + (i * 17), matA(), sizeof(float) * 16 );
+            pOut[(i * 17) + 16] = (result ? 1.f : 0.f);
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  transform a point
+    ************************************************************************/
+    void transformPoint( const CKernelData & data, float * pOut )
+    {
+        for( size_t i = 0; i < data.count; ++i )
+        {
+            const CMatrix matA( const_cast<float *>(data.pMatA + (i * 16)) );
+            const float * pSrc = data.pPoints + (i * 12);
+
+            CPoint<float> dest;
+            matA.transform( dest, CPoint<float>( pSrc[0], pSrc[1], pSrc[2] ) );
+
+            pOut[(i * 3)] = dest.x;
+            pOut[(i * 3) + 1] = dest.y;
+            pOut[(i * 3) + 2] = dest.z;
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  transform a point through pointers
+    ************************************************************************/
+    void transformPointPtr( const CKernelData & data, float * pOut )
+    {
+        for( size_t i = 0; i < data.count; ++i )
+        {
+            const CMatrix matA( const_cast<float *>(data.pMatA + (i * 16)) );
+            const float * pSrc = data.pPoints + (i * 12);
+
+            const CPoint<float> source( pSrc[0], pSrc[1], pSrc[2] );
+            CPoint<float> dest;
+            matA.transform( &dest, &source );
+
+            pOut[(i * 3)] = dest.x;
+            pOut[(i * 3) + 1] = dest.y;
+            pOut[(i * 3) + 2] = dest.z;
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  transform a normal
+    ************************************************************************/
+    void transformNormal( const CKernelData & data, float * pOut )
+    {
+        for( size_t i = 0; i < data.count; ++i )
+        {
+            const CMatrix matA( const_cast<float *>(data.pMatA + (i * 16)) );
+            const float * pSrc = data.pPoints + (i * 12);
+
+            CNormal<float> dest;
+            matA.transform( dest, CNormal<float>( pSrc[0], pSrc[1], pSrc[2] ) );
+
+            pOut[(i * 3)] = dest.x;
+            pOut[(i * 3) + 1] = dest.y;
+            pOut[(i * 3) + 2] = dest.z;
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  transform3x3
+    ************************************************************************/
+    void transform3x3( const CKernelData & data, float * pOut )
+    {
+        for( size_t i = 0; i < data.count; ++i )
+        {
+            const CMatrix matA( const_cast<float *>(data.pMatA + (i * 16)) );
+            const float * pSrc = data.pPoints + (i * 12);
+
+            CPoint<float> dest;
+            matA.transform3x3( dest, CPoint<float>( pSrc[0], pSrc[1], pSrc[2] ) );
+
+            pOut[(i * 3)] = dest.x;
+            pOut[(i * 3) + 1] = dest.y;
+            pOut[(i * 3) + 2] = dest.z;
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  transform a quad
+    ************************************************************************/
+    void transformQuad( const CKernelData & data, float * pOut )
+    {
+        for( size_t i = 0; i < data.count; ++i )
+        {
+            const CMatrix matA( const_cast<float *>(data.pMatA + (i * 16)) );
+            const float * pSrc = data.pPoints + (i * 12);
+
+            CQuad source;
+            for( int j = 0; j < 4; ++j )
+                source.point[j] = CPoint<float>( pSrc[j * 3], pSrc[(j * 3) + 1], pSrc[(j * 3) + 2] );
+
+            CQuad dest;
+            matA.transform( dest, source );
+
+            for( int j = 0; j < 4; ++j )
+            {
+                pOut[(i * 12) + (j * 3)] = dest.point[j].x;
+                pOut[(i * 12) + (j * 3) + 1] = dest.point[j].y;
+                pOut[(i * 12) + (j * 3) + 2] = dest.point[j].z;
+            }
+        }
+    }
+
+    const std::vector<CMatrixKernel> kernelVec = {
+        {"operator *", 16, multiply},
+        {"operator *=", 16, multiplyAssign},
+        {"mergeMatrix", 16, mergeMatrix},
+        {"multiply3x3", 16, multiply3x3},
+        {"inverse", 17, inverse},
+        {"transform point", 3, transformPoint},
+        {"transform point ptr", 3, transformPointPtr},
+        {"transform normal", 3, transformNormal},
+        {"transform3x3", 3, transform3x3},
+        {"transform quad", 12, transformQuad} };
+}
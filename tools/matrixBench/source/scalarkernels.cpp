@@ -0,0 +1,27 @@
+
+/************************************************************************
+*    FILE NAME:       scalarkernels.cpp
+*
+*    DESCRIPTION:     The kernels bound to a scalar build of CMatrix.
+*                     matrix.cpp is compiled here a second time with
+*                     MATRIX_SCALAR and the class renamed so it can sit
+*                     next to the SIMD build in the same executable
+************************************************************************/
+
+// Physical component dependency
+#include <matrixkernels.h>
+
+// The scalar build of the matrix
+#define MATRIX_SCALAR
+#define CMatrix CScalarMatrix
+#include <utilities/matrix.cpp>
+
+#include <matrixkernels.inl>
+
+/************************************************************************
+*    DESC:  Get the kernels of the scalar build
+************************************************************************/
+const std::vector<CMatrixKernel> & getScalarKernels()
+{
+    return kernelVec;
+}
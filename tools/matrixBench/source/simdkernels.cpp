@@ -0,0 +1,25 @@
+
+/************************************************************************
+*    FILE NAME:       simdkernels.cpp
+*
+*    DESCRIPTION:     The kernels bound to the SIMD build of CMatrix.
+*                     matrix.cpp is compiled here the same way as in
+*                     scalarkernels.cpp so both get the same inlining
+************************************************************************/
+
+// Physical component dependency
+#include <matrixkernels.h>
+
+// The SIMD build of the matrix
+#define CMatrix CSimdMatrix
+#include <utilities/matrix.cpp>
+
+#include <matrixkernels.inl>
+
+/************************************************************************
+*    DESC:  Get the kernels of the SIMD build
+************************************************************************/
+const std::vector<CMatrixKernel> & getSimdKernels()
+{
+    return kernelVec;
+}
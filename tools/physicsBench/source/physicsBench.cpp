@@ -0,0 +1,370 @@
+
+/************************************************************************
+*    FILE NAME:       physicsBench.cpp
+*
+*    DESCRIPTION:     Builds the same Pachinko style board in several
+*                     Box2D worlds and steps them one after the other and
+*                     then in parallel, one world per thread with a join
+*                     after every step like CPhysicsWorldManager2D
+*
+*                     physicsBench [--worlds N] [--threads N] [--steps N]
+*                                  [--bodies N]
+*
+*                     --threads N runs the parallel step with 1, 2, 4...
+*                     up to N threads so the scaling against the core
+*                     count shows up in one run
+*
+*    NOTE:            The bodies of every parallel run have to end up in
+*                     the same place as the serial run. Returns non-zero
+*                     if not
+************************************************************************/
+
+// Box2D lib dependencies
+#include <Box2D/Box2D.h>
+
+// Standard lib dependencies
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+// Same settings as PachinkoChallenge's gamePhysics.cfg
+const b2Vec2 GRAVITY( 0, 40 );
+const float STEP_TIME = 1.f / 60.f;
+const int VELOCITY_STEPS = 6;
+const int POSITION_STEPS = 2;
+
+/************************************************************************
+*    Runs a function over an index range on a set of threads and joins
+*    NOTE: The calling thread takes part so threads - 1 are started
+************************************************************************/
+class CStepPool
+{
+public:
+
+    explicit CStepPool( int threads )
+    {
+        for( int i = 1; i < threads; ++i )
+            m_threadVec.emplace_back( &CStepPool::workerLoop, this );
+    }
+
+    ~CStepPool()
+    {
+        {
+            std::unique_lock<std::mutex> lock( m_mutex );
+            m_stop = true;
+        }
+
+        m_condVar.notify_all();
+
+        for( auto & iter : m_threadVec )
+            iter.join();
+    }
+
+    // Call the function for every index and return when they are all done
+    void run( size_t count, const std::function<void(size_t)> & func )
+    {
+        {
+            std::unique_lock<std::mutex> lock( m_mutex );
+            m_pFunc = &func;
+            m_count = count;
+            m_next = 0;
+            m_working = m_threadVec.size();
+            ++m_generation;
+        }
+
+        m_condVar.notify_all();
+
+        work();
+
+        std::unique_lock<std::mutex> lock( m_mutex );
+        m_doneCondVar.wait( lock, [this] { return m_working == 0; } );
+    }
+
+private:
+
+    void workerLoop()
+    {
+        size_t generation(0);
+
+        while( true )
+        {
+            {
+                std::unique_lock<std::mutex> lock( m_mutex );
+                m_condVar.wait( lock, [this, generation] { return m_stop || (m_generation != generation); } );
+
+                if( m_stop )
+                    break;
+
+                generation = m_generation;
+            }
+
+            work();
+
+            std::unique_lock<std::mutex> lock( m_mutex );
+            if( --m_working == 0 )
+                m_doneCondVar.notify_all();
+        }
+    }
+
+    void work()
+    {
+        size_t index;
+        while( (index = m_next++) < m_count )
+            (*m_pFunc)( index );
+    }
+
+private:
+
+    std::vector<std::thread> m_threadVec;
+    std::mutex m_mutex;
+    std::condition_variable m_condVar;
+    std::condition_variable m_doneCondVar;
+    const std::function<void(size_t)> * m_pFunc = nullptr;
+    size_t m_count = 0;
+    std::atomic_size_t m_next{0};
+    size_t m_working = 0;
+    size_t m_generation = 0;
+    bool m_stop = false;
+};
+
+/************************************************************************
+*    DESC:  Build a board of static pegs between two walls and drop the
+*           balls in from the top
+*
+*    NOTE:  The walls grow with the ball count so thousands of balls
+*           stay on the board
+************************************************************************/
+std::unique_ptr<b2World> createBoard( int balls )
+{
+    std::unique_ptr<b2World> upWorld( new b2World( GRAVITY ) );
+
+    // Walls and floor
+    {
+        const float wallTop = std::min( -40.f, -30.f - ((balls / 20) * 1.1f) );
+
+        b2BodyDef bodyDef;
+        b2Body * pBody = upWorld->CreateBody( &bodyDef );
+
+        b2EdgeShape edge;
+        edge.Set( b2Vec2(-24, wallTop), b2Vec2(-24, 20) );
+        pBody->CreateFixture( &edge, 0 );
+        edge.Set( b2Vec2(24, wallTop), b2Vec2(24, 20) );
+        pBody->CreateFixture( &edge, 0 );
+        edge.Set( b2Vec2(-24, 20), b2Vec2(24, 20) );
+        pBody->CreateFixture( &edge, 0 );
+    }
+
+    // Rows of pegs with every other row offset
+    b2CircleShape pegShape;
+    pegShape.m_radius = 0.25f;
+
+    for( int row = 0; row < 14; ++row )
+    {
+        for( int col = 0; col < 15; ++col )
+        {
+            b2BodyDef bodyDef;
+            bodyDef.position.Set( -21.f + (col * 3.f) + ((row % 2) * 1.5f), -20.f + (row * 2.5f) );
+
+            upWorld->CreateBody( &bodyDef )->CreateFixture( &pegShape, 0 );
+        }
+    }
+
+    // The balls start in a block above the pegs
+    b2CircleShape ballShape;
+    ballShape.m_radius = 0.5f;
+
+    b2FixtureDef fixtureDef;
+    fixtureDef.shape = &ballShape;
+    fixtureDef.density = 1.f;
+    fixtureDef.restitution = 0.5f;
+    fixtureDef.friction = 0.3f;
+
+    for( int i = 0; i < balls; ++i )
+    {
+        b2BodyDef bodyDef;
+        bodyDef.type = b2_dynamicBody;
+        bodyDef.bullet = ((i % 8) == 0);
+        bodyDef.position.Set( -20.f + ((i % 20) * 2.05f) + ((i / 20) % 2) * 0.3f, -25.f - ((i / 20) * 1.1f) );
+
+        upWorld->CreateBody( &bodyDef )->CreateFixture( &fixtureDef );
+    }
+
+    return upWorld;
+}
+
+/************************************************************************
+*    DESC:  Build the worlds
+************************************************************************/
+std::vector<std::unique_ptr<b2World>> createWorlds( int worlds, int balls )
+{
+    std::vector<std::unique_ptr<b2World>> upWorldVec;
+
+    for( int i = 0; i < worlds; ++i )
+        upWorldVec.push_back( createBoard( balls ) );
+
+    return upWorldVec;
+}
+
+/************************************************************************
+*    DESC:  Get the position and angle of every body of the worlds
+************************************************************************/
+std::vector<float> getState( const std::vector<std::unique_ptr<b2World>> & upWorldVec )
+{
+    std::vector<float> stateVec;
+
+    for( auto & iter : upWorldVec )
+    {
+        for( const b2Body * pBody = iter->GetBodyList(); pBody != nullptr; pBody = pBody->GetNext() )
+        {
+            stateVec.push_back( pBody->GetPosition().x );
+            stateVec.push_back( pBody->GetPosition().y );
+            stateVec.push_back( pBody->GetAngle() );
+        }
+    }
+
+    return stateVec;
+}
+
+/************************************************************************
+*    DESC:  Step the worlds one after the other and return the time in ms
+************************************************************************/
+double stepSerial( std::vector<std::unique_ptr<b2World>> & upWorldVec, int steps )
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    for( int step = 0; step < steps; ++step )
+        for( auto & iter : upWorldVec )
+            iter->Step( STEP_TIME, VELOCITY_STEPS, POSITION_STEPS );
+
+    return std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+}
+
+/************************************************************************
+*    DESC:  Step the worlds on a pool of threads and return the time in ms
+************************************************************************/
+double stepParallel( std::vector<std::unique_ptr<b2World>> & upWorldVec, int steps, int threads )
+{
+    CStepPool pool( threads );
+
+    const std::function<void(size_t)> stepWorld =
+        [&upWorldVec]( size_t index )
+        { upWorldVec[index]->Step( STEP_TIME, VELOCITY_STEPS, POSITION_STEPS ); };
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for( int step = 0; step < steps; ++step )
+        pool.run( upWorldVec.size(), stepWorld );
+
+    return std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+}
+
+/************************************************************************
+*    DESC:  The thread counts to sweep. 1, 2, 4... and always the max
+************************************************************************/
+std::vector<int> getThreadSweep( int maxThreads )
+{
+    std::vector<int> threadVec;
+
+    for( int threads = 1; threads < maxThreads; threads *= 2 )
+        threadVec.push_back( threads );
+
+    threadVec.push_back( maxThreads );
+
+    return threadVec;
+}
+
+/************************************************************************
+*    DESC:  main
+************************************************************************/
+int main( int argc, char ** argv )
+{
+    int worlds = 4;
+    int threads = std::max( 1u, std::thread::hardware_concurrency() );
+    int steps = 600;
+    int balls = 300;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        const std::string arg( argv[i] );
+        int * pValue = nullptr;
+
+        if( arg == "--worlds" )
+            pValue = &worlds;
+        else if( arg == "--threads" )
+            pValue = &threads;
+        else if( arg == "--steps" )
+            pValue = &steps;
+        else if( arg == "--bodies" )
+            pValue = &balls;
+
+        if( (pValue == nullptr) || (++i == argc) )
+        {
+            worlds = 0;
+            break;
+        }
+
+        *pValue = std::atoi( argv[i] );
+    }
+
+    if( (worlds <= 0) || (threads <= 0) || (steps <= 0) || (balls < 0) )
+    {
+        std::printf( "Usage: physicsBench [--worlds N] [--threads N] [--steps N] [--bodies N]\n" );
+        return 1;
+    }
+
+    std::printf( "%d worlds, %d steps, %d balls per world, %u cores\n\n",
+        worlds, steps, balls, std::thread::hardware_concurrency() );
+
+    // Serial
+    auto upSerialWorldVec = createWorlds( worlds, balls );
+    const double serialTime = stepSerial( upSerialWorldVec, steps );
+    const std::vector<float> serialStateVec = getState( upSerialWorldVec );
+
+    int contacts(0);
+    for( auto & iter : upSerialWorldVec )
+        contacts += iter->GetContactCount();
+
+    std::printf( "threads       total ms   ms per step   speedup\n" );
+    std::printf( " serial     %10.2f    %10.3f     1.00x\n", serialTime, serialTime / steps );
+
+    // Parallel with a growing thread count. Worlds share nothing so the
+    // thread count can't change the result
+    bool match(true);
+
+    for( int sweepThreads : getThreadSweep( threads ) )
+    {
+        auto upParallelWorldVec = createWorlds( worlds, balls );
+        const double parallelTime = stepParallel( upParallelWorldVec, steps, sweepThreads );
+        const std::vector<float> parallelStateVec = getState( upParallelWorldVec );
+
+        const bool sweepMatch = (serialStateVec.size() == parallelStateVec.size()) &&
+            (std::memcmp( serialStateVec.data(), parallelStateVec.data(), serialStateVec.size() * sizeof(float) ) == 0);
+
+        std::printf( "%7d     %10.2f    %10.3f  %8.2fx%s\n",
+            sweepThreads, parallelTime, parallelTime / steps, serialTime / parallelTime, sweepMatch ? "" : "  MISMATCH" );
+
+        match = match && sweepMatch;
+    }
+
+    std::printf( "\ncontacts at the end: %d\n", contacts );
+
+    if( !match )
+    {
+        std::printf( "\nA parallel run doesn't match the serial run\n" );
+        return 1;
+    }
+
+    std::printf( "\nThe parallel runs match the serial run\n" );
+
+    return 0;
+}
@@ -0,0 +1,301 @@
+
+/************************************************************************
+*    FILE NAME:       scriptBench.cpp
+*
+*    DESCRIPTION:     Times the per call overhead of the script API
+*                     bindings. setPos and incRot are registered in one
+*                     engine the way the library did before, through the
+*                     autowrapper with asCALL_GENERIC, and in another
+*                     through the SCRIPT_* macros of script/scriptwrap.h
+*                     which use the native calling conventions
+*
+*                     scriptBench [calls]
+*
+*    NOTE:            The sprite is a stand in with the same members and
+*                     setters as CObject so the engine isn't needed
+************************************************************************/
+
+// Game lib dependencies
+#include <common/point.h>
+#include <common/defs.h>
+#include <script/scriptwrap.h>
+
+// AngelScript lib dependencies
+#include <angelscript.h>
+#include <autowrapper/aswrappedcall.h>
+
+// Standard lib dependencies
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <chrono>
+#include <new>
+
+/************************************************************************
+*    Same setters as CObject
+************************************************************************/
+class CBenchSprite
+{
+public:
+
+    void setPos( const CPoint<float> & position )
+    {
+        m_parameters |= TRANSLATE;
+        m_pos = position;
+    }
+
+    void setPos( float x, float y, float z )
+    {
+        m_parameters |= TRANSLATE;
+        m_pos.set( x, y, z );
+    }
+
+    void incRot( const CPoint<float> & rotation, bool convertToRadians )
+    {
+        m_parameters |= ROTATE;
+
+        if( convertToRadians )
+            m_rot += rotation * defs_DEG_TO_RAD;
+        else
+            m_rot += rotation;
+
+        m_rot.cap(360.0f * defs_DEG_TO_RAD);
+    }
+
+    void incRot( float x, float y, float z, bool convertToRadians )
+    {
+        m_parameters |= ROTATE;
+
+        if( convertToRadians )
+            m_rot.inc( x * defs_DEG_TO_RAD, y * defs_DEG_TO_RAD, z * defs_DEG_TO_RAD );
+        else
+            m_rot.inc( x, y, z );
+    }
+
+    enum { TRANSLATE = 1, ROTATE = 2 };
+
+    CPoint<float> m_pos;
+    CPoint<float> m_rot;
+    uint32_t m_parameters = 0;
+};
+
+/************************************************************************
+*    The object last helpers the way script/scriptsprite.cpp has them
+************************************************************************/
+namespace NBench
+{
+    void PointConstructor( float x, float y, float z, void * pThisPointer )
+    {
+        new(pThisPointer) CPoint<float>(x, y, z);
+    }
+
+    void SetSpritePos1( const CPoint<float> & pos, CBenchSprite & sprite )
+    {
+        sprite.setPos(pos);
+    }
+
+    void SetSpritePos2( float x, float y, float z, CBenchSprite & sprite )
+    {
+        sprite.setPos(x,y,z);
+    }
+
+    void IncSpriteRot1( const CPoint<float> & rot, bool convertToRadians, CBenchSprite & sprite )
+    {
+        sprite.incRot(rot, convertToRadians);
+    }
+
+    void IncSpriteRot2( float x, float y, float z, bool convertToRadians, CBenchSprite & sprite )
+    {
+        sprite.incRot(x,y,z, convertToRadians);
+    }
+}
+
+// The methods are registered on the point and sprite types in both engines
+const char * POINT_CONSTRUCT = "void f(float, float, float)";
+const char * SET_POS_1 = "void setPos(const CPoint &in)";
+const char * SET_POS_2 = "void setPos(float x = 0, float y = 0, float z = 0)";
+const char * INC_ROT_1 = "void incRot(const CPoint &in, bool convertToRadians = true)";
+const char * INC_ROT_2 = "void incRot(float x = 0, float y = 0, float z = 0, bool convertToRadians = true)";
+const char * SET_POS_MEMBER = "void setPosMember(float, float, float)";
+
+// Each function runs its call in a loop. empty() is the cost of the loop itself
+const char * SCRIPT_SOURCE =
+    "void empty( CSprite & sprite, int count )\n"
+    "{ for( int i = 0; i < count; ++i ) {} }\n"
+    "void setPosPoint( CSprite & sprite, int count )\n"
+    "{ CPoint pos(1, 2, 3); for( int i = 0; i < count; ++i ) sprite.setPos( pos ); }\n"
+    "void setPosFloats( CSprite & sprite, int count )\n"
+    "{ for( int i = 0; i < count; ++i ) sprite.setPos( 1, 2, 3 ); }\n"
+    "void setPosMember( CSprite & sprite, int count )\n"
+    "{ for( int i = 0; i < count; ++i ) sprite.setPosMember( 1, 2, 3 ); }\n"
+    "void incRotPoint( CSprite & sprite, int count )\n"
+    "{ CPoint rot(0, 0, 1); for( int i = 0; i < count; ++i ) sprite.incRot( rot ); }\n"
+    "void incRotFloats( CSprite & sprite, int count )\n"
+    "{ for( int i = 0; i < count; ++i ) sprite.incRot( 0, 0, 1 ); }\n";
+
+/************************************************************************
+*    DESC:  Print the messages of the script compiler
+************************************************************************/
+void MessageCallback( const asSMessageInfo * pMsg, void * pParam )
+{
+    std::printf( "%s (%d, %d) : %s\n", pMsg->section, pMsg->row, pMsg->col, pMsg->message );
+}
+
+/************************************************************************
+*    DESC:  Exit on a failed registration
+************************************************************************/
+void Throw( int value )
+{
+    if( value < 0 )
+    {
+        std::printf( "Function could not be registered: %d\n", value );
+        std::exit( 1 );
+    }
+}
+
+/************************************************************************
+*    DESC:  Register the types the way the library did with the generic
+*           calling convention
+************************************************************************/
+void RegisterGeneric( asIScriptEngine * pEngine )
+{
+    using namespace NBench;
+
+    Throw( pEngine->RegisterObjectType("CPoint", sizeof(CPoint<float>), asOBJ_VALUE | asOBJ_POD | asGetTypeTraits<CPoint<float>>() | asOBJ_APP_CLASS_ALLFLOATS ) );
+    Throw( pEngine->RegisterObjectBehaviour("CPoint", asBEHAVE_CONSTRUCT, POINT_CONSTRUCT, WRAP_OBJ_LAST(PointConstructor), asCALL_GENERIC) );
+
+    Throw( pEngine->RegisterObjectType("CSprite", 0, asOBJ_REF|asOBJ_NOCOUNT) );
+    Throw( pEngine->RegisterObjectMethod("CSprite", SET_POS_1, WRAP_OBJ_LAST(SetSpritePos1), asCALL_GENERIC) );
+    Throw( pEngine->RegisterObjectMethod("CSprite", SET_POS_2, WRAP_OBJ_LAST(SetSpritePos2), asCALL_GENERIC) );
+    Throw( pEngine->RegisterObjectMethod("CSprite", INC_ROT_1, WRAP_OBJ_LAST(IncSpriteRot1), asCALL_GENERIC) );
+    Throw( pEngine->RegisterObjectMethod("CSprite", INC_ROT_2, WRAP_OBJ_LAST(IncSpriteRot2), asCALL_GENERIC) );
+    Throw( pEngine->RegisterObjectMethod("CSprite", SET_POS_MEMBER, WRAP_MFN_PR(CBenchSprite, setPos, (float, float, float), void), asCALL_GENERIC) );
+}
+
+/************************************************************************
+*    DESC:  Register the types through the scriptwrap.h macros
+************************************************************************/
+void RegisterScriptWrap( asIScriptEngine * pEngine )
+{
+    using namespace NBench;
+
+    Throw( pEngine->RegisterObjectType("CPoint", sizeof(CPoint<float>), asOBJ_VALUE | asOBJ_POD | asGetTypeTraits<CPoint<float>>() | asOBJ_APP_CLASS_ALLFLOATS ) );
+    Throw( pEngine->RegisterObjectBehaviour("CPoint", asBEHAVE_CONSTRUCT, POINT_CONSTRUCT, SCRIPT_OBJ_LAST(PointConstructor)) );
+
+    Throw( pEngine->RegisterObjectType("CSprite", 0, asOBJ_REF|asOBJ_NOCOUNT) );
+    Throw( pEngine->RegisterObjectMethod("CSprite", SET_POS_1, SCRIPT_OBJ_LAST(SetSpritePos1)) );
+    Throw( pEngine->RegisterObjectMethod("CSprite", SET_POS_2, SCRIPT_OBJ_LAST(SetSpritePos2)) );
+    Throw( pEngine->RegisterObjectMethod("CSprite", INC_ROT_1, SCRIPT_OBJ_LAST(IncSpriteRot1)) );
+    Throw( pEngine->RegisterObjectMethod("CSprite", INC_ROT_2, SCRIPT_OBJ_LAST(IncSpriteRot2)) );
+    Throw( pEngine->RegisterObjectMethod("CSprite", SET_POS_MEMBER, SCRIPT_MFN_PR(CBenchSprite, setPos, (float, float, float), void)) );
+}
+
+/************************************************************************
+*    Engine with the script built
+************************************************************************/
+class CBenchEngine
+{
+public:
+
+    explicit CBenchEngine( void (*pRegister)(asIScriptEngine *) )
+    {
+        m_pEngine = asCreateScriptEngine();
+        m_pEngine->SetMessageCallback( asFUNCTION(MessageCallback), nullptr, asCALL_CDECL );
+
+        pRegister( m_pEngine );
+
+        asIScriptModule * pModule = m_pEngine->GetModule( "bench", asGM_ALWAYS_CREATE );
+        pModule->AddScriptSection( "bench", SCRIPT_SOURCE );
+        Throw( pModule->Build() );
+
+        m_pContext = m_pEngine->CreateContext();
+    }
+
+    ~CBenchEngine()
+    {
+        m_pContext->Release();
+        m_pEngine->ShutDownAndRelease();
+    }
+
+    // Run the script function and return the nanoseconds per loop
+    double run( const std::string & name, CBenchSprite & sprite, int count )
+    {
+        asIScriptFunction * pFunc = m_pEngine->GetModule( "bench" )->GetFunctionByName( name.c_str() );
+
+        m_pContext->Prepare( pFunc );
+        m_pContext->SetArgAddress( 0, &sprite );
+        m_pContext->SetArgDWord( 1, count );
+
+        const auto start = std::chrono::steady_clock::now();
+
+        if( m_pContext->Execute() != asEXECUTION_FINISHED )
+        {
+            std::printf( "%s didn't finish\n", name.c_str() );
+            std::exit( 1 );
+        }
+
+        const auto end = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::nano>( end - start ).count() / count;
+    }
+
+private:
+
+    asIScriptEngine * m_pEngine = nullptr;
+    asIScriptContext * m_pContext = nullptr;
+};
+
+/************************************************************************
+*    DESC:  main
+************************************************************************/
+int main( int argc, char ** argv )
+{
+    const int count = (argc > 1) ? std::atoi( argv[1] ) : 2000000;
+
+    if( count <= 0 )
+    {
+        std::printf( "Usage: scriptBench [calls]\n" );
+        return 1;
+    }
+
+    std::printf( "AngelScript %s %s\n", asGetLibraryVersion(), asGetLibraryOptions() );
+    std::printf( "scriptwrap.h native calls: %s\n", NScriptWrap::UseNativeCalls() ? "yes" : "no (AS_MAX_PORTABILITY)" );
+    std::printf( "%d calls each, ns per call with the script loop taken out\n\n", count );
+
+    CBenchEngine genericEngine( RegisterGeneric );
+    CBenchEngine nativeEngine( RegisterScriptWrap );
+
+    CBenchSprite genericSprite, nativeSprite;
+
+    // Warm up and time the loop on its own
+    genericEngine.run( "empty", genericSprite, count );
+    nativeEngine.run( "empty", nativeSprite, count );
+    const double genericLoop = genericEngine.run( "empty", genericSprite, count );
+    const double nativeLoop = nativeEngine.run( "empty", nativeSprite, count );
+
+    std::printf( "%-34s %10s %10s %9s\n", "call", "generic", "native", "speedup" );
+
+    const char * nameAry[][2] = {
+        {"setPosPoint", "setPos(CPoint &in) obj last"},
+        {"setPosFloats", "setPos(float,float,float) obj last"},
+        {"setPosMember", "setPos(float,float,float) method"},
+        {"incRotPoint", "incRot(CPoint &in, bool) obj last"},
+        {"incRotFloats", "incRot(float,float,float,bool)"} };
+
+    for( auto & iter : nameAry )
+    {
+        const double genericTime = genericEngine.run( iter[0], genericSprite, count ) - genericLoop;
+        const double nativeTime = nativeEngine.run( iter[0], nativeSprite, count ) - nativeLoop;
+
+        std::printf( "%-34s %10.2f %10.2f %8.2fx\n", iter[1], genericTime, nativeTime, genericTime / nativeTime );
+    }
+
+    // Both engines made the same calls so the sprites have to agree
+    if( (genericSprite.m_pos != nativeSprite.m_pos) || (genericSprite.m_rot != nativeSprite.m_rot) )
+    {
+        std::printf( "\nThe generic and native calls left the sprites in different states\n" );
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,315 @@
+
+/************************************************************************
+*    FILE NAME:       textureBaker.cpp
+*
+*    DESCRIPTION:     Bakes the source images under a folder into KTX2
+*                     files with all the mip levels the engine loads in
+*                     place of the images
+*
+*                     name.png.bc.ktx2  - BC1 if the image is opaque, else BC3
+*                     name.png.ktx2     - RGBA8 with --rgba. Devices without
+*                                         BCn support otherwise decode the
+*                                         source image
+*
+*    NOTE:            ASTC (name.png.astc.ktx2) and ETC2 (name.png.etc2.ktx2)
+*                     are loaded by the engine but need an external encoder
+************************************************************************/
+
+// Game lib dependencies
+#include <common/ktx2file.h>
+#include <utilities/exceptionhandling.h>
+#include <soil/SOIL.h>
+
+// The DXT header has no C++ guard
+extern "C"
+{
+#include <soil/image_DXT.h>
+}
+
+// Standard lib dependencies
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+/************************************************************************
+*    Image level in RGBA8
+************************************************************************/
+class CImageLevel
+{
+public:
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> pixelVec;
+};
+
+/************************************************************************
+*    Running totals for the summary
+************************************************************************/
+class CBakeTotals
+{
+public:
+
+    uint32_t fileCount = 0;
+    uint32_t skipCount = 0;
+    uintmax_t sourceBytes = 0;
+    uintmax_t rgbaBytes = 0;
+    uintmax_t bcBytes = 0;
+    double decodeMs = 0;
+    double ktx2ReadMs = 0;
+};
+
+/************************************************************************
+*    DESC:  Get the elapsed time in milliseconds
+************************************************************************/
+double GetElapsedMs( std::chrono::steady_clock::time_point startTime )
+{
+    return std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - startTime ).count();
+}
+
+/************************************************************************
+*    DESC:  Build the mip chain down to 1x1 with a box filter
+************************************************************************/
+void BuildMipChain( std::vector<CImageLevel> & levelVec )
+{
+    while( (levelVec.back().width > 1) || (levelVec.back().height > 1) )
+    {
+        const CImageLevel & src = levelVec.back();
+
+        CImageLevel dst;
+        dst.width = std::max( src.width / 2, 1u );
+        dst.height = std::max( src.height / 2, 1u );
+        dst.pixelVec.resize( dst.width * dst.height * 4 );
+
+        for( uint32_t y = 0; y < dst.height; ++y )
+        {
+            // Odd sizes clamp to the last row/column
+            const uint32_t y0 = std::min( y * 2, src.height - 1 );
+            const uint32_t y1 = std::min( (y * 2) + 1, src.height - 1 );
+
+            for( uint32_t x = 0; x < dst.width; ++x )
+            {
+                const uint32_t x0 = std::min( x * 2, src.width - 1 );
+                const uint32_t x1 = std::min( (x * 2) + 1, src.width - 1 );
+
+                for( uint32_t c = 0; c < 4; ++c )
+                {
+                    const uint32_t sum =
+                        src.pixelVec[((y0 * src.width) + x0) * 4 + c] +
+                        src.pixelVec[((y0 * src.width) + x1) * 4 + c] +
+                        src.pixelVec[((y1 * src.width) + x0) * 4 + c] +
+                        src.pixelVec[((y1 * src.width) + x1) * 4 + c];
+
+                    dst.pixelVec[((y * dst.width) + x) * 4 + c] = (sum + 2) / 4;
+                }
+            }
+        }
+
+        levelVec.push_back( std::move(dst) );
+    }
+}
+
+/************************************************************************
+*    DESC:  Is every pixel of the image opaque
+************************************************************************/
+bool IsOpaque( const CImageLevel & level )
+{
+    for( size_t i = 3; i < level.pixelVec.size(); i += 4 )
+        if( level.pixelVec[i] != 255 )
+            return false;
+
+    return true;
+}
+
+/************************************************************************
+*    DESC:  Write the file data
+************************************************************************/
+void WriteFile( const fs::path & filePath, const std::vector<char> & dataVec )
+{
+    std::ofstream file( filePath, std::ios::binary | std::ios::trunc );
+    file.write( dataVec.data(), dataVec.size() );
+
+    if( !file )
+        throw NExcept::CCriticalException( "Texture Baker Error!", "Error writing file: " + filePath.string() );
+}
+
+/************************************************************************
+*    DESC:  Read the file data
+************************************************************************/
+std::vector<char> ReadFile( const fs::path & filePath )
+{
+    std::ifstream file( filePath, std::ios::binary );
+    if( !file )
+        throw NExcept::CCriticalException( "Texture Baker Error!", "Error reading file: " + filePath.string() );
+
+    return std::vector<char>( std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() );
+}
+
+/************************************************************************
+*    DESC:  Bake one source image
+************************************************************************/
+void BakeImage( const fs::path & sourcePath, bool force, bool rgba, CBakeTotals & totals )
+{
+    // The source extension is kept so images only differing by it don't collide
+    const fs::path rgbaPath( sourcePath.string() + ".ktx2" );
+    const fs::path bcPath( sourcePath.string() + ".bc.ktx2" );
+
+    // Skip images that haven't changed since they were baked
+    if( !force && fs::exists( bcPath ) &&
+        (fs::last_write_time( bcPath ) >= fs::last_write_time( sourcePath )) &&
+        (!rgba || (fs::exists( rgbaPath ) && (fs::last_write_time( rgbaPath ) >= fs::last_write_time( sourcePath )))) )
+    {
+        ++totals.skipCount;
+        return;
+    }
+
+    // Decode the source image the same way the engine does
+    auto startTime = std::chrono::steady_clock::now();
+
+    int width(0), height(0), channels(0);
+    unsigned char * pPixels = SOIL_load_image( sourcePath.string().c_str(), &width, &height, &channels, SOIL_LOAD_RGBA );
+    if( pPixels == nullptr )
+        throw NExcept::CCriticalException( "Texture Baker Error!", "Error loading image: " + sourcePath.string() );
+
+    const double decodeMs = GetElapsedMs( startTime );
+
+    std::vector<CImageLevel> levelVec( 1 );
+    levelVec[0].width = width;
+    levelVec[0].height = height;
+    levelVec[0].pixelVec.assign( pPixels, pPixels + (width * height * 4) );
+    SOIL_free_image_data( pPixels );
+
+    BuildMipChain( levelVec );
+
+    // RGBA8 fallback. Always built for the memory comparison
+    CKtx2File rgbaFile;
+    rgbaFile.create( VK_FORMAT_R8G8B8A8_UNORM, width, height );
+    for( auto & iter : levelVec )
+        rgbaFile.addLevel( iter.pixelVec.data(), iter.pixelVec.size() );
+
+    if( rgba )
+        WriteFile( rgbaPath, rgbaFile.write() );
+
+    // BC1 if the image is opaque, else BC3
+    const bool opaque = IsOpaque( levelVec[0] );
+
+    CKtx2File bcFile;
+    bcFile.create( (opaque ? VK_FORMAT_BC1_RGB_UNORM_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK), width, height );
+    for( auto & iter : levelVec )
+    {
+        int size(0);
+        unsigned char * pBlocks = opaque ?
+            convert_image_to_DXT1( iter.pixelVec.data(), iter.width, iter.height, 4, &size ) :
+            convert_image_to_DXT5( iter.pixelVec.data(), iter.width, iter.height, 4, &size );
+
+        if( pBlocks == nullptr )
+            throw NExcept::CCriticalException( "Texture Baker Error!", "Error compressing image: " + sourcePath.string() );
+
+        bcFile.addLevel( pBlocks, size );
+        free( pBlocks );
+    }
+
+    WriteFile( bcPath, bcFile.write() );
+
+    // Time the load the engine does in place of the decode
+    startTime = std::chrono::steady_clock::now();
+    CKtx2File readFile;
+    readFile.parse( ReadFile( bcPath ), bcPath.string() );
+    const double ktx2ReadMs = GetElapsedMs( startTime );
+
+    const uintmax_t sourceBytes = fs::file_size( sourcePath );
+
+    printf( "%-48s %4dx%-4d %s  src: %6jukb  rgba: %6zukb  bc: %6zukb  decode: %7.2fms  ktx2: %6.2fms\n",
+        sourcePath.filename().string().c_str(),
+        width, height,
+        (opaque ? "BC1" : "BC3"),
+        sourceBytes / 1024,
+        rgbaFile.getDataSize() / 1024,
+        bcFile.getDataSize() / 1024,
+        decodeMs,
+        ktx2ReadMs );
+
+    ++totals.fileCount;
+    totals.sourceBytes += sourceBytes;
+    totals.rgbaBytes += rgbaFile.getDataSize();
+    totals.bcBytes += bcFile.getDataSize();
+    totals.decodeMs += decodeMs;
+    totals.ktx2ReadMs += ktx2ReadMs;
+}
+
+/************************************************************************
+*    DESC:  The main function
+************************************************************************/
+int main( int argc, char * argv[] )
+{
+    std::string texturePath;
+    bool force(false);
+    bool rgba(false);
+
+    for( int i = 1; i < argc; ++i )
+    {
+        if( std::strcmp( argv[i], "--force" ) == 0 )
+            force = true;
+        else if( std::strcmp( argv[i], "--rgba" ) == 0 )
+            rgba = true;
+        else
+            texturePath = argv[i];
+    }
+
+    if( texturePath.empty() )
+    {
+        printf( "Usage: textureBaker <textures folder> [--force] [--rgba]\n" );
+        return 1;
+    }
+
+    const std::vector<std::string> sourceExtVec = { ".png", ".tga", ".bmp", ".jpg", ".jpeg" };
+
+    CBakeTotals totals;
+
+    try
+    {
+        for( auto & iter : fs::recursive_directory_iterator( texturePath ) )
+        {
+            if( !iter.is_regular_file() )
+                continue;
+
+            std::string ext = iter.path().extension().string();
+            std::transform( ext.begin(), ext.end(), ext.begin(), ::tolower );
+
+            if( std::find( sourceExtVec.begin(), sourceExtVec.end(), ext ) != sourceExtVec.end() )
+                BakeImage( iter.path(), force, rgba, totals );
+        }
+    }
+    catch( NExcept::CCriticalException & ex )
+    {
+        printf( "%s\n%s\n", ex.getErrorTitle().c_str(), ex.getErrorMsg().c_str() );
+        return 1;
+    }
+    catch( std::exception & ex )
+    {
+        printf( "Texture Baker Error!\n%s\n", ex.what() );
+        return 1;
+    }
+
+    // GPU memory is the size of the level data. Load time is the decode vs the KTX2 read.
+    printf( "\nBaked: %u  Up to date: %u\n", totals.fileCount, totals.skipCount );
+
+    if( totals.fileCount > 0 )
+    {
+        printf( "Source files: %jukb\n", totals.sourceBytes / 1024 );
+        printf( "GPU memory:   rgba %jukb, bc %jukb (%.1f%%)\n",
+            totals.rgbaBytes / 1024, totals.bcBytes / 1024, 100.0 * totals.bcBytes / totals.rgbaBytes );
+        printf( "Load time:    decode %.1fms, ktx2 %.1fms\n", totals.decodeMs, totals.ktx2ReadMs );
+    }
+
+    return 0;
+}